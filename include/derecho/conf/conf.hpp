@@ -40,10 +40,36 @@ public:
     static constexpr const char* DERECHO_HEARTBEAT_MS = "DERECHO/heartbeat_ms";
     static constexpr const char* DERECHO_P2P_LOOP_BUSY_WAIT_BEFORE_SLEEP_MS = "DERECHO/p2p_loop_busy_wait_before_sleep_ms";
     static constexpr const char* DERECHO_SST_POLL_CQ_TIMEOUT_MS = "DERECHO/sst_poll_cq_timeout_ms";
+    static constexpr const char* DERECHO_FAILURE_DETECTOR = "DERECHO/failure_detector";
+    static constexpr const char* DERECHO_MAX_HEARTBEAT_MS = "DERECHO/max_heartbeat_ms";
+    static constexpr const char* DERECHO_PHI_SUSPICION_THRESHOLD = "DERECHO/phi_suspicion_threshold";
+    static constexpr const char* DERECHO_PHI_MIN_STD_DEVIATION_MS = "DERECHO/phi_min_std_deviation_ms";
     static constexpr const char* DERECHO_RESTART_TIMEOUT_MS = "DERECHO/restart_timeout_ms";
     static constexpr const char* DERECHO_ENABLE_BACKUP_RESTART_LEADERS = "DERECHO/enable_backup_restart_leaders";
     static constexpr const char* DERECHO_DISABLE_PARTITIONING_SAFETY = "DERECHO/disable_partitioning_safety";
     static constexpr const char* DERECHO_MAX_NODE_ID = "DERECHO/max_node_id";
+    static constexpr const char* DERECHO_STATE_TRANSFER_CHUNK_SIZE = "DERECHO/state_transfer_chunk_size";
+    static constexpr const char* DERECHO_RDMA_STATE_TRANSFER = "DERECHO/rdma_state_transfer";
+    static constexpr const char* DERECHO_REUSE_SST_CONNECTIONS = "DERECHO/reuse_sst_connections";
+    static constexpr const char* DERECHO_MAX_JOINS_PER_VIEW = "DERECHO/max_joins_per_view";
+    static constexpr const char* DERECHO_JOIN_BATCH_WINDOW_MS = "DERECHO/join_batch_window_ms";
+    static constexpr const char* DERECHO_DEFER_WEDGE_UNTIL_COMMIT = "DERECHO/defer_wedge_until_commit";
+    static constexpr const char* DERECHO_RDMC_ARENA_SIZE = "DERECHO/rdmc_arena_size";
+    static constexpr const char* DERECHO_RDMC_POOL_MAX_IDLE_BYTES = "DERECHO/rdmc_pool_max_idle_bytes";
+    static constexpr const char* DERECHO_RDMC_ARENA_HUGEPAGES = "DERECHO/rdmc_arena_hugepages";
+    static constexpr const char* DERECHO_RDMC_ADAPTIVE_BLOCK_SIZE = "DERECHO/rdmc_adaptive_block_size";
+    static constexpr const char* DERECHO_RDMC_MIN_BLOCK_SIZE = "DERECHO/rdmc_min_block_size";
+    static constexpr const char* DERECHO_RDMC_BLOCK_OVERHEAD_US = "DERECHO/rdmc_block_overhead_us";
+    static constexpr const char* DERECHO_RDMC_LINK_BANDWIDTH_GBPS = "DERECHO/rdmc_link_bandwidth_gbps";
+    static constexpr const char* DERECHO_RDMC_MAX_IN_FLIGHT_MESSAGES = "DERECHO/rdmc_max_in_flight_messages";
+    static constexpr const char* DERECHO_RDMC_SHARED_SHARD_GROUPS = "DERECHO/rdmc_shared_shard_groups";
+    static constexpr const char* DERECHO_RDMC_NODE_LOCATIONS = "DERECHO/rdmc_node_locations";
+    static constexpr const char* DERECHO_HYBRID_MULTICAST = "DERECHO/hybrid_multicast";
+    static constexpr const char* DERECHO_HYBRID_RDMC_MIN_SIZE = "DERECHO/hybrid_rdmc_min_size";
+    static constexpr const char* DERECHO_REGISTERED_MEMORY_HUGEPAGES = "DERECHO/registered_memory_hugepages";
+    static constexpr const char* DERECHO_REGISTERED_MEMORY_NUMA_NODE = "DERECHO/registered_memory_numa_node";
+    static constexpr const char* DERECHO_NUM_SENDER_THREADS = "DERECHO/num_sender_threads";
+    static constexpr const char* DERECHO_SENDER_THREAD_SUBGROUPS = "DERECHO/sender_thread_subgroups";
 
     static constexpr const char* DERECHO_MAX_P2P_REQUEST_PAYLOAD_SIZE = "DERECHO/max_p2p_request_payload_size";
     static constexpr const char* DERECHO_MAX_P2P_REPLY_PAYLOAD_SIZE = "DERECHO/max_p2p_reply_payload_size";
@@ -66,6 +92,7 @@ public:
     static constexpr const char* PERS_MAX_LOG_ENTRY = "PERS/max_log_entry";
     static constexpr const char* PERS_MAX_DATA_SIZE = "PERS/max_data_size";
     static constexpr const char* PERS_PRIVATE_KEY_FILE = "PERS/private_key_file";
+    static constexpr const char* PERS_ENABLE_CHECKSUMS = "PERS/enable_checksums";
     static constexpr const char* LOGGER_DEFAULT_LOG_NAME = "LOGGER/default_log_name";
     static constexpr const char* LOGGER_DEFAULT_LOG_LEVEL = "LOGGER/default_log_level";
     static constexpr const char* LOGGER_SST_LOG_LEVEL = "LOGGER/sst_log_level";
@@ -98,6 +125,10 @@ private:
             {SUBGROUP_DEFAULT_RDMC_SEND_ALGORITHM, "binomial_send"},
             {DERECHO_P2P_LOOP_BUSY_WAIT_BEFORE_SLEEP_MS, "250"},
             {DERECHO_SST_POLL_CQ_TIMEOUT_MS, "2000"},
+            {DERECHO_FAILURE_DETECTOR, "fixed"},
+            {DERECHO_MAX_HEARTBEAT_MS, "0"},
+            {DERECHO_PHI_SUSPICION_THRESHOLD, "8"},
+            {DERECHO_PHI_MIN_STD_DEVIATION_MS, "100"},
             {DERECHO_RESTART_TIMEOUT_MS, "2000"},
             {DERECHO_DISABLE_PARTITIONING_SAFETY, "true"},
             {DERECHO_ENABLE_BACKUP_RESTART_LEADERS, "false"},
@@ -105,6 +136,28 @@ private:
             {DERECHO_MAX_P2P_REPLY_PAYLOAD_SIZE, "10240"},
             {DERECHO_P2P_WINDOW_SIZE, "16"},
             {DERECHO_MAX_NODE_ID, "1024"},
+            {DERECHO_STATE_TRANSFER_CHUNK_SIZE, "1048576"},
+            {DERECHO_RDMA_STATE_TRANSFER, "false"},
+            {DERECHO_REUSE_SST_CONNECTIONS, "false"},
+            {DERECHO_MAX_JOINS_PER_VIEW, "0"},
+            {DERECHO_JOIN_BATCH_WINDOW_MS, "0"},
+            {DERECHO_DEFER_WEDGE_UNTIL_COMMIT, "false"},
+            {DERECHO_RDMC_ARENA_SIZE, "67108864"},
+            {DERECHO_RDMC_POOL_MAX_IDLE_BYTES, "268435456"},
+            {DERECHO_RDMC_ARENA_HUGEPAGES, "false"},
+            {DERECHO_RDMC_ADAPTIVE_BLOCK_SIZE, "false"},
+            {DERECHO_RDMC_MIN_BLOCK_SIZE, "4096"},
+            {DERECHO_RDMC_BLOCK_OVERHEAD_US, "5"},
+            {DERECHO_RDMC_LINK_BANDWIDTH_GBPS, "100"},
+            {DERECHO_RDMC_MAX_IN_FLIGHT_MESSAGES, "1"},
+            {DERECHO_RDMC_SHARED_SHARD_GROUPS, "false"},
+            {DERECHO_RDMC_NODE_LOCATIONS, ""},
+            {DERECHO_HYBRID_MULTICAST, "false"},
+            {DERECHO_HYBRID_RDMC_MIN_SIZE, "8192"},
+            {DERECHO_REGISTERED_MEMORY_HUGEPAGES, "none"},
+            {DERECHO_REGISTERED_MEMORY_NUMA_NODE, "-1"},
+            {DERECHO_NUM_SENDER_THREADS, "1"},
+            {DERECHO_SENDER_THREAD_SUBGROUPS, ""},
             // [SUBGROUP/<subgroupname>]
             {SUBGROUP_DEFAULT_MAX_PAYLOAD_SIZE, "10240"},
             {SUBGROUP_DEFAULT_MAX_REPLY_PAYLOAD_SIZE, "10240"},
@@ -124,6 +177,7 @@ private:
             {PERS_MAX_LOG_ENTRY, "1048576"},       // 1M log entries.
             {PERS_MAX_DATA_SIZE, "549755813888"},  // 512G total data size.
             {PERS_PRIVATE_KEY_FILE, "private_key.pem"},
+            {PERS_ENABLE_CHECKSUMS, "false"},
             // [LOGGER]
             {LOGGER_DEFAULT_LOG_NAME, "derecho_debug"},
             {LOGGER_DEFAULT_LOG_LEVEL, "info"},
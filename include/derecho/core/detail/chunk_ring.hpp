@@ -0,0 +1,89 @@
+/**
+ * @file chunk_ring.hpp
+ *
+ * A fixed ring of chunk buffers that a serialized object is received into
+ * during state transfer, and that the object is deserialized from as the
+ * chunks arrive.
+ */
+#pragma once
+
+#include <derecho/mutils-serialization/SerializationSupport.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace derecho {
+
+/**
+ * A fixed number of fixed-size buffers that one thread (the writer) fills
+ * with an object's serialized bytes a chunk at a time, in order, while
+ * another thread (the reader) deserializes the object from them through the
+ * mutils::ByteSource interface. A chunk is reused as soon as the reader has
+ * consumed all of its bytes, so receiving an object never takes more memory
+ * than the ring's chunks, however large the object is.
+ *
+ * The writer takes a chunk with next_free_chunk(), fills it (from a socket or
+ * with an RDMA read) and hands it over with chunk_filled(). If the writer
+ * fails, it calls close() so the reader stops waiting for more bytes; the
+ * reader calls stop_reading() when it is done, so the writer stops waiting
+ * for a free chunk. All methods are thread-safe.
+ */
+class ChunkRing : public mutils::ByteSource {
+    const std::size_t chunk_size;
+    std::vector<std::unique_ptr<uint8_t[]>> chunks;
+    /** The number of bytes the writer put in each chunk. */
+    std::vector<std::size_t> filled_sizes;
+    std::mutex ring_mutex;
+    std::condition_variable ring_cv;
+    /** The number of chunks filled since the ring was created. */
+    uint64_t chunks_filled = 0;
+    /** The number of chunks whose bytes have all been consumed since the ring was created. */
+    uint64_t chunks_consumed = 0;
+    /** The offset of the next unread byte in the chunk after the last consumed one. */
+    std::size_t read_offset = 0;
+    bool writer_closed = false;
+    bool reader_stopped = false;
+
+public:
+    /**
+     * @param num_chunks The number of chunks in the ring
+     * @param chunk_size The size of each chunk, in bytes
+     */
+    ChunkRing(std::size_t num_chunks, std::size_t chunk_size);
+
+    std::size_t get_chunk_size() const { return chunk_size; }
+    std::size_t num_chunks() const { return chunks.size(); }
+    /** @return The chunk at the given position in the ring, e.g. to register it for RDMA. */
+    uint8_t* get_chunk(std::size_t index) { return chunks[index].get(); }
+
+    /**
+     * Waits until the chunk after the last filled one has been consumed, and
+     * returns it for the writer to fill.
+     * @throws derecho_exception if the reader stops before the chunk is free
+     */
+    uint8_t* next_free_chunk();
+    /**
+     * Hands the chunk last returned by next_free_chunk() to the reader.
+     * @param size The number of bytes the writer put in it, at most chunk_size
+     */
+    void chunk_filled(std::size_t size);
+    /** Tells the reader that no more chunks will be filled. */
+    void close();
+    /** Tells the writer that no more chunks will be consumed. */
+    void stop_reading();
+
+    /**
+     * Returns the unread bytes of the next filled chunk, waiting for the
+     * writer to fill it if necessary.
+     * @throws derecho_exception if the writer closes the ring first
+     */
+    std::pair<const uint8_t*, std::size_t> next_bytes() override;
+    void consume(std::size_t size) override;
+};
+
+}  // namespace derecho
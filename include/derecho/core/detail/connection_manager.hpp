@@ -145,5 +145,15 @@ public:
      * @return A LockedReference to the TCP socket connected to that node.
      */
     derecho::LockedReference<std::unique_lock<std::mutex>, socket> get_socket(node_id_t node_id);
+
+    /**
+     * Gets a locked reference to the map of all the TCP sockets managed by
+     * this object, indexed by node ID. As with get_socket, no other
+     * tcp_connections methods can be called while the caller holds the locked
+     * reference, but the caller may use several sockets at once (e.g. from
+     * different threads), as long as it does not add or remove sockets.
+     * @return A LockedReference to the map from node IDs to TCP sockets
+     */
+    derecho::LockedReference<std::unique_lock<std::mutex>, std::map<node_id_t, socket>> get_all_sockets();
 };
 }  // namespace tcp
@@ -5,6 +5,7 @@
 #include <derecho/sst/sst.hpp>
 #include "derecho_internal.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <cstring>
@@ -133,7 +134,8 @@ public:
     /**
      * How many changes to the view have been proposed. Monotonically increases.
      * num_changes - num_committed is the number of pending changes, which should never
-     * exceed the number of members in the current view. If num_changes == num_committed
+     * exceed the number of members in the current view (plus max_joins_per_view, if it
+     * is configured). If num_changes == num_committed
      * == num_installed, no changes are pending.
      */
     SSTField<int> num_changes;
@@ -195,8 +197,10 @@ public:
      * @param   num_received_size
      * @param   slot_size
      * @param   index_field_size
+     * @param   max_joins_per_view The number of joins the leader may propose
+     *          at once, beyond the number of members, if greater than 100
      */
-    DerechoSST(const sst::SSTParams& parameters, uint32_t num_subgroups, uint32_t signature_size, uint32_t num_received_size, uint64_t slot_size, uint32_t index_field_size)
+    DerechoSST(const sst::SSTParams& parameters, uint32_t num_subgroups, uint32_t signature_size, uint32_t num_received_size, uint64_t slot_size, uint32_t index_field_size, uint32_t max_joins_per_view = 0)
             : sst::SST<DerechoSST>(this, parameters),
               seq_num(num_subgroups),
               delivered_num(num_subgroups),
@@ -205,13 +209,13 @@ public:
               signed_num(num_subgroups),
               verified_num(num_subgroups),
               suspected(parameters.members.size()),
-              changes(100 + parameters.members.size()),  //The extra 100 entries allows for more joins at startup, when the group is very small
-              joiner_ips(100 + parameters.members.size()),
-              joiner_gms_ports(100 + parameters.members.size()),
-              joiner_state_transfer_ports(100 + parameters.members.size()),
-              joiner_sst_ports(100 + parameters.members.size()),
-              joiner_rdmc_ports(100 + parameters.members.size()),
-              joiner_external_ports(100 + parameters.members.size()),
+              changes(std::max(100u, max_joins_per_view) + parameters.members.size()),  //The extra 100 entries allows for more joins at startup, when the group is very small
+              joiner_ips(std::max(100u, max_joins_per_view) + parameters.members.size()),
+              joiner_gms_ports(std::max(100u, max_joins_per_view) + parameters.members.size()),
+              joiner_state_transfer_ports(std::max(100u, max_joins_per_view) + parameters.members.size()),
+              joiner_sst_ports(std::max(100u, max_joins_per_view) + parameters.members.size()),
+              joiner_rdmc_ports(std::max(100u, max_joins_per_view) + parameters.members.size()),
+              joiner_external_ports(std::max(100u, max_joins_per_view) + parameters.members.size()),
               num_received(num_received_size),
               global_min(num_received_size),
               global_min_ready(num_subgroups),
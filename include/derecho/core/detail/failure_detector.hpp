@@ -0,0 +1,142 @@
+/**
+ * @file failure_detector.hpp
+ *
+ * Policies that decide when a member that stopped acknowledging heartbeats
+ * should be reported as failed, and how often heartbeats should be sent.
+ */
+#pragma once
+
+#include <derecho/core/derecho_type_definitions.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace derecho {
+
+/**
+ * Interface for the failure detectors used by the heartbeat threads of
+ * MulticastGroup and P2PConnectionManager. The heartbeat thread reports every
+ * piece of evidence that a peer is alive (a heartbeat write that completed, or
+ * any ordinary message received from the peer) with heartbeat(), and asks
+ * should_suspect() when a heartbeat write to the peer timed out. A write that
+ * completes with an error always means the peer has failed, so it is never
+ * passed to the detector. All methods are thread-safe.
+ */
+class FailureDetector {
+public:
+    using clock = std::chrono::steady_clock;
+
+    virtual ~FailureDetector() = default;
+    /**
+     * Records that the given node was known to be alive at the given time.
+     * @param who The ID of the node
+     * @param when The time at which it was seen alive
+     */
+    virtual void heartbeat(node_id_t who, clock::time_point when) = 0;
+    /**
+     * @return true if heartbeat() has been called for the given node with a
+     * time no earlier than since.
+     */
+    virtual bool heard_from_since(node_id_t who, clock::time_point since) const = 0;
+    /**
+     * Decides whether a node whose heartbeat write just timed out should be
+     * reported as failed.
+     * @param who The ID of the node
+     * @param now The current time
+     * @return true if the node should be suspected
+     */
+    virtual bool should_suspect(node_id_t who, clock::time_point now) = 0;
+    /** Forgets all the heartbeat history of a node that left the group. */
+    virtual void remove(node_id_t who) = 0;
+    /**
+     * Returns how long the heartbeat thread should wait before its next round
+     * of heartbeats.
+     * @param all_acknowledged True if every heartbeat of the last round was
+     * acknowledged before the completion queue timeout
+     */
+    virtual std::chrono::milliseconds next_heartbeat_interval(bool all_acknowledged) = 0;
+};
+
+/**
+ * The original failure detector: heartbeats are sent every heartbeat_ms, and
+ * a node is suspected as soon as a single heartbeat write times out.
+ */
+class FixedFailureDetector : public FailureDetector {
+    const std::chrono::milliseconds heartbeat_interval;
+    mutable std::mutex history_mutex;
+    std::map<node_id_t, clock::time_point> last_heartbeat;
+
+public:
+    FixedFailureDetector(uint32_t heartbeat_ms);
+    void heartbeat(node_id_t who, clock::time_point when) override;
+    bool heard_from_since(node_id_t who, clock::time_point since) const override;
+    bool should_suspect(node_id_t who, clock::time_point now) override;
+    void remove(node_id_t who) override;
+    std::chrono::milliseconds next_heartbeat_interval(bool all_acknowledged) override;
+};
+
+/**
+ * A phi-accrual failure detector. For each node it keeps a window of the
+ * intervals between successive pieces of evidence that the node is alive,
+ * and models them as a normal distribution. When a heartbeat times out, the
+ * suspicion level phi is -log10 of the probability that the node is still
+ * alive given how long it has been silent; the node is suspected only if phi
+ * exceeds the configured threshold, so a transient stall does not evict a
+ * healthy node. The heartbeat interval starts at heartbeat_ms and doubles
+ * after every round in which all heartbeats were acknowledged, up to
+ * max_heartbeat_ms; it drops back to heartbeat_ms after any timeout.
+ */
+class PhiAccrualFailureDetector : public FailureDetector {
+    /** The number of inter-arrival intervals remembered for each node. */
+    static constexpr std::size_t WINDOW_SIZE = 100;
+
+    struct HeartbeatHistory {
+        clock::time_point last_heartbeat;
+        std::deque<double> intervals_ms;
+        double interval_sum = 0;
+        double interval_squared_sum = 0;
+    };
+
+    const double phi_threshold;
+    const double min_std_deviation_ms;
+    const std::chrono::milliseconds min_heartbeat_interval;
+    const std::chrono::milliseconds max_heartbeat_interval;
+    std::chrono::milliseconds heartbeat_interval;
+    mutable std::mutex history_mutex;
+    std::map<node_id_t, HeartbeatHistory> histories;
+
+public:
+    /**
+     * @param phi_threshold The suspicion level above which a node is suspected
+     * @param min_std_deviation_ms A lower bound on the standard deviation of
+     * the intervals, which keeps a very regular node from being suspected
+     * after a single short stall
+     * @param heartbeat_ms The shortest (and initial) heartbeat interval
+     * @param max_heartbeat_ms The longest heartbeat interval
+     */
+    PhiAccrualFailureDetector(double phi_threshold, double min_std_deviation_ms,
+                              uint32_t heartbeat_ms, uint32_t max_heartbeat_ms);
+    void heartbeat(node_id_t who, clock::time_point when) override;
+    bool heard_from_since(node_id_t who, clock::time_point since) const override;
+    bool should_suspect(node_id_t who, clock::time_point now) override;
+    void remove(node_id_t who) override;
+    std::chrono::milliseconds next_heartbeat_interval(bool all_acknowledged) override;
+    /**
+     * @return The current suspicion level of a node; 0 if it has never been
+     * heard from.
+     */
+    double phi(node_id_t who, clock::time_point now) const;
+};
+
+/**
+ * Constructs the failure detector selected by DERECHO/failure_detector.
+ * @param heartbeat_ms The heartbeat interval of the calling thread
+ */
+std::unique_ptr<FailureDetector> make_failure_detector(uint32_t heartbeat_ms);
+
+}  // namespace derecho
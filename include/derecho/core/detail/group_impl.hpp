@@ -221,14 +221,19 @@ Group<ReplicatedTypes...>::Group(const UserMessageCallbacks& callbacks,
         const vector_int64_2d& old_shard_leaders = view_manager.get_old_shard_leaders();
         // As a side effect, construct_objects filters old_shard_leaders to just the leaders
         // this node needs to receive object state from
+        const auto load_start_time = std::chrono::steady_clock::now();
+        preload_logs(view_manager.get_current_or_restart_view().get());
         std::set<std::pair<subgroup_id_t, node_id_t>> subgroups_and_leaders_to_receive
                 = construct_objects<ReplicatedTypes...>(view_manager.get_current_or_restart_view().get(),
                                                         old_shard_leaders, in_total_restart);
+        persistent::FilePersistLog::discardPreloadedLogs();
         if(in_total_restart) {
+            view_manager.add_restart_log_load_time(std::chrono::steady_clock::now() - load_start_time);
             view_manager.truncate_logs();
-            view_manager.send_logs();
         }
-        receive_objects(subgroups_and_leaders_to_receive);
+        // In total restart, this also sends logs to the other members of shards this node is the restart leader for
+        view_manager.transfer_initial_objects(subgroups_and_leaders_to_receive);
+        retired_objects.clear();
         if(view_manager.is_starting_leader()) {
             if(in_total_restart) {
                 bool leader_has_quorum = true;
@@ -271,7 +276,9 @@ Group<ReplicatedTypes...>::Group(const UserMessageCallbacks& callbacks,
             // Verification callback
             [this](subgroup_id_t subgroup, persistent::version_t version) {
                 rpc_manager.notify_verification_finished(subgroup, version);
-            }};
+            },
+            // RPC receive buffer callback (set in ViewManager)
+            nullptr};
     view_manager.initialize_multicast_groups(callbacks, internal_callbacks);
     rpc_manager.create_connections();
     // This function registers some new-view upcalls to view_manager, so it must come before finish_setup()
@@ -328,9 +335,8 @@ std::set<std::pair<subgroup_id_t, node_id_t>> Group<ReplicatedTypes...>::constru
                 if(old_object != replicated_objects.template get<FirstType>().end() && old_object->second.get_shard_num() != shard_num) {
                     dbg_default_debug("Deleting old Replicated Object state for type {}; I was reassigned from shard {} to shard {}",
                                       typeid(FirstType).name(), old_object->second.get_shard_num(), shard_num);
-                    // also erase from objects_by_subgroup_id
-                    objects_by_subgroup_id.erase(subgroup_id);
-                    replicated_objects.template get<FirstType>().erase(old_object);
+                    // also erases it from objects_by_subgroup_id
+                    retire_object<FirstType>(subgroup_id, old_object);
                 }
                 // Determine if there is existing state for this shard on another node
                 bool has_previous_leader = old_shard_leaders.size() > subgroup_id
@@ -375,8 +381,7 @@ std::set<std::pair<subgroup_id_t, node_id_t>> Group<ReplicatedTypes...>::constru
             if(old_object != replicated_objects.template get<FirstType>().end()) {
                 dbg_default_debug("Deleting old Replicated Object state (of type {}) for subgroup {} because this node is no longer a member",
                                   typeid(FirstType).name(), subgroup_index);
-                objects_by_subgroup_id.erase(subgroup_id);
-                replicated_objects.template get<FirstType>().erase(old_object);
+                retire_object<FirstType>(subgroup_id, old_object);
             }
             // Create a PeerCaller for the subgroup if we don't already have one
             peer_callers.template get<FirstType>().emplace(
@@ -391,6 +396,41 @@ std::set<std::pair<subgroup_id_t, node_id_t>> Group<ReplicatedTypes...>::constru
     return functional_insert(subgroups_to_receive, construct_objects<RestTypes...>(curr_view, old_shard_leaders, in_restart));
 }
 
+template <typename... ReplicatedTypes>
+template <typename T>
+void Group<ReplicatedTypes...>::collect_log_prefixes(const View& curr_view,
+                                                     std::vector<std::pair<std::string, bool>>& log_prefixes) {
+    if constexpr(has_persistent_fields<T>::value) {
+        const subgroup_type_id_t subgroup_type_id = index_of_type<T, ReplicatedTypes...>;
+        const auto& subgroup_ids = curr_view.subgroup_ids_by_type_id.at(subgroup_type_id);
+        for(uint32_t subgroup_index = 0; subgroup_index < subgroup_ids.size(); ++subgroup_index) {
+            if(replicated_objects.template get<T>().count(subgroup_index) != 0) {
+                continue;
+            }
+            const auto& shard_views = curr_view.subgroup_shard_views.at(subgroup_ids.at(subgroup_index));
+            for(uint32_t shard_num = 0; shard_num < shard_views.size(); ++shard_num) {
+                const std::vector<node_id_t>& members = shard_views.at(shard_num).members;
+                if(std::find(members.begin(), members.end(), my_id) != members.end()) {
+                    log_prefixes.emplace_back(persistent::PersistentRegistry::generate_prefix(
+                                                      std::type_index(typeid(T)), subgroup_index, shard_num),
+                                              has_signed_fields<T>::value);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+template <typename... ReplicatedTypes>
+void Group<ReplicatedTypes...>::preload_logs(const View& curr_view) {
+    if(!curr_view.is_adequately_provisioned) {
+        return;
+    }
+    std::vector<std::pair<std::string, bool>> log_prefixes;
+    (collect_log_prefixes<ReplicatedTypes>(curr_view, log_prefixes), ...);
+    persistent::FilePersistLog::preloadLogs(log_prefixes);
+}
+
 template <typename... ReplicatedTypes>
 void Group<ReplicatedTypes...>::set_up_components() {
     // Give PersistenceManager this pointer to break the circular dependency
@@ -418,7 +458,10 @@ void Group<ReplicatedTypes...>::set_up_components() {
                                                            const vector_int64_2d& old_shard_leaders) {
         std::set<std::pair<subgroup_id_t, node_id_t>> subgroups_and_leaders
                 = construct_objects<ReplicatedTypes...>(view, old_shard_leaders, false);
-        receive_objects(subgroups_and_leaders);
+        // Objects are sent and received only after they have all been constructed, so retired_objects
+        // keeps the ones for shards this node just left alive until it has sent them to new members
+        view_manager.transfer_objects_to_new_view(view, old_shard_leaders, subgroups_and_leaders, retired_objects);
+        retired_objects.clear();
     });
 }
 
@@ -510,34 +553,16 @@ ShardIterator<SubgroupType> Group<ReplicatedTypes...>::get_shard_iterator(uint32
 }
 
 template <typename... ReplicatedTypes>
-void Group<ReplicatedTypes...>::receive_objects(const std::set<std::pair<subgroup_id_t, node_id_t>>& subgroups_and_leaders) {
-    // This will receive one object from each shard leader in ascending order of subgroup ID
-    for(const auto& subgroup_and_leader : subgroups_and_leaders) {
-        LockedReference<std::unique_lock<std::mutex>, tcp::socket> leader_socket
-                = view_manager.get_transfer_socket(subgroup_and_leader.second);
-        ReplicatedObject* subgroup_object = objects_by_subgroup_id.at(subgroup_and_leader.first);
-        try {
-            if(subgroup_object->is_persistent()) {
-                persistent::version_t log_tail_length = subgroup_object->get_minimum_latest_persisted_version();
-                dbg_default_debug("Sending log tail length of {} for subgroup {} to node {}.",
-                                  log_tail_length, subgroup_and_leader.first, subgroup_and_leader.second);
-                leader_socket.get().write(log_tail_length);
-            }
-            dbg_default_debug("Receiving Replicated Object state for subgroup {} from node {}",
-                              subgroup_and_leader.first, subgroup_and_leader.second);
-            std::size_t buffer_size;
-            leader_socket.get().read(buffer_size);
-            std::unique_ptr<uint8_t[]> buffer = std::make_unique<uint8_t[]>(buffer_size);
-            leader_socket.get().read(buffer.get(), buffer_size);
-            dbg_default_trace("Deserializing Replicated Object from buffer of size {}", buffer_size);
-            subgroup_object->receive_object(buffer.get());
-        } catch(tcp::socket_error& e) {
-            // Convert socket exceptions to a more readable error message, since this will cause a crash
-            throw derecho_exception("Fatal error: Node " + std::to_string(subgroup_and_leader.second) + " failed during state transfer!");
-        }
-    }
-
-    dbg_default_debug("Done receiving all Replicated Objects from subgroup leaders {}", subgroups_and_leaders.empty() ? "(there were none to receive)" : "");
+template <typename T>
+void Group<ReplicatedTypes...>::retire_object(subgroup_id_t subgroup_id,
+                                              typename replicated_index_map<T>::iterator object_iter) {
+    objects_by_subgroup_id.erase(subgroup_id);
+    // Moving the Replicated<T> leaves an empty shell in the map that can be erased without side effects
+    std::unique_ptr<Replicated<T>> retired = std::make_unique<Replicated<T>>(std::move(object_iter->second));
+    replicated_objects.template get<T>().erase(object_iter);
+    // A new Replicated<T> for this subgroup may be constructed before the retired one is destroyed
+    retired->detach_rpc_functions();
+    retired_objects[subgroup_id] = std::move(retired);
 }
 
 template <typename... ReplicatedTypes>
@@ -562,6 +587,26 @@ std::vector<node_id_t> Group<ReplicatedTypes...>::get_members() {
     return view_manager.get_members();
 }
 
+template <typename... ReplicatedTypes>
+const RestartTimings& Group<ReplicatedTypes...>::get_restart_timings() const {
+    return view_manager.get_restart_timings();
+}
+
+template <typename... ReplicatedTypes>
+ViewChangeTimings Group<ReplicatedTypes...>::get_last_view_change_timings() const {
+    return view_manager.get_last_view_change_timings();
+}
+
+template <typename... ReplicatedTypes>
+BufferPoolStats Group<ReplicatedTypes...>::get_rdmc_buffer_pool_stats() {
+    return view_manager.get_rdmc_buffer_pool_stats();
+}
+
+template <typename... ReplicatedTypes>
+RDMCGroupStats Group<ReplicatedTypes...>::get_rdmc_group_stats() {
+    return view_manager.get_rdmc_group_stats();
+}
+
 template <typename... ReplicatedTypes>
 std::vector<IpAndPorts> Group<ReplicatedTypes...>::get_member_addresses() {
     return view_manager.get_member_addresses();
@@ -0,0 +1,204 @@
+/**
+ * @file message_buffer_pool.hpp
+ *
+ * A pool of registered memory that RDMC messages are sent from and received
+ * into, which grows and shrinks with the amount of data in flight.
+ */
+#pragma once
+
+#include <derecho/rdmc/rdmc.hpp>
+#include <derecho/utils/registered_memory.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace derecho {
+
+class MessageBufferPool;
+
+/**
+ * A large block of memory that is registered with the RDMA layer once and
+ * divided into equal-sized message buffers.
+ */
+struct BufferArena {
+    RegisteredMemory memory;
+    uint8_t* base;
+    std::size_t size;
+    /** The size of each buffer this arena is divided into. */
+    const std::size_t buffer_size;
+    /** True if the arena's memory is backed by huge pages. */
+    bool hugepage_backed;
+    std::shared_ptr<rdma::memory_region> mr;
+    /** The number of this arena's buffers that are in use; protected by the pool's mutex. */
+    std::size_t num_buffers_in_use = 0;
+
+    /**
+     * Maps and registers the memory for a new arena.
+     * @param size The size of the arena in bytes, a multiple of buffer_size
+     * @param buffer_size The size of each buffer in the arena
+     * @param memory_options How to map the arena's memory
+     */
+    BufferArena(std::size_t size, std::size_t buffer_size, const RegisteredMemoryOptions& memory_options);
+    ~BufferArena();
+    BufferArena(const BufferArena&) = delete;
+    BufferArena& operator=(const BufferArena&) = delete;
+};
+
+/**
+ * A buffer for the body of one RDMC message. It is a slice of a registered
+ * BufferArena, identified by the arena's memory region and an offset within
+ * it, and it is returned to the MessageBufferPool it came from when it is
+ * released or destroyed. A MessageBuffer can also wrap registered memory that
+ * the application provided for the message, in which case it has no pool and
+ * releasing it only drops its reference to the memory region.
+ */
+struct MessageBuffer {
+    /** The start of the buffer. */
+    uint8_t* buffer = nullptr;
+    /** The registered memory region that contains the buffer. */
+    std::shared_ptr<rdma::memory_region> mr;
+    /** The offset of the buffer within mr. */
+    std::size_t offset = 0;
+    /** The usable size of the buffer, which is at least the size requested from the pool. */
+    std::size_t size = 0;
+
+    MessageBuffer() {}
+    MessageBuffer(const MessageBuffer&) = delete;
+    MessageBuffer(MessageBuffer&& other);
+    MessageBuffer& operator=(const MessageBuffer&) = delete;
+    MessageBuffer& operator=(MessageBuffer&& other);
+    ~MessageBuffer();
+    /** Returns the buffer to its pool, leaving this MessageBuffer empty. */
+    void release();
+
+private:
+    friend class MessageBufferPool;
+    std::shared_ptr<MessageBufferPool> pool;
+    std::shared_ptr<BufferArena> arena;
+};
+
+/** Accounting for one size class of a MessageBufferPool. */
+struct BufferSizeClassStats {
+    std::size_t buffer_size;
+    std::size_t num_arenas;
+    std::size_t buffers_in_use;
+    std::size_t free_buffers;
+};
+
+/** Accounting for a MessageBufferPool, for operators to inspect. */
+struct BufferPoolStats {
+    /** Bytes of memory currently registered in all arenas. */
+    std::size_t registered_bytes = 0;
+    /** The largest value registered_bytes has had. */
+    std::size_t peak_registered_bytes = 0;
+    /** Bytes in buffers that are currently handed out. */
+    std::size_t in_use_bytes = 0;
+    std::size_t num_arenas = 0;
+    std::size_t num_hugepage_arenas = 0;
+    std::vector<BufferSizeClassStats> size_classes;
+};
+
+/**
+ * Hands out registered buffers for RDMC messages, sized to the message rather
+ * than to the largest message a subgroup allows. Requests are rounded up to a
+ * power-of-two size class, and each size class carves its buffers out of
+ * arenas of about arena_size bytes that are registered once. An arena is
+ * unregistered and unmapped as soon as none of its buffers are in use and the
+ * pool holds more than max_idle_bytes of free buffers. The memory pinned by
+ * the pool therefore follows the data actually in flight.
+ *
+ * Mapping and registering an arena is slow, and buffers are taken on RDMC's
+ * polling thread, so arenas are only ever created by the pool's own grower
+ * thread. A size class asks it for a new arena when its free buffers drop
+ * below a quarter of an arena's worth, so that the next requests usually find
+ * a buffer ready, and a request that finds no free buffer waits for the
+ * grower without holding the pool's lock.
+ *
+ * A pool must be owned by a std::shared_ptr, which the buffers it hands out
+ * share. All methods are thread-safe.
+ */
+class MessageBufferPool : public std::enable_shared_from_this<MessageBufferPool> {
+    /** The smallest size class. */
+    static constexpr std::size_t MIN_BUFFER_SIZE = 4096;
+
+    struct SizeClass {
+        std::vector<std::shared_ptr<BufferArena>> arenas;
+        /** The free buffers of this size class and the arenas they belong to. */
+        std::vector<std::pair<std::shared_ptr<BufferArena>, uint8_t*>> free_buffers;
+        std::size_t buffers_in_use = 0;
+        /** The number of times the grower thread has failed to register an arena for this size class. */
+        uint64_t failed_grows = 0;
+    };
+
+    const std::size_t arena_size;
+    const std::size_t max_idle_bytes;
+    const RegisteredMemoryOptions memory_options;
+    mutable std::mutex pool_mutex;
+    /** Notified when a buffer is freed, an arena is added or fails to be added, or the grower has work. */
+    std::condition_variable pool_cv;
+    /** Maps buffer sizes to size classes. */
+    std::map<std::size_t, SizeClass> size_classes;
+    /** The size classes, by buffer size, that the grower thread should add an arena to. */
+    std::set<std::size_t> grow_requests;
+    std::size_t registered_bytes = 0;
+    std::size_t peak_registered_bytes = 0;
+    std::size_t in_use_bytes = 0;
+    bool thread_shutdown = false;
+    std::thread grower_thread;
+
+    friend struct MessageBuffer;
+    /** Returns a buffer from the given arena to its size class. */
+    void release(const std::shared_ptr<BufferArena>& arena, uint8_t* buffer);
+    /** The number of buffers in each arena of the size class with the given buffer size. */
+    std::size_t buffers_per_arena(std::size_t buffer_size) const;
+    /** The grower thread's loop, which registers arenas for the size classes in grow_requests. */
+    void grow_loop();
+
+public:
+    /**
+     * @param arena_size The approximate size of each arena, in bytes. Size
+     * classes larger than this get one buffer per arena.
+     * @param max_idle_bytes The number of bytes of free buffers the pool
+     * keeps registered before it starts releasing empty arenas
+     * @param memory_options How to map the memory of each arena
+     */
+    MessageBufferPool(std::size_t arena_size, std::size_t max_idle_bytes, const RegisteredMemoryOptions& memory_options);
+    ~MessageBufferPool();
+
+    /**
+     * Gets a buffer that can hold at least size bytes. If its size class has
+     * no free buffers, waits until the grower thread has registered a new
+     * arena or another buffer of the size class is released. Never throws.
+     * @return The buffer, or an empty MessageBuffer (whose buffer is null) if
+     * the grower thread could not register the memory for a new arena
+     */
+    MessageBuffer try_acquire(std::size_t size);
+
+    /**
+     * Gets a buffer that can hold at least size bytes, like try_acquire.
+     * @throws derecho_exception if no memory could be registered for it
+     */
+    MessageBuffer acquire(std::size_t size);
+
+    BufferPoolStats get_stats() const;
+
+    /** @return The buffer size of the size class that a request for size bytes falls in. */
+    static std::size_t size_class_of(std::size_t size);
+};
+
+/**
+ * Constructs a MessageBufferPool configured by DERECHO/rdmc_arena_size,
+ * DERECHO/rdmc_pool_max_idle_bytes, DERECHO/rdmc_arena_hugepages and the
+ * DERECHO/registered_memory_* options.
+ */
+std::shared_ptr<MessageBufferPool> make_message_buffer_pool();
+
+}  // namespace derecho
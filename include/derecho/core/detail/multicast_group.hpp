@@ -12,12 +12,16 @@
 #include <derecho/sst/sst.hpp>
 #include "derecho_internal.hpp"
 #include "derecho_sst.hpp"
+#include "failure_detector.hpp"
+#include "message_buffer_pool.hpp"
 #include "persistence_manager.hpp"
 
 #include <spdlog/spdlog.h>
 
 #include <assert.h>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <list>
 #include <map>
@@ -98,6 +102,8 @@ struct DerechoParams : public mutils::ByteRepresentable {
             return rdmc::send_algorithm::SEQUENTIAL_SEND;
         } else if(rdmc_send_algorithm_string == "tree_send") {
             return rdmc::send_algorithm::TREE_SEND;
+        } else if(rdmc_send_algorithm_string == "topology_send") {
+            return rdmc::send_algorithm::TOPOLOGY_SEND;
         } else {
             throw "wrong value for RDMC send algorithm: " + rdmc_send_algorithm_string + ". Check your config file.";
         }
@@ -170,29 +176,6 @@ struct DerechoParams : public mutils::ByteRepresentable {
                                   heartbeat_ms, rdmc_send_algorithm, state_transfer_port);
 };
 
-/**
- * Represents a block of memory used to store a message. This object contains
- * both the array of bytes in which the message is stored and the corresponding
- * RDMA memory region (which has registered that array of bytes as its buffer).
- * This is a move-only type, since memory regions can't be copied.
- */
-struct MessageBuffer {
-    std::unique_ptr<uint8_t[]> buffer;
-    std::shared_ptr<rdma::memory_region> mr;
-
-    MessageBuffer() {}
-    MessageBuffer(size_t size) {
-        if(size != 0) {
-            buffer = std::unique_ptr<uint8_t[]>(new uint8_t[size]);
-            mr = std::make_shared<rdma::memory_region>(buffer.get(), size);
-        }
-    }
-    MessageBuffer(const MessageBuffer&) = delete;
-    MessageBuffer(MessageBuffer&&) = default;
-    MessageBuffer& operator=(const MessageBuffer&) = delete;
-    MessageBuffer& operator=(MessageBuffer&&) = default;
-};
-
 /**
  * A structure containing an RDMC message (which consists of some bytes in a
  * registered memory region) and some associated metadata. Note that the
@@ -222,6 +205,21 @@ struct SSTMessage {
     volatile uint8_t* buf;
 };
 
+/**
+ * The cost of the RDMC groups that a MulticastGroup created when it was
+ * constructed, for comparing ways of setting them up.
+ */
+struct RDMCGroupStats {
+    /** Wall-clock time spent creating all of the RDMC groups */
+    std::chrono::nanoseconds setup_time{0};
+    /** The number of RDMC groups this node belongs to */
+    std::size_t num_groups = 0;
+    /** The number of connections the RDMC groups opened from this node */
+    std::size_t num_connections = 0;
+    /** Bytes of memory the RDMC groups registered for their own use */
+    std::size_t registered_bytes = 0;
+};
+
 /**
  * A collection of settings for a single subgroup that this node is a member of,
  * specifically the single shard within that subgroup that this node is a member
@@ -252,6 +250,17 @@ struct SubgroupSettings {
     DerechoParams profile;
 };
 
+/**
+ * The type of the function used by MulticastGroup to ask the receiving
+ * Replicated Object for a buffer for an incoming RDMC message that carries an
+ * RPC call. Parameters: the subgroup, the sender, the start of the RPC message
+ * (after the Derecho header), the number of bytes available there, and the
+ * size of the whole message. Returns a destination that can hold the whole
+ * message, or std::nullopt to receive it into a buffer from the pool.
+ */
+using rpc_receive_buffer_func_t = std::function<std::optional<rdmc::receive_destination>(
+        subgroup_id_t, node_id_t, const uint8_t*, std::size_t, std::size_t)>;
+
 /**
  * Additional message-delivery-related callbacks needed by MulticastGroup that
  * are not in the user-facing set of callbacks defined in UserMessageCallbacks.
@@ -277,6 +286,12 @@ struct MulticastGroupCallbacks {
      * verification callback in UserMessageCallbacks).
      */
     verified_callback_t global_verified_callback;
+    /**
+     * A callback that lets a Replicated Object provide the buffer an incoming
+     * RPC message is received into, so that its payload does not need to be
+     * copied out of a pool buffer.
+     */
+    rpc_receive_buffer_func_t rpc_receive_buffer_callback;
 };
 
 /** Implements the low-level mechanics of tracking multicasts in a Derecho group,
@@ -312,9 +327,21 @@ private:
     uint16_t rdmc_group_num_offset;
     /** false if RDMC groups haven't been created successfully */
     bool rdmc_sst_groups_created = false;
-    /** Stores message buffers not currently in use. Protected by
-     * msg_state_mtx */
-    std::map<uint32_t, std::vector<MessageBuffer>> free_message_buffers;
+    /** The pool that RDMC message buffers come from. It is shared by all
+     * subgroups, and passed on to the MulticastGroup of the next view. */
+    std::shared_ptr<MessageBufferPool> buffer_pool;
+    /** The number of RDMC messages this node may have in flight in each subgroup
+     * it sends in, from DERECHO/rdmc_max_in_flight_messages. */
+    const uint32_t max_rdmc_messages_in_flight;
+    /** Whether messages that fit in an SMC slot may be sent through RDMC,
+     * from DERECHO/hybrid_multicast. */
+    const bool hybrid_multicast;
+    /** With hybrid_multicast, the size (including the header) from which a
+     * message that fits in an SMC slot is sent through RDMC when RDMC is idle,
+     * from DERECHO/hybrid_rdmc_min_size. */
+    const uint64_t hybrid_rdmc_min_size;
+    /** What it cost to create this view's RDMC groups. */
+    RDMCGroupStats rdmc_group_stats;
 
     /** Index to be used the next time get_sendbuffer_ptr is called.
      * When next_message is not none, then next_message.index = future_message_index-1 */
@@ -332,12 +359,12 @@ private:
     std::vector<int32_t> first_null_index;
     /** Messages that are ready to be sent, but must wait until the current send finishes. */
     std::vector<std::queue<RDMCMessage>> pending_sends;
-    /** Vector of messages that are currently being sent out using RDMC, or boost::none otherwise. */
-    /** one per subgroup */
-    std::vector<std::optional<RDMCMessage>> current_sends;
+    /** Messages that are currently being sent out using RDMC, oldest first.
+     * One queue per subgroup, holding at most max_rdmc_messages_in_flight messages. */
+    std::vector<std::deque<RDMCMessage>> current_sends;
 
-    /** Messages that are currently being received. */
-    std::map<std::pair<subgroup_id_t, node_id_t>, RDMCMessage> current_receives;
+    /** Messages that are currently being received, oldest first, by subgroup and sender. */
+    std::map<std::pair<subgroup_id_t, node_id_t>, std::deque<RDMCMessage>> current_receives;
     /** Receiver lambdas for shards that have only one member. */
     std::map<subgroup_id_t, std::function<void(uint8_t*, size_t)>> singleton_shard_receive_handlers;
 
@@ -384,16 +411,32 @@ private:
     std::vector<std::unique_ptr<std::atomic<persistent::version_t>>> delivered_version;
 
     std::recursive_mutex msg_state_mtx;
-    std::condition_variable_any sender_cv;
+
+    /**
+     * A thread that sends messages with RDMC in some of the subgroups, and
+     * the condition it waits on until one of them has a message to send.
+     */
+    struct SenderThread {
+        /** The subgroups this thread sends in. */
+        std::vector<subgroup_id_t> subgroups;
+        std::condition_variable_any cv;
+        std::thread thread;
+    };
+    /** The DERECHO/num_sender_threads sender threads; those with no subgroups are not started. */
+    std::vector<std::unique_ptr<SenderThread>> sender_threads;
+    /** Maps each subgroup number to the index of the sender thread that sends in it. */
+    std::vector<uint32_t> subgroup_sender_threads;
 
     /** The time, in milliseconds, that a sender can wait to send a message before it is considered failed. */
     unsigned int sender_timeout;
+    /** Decides how often timeout_thread sends heartbeats and which timeouts are failures. */
+    std::unique_ptr<FailureDetector> failure_detector;
 
     /** Indicates that the group is being destroyed. */
     std::atomic<bool> thread_shutdown{false};
-    /** The background thread that sends messages with RDMC. */
-    std::thread sender_thread;
-
+    /** Subgroups in which no new messages may be sent, although the group is not
+     * wedged yet. Protected by msg_state_mtx. */
+    std::set<subgroup_id_t> wedged_subgroups;
     std::thread timeout_thread;
 
     /** The SST, shared between this group and its GMS. */
@@ -415,14 +458,30 @@ private:
      * alert it when a new version needs to be persisted. */
     PersistenceManager& persistence_manager;
 
-    /** Continuously waits for a new pending send, then sends it. This function
-     * implements the sender thread. */
-    void send_loop();
+    /** Continuously waits for a new pending send in one of the sender's
+     * subgroups, then sends it. This function implements a sender thread. */
+    void send_loop(SenderThread& sender);
+    /** Creates the sender threads' state and assigns the subgroups to them,
+     * as configured by DERECHO/num_sender_threads and
+     * DERECHO/sender_thread_subgroups, without starting the threads. */
+    void assign_sender_threads();
+    /** Starts the sender threads that have subgroups to send in. */
+    void start_sender_threads();
+    /** Wakes up the sender thread that sends in a subgroup. */
+    void notify_sender(subgroup_id_t subgroup_num);
 
     /** Checks for failures when a sender reaches its timeout. This function
      * implements the timeout thread. */
     void check_failures_loop();
 
+    /** Creates the next RDMC message to send in a subgroup and returns a
+     * pointer to its payload, or nullptr if another send is still being
+     * filled in. Called by get_sendbuffer_ptr. */
+    uint8_t* get_rdmc_sendbuffer_ptr(subgroup_id_t subgroup_num, long long unsigned int msg_size, bool cooked_send);
+    /** Whether a new RDMC message in a subgroup could be handed to RDMC
+     * without waiting for earlier RDMC messages to finish. */
+    bool rdmc_has_room(subgroup_id_t subgroup_num) const;
+
     bool create_rdmc_sst_groups();
     void initialize_sst_row();
     void register_predicates();
@@ -594,9 +653,27 @@ public:
 
     /** Stops all sending and receiving in this group, in preparation for shutting it down. */
     void wedge();
+    /**
+     * Stops sending new messages in some subgroups, while messages that were
+     * already sent continue to be received and delivered. Sending in the
+     * other subgroups is unaffected. Used to stop the subgroups affected by a
+     * proposed membership change until it commits and wedge() is called.
+     * @param subgroups The IDs of the subgroups to stop sending in
+     */
+    void wedge_subgroups(const std::set<subgroup_id_t>& subgroups);
     /** Debugging function; prints the current state of the SST to stdout. */
     void debug_print();
 
+    /** @return The memory accounting of the pool that RDMC message buffers come from. */
+    BufferPoolStats get_buffer_pool_stats() const {
+        return buffer_pool->get_stats();
+    }
+
+    /** @return The cost of the RDMC groups created for this view. */
+    RDMCGroupStats get_rdmc_group_stats() const {
+        return rdmc_group_stats;
+    }
+
     /**
      * @return a map from subgroup ID to SubgroupSettings for only those subgroups
      * that this node belongs to.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <derecho/config.h>
+#include "failure_detector.hpp"
 #include "p2p_connection.hpp"
 #ifdef USE_VERBS_API
 #include <derecho/sst/detail/verbs.hpp>
@@ -70,6 +71,12 @@ class P2PConnectionManager {
 
     void check_failures_loop();
     failure_upcall_t failure_upcall;
+    /**
+     * Decides which timed-out heartbeats are failures. Messages received in
+     * probe_all() count as heartbeats, so check_failures_loop() does not need
+     * to probe a node that has been sending to this one.
+     */
+    std::unique_ptr<derecho::FailureDetector> failure_detector;
     std::mutex connections_mutex;
 
 public:
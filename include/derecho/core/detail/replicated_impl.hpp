@@ -6,7 +6,10 @@
 
 #include <derecho/mutils-serialization/SerializationSupport.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <utility>
 
@@ -192,25 +195,87 @@ void Replicated<T>::send_object(tcp::socket& receiver_socket) const {
 
 template <typename T>
 void Replicated<T>::send_object_raw(tcp::socket& receiver_socket) const {
-    auto bind_socket_write = [&receiver_socket](const uint8_t* bytes, std::size_t size) {
-        receiver_socket.write(bytes, size);
+    // post_object produces the object a piece at a time (often one piece per field), so gather
+    // small pieces into a bounded chunk instead of writing each one, but write large pieces
+    // (e.g. log data) directly. Either way, each piece goes out as soon as it's serialized.
+    const std::size_t chunk_size = getConfUInt64(Conf::DERECHO_STATE_TRANSFER_CHUNK_SIZE);
+    std::unique_ptr<uint8_t[]> chunk = std::make_unique<uint8_t[]>(chunk_size);
+    std::size_t chunk_used = 0;
+    auto chunked_socket_write = [&](const uint8_t* bytes, std::size_t size) {
+        if(chunk_used + size > chunk_size && chunk_used > 0) {
+            receiver_socket.write(chunk.get(), chunk_used);
+            chunk_used = 0;
+        }
+        if(size >= chunk_size) {
+            receiver_socket.write(bytes, size);
+        } else {
+            memcpy(chunk.get() + chunk_used, bytes, size);
+            chunk_used += size;
+        }
     };
-    mutils::post_object(bind_socket_write, **user_object_ptr);
+    mutils::post_object(chunked_socket_write, **user_object_ptr);
+    if(chunk_used > 0) {
+        receiver_socket.write(chunk.get(), chunk_used);
+    }
 }
 
 template <typename T>
-std::size_t Replicated<T>::receive_object(uint8_t* buffer) {
+void Replicated<T>::send_object_chunks(std::size_t chunk_size, const std::function<uint8_t*()>& next_chunk,
+                                       const std::function<void(std::size_t)>& chunk_ready) const {
+    uint8_t* chunk = nullptr;
+    std::size_t chunk_used = 0;
+    // Pieces from post_object can be any size, so a large one is split across several chunks
+    auto chunked_copy = [&](const uint8_t* bytes, std::size_t size) {
+        while(size > 0) {
+            if(!chunk) {
+                chunk = next_chunk();
+                chunk_used = 0;
+            }
+            const std::size_t copy_size = std::min(size, chunk_size - chunk_used);
+            memcpy(chunk + chunk_used, bytes, copy_size);
+            chunk_used += copy_size;
+            bytes += copy_size;
+            size -= copy_size;
+            if(chunk_used == chunk_size) {
+                chunk_ready(chunk_used);
+                chunk = nullptr;
+            }
+        }
+    };
+    mutils::post_object(chunked_copy, **user_object_ptr);
+    if(chunk) {
+        chunk_ready(chunk_used);
+    }
+}
+
+template <typename T>
+std::size_t Replicated<T>::receive_object(mutils::ByteSource& source, std::size_t object_size) {
     // Add this object's persistent registry to the list of deserialization contexts
     mutils::RemoteDeserialization_v rdv{group_rpc_manager.deserialization_contexts};
     rdv.insert(rdv.begin(), persistent_registry.get());
     mutils::DeserializationManager dsm{rdv};
-    *user_object_ptr = std::move(mutils::from_bytes<T>(&dsm, buffer));
+    if constexpr(mutils::is_streamable<T>::value) {
+        *user_object_ptr = mutils::from_stream<T>(&dsm, source);
+    } else {
+        // T can only be deserialized from a buffer that holds all of it
+        std::unique_ptr<uint8_t[]> buffer = std::make_unique<uint8_t[]>(object_size);
+        source.read(buffer.get(), object_size);
+        *user_object_ptr = mutils::from_bytes<T>(&dsm, buffer.get());
+    }
     if constexpr(std::is_base_of_v<GroupReference, T>) {
         (**user_object_ptr).set_group_pointers(group, subgroup_index);
     }
     return mutils::bytes_size(**user_object_ptr);
 }
 
+template <typename T>
+void Replicated<T>::detach_rpc_functions() {
+    if(wrapped_this) {
+        group_rpc_manager.destroy_remote_invocable_class(subgroup_id);
+        wrapped_this.reset();
+    }
+}
+
 template <typename T>
 void Replicated<T>::new_view_callback(const View& new_view) {
     if constexpr(view_callback_enabled_v<T>) {
@@ -276,6 +341,11 @@ persistent::version_t Replicated<T>::get_minimum_latest_persisted_version() {
     return persistent_registry->getMinimumLatestPersistedVersion();
 }
 
+template <typename T>
+std::map<std::size_t, persistent::version_t> Replicated<T>::get_latest_persisted_versions() {
+    return persistent_registry->getLatestPersistedVersions();
+}
+
 template <typename T>
 void Replicated<T>::post_next_version(persistent::version_t version, uint64_t ts_us) {
     current_version = version;
@@ -286,6 +356,28 @@ void Replicated<T>::post_next_version(persistent::version_t version, uint64_t ts
     }
 }
 
+template <typename T>
+std::optional<ReceiveBuffer> Replicated<T>::get_receive_buffer(node_id_t sender, const uint8_t* rpc_header,
+                                                               std::size_t rpc_header_size,
+                                                               std::size_t message_size) {
+    if constexpr(receive_buffers_enabled_v<T>) {
+        if(!is_valid() || rpc_header_size < rpc::remote_invocation_utilities::header_space()) {
+            return std::nullopt;
+        }
+        std::size_t payload_size;
+        rpc::Opcode opcode;
+        node_id_t from;
+        uint32_t flags;
+        rpc::remote_invocation_utilities::retrieve_header(rpc_header, payload_size, opcode, from, flags);
+        if(opcode.is_reply || opcode.subgroup_id != subgroup_id) {
+            return std::nullopt;
+        }
+        return (**user_object_ptr).get_receive_buffer(opcode.function_id, sender, message_size);
+    } else {
+        return std::nullopt;
+    }
+}
+
 template <typename T>
 std::tuple<persistent::version_t, HLC> Replicated<T>::get_current_version() {
     return std::tie(current_version, current_hlc);
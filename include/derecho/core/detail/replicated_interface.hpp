@@ -2,9 +2,14 @@
 
 #include <derecho/config.h>
 #include <derecho/openssl/signature.hpp>
+#include <derecho/rdmc/rdmc.hpp>
 #include <derecho/tcp/tcp.hpp>
 #include "derecho_internal.hpp"
 
+#include <derecho/mutils-serialization/SerializationSupport.hpp>
+
+#include <functional>
+#include <map>
 #include <optional>
 #include <vector>
 
@@ -23,6 +28,7 @@ public:
     virtual bool is_persistent() const = 0;
     virtual bool is_signed() const = 0;
     virtual persistent::version_t get_minimum_latest_persisted_version() = 0;
+    virtual std::map<std::size_t, persistent::version_t> get_latest_persisted_versions() = 0;
     virtual std::vector<uint8_t> get_signature(persistent::version_t version) = 0;
     virtual bool verify_log(persistent::version_t version, openssl::Verifier& verifier,
                             const uint8_t* signature) = 0;
@@ -30,12 +36,18 @@ public:
     virtual std::size_t object_size() const = 0;
     virtual void send_object(tcp::socket& receiver_socket) const = 0;
     virtual void send_object_raw(tcp::socket& receiver_socket) const = 0;
-    virtual std::size_t receive_object(uint8_t* buffer) = 0;
+    virtual void send_object_chunks(std::size_t chunk_size, const std::function<uint8_t*()>& next_chunk,
+                                    const std::function<void(std::size_t)>& chunk_ready) const = 0;
+    virtual std::size_t receive_object(mutils::ByteSource& source, std::size_t object_size) = 0;
     virtual void make_version(persistent::version_t ver, const HLC& hlc) = 0;
     virtual persistent::version_t sign(uint8_t* signature_buffer) = 0;
     virtual persistent::version_t persist(std::optional<persistent::version_t> version = std::nullopt) = 0;
     virtual void truncate(persistent::version_t latest_version) = 0;
     virtual void post_next_version(persistent::version_t version, uint64_t msg_ts) = 0;
+    virtual std::optional<rdmc::receive_destination> get_receive_buffer(node_id_t sender, const uint8_t* rpc_header,
+                                                                        std::size_t rpc_header_size,
+                                                                        std::size_t message_size)
+            = 0;
 };
 
 }  // namespace derecho
@@ -8,7 +8,9 @@
 
 #include <spdlog/spdlog.h>
 
+#include <chrono>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <sstream>
@@ -99,6 +101,48 @@ struct RestartState {
                                                                const std::vector<int32_t>& max_received_by_sender);
 };
 
+/**
+ * Wall-clock time this node spent in each stage of a total restart. Stages
+ * that ran more than once (e.g. because a restart leader failed and the node
+ * had to try again) accumulate their durations; stages that did not run on
+ * this node stay at zero.
+ */
+struct RestartTimings {
+    /** Reading the logged View from disk */
+    std::chrono::nanoseconds load_view{0};
+    /** Discovering the persistent logs and loading or synthesizing the ragged trims */
+    std::chrono::nanoseconds load_ragged_trim{0};
+    /** Reaching the restart leader (or, on the leader, waiting for a quorum)
+     * and receiving the restart View, excluding load_ragged_trim */
+    std::chrono::nanoseconds contact_leader{0};
+    /** Loading the persistent logs, each field's log concurrently, and
+     * constructing the Replicated Objects from them */
+    std::chrono::nanoseconds load_logs{0};
+    /** Saving the final ragged trims and truncating the persistent logs */
+    std::chrono::nanoseconds truncate_logs{0};
+    /** State transfer: sending object state to other members of shards this node
+     * leads, concurrently with receiving object state from other leaders */
+    std::chrono::nanoseconds send_logs{0};
+    /** From the start of ViewManager::first_init() until the restart View is
+     * installed in ViewManager::finish_setup() */
+    std::chrono::nanoseconds total{0};
+};
+
+/**
+ * Everything a node sends to the restart leader when it rejoins during total
+ * restart, before the leader has decided on a restart view.
+ */
+struct RejoinMessage {
+    node_id_t joiner_id;
+    IpAndPorts ips_and_ports;
+    /** The last View the node logged */
+    std::unique_ptr<View> logged_view;
+    /** The node's logged RaggedTrims, which include its longest-log records */
+    std::vector<std::unique_ptr<RaggedTrim>> ragged_trims;
+    /** The TCP socket connected to the node */
+    tcp::socket socket;
+};
+
 class RestartLeaderState {
 private:
     /** Pointer to the ViewManager logger, which is created by ViewManager */
@@ -135,15 +179,36 @@ private:
     const node_id_t my_id;
 
     /**
-     * Helper method for await_quorum that processes the logged View and
-     * RaggedTrims from a single rejoining node. This may update curr_view or
-     * logged_ragged_trim if the joiner has newer information.
-     * @param joiner_id The ID of the rejoining node
+     * Helper method for await_quorum that does the rejoin handshake with a
+     * node that connected to the leader, and receives its ports, logged View
+     * and RaggedTrims. Since it does not modify any state, await_quorum runs
+     * it concurrently for all the nodes that are connecting.
      * @param client_socket The TCP socket connected to the rejoining node
-     * @return True if the logs were received successfully, false if the client
-     * disconnected (crashed) while sending them
+     * @return The node's rejoin information, which owns the socket, or null if
+     * the node was rejected or disconnected (crashed) during the handshake
+     */
+    std::unique_ptr<RejoinMessage> receive_rejoin(tcp::socket client_socket);
+
+    /**
+     * Helper method for await_quorum that processes the logged View and
+     * RaggedTrims from a single rejoining node, and adds it to the set of
+     * rejoined nodes. This may update curr_view or logged_ragged_trim if the
+     * joiner has newer information.
+     * @param rejoin The information received from the node by receive_rejoin;
+     * its socket is moved to waiting_join_sockets.
+     */
+    void merge_joiner_logs(RejoinMessage& rejoin);
+
+    /**
+     * Runs an operation on the sockets of all the nodes that are ready to
+     * restart concurrently, and waits for all of them to finish. Nodes for
+     * which the operation throws a socket error are removed from the rejoined
+     * nodes, and their sockets are closed.
+     * @param operation The operation to run on each node's ID and socket
+     * @return -1 if the operation succeeded for every node; otherwise the ID
+     * of a node that failed.
      */
-    bool receive_joiner_logs(const node_id_t& joiner_id, tcp::socket& client_socket);
+    int64_t for_each_waiting_socket(const std::function<void(node_id_t, tcp::socket&)>& operation);
 
     /**
      * Recomputes the restart view based on the current set of nodes that have
@@ -169,7 +234,9 @@ public:
      * Waits for nodes to rejoin at this node, updating the last known View and
      * RaggedTrim (and corresponding longest-log information) as each node connects,
      * until there is a quorum of nodes from the last known View and a new View
-     * can be installed that is adequately provisioned.
+     * can be installed that is adequately provisioned. Rejoin handshakes run
+     * concurrently, and the restart view is recomputed once for each group of
+     * nodes whose handshakes have finished, rather than once per node.
      * @param server_socket The TCP socket to listen for rejoining nodes on
      */
     void await_quorum(tcp::connection_listener& server_socket);
@@ -10,6 +10,7 @@
 #include "../view.hpp"
 #include <derecho/conf/conf.hpp>
 #include <derecho/mutils-serialization/SerializationSupport.hpp>
+#include "chunk_ring.hpp"
 #include "derecho_internal.hpp"
 #include "locked_reference.hpp"
 #include "multicast_group.hpp"
@@ -20,10 +21,12 @@
 
 #include <spdlog/spdlog.h>
 
+#include <chrono>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <shared_mutex>
 #include <string>
 #include <thread>
@@ -112,6 +115,30 @@ using SharedLockedReference = LockedReference<std::shared_lock<std::shared_timed
 /** Type of a function that can be called by ViewManager to notify another component that a new view was installed */
 using view_upcall_t = std::function<void(const View&)>;
 
+/**
+ * Wall-clock time this node spent in each stage of the view change that
+ * installed a View. Stages run one after another, so they add up to total.
+ */
+struct ViewChangeTimings {
+    /** The ID of the View that this view change installed, or -1 if no view change has completed */
+    int32_t vid = -1;
+    /** From the first failure suspicion or proposed membership change until
+     * the leader committed the change and this node started wedging */
+    std::chrono::nanoseconds suspicion{0};
+    /** Waiting for every non-failed member to wedge the old view */
+    std::chrono::nanoseconds wedge{0};
+    /** Ragged edge cleanup, including waiting for the trimmed messages to persist */
+    std::chrono::nanoseconds ragged_trim{0};
+    /** Sending (on the leader) or receiving the new View, including sending it to joining nodes */
+    std::chrono::nanoseconds view_send{0};
+    /** Constructing the new Replicated Objects, state transfer, and committing the view with joining nodes */
+    std::chrono::nanoseconds state_transfer{0};
+    /** Updating the TCP connections of RDMC and SST and setting up the new SST and MulticastGroup */
+    std::chrono::nanoseconds sst_rebuild{0};
+    /** The whole view change, from the start of the suspicion stage until the new View is installed */
+    std::chrono::nanoseconds total{0};
+};
+
 /** Type of a 2-dimensional vector used to store potential node IDs, or -1 */
 using vector_int64_2d = std::vector<std::vector<int64_t>>;
 
@@ -121,6 +148,14 @@ private:
 
     using initialize_rpc_objects_t = std::function<void(node_id_t, const View&, const std::vector<std::vector<int64_t>>&)>;
 
+    /**
+     * Lists the Replicated Objects to send to, or receive from, each node
+     * during state transfer, indexed by node ID. Each node's list must be in
+     * ascending order of subgroup ID, since both ends of a transfer rely on
+     * this order to match up objects.
+     */
+    using object_transfer_map_t = std::map<node_id_t, std::vector<std::pair<subgroup_id_t, ReplicatedObject*>>>;
+
     //Allow Replicated to access view_mutex and view_change_cv directly
     template <typename T>
     friend class Replicated;
@@ -146,6 +181,8 @@ private:
     LockedQueue<tcp::socket> pending_new_sockets;
     /** On the leader node, contains client sockets for pending joins that have not yet been handled.*/
     std::list<std::pair<node_id_t, tcp::socket>> pending_join_sockets;
+    /** The time at which the oldest socket in pending_join_sockets arrived */
+    std::chrono::steady_clock::time_point oldest_pending_join_time;
     /** The sockets connected to clients that will join in the next view, if any */
     std::list<std::pair<node_id_t, tcp::socket>> proposed_join_sockets;
     /**
@@ -164,6 +201,18 @@ private:
      * Helps the SST predicate detect when there's been a change to suspected[].*/
     std::vector<bool> last_suspected;
 
+    /** Stage durations of the view change in progress, filled in as it proceeds */
+    ViewChangeTimings view_change_timings;
+    /** The time at which the view change in progress was first noticed, or
+     * the epoch if no view change is in progress */
+    std::chrono::steady_clock::time_point view_change_start_time;
+    /** The time at which the current stage of the view change in progress started */
+    std::chrono::steady_clock::time_point view_change_stage_start_time;
+    /** Stage durations of the last completed view change, returned by get_last_view_change_timings() */
+    ViewChangeTimings last_view_change_timings;
+    /** Protects last_view_change_timings, which the application can read at any time */
+    mutable std::mutex view_change_timings_mutex;
+
     /** The TCP socket the leader uses to listen for joining clients */
     tcp::connection_listener server_socket;
     /** A flag to signal background threads to shut down; set to true when the group is destroyed. */
@@ -179,6 +228,24 @@ private:
      */
     const bool disable_partitioning_safety;
 
+    /**
+     * The maximum number of joins the leader will propose in one view change,
+     * from the configuration. If 0, the leader proposes at most as many
+     * changes at once as there are members in the current view.
+     */
+    const uint32_t max_joins_per_view;
+    /**
+     * How long the leader waits after a join request arrives for more join
+     * requests, so that they can all be proposed in the same view change.
+     */
+    const std::chrono::milliseconds join_batch_window;
+    /**
+     * If true, the view is not wedged until start_meta_wedge(). Until then, a
+     * proposed membership change only stops sending in the subgroups this node
+     * belongs to that contain a failed or departing node.
+     */
+    const bool defer_wedge_until_commit;
+
     //Handles for all the predicates the GMS registered with the current view's SST.
     pred_handle leader_suspicion_handle;
     pred_handle follower_suspicion_handle;
@@ -243,6 +310,13 @@ private:
      * before completing group setup; false otherwise. */
     bool in_total_restart;
 
+    /** True once the SST's global state and TCP connections have been set up. */
+    bool sst_initialized = false;
+    /** The members of the initial view the SST's TCP connections were set up
+     * for. This is only kept up to date until the initial view commits, since
+     * RDMA state transfer may set up the SST for an initial view that aborts. */
+    std::set<node_id_t> sst_members;
+
     /** If this node is the restart leader and currently doing a total restart,
      * this object contains state related to the restart, including curr_view.
      * Otherwise this will be a null pointer. */
@@ -253,6 +327,12 @@ private:
      * Otherwise this will be a null pointer. */
     std::unique_ptr<RestartState> restart_state;
 
+    /** Time spent in each stage of total restart, if this node restarted */
+    RestartTimings restart_timings;
+
+    /** The time at which first_init() started, used to compute restart_timings.total */
+    std::chrono::steady_clock::time_point restart_start_time;
+
     /**
      * True if this node is the current leader and is fully active (i.e. has
      * finished "waking up"), false otherwise.
@@ -281,6 +361,12 @@ private:
 
     bool has_pending_new() { return pending_new_sockets.locked().access.size() > 0; }
     bool has_pending_join() { return pending_join_sockets.size() > 0; }
+    /**
+     * Returns true if the leader should propose the pending joins now, rather
+     * than wait for more joins to arrive: either join_batch_window has elapsed
+     * since the oldest pending join arrived, or a full batch is pending.
+     */
+    bool join_batch_ready() const;
 
     /* ---------------------------- View-management triggers ---------------------------- */
     /**
@@ -291,7 +377,9 @@ private:
     /**
      * A gateway that handles any socket connections, exchanges version code,
      * reads JoinRequest and then decides whether to propose changes, redirect
-     * to leader, or handle as an external connection request.
+     * to leader, or handle as an external connection request. Handles every
+     * socket that is pending when it is called, doing the version exchanges
+     * concurrently so that a burst of connections is handled at once.
      */
     void process_new_sockets();
     /**
@@ -362,12 +450,55 @@ private:
     /* ------------------- Helper methods for view-management triggers ------------------ */
 
     /**
-     * Assuming this node is the leader, handles a join request from a client.
+     * Records that a view change has started, if one is not already in
+     * progress, for view_change_timings.
+     */
+    void note_view_change_started();
+
+    /**
+     * Ends the current stage of the view change in progress, adding its
+     * duration to the given field of view_change_timings, and starts the next.
+     * @param stage_duration The field of view_change_timings for the stage that ended
+     */
+    void end_view_change_stage(std::chrono::nanoseconds& stage_duration);
+
+    /**
+     * Returns the IDs of the subgroups, among the ones this node belongs to,
+     * whose shard contains at least one of the given nodes.
+     */
+    std::set<subgroup_id_t> subgroups_containing(const std::set<node_id_t>& nodes) const;
+
+    /**
+     * Assuming this node is the leader, handles a batch of join requests
+     * from clients: completes the join handshake with all of them
+     * concurrently, then proposes a join in the SST for each one that
+     * succeeded and moves its socket to proposed_join_sockets.
+     * @param joiners The joining clients' IDs and the TCP sockets connected
+     * to them. The sockets of clients whose joins failed are closed.
+     */
+    void receive_joins(DerechoSST& gmsSST, std::list<std::pair<node_id_t, tcp::socket>>&& joiners);
+
+    /**
+     * Assuming this node is the leader, does the handshake for a join
+     * request from a client, which tells the client whether it can join and
+     * receives its port numbers. Does not modify any state, so it can be
+     * called concurrently for several clients.
+     * @param joiner_id The ID the client announced
      * @param client_socket A TCP socket connected to the joining client
-     * @return True if the join succeeded, false if it failed because the
-     *         client's ID was already in use.
+     * @param id_in_use True if the client should be rejected because its ID
+     * is already in use (by a member or another client in the same batch)
+     * @param joiner_address Set to the client's IP address and ports
+     * @return True if the handshake succeeded, false if it failed because the
+     *         client's ID was already in use or the connection failed.
      */
-    bool receive_join(DerechoSST& gmsSST, const node_id_t joiner_id, tcp::socket& client_socket);
+    bool receive_join(const node_id_t joiner_id, tcp::socket& client_socket, bool id_in_use,
+                      IpAndPorts& joiner_address);
+    /**
+     * Assuming this node is the leader, proposes a join by a client that has
+     * finished the join handshake, by adding it to the changes in the SST.
+     * Does not push the proposed change.
+     */
+    void propose_join(DerechoSST& gmsSST, const node_id_t joiner_id, const IpAndPorts& joiner_address);
 
     /**
      * Assuming the suspected[] array in the SST has changed, searches through
@@ -383,14 +514,94 @@ private:
      * initializes new connections to joined members.
      */
     void update_tcp_connections();
+    /**
+     * Updates the SST's TCP connections to reflect the joined and departed
+     * members in next_view, like update_tcp_connections.
+     */
+    void update_sst_connections();
 
-    /** Helper method for completing view changes; determines whether this node
-     * needs to send Replicated Object state to each node that just joined, and then
-     * sends the state if necessary. */
-    void send_objects_to_new_members(const vector_int64_2d& old_shard_leaders);
+    /**
+     * Builds the list of Replicated Objects to receive during state transfer,
+     * which are the objects in subgroup_objects for the subgroups listed in
+     * subgroups_and_leaders, indexed by the node each one comes from.
+     * @param subgroups_and_leaders Pairs of (subgroup ID, leader's node ID)
+     * for subgroups that need to have their state initialized from the leader
+     */
+    object_transfer_map_t get_objects_to_receive(const std::set<std::pair<subgroup_id_t, node_id_t>>& subgroups_and_leaders);
 
-    /** Sends a single subgroup's replicated object to a new member after a view change. */
-    void send_subgroup_object(subgroup_id_t subgroup_id, node_id_t new_node_id);
+    /**
+     * Sends and receives Replicated Object state over the state-transfer TCP
+     * sockets, running the transfers with every other node concurrently.
+     * Throws once all transfers have stopped if any of them failed.
+     *
+     * Since every object involved has already been constructed, no transfer
+     * waits for another to finish, so two nodes that exchange objects in
+     * both directions cannot deadlock.
+     *
+     * If DERECHO/rdma_state_transfer is enabled, this first sets up an RDMA
+     * connection to each of the other nodes, which must already have SST TCP
+     * connections to this node, and objects are sent with RDMA.
+     * @param objects_to_send The objects this node should send to each node
+     * @param objects_to_receive The objects this node should receive from
+     * each node, which will be updated with the received state
+     * @throw derecho_exception if another node failed during state transfer
+     */
+    void transfer_objects(const object_transfer_map_t& objects_to_send,
+                          const object_transfer_map_t& objects_to_receive);
+
+    /**
+     * Helper for transfer_objects that runs all the transfers between this
+     * node and one other node over their shared socket. Each node first
+     * writes the log tail lengths of the persistent objects it is about to
+     * receive, then the objects it is sending, while a second thread reads
+     * the same sequence from the other node; this lets both directions make
+     * progress at once. The log tail lengths are the latest version of each
+     * Persistent field, so the sender only sends the log entries the receiver
+     * is missing, and leaves out each field's current state if the receiver
+     * can rebuild it from its own log.
+     *
+     * If rdma_connection is not null, each object is instead serialized a
+     * chunk at a time into a small ring of chunk buffers registered as OOB
+     * memory, and only each chunk's size, address and memory key are written
+     * to the socket. The other node reads each chunk with a one-sided RDMA
+     * read and then writes the number of chunks it has read into this node's
+     * OOB memory, so this node can reuse the chunk's buffer; once it has read
+     * every object, it writes an acknowledgement so this node knows when it
+     * can release the buffers. The receiving side follows whichever method
+     * the sender chose for each object.
+     * @param other_id The ID of the other node
+     * @param other_socket The state-transfer socket connected to that node
+     * @param objects_to_send The objects to send to that node, in ascending
+     * order of subgroup ID
+     * @param objects_to_receive The objects to receive from that node, in
+     * ascending order of subgroup ID
+     * @param rdma_connection The RDMA connection to that node to send objects
+     * with, or null to send them over the socket
+     */
+    void transfer_objects_with(node_id_t other_id, tcp::socket& other_socket,
+                               const std::vector<std::pair<subgroup_id_t, ReplicatedObject*>>& objects_to_send,
+                               const std::vector<std::pair<subgroup_id_t, ReplicatedObject*>>& objects_to_receive,
+                               sst::resources* rdma_connection);
+
+    /**
+     * Receives one Replicated Object's serialized state from another node
+     * during state transfer into a ring of chunks, from which another thread
+     * deserializes the object as the chunks arrive, using whichever method the
+     * sender chose. With RDMA, each chunk is read straight into the ring, whose
+     * chunks are registered as OOB memory while the object is read.
+     * @param other_id The ID of the node sending the object
+     * @param other_socket The state-transfer socket connected to that node
+     * @param rdma_connection The RDMA connection to that node, or null if
+     * there is none
+     * @param over_rdma True if the sender chose to send the object with RDMA
+     * @param object_size The size of the serialized object
+     * @param ring The ring to receive the object's chunks into
+     * @param rdma_chunks_read The number of chunks read with RDMA from that
+     * node so far, which is updated as chunks are read
+     */
+    void receive_object_state(node_id_t other_id, tcp::socket& other_socket,
+                              sst::resources* rdma_connection, bool over_rdma,
+                              std::size_t object_size, ChunkRing& ring, uint64_t& rdma_chunks_read);
 
     /** Sends a joining node the new view that has been constructed to include it.*/
     void send_view(const View& new_view, tcp::socket& client_socket);
@@ -526,7 +737,8 @@ private:
     /** Constructor helper method to encapsulate creating all the predicates. */
     void register_predicates();
     /** Constructor helper that reads logged ragged trim information from disk,
-     * called only if there is also a logged view on disk from a previous failed group. */
+     * called only if there is also a logged view on disk from a previous failed group.
+     * Records the time it took in restart_timings. */
     void load_ragged_trim();
     /** Constructor helper for the leader when it first starts; waits for enough
      * new nodes to join to make the first view adequately provisioned. */
@@ -543,6 +755,13 @@ private:
 
     /** Performs one-time global initialization of RDMC and SST, using the current view's membership. */
     void initialize_rdmc_sst();
+    /**
+     * Performs one-time global initialization of the SST, using a view's
+     * membership. If the SST was already initialized for an earlier initial
+     * view, updates its TCP connections to match this view's members instead.
+     * @param view The initial view (or restart view) this node is installing
+     */
+    void initialize_sst(const View& view);
     /**
      * Helper for joining an existing group; sends a join request to the configured
      * contact node, handles redirects to the leader, and sends the logged View if
@@ -783,12 +1002,68 @@ public:
     void truncate_logs();
 
     /**
-     * An extra setup method only needed during total restart. Sends Replicated
-     * Object data (most importantly, the persistent logs) to all members of a
-     * shard if this node is listed as that shard's leader. This function does
-     * nothing if this node is not in total restart mode.
+     * Returns the time this node spent in each stage of total restart. All
+     * durations are zero if this node did not restart from logged state.
+     */
+    const RestartTimings& get_restart_timings() const { return restart_timings; }
+
+    /**
+     * Adds the time Group spent loading persistent logs and constructing
+     * Replicated Objects from them to the total restart timings.
+     */
+    void add_restart_log_load_time(std::chrono::nanoseconds load_time) { restart_timings.load_logs += load_time; }
+
+    /**
+     * Returns the time this node spent in each stage of the most recent view
+     * change it completed. The vid field is -1 if there has not been one yet.
+     * This can be called from a new-view upcall to get the timings of the view
+     * change that installed that view.
+     */
+    ViewChangeTimings get_last_view_change_timings() const;
+
+    /**
+     * Returns the memory accounting of the pool of registered buffers that
+     * RDMC messages are sent from and received into.
+     */
+    BufferPoolStats get_rdmc_buffer_pool_stats();
+
+    /**
+     * Returns how long it took to create the RDMC groups of the current view,
+     * and how many connections and how much registered memory they use.
+     */
+    RDMCGroupStats get_rdmc_group_stats();
+
+    /**
+     * Completes state transfer for this node's initial view, after Group has
+     * constructed its Replicated Objects, by receiving object state from the
+     * shard leaders listed in subgroups_and_leaders. During total restart,
+     * this also sends Replicated Object data (most importantly, the persistent
+     * logs) to all members of a shard if this node is listed as that shard's
+     * leader. All of the transfers run concurrently.
+     * @param subgroups_and_leaders Pairs of (subgroup ID, leader's node ID)
+     * for subgroups that need to have their state initialized from the leader
+     */
+    void transfer_initial_objects(const std::set<std::pair<subgroup_id_t, node_id_t>>& subgroups_and_leaders);
+
+    /**
+     * Completes state transfer for a view change, after Group has constructed
+     * the Replicated Objects for the new view. Sends the state of each shard
+     * this node led in the previous view to the shard's new members, while
+     * receiving the state of the shards this node just joined; all of the
+     * transfers run concurrently.
+     * @param new_view The view being installed
+     * @param old_shard_leaders The leader of each shard in the previous view,
+     * indexed by the new view's subgroup IDs, or -1 if there was none
+     * @param subgroups_and_leaders Pairs of (subgroup ID, leader's node ID)
+     * for subgroups that need to have their state initialized from the leader
+     * @param retired_objects Replicated Objects that Group removed from
+     * subgroup_objects because this node left their shard, but whose state
+     * this node may still need to send
      */
-    void send_logs();
+    void transfer_objects_to_new_view(const View& new_view,
+                                      const vector_int64_2d& old_shard_leaders,
+                                      const std::set<std::pair<subgroup_id_t, node_id_t>>& subgroups_and_leaders,
+                                      const std::map<subgroup_id_t, std::unique_ptr<ReplicatedObject>>& retired_objects);
 
     /**
      * Sets up RDMA sessions for the multicast groups within this group. This
@@ -838,14 +1113,6 @@ public:
      */
     const vector_int64_2d& get_old_shard_leaders() const { return prior_view_shard_leaders; }
 
-    /**
-     * Gets a locked reference to the TCP socket connected to a particular node
-     * for the purposes of doing state transfer. This is needed by Group to
-     * complete state transfer during Replicated Object construction, and just
-     * forwards the same call through to ViewManager's tcp_connections.
-     */
-    LockedReference<std::unique_lock<std::mutex>, tcp::socket> get_transfer_socket(node_id_t member_id);
-
     /** Causes this node to cleanly leave the group by setting itself to "failed." */
     void leave();
 
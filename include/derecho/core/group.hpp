@@ -258,15 +258,24 @@ private:
      * removed from the subgroup.
      */
     std::map<subgroup_id_t, ReplicatedObject*> objects_by_subgroup_id;
+    /**
+     * Replicated<T>s that construct_objects removed from replicated_objects
+     * because this node left their shard, indexed by subgroup ID. They are
+     * kept alive, with their RPC functions detached, only until the state
+     * transfer for the view change finishes, since this node may have been
+     * the shard's leader and still need to send their state to new members.
+     */
+    std::map<subgroup_id_t, std::unique_ptr<ReplicatedObject>> retired_objects;
 
     /**
-     * Updates the state of the replicated objects that correspond to subgroups
-     * identified in the provided map, by receiving serialized state from the
-     * shard leader whose ID is paired with that subgroup ID.
-     * @param subgroups_and_leaders Pairs of (subgroup ID, leader's node ID) for
-     * subgroups that need to have their state initialized from the leader.
+     * Helper for construct_objects that removes a Replicated<T> from
+     * replicated_objects and objects_by_subgroup_id, and moves it to
+     * retired_objects.
+     * @param subgroup_id The subgroup ID of the Replicated<T>
+     * @param object_iter An iterator to the Replicated<T> in replicated_objects
      */
-    void receive_objects(const std::set<std::pair<subgroup_id_t, node_id_t>>& subgroups_and_leaders);
+    template <typename T>
+    void retire_object(subgroup_id_t subgroup_id, typename replicated_index_map<T>::iterator object_iter);
 
     /** Base case for new_view_callback_per_type with an empty parameter pack, does nothing */
     template <typename... Empty>
@@ -332,6 +341,22 @@ private:
             const View& curr_view, const vector_int64_2d& old_shard_leaders,
             bool in_restart);
 
+    /**
+     * Helper for preload_logs that adds the log prefix of this node's shard
+     * of each subgroup of type T to log_prefixes, if T has Persistent fields
+     * and this node has not already constructed the shard's Replicated<T>.
+     */
+    template <typename T>
+    void collect_log_prefixes(const View& curr_view, std::vector<std::pair<std::string, bool>>& log_prefixes);
+
+    /**
+     * Constructor helper that loads the persistent logs of every Replicated
+     * Object this node is about to construct concurrently, so that
+     * construct_objects can build their Persistent fields from the already
+     * loaded logs instead of loading each one in turn.
+     */
+    void preload_logs(const View& curr_view);
+
 public:
     /**
      * Constructor that starts or joins a Derecho group. Whether this node acts
@@ -455,6 +480,35 @@ public:
      */
     std::vector<IpAndPorts> get_member_addresses();
 
+    /**
+     * Returns the time this node spent in each stage of total restart while
+     * the Group was being constructed. All durations are zero if this node
+     * did not restart from logged state.
+     */
+    const RestartTimings& get_restart_timings() const;
+
+    /**
+     * Returns the time this node spent in each stage of the most recent view
+     * change, such as wedging, ragged edge cleanup, and state transfer. This
+     * can be called from a new-view upcall to get the timings of the view
+     * change that installed the new view.
+     */
+    ViewChangeTimings get_last_view_change_timings() const;
+
+    /**
+     * Returns how much memory is registered for RDMC message buffers on this
+     * node, how much of it holds messages that are in flight, and how it is
+     * divided among buffer sizes.
+     */
+    BufferPoolStats get_rdmc_buffer_pool_stats();
+
+    /**
+     * Returns how long this node took to set up the RDMC groups of the
+     * current view, how many groups there are, and how many connections and
+     * bytes of registered memory they use.
+     */
+    RDMCGroupStats get_rdmc_group_stats();
+
     /**
      * Returns the number of subgroups of the specified type. This information
      * is also in the configuration file or SubgroupInfo function, but this method
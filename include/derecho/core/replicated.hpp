@@ -89,6 +89,63 @@ using view_callback_enabled = std::is_base_of<GetsViewChangeCallback, T>;
 template <typename T>
 inline constexpr bool view_callback_enabled_v = view_callback_enabled<T>::value;
 
+/**
+ * A registered memory region, and an offset within it, that a Replicated
+ * Object provides for an incoming message to be received into.
+ */
+using ReceiveBuffer = rdmc::receive_destination;
+
+/**
+ * An interface that user-defined Replicated Object types (i.e. the T in a
+ * Replicated<T>) can implement to receive large ordered_send calls directly
+ * into their own storage. When an RPC message that is sent with RDMC starts
+ * to arrive at a replica, Derecho calls get_receive_buffer with the tag of
+ * the function being called, and the whole message, including its headers,
+ * is written to the buffer it returns. The arguments that the RPC function
+ * receives by const reference, such as a const Bytes&, then point into that
+ * buffer, so the object can keep them where they are instead of copying
+ * them. This is only done for messages sent by other members; the sender's
+ * own call is still delivered from Derecho's send buffer.
+ */
+class ProvidesReceiveBuffers {
+public:
+    /**
+     * Called on Derecho's RDMC thread, possibly while an RPC function is
+     * running, so it must be thread-safe.
+     * @param function_tag The tag that identifies the RPC function the
+     * message calls; use calls_function to compare it to an RPC_NAME
+     * @param sender The ID of the node that sent the message
+     * @param message_size The number of bytes the buffer must hold
+     * @return A buffer of at least message_size bytes, which must not be
+     * reused until the RPC function has been called with the message (or a
+     * new view has been installed without it being called), or std::nullopt
+     * to receive the message into a Derecho buffer as usual.
+     */
+    virtual std::optional<ReceiveBuffer> get_receive_buffer(rpc::FunctionTag function_tag, node_id_t sender,
+                                                            std::size_t message_size)
+            = 0;
+
+protected:
+    /**
+     * @return True if function_tag, as passed to get_receive_buffer, is the
+     * tag of an ordered_send to the function whose RPC_NAME is user_tag.
+     */
+    static constexpr bool calls_function(rpc::FunctionTag function_tag, rpc::FunctionTag user_tag) {
+        return function_tag == rpc::to_internal_tag<false>(user_tag);
+    }
+};
+
+/**
+ * A template whose member field "value" will be true if type T inherits
+ * from ProvidesReceiveBuffers.
+ */
+template <typename T>
+using receive_buffers_enabled = std::is_base_of<ProvidesReceiveBuffers, T>;
+
+/** Shortcut for receive_buffers_enabled<T>::value */
+template <typename T>
+inline constexpr bool receive_buffers_enabled_v = receive_buffers_enabled<T>::value;
+
 /**
  * An empty class to be used as the "replicated type" for a subgroup that
  * doesn't implement a Replicated Object. Subgroups of type RawObject will
@@ -319,6 +376,15 @@ public:
      */
     virtual persistent::version_t get_minimum_latest_persisted_version();
 
+    /**
+     * Returns the "latest version" number of each Persistent field of this
+     * object, keyed by the hash of the field's name. A node receiving this
+     * object's state sends these to the sender so that each field's log is
+     * sent starting from where the local copy of that log ends.
+     * @return A map from field name hash to version number
+     */
+    virtual std::map<std::size_t, persistent::version_t> get_latest_persisted_versions();
+
     /**
      * Returns the current global persistence frontier, aka, stable frontier that will survive whole system restart.
      * Please note this applies to persistent data ONLY. The data not in Persistent<> are not saved.
@@ -490,20 +556,50 @@ public:
      * this Replicated<T> over the given socket *without* first sending its size.
      * Should only be used when sending a list of objects, preceded by their
      * total size, otherwise the recipient will have no way of knowing how large
-     * a buffer to allocate for this object.
+     * a buffer to allocate for this object. The object is written as it is
+     * serialized, with small pieces gathered into writes of up to
+     * DERECHO/state_transfer_chunk_size bytes, so it is never copied in full.
      * @param receiver_socket
      */
     virtual void send_object_raw(tcp::socket& receiver_socket) const;
 
+    /**
+     * Serializes the state of the "wrapped" object (of type T) for this
+     * Replicated<T> a chunk at a time, so that it is never copied in full.
+     * Each chunk is filled in a buffer of chunk_size bytes returned by
+     * next_chunk, then passed on by calling chunk_ready with the number of
+     * bytes in it, which is less than chunk_size only for the last chunk.
+     * Used when the object is sent with RDMA instead of over a socket.
+     * @param chunk_size The size of the buffers returned by next_chunk
+     * @param next_chunk A function that returns the buffer to fill next
+     * @param chunk_ready A function that is called when the buffer last
+     * returned by next_chunk is ready to send
+     */
+    virtual void send_object_chunks(std::size_t chunk_size, const std::function<uint8_t*()>& next_chunk,
+                                    const std::function<void(std::size_t)>& chunk_ready) const;
+
     /**
      * Updates the state of the "wrapped" object by replacing it with the object
-     * serialized in a buffer. Returns the number of bytes read from the buffer,
-     * in case the caller needs to know.
-     * @param buffer A buffer containing a serialized T, which will replace this
-     * Replicated<T>'s wrapped T
-     * @return The number of bytes read from the buffer.
+     * serialized in a stream of bytes, such as the chunks of the object as they
+     * are received. If T can be deserialized from a stream (see
+     * mutils::is_streamable), it is built as the bytes arrive, so they never
+     * have to be in one buffer; otherwise the bytes are first copied into a
+     * buffer of object_size bytes and deserialized from there.
+     * @param source The stream of bytes of a serialized T, which will replace
+     * this Replicated<T>'s wrapped T
+     * @param object_size The size of the serialized T
+     * @return The number of bytes read from the stream.
+     */
+    virtual std::size_t receive_object(mutils::ByteSource& source, std::size_t object_size);
+
+    /**
+     * Removes this Replicated<T>'s RPC functions from the RPCManager, so that
+     * a new Replicated<T> can be constructed for the same subgroup while this
+     * one is kept alive to finish sending its state to new members. After
+     * this, the object can no longer send or receive RPC messages, and
+     * destroying it will not affect the RPC functions of its replacement.
      */
-    virtual std::size_t receive_object(uint8_t* buffer);
+    void detach_rpc_functions();
 
     /**
      * make a version for all the persistent<T> members.
@@ -565,6 +661,21 @@ public:
      * @return ts_us The new update's timestamp in microseconds
      */
     virtual void post_next_version(persistent::version_t version, uint64_t ts_us);
+
+    /**
+     * Asks the wrapped object for a buffer to receive an incoming RPC message
+     * into, if T derives from ProvidesReceiveBuffers and the message calls
+     * one of its functions.
+     * @param sender The ID of the node that sent the message
+     * @param rpc_header The start of the RPC message, after the Derecho header
+     * @param rpc_header_size The number of bytes of the RPC message available
+     * at rpc_header
+     * @param message_size The size of the whole message
+     * @return The buffer provided by the object, or std::nullopt
+     */
+    virtual std::optional<ReceiveBuffer> get_receive_buffer(node_id_t sender, const uint8_t* rpc_header,
+                                                            std::size_t rpc_header_size,
+                                                            std::size_t message_size);
 };
 
 template <typename T>
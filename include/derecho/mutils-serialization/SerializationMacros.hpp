@@ -922,12 +922,37 @@
     static std::unique_ptr<Name> from_bytes(mutils::DeserializationManager* dsm, uint8_t const * buf){ \
         auto a_obj = mutils::from_bytes<std::decay_t<decltype(a)> >(dsm, buf); \
         return std::make_unique<Name>(*a_obj); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE3(Name,a,b) \
     static std::unique_ptr<Name> from_bytes(mutils::DeserializationManager* dsm, uint8_t const * buf){ \
         auto a_obj = mutils::from_bytes<std::decay_t<decltype(a)> >(dsm, buf); \
         return std::make_unique<Name>(*a_obj, *(mutils::from_bytes<std::decay_t<decltype(b)> >(dsm, buf + mutils::bytes_size(*a_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE4(Name,a,b,c) \
@@ -936,6 +961,20 @@
         std::size_t bytes_read = mutils::bytes_size(*a_obj); \
         auto b_obj = mutils::from_bytes<std::decay_t<decltype(b)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj, *(mutils::from_bytes<std::decay_t<decltype(c)> >(dsm, buf + bytes_read + mutils::bytes_size(*b_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE5(Name,a,b,c,d) \
@@ -946,6 +985,21 @@
         bytes_read += mutils::bytes_size(*b_obj); \
         auto c_obj = mutils::from_bytes<std::decay_t<decltype(c)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj, *(mutils::from_bytes<std::decay_t<decltype(d)> >(dsm, buf + bytes_read + mutils::bytes_size(*c_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE6(Name,a,b,c,d,e) \
@@ -958,6 +1012,22 @@
         bytes_read += mutils::bytes_size(*c_obj); \
         auto d_obj = mutils::from_bytes<std::decay_t<decltype(d)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj, *(mutils::from_bytes<std::decay_t<decltype(e)> >(dsm, buf + bytes_read + mutils::bytes_size(*d_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE7(Name,a,b,c,d,e,f) \
@@ -972,6 +1042,23 @@
         bytes_read += mutils::bytes_size(*d_obj); \
         auto e_obj = mutils::from_bytes<std::decay_t<decltype(e)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj, *(mutils::from_bytes<std::decay_t<decltype(f)> >(dsm, buf + bytes_read + mutils::bytes_size(*e_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE8(Name,a,b,c,d,e,f,g) \
@@ -988,6 +1075,24 @@
         bytes_read += mutils::bytes_size(*e_obj); \
         auto f_obj = mutils::from_bytes<std::decay_t<decltype(f)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj, *(mutils::from_bytes<std::decay_t<decltype(g)> >(dsm, buf + bytes_read + mutils::bytes_size(*f_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE9(Name,a,b,c,d,e,f,g,h) \
@@ -1006,6 +1111,25 @@
         bytes_read += mutils::bytes_size(*f_obj); \
         auto g_obj = mutils::from_bytes<std::decay_t<decltype(g)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj, *(mutils::from_bytes<std::decay_t<decltype(h)> >(dsm, buf + bytes_read + mutils::bytes_size(*g_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE10(Name,a,b,c,d,e,f,g,h,i) \
@@ -1026,6 +1150,26 @@
         bytes_read += mutils::bytes_size(*g_obj); \
         auto h_obj = mutils::from_bytes<std::decay_t<decltype(h)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj, *(mutils::from_bytes<std::decay_t<decltype(i)> >(dsm, buf + bytes_read + mutils::bytes_size(*h_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE11(Name,a,b,c,d,e,f,g,h,i,j) \
@@ -1048,6 +1192,27 @@
         bytes_read += mutils::bytes_size(*h_obj); \
         auto i_obj = mutils::from_bytes<std::decay_t<decltype(i)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj, *(mutils::from_bytes<std::decay_t<decltype(j)> >(dsm, buf + bytes_read + mutils::bytes_size(*i_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE12(Name,a,b,c,d,e,f,g,h,i,j,k) \
@@ -1072,6 +1237,28 @@
         bytes_read += mutils::bytes_size(*i_obj); \
         auto j_obj = mutils::from_bytes<std::decay_t<decltype(j)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj, *(mutils::from_bytes<std::decay_t<decltype(k)> >(dsm, buf + bytes_read + mutils::bytes_size(*j_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE13(Name,a,b,c,d,e,f,g,h,i,j,k,l) \
@@ -1098,6 +1285,29 @@
         bytes_read += mutils::bytes_size(*j_obj); \
         auto k_obj = mutils::from_bytes<std::decay_t<decltype(k)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj, *(mutils::from_bytes<std::decay_t<decltype(l)> >(dsm, buf + bytes_read + mutils::bytes_size(*k_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE14(Name,a,b,c,d,e,f,g,h,i,j,k,l,m) \
@@ -1126,6 +1336,30 @@
         bytes_read += mutils::bytes_size(*k_obj); \
         auto l_obj = mutils::from_bytes<std::decay_t<decltype(l)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj, *(mutils::from_bytes<std::decay_t<decltype(m)> >(dsm, buf + bytes_read + mutils::bytes_size(*l_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE15(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n) \
@@ -1156,6 +1390,31 @@
         bytes_read += mutils::bytes_size(*l_obj); \
         auto m_obj = mutils::from_bytes<std::decay_t<decltype(m)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj, *(mutils::from_bytes<std::decay_t<decltype(n)> >(dsm, buf + bytes_read + mutils::bytes_size(*m_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE16(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o) \
@@ -1188,6 +1447,32 @@
         bytes_read += mutils::bytes_size(*m_obj); \
         auto n_obj = mutils::from_bytes<std::decay_t<decltype(n)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj, *(mutils::from_bytes<std::decay_t<decltype(o)> >(dsm, buf + bytes_read + mutils::bytes_size(*n_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE17(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p) \
@@ -1222,6 +1507,33 @@
         bytes_read += mutils::bytes_size(*n_obj); \
         auto o_obj = mutils::from_bytes<std::decay_t<decltype(o)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj, *(mutils::from_bytes<std::decay_t<decltype(p)> >(dsm, buf + bytes_read + mutils::bytes_size(*o_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        auto p_obj = mutils::from_stream<std::decay_t<decltype(p)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&,std::decay_t<decltype(p)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj),std::move(*p_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value && mutils::is_streamable<std::decay_t<decltype(p)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE18(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q) \
@@ -1258,6 +1570,34 @@
         bytes_read += mutils::bytes_size(*o_obj); \
         auto p_obj = mutils::from_bytes<std::decay_t<decltype(p)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj, *(mutils::from_bytes<std::decay_t<decltype(q)> >(dsm, buf + bytes_read + mutils::bytes_size(*p_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        auto p_obj = mutils::from_stream<std::decay_t<decltype(p)> >(dsm, source); \
+        auto q_obj = mutils::from_stream<std::decay_t<decltype(q)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&,std::decay_t<decltype(p)>&&,std::decay_t<decltype(q)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj),std::move(*p_obj),std::move(*q_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value && mutils::is_streamable<std::decay_t<decltype(p)> >::value && mutils::is_streamable<std::decay_t<decltype(q)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE19(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q,r) \
@@ -1296,6 +1636,35 @@
         bytes_read += mutils::bytes_size(*p_obj); \
         auto q_obj = mutils::from_bytes<std::decay_t<decltype(q)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj, *(mutils::from_bytes<std::decay_t<decltype(r)> >(dsm, buf + bytes_read + mutils::bytes_size(*q_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        auto p_obj = mutils::from_stream<std::decay_t<decltype(p)> >(dsm, source); \
+        auto q_obj = mutils::from_stream<std::decay_t<decltype(q)> >(dsm, source); \
+        auto r_obj = mutils::from_stream<std::decay_t<decltype(r)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&,std::decay_t<decltype(p)>&&,std::decay_t<decltype(q)>&&,std::decay_t<decltype(r)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj),std::move(*p_obj),std::move(*q_obj),std::move(*r_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value && mutils::is_streamable<std::decay_t<decltype(p)> >::value && mutils::is_streamable<std::decay_t<decltype(q)> >::value && mutils::is_streamable<std::decay_t<decltype(r)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE20(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q,r,s) \
@@ -1336,6 +1705,36 @@
         bytes_read += mutils::bytes_size(*q_obj); \
         auto r_obj = mutils::from_bytes<std::decay_t<decltype(r)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj, *(mutils::from_bytes<std::decay_t<decltype(s)> >(dsm, buf + bytes_read + mutils::bytes_size(*r_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        auto p_obj = mutils::from_stream<std::decay_t<decltype(p)> >(dsm, source); \
+        auto q_obj = mutils::from_stream<std::decay_t<decltype(q)> >(dsm, source); \
+        auto r_obj = mutils::from_stream<std::decay_t<decltype(r)> >(dsm, source); \
+        auto s_obj = mutils::from_stream<std::decay_t<decltype(s)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&,std::decay_t<decltype(p)>&&,std::decay_t<decltype(q)>&&,std::decay_t<decltype(r)>&&,std::decay_t<decltype(s)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj),std::move(*p_obj),std::move(*q_obj),std::move(*r_obj),std::move(*s_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value && mutils::is_streamable<std::decay_t<decltype(p)> >::value && mutils::is_streamable<std::decay_t<decltype(q)> >::value && mutils::is_streamable<std::decay_t<decltype(r)> >::value && mutils::is_streamable<std::decay_t<decltype(s)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE21(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q,r,s,t) \
@@ -1378,6 +1777,37 @@
         bytes_read += mutils::bytes_size(*r_obj); \
         auto s_obj = mutils::from_bytes<std::decay_t<decltype(s)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj, *(mutils::from_bytes<std::decay_t<decltype(t)> >(dsm, buf + bytes_read + mutils::bytes_size(*s_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        auto p_obj = mutils::from_stream<std::decay_t<decltype(p)> >(dsm, source); \
+        auto q_obj = mutils::from_stream<std::decay_t<decltype(q)> >(dsm, source); \
+        auto r_obj = mutils::from_stream<std::decay_t<decltype(r)> >(dsm, source); \
+        auto s_obj = mutils::from_stream<std::decay_t<decltype(s)> >(dsm, source); \
+        auto t_obj = mutils::from_stream<std::decay_t<decltype(t)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&,std::decay_t<decltype(p)>&&,std::decay_t<decltype(q)>&&,std::decay_t<decltype(r)>&&,std::decay_t<decltype(s)>&&,std::decay_t<decltype(t)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj),std::move(*p_obj),std::move(*q_obj),std::move(*r_obj),std::move(*s_obj),std::move(*t_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value && mutils::is_streamable<std::decay_t<decltype(p)> >::value && mutils::is_streamable<std::decay_t<decltype(q)> >::value && mutils::is_streamable<std::decay_t<decltype(r)> >::value && mutils::is_streamable<std::decay_t<decltype(s)> >::value && mutils::is_streamable<std::decay_t<decltype(t)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE22(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q,r,s,t,u) \
@@ -1422,6 +1852,38 @@
         bytes_read += mutils::bytes_size(*s_obj); \
         auto t_obj = mutils::from_bytes<std::decay_t<decltype(t)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj, *(mutils::from_bytes<std::decay_t<decltype(u)> >(dsm, buf + bytes_read + mutils::bytes_size(*t_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        auto p_obj = mutils::from_stream<std::decay_t<decltype(p)> >(dsm, source); \
+        auto q_obj = mutils::from_stream<std::decay_t<decltype(q)> >(dsm, source); \
+        auto r_obj = mutils::from_stream<std::decay_t<decltype(r)> >(dsm, source); \
+        auto s_obj = mutils::from_stream<std::decay_t<decltype(s)> >(dsm, source); \
+        auto t_obj = mutils::from_stream<std::decay_t<decltype(t)> >(dsm, source); \
+        auto u_obj = mutils::from_stream<std::decay_t<decltype(u)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&,std::decay_t<decltype(p)>&&,std::decay_t<decltype(q)>&&,std::decay_t<decltype(r)>&&,std::decay_t<decltype(s)>&&,std::decay_t<decltype(t)>&&,std::decay_t<decltype(u)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj),std::move(*p_obj),std::move(*q_obj),std::move(*r_obj),std::move(*s_obj),std::move(*t_obj),std::move(*u_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj,*u_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value && mutils::is_streamable<std::decay_t<decltype(p)> >::value && mutils::is_streamable<std::decay_t<decltype(q)> >::value && mutils::is_streamable<std::decay_t<decltype(r)> >::value && mutils::is_streamable<std::decay_t<decltype(s)> >::value && mutils::is_streamable<std::decay_t<decltype(t)> >::value && mutils::is_streamable<std::decay_t<decltype(u)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE23(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q,r,s,t,u,v) \
@@ -1468,6 +1930,39 @@
         bytes_read += mutils::bytes_size(*t_obj); \
         auto u_obj = mutils::from_bytes<std::decay_t<decltype(u)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj,*u_obj, *(mutils::from_bytes<std::decay_t<decltype(v)> >(dsm, buf + bytes_read + mutils::bytes_size(*u_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        auto p_obj = mutils::from_stream<std::decay_t<decltype(p)> >(dsm, source); \
+        auto q_obj = mutils::from_stream<std::decay_t<decltype(q)> >(dsm, source); \
+        auto r_obj = mutils::from_stream<std::decay_t<decltype(r)> >(dsm, source); \
+        auto s_obj = mutils::from_stream<std::decay_t<decltype(s)> >(dsm, source); \
+        auto t_obj = mutils::from_stream<std::decay_t<decltype(t)> >(dsm, source); \
+        auto u_obj = mutils::from_stream<std::decay_t<decltype(u)> >(dsm, source); \
+        auto v_obj = mutils::from_stream<std::decay_t<decltype(v)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&,std::decay_t<decltype(p)>&&,std::decay_t<decltype(q)>&&,std::decay_t<decltype(r)>&&,std::decay_t<decltype(s)>&&,std::decay_t<decltype(t)>&&,std::decay_t<decltype(u)>&&,std::decay_t<decltype(v)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj),std::move(*p_obj),std::move(*q_obj),std::move(*r_obj),std::move(*s_obj),std::move(*t_obj),std::move(*u_obj),std::move(*v_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj,*u_obj,*v_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value && mutils::is_streamable<std::decay_t<decltype(p)> >::value && mutils::is_streamable<std::decay_t<decltype(q)> >::value && mutils::is_streamable<std::decay_t<decltype(r)> >::value && mutils::is_streamable<std::decay_t<decltype(s)> >::value && mutils::is_streamable<std::decay_t<decltype(t)> >::value && mutils::is_streamable<std::decay_t<decltype(u)> >::value && mutils::is_streamable<std::decay_t<decltype(v)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE24(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q,r,s,t,u,v,w) \
@@ -1516,6 +2011,40 @@
         bytes_read += mutils::bytes_size(*u_obj); \
         auto v_obj = mutils::from_bytes<std::decay_t<decltype(v)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj,*u_obj,*v_obj, *(mutils::from_bytes<std::decay_t<decltype(w)> >(dsm, buf + bytes_read + mutils::bytes_size(*v_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        auto p_obj = mutils::from_stream<std::decay_t<decltype(p)> >(dsm, source); \
+        auto q_obj = mutils::from_stream<std::decay_t<decltype(q)> >(dsm, source); \
+        auto r_obj = mutils::from_stream<std::decay_t<decltype(r)> >(dsm, source); \
+        auto s_obj = mutils::from_stream<std::decay_t<decltype(s)> >(dsm, source); \
+        auto t_obj = mutils::from_stream<std::decay_t<decltype(t)> >(dsm, source); \
+        auto u_obj = mutils::from_stream<std::decay_t<decltype(u)> >(dsm, source); \
+        auto v_obj = mutils::from_stream<std::decay_t<decltype(v)> >(dsm, source); \
+        auto w_obj = mutils::from_stream<std::decay_t<decltype(w)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&,std::decay_t<decltype(p)>&&,std::decay_t<decltype(q)>&&,std::decay_t<decltype(r)>&&,std::decay_t<decltype(s)>&&,std::decay_t<decltype(t)>&&,std::decay_t<decltype(u)>&&,std::decay_t<decltype(v)>&&,std::decay_t<decltype(w)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj),std::move(*p_obj),std::move(*q_obj),std::move(*r_obj),std::move(*s_obj),std::move(*t_obj),std::move(*u_obj),std::move(*v_obj),std::move(*w_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj,*u_obj,*v_obj,*w_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value && mutils::is_streamable<std::decay_t<decltype(p)> >::value && mutils::is_streamable<std::decay_t<decltype(q)> >::value && mutils::is_streamable<std::decay_t<decltype(r)> >::value && mutils::is_streamable<std::decay_t<decltype(s)> >::value && mutils::is_streamable<std::decay_t<decltype(t)> >::value && mutils::is_streamable<std::decay_t<decltype(u)> >::value && mutils::is_streamable<std::decay_t<decltype(v)> >::value && mutils::is_streamable<std::decay_t<decltype(w)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE25(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q,r,s,t,u,v,w,x) \
@@ -1566,6 +2095,41 @@
         bytes_read += mutils::bytes_size(*v_obj); \
         auto w_obj = mutils::from_bytes<std::decay_t<decltype(w)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj,*u_obj,*v_obj,*w_obj, *(mutils::from_bytes<std::decay_t<decltype(x)> >(dsm, buf + bytes_read + mutils::bytes_size(*w_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        auto p_obj = mutils::from_stream<std::decay_t<decltype(p)> >(dsm, source); \
+        auto q_obj = mutils::from_stream<std::decay_t<decltype(q)> >(dsm, source); \
+        auto r_obj = mutils::from_stream<std::decay_t<decltype(r)> >(dsm, source); \
+        auto s_obj = mutils::from_stream<std::decay_t<decltype(s)> >(dsm, source); \
+        auto t_obj = mutils::from_stream<std::decay_t<decltype(t)> >(dsm, source); \
+        auto u_obj = mutils::from_stream<std::decay_t<decltype(u)> >(dsm, source); \
+        auto v_obj = mutils::from_stream<std::decay_t<decltype(v)> >(dsm, source); \
+        auto w_obj = mutils::from_stream<std::decay_t<decltype(w)> >(dsm, source); \
+        auto x_obj = mutils::from_stream<std::decay_t<decltype(x)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&,std::decay_t<decltype(p)>&&,std::decay_t<decltype(q)>&&,std::decay_t<decltype(r)>&&,std::decay_t<decltype(s)>&&,std::decay_t<decltype(t)>&&,std::decay_t<decltype(u)>&&,std::decay_t<decltype(v)>&&,std::decay_t<decltype(w)>&&,std::decay_t<decltype(x)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj),std::move(*p_obj),std::move(*q_obj),std::move(*r_obj),std::move(*s_obj),std::move(*t_obj),std::move(*u_obj),std::move(*v_obj),std::move(*w_obj),std::move(*x_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj,*u_obj,*v_obj,*w_obj,*x_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value && mutils::is_streamable<std::decay_t<decltype(p)> >::value && mutils::is_streamable<std::decay_t<decltype(q)> >::value && mutils::is_streamable<std::decay_t<decltype(r)> >::value && mutils::is_streamable<std::decay_t<decltype(s)> >::value && mutils::is_streamable<std::decay_t<decltype(t)> >::value && mutils::is_streamable<std::decay_t<decltype(u)> >::value && mutils::is_streamable<std::decay_t<decltype(v)> >::value && mutils::is_streamable<std::decay_t<decltype(w)> >::value && mutils::is_streamable<std::decay_t<decltype(x)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE26(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q,r,s,t,u,v,w,x,y) \
@@ -1618,6 +2182,42 @@
         bytes_read += mutils::bytes_size(*w_obj); \
         auto x_obj = mutils::from_bytes<std::decay_t<decltype(x)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj,*u_obj,*v_obj,*w_obj,*x_obj, *(mutils::from_bytes<std::decay_t<decltype(y)> >(dsm, buf + bytes_read + mutils::bytes_size(*x_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        auto p_obj = mutils::from_stream<std::decay_t<decltype(p)> >(dsm, source); \
+        auto q_obj = mutils::from_stream<std::decay_t<decltype(q)> >(dsm, source); \
+        auto r_obj = mutils::from_stream<std::decay_t<decltype(r)> >(dsm, source); \
+        auto s_obj = mutils::from_stream<std::decay_t<decltype(s)> >(dsm, source); \
+        auto t_obj = mutils::from_stream<std::decay_t<decltype(t)> >(dsm, source); \
+        auto u_obj = mutils::from_stream<std::decay_t<decltype(u)> >(dsm, source); \
+        auto v_obj = mutils::from_stream<std::decay_t<decltype(v)> >(dsm, source); \
+        auto w_obj = mutils::from_stream<std::decay_t<decltype(w)> >(dsm, source); \
+        auto x_obj = mutils::from_stream<std::decay_t<decltype(x)> >(dsm, source); \
+        auto y_obj = mutils::from_stream<std::decay_t<decltype(y)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&,std::decay_t<decltype(p)>&&,std::decay_t<decltype(q)>&&,std::decay_t<decltype(r)>&&,std::decay_t<decltype(s)>&&,std::decay_t<decltype(t)>&&,std::decay_t<decltype(u)>&&,std::decay_t<decltype(v)>&&,std::decay_t<decltype(w)>&&,std::decay_t<decltype(x)>&&,std::decay_t<decltype(y)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj),std::move(*p_obj),std::move(*q_obj),std::move(*r_obj),std::move(*s_obj),std::move(*t_obj),std::move(*u_obj),std::move(*v_obj),std::move(*w_obj),std::move(*x_obj),std::move(*y_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj,*u_obj,*v_obj,*w_obj,*x_obj,*y_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value && mutils::is_streamable<std::decay_t<decltype(p)> >::value && mutils::is_streamable<std::decay_t<decltype(q)> >::value && mutils::is_streamable<std::decay_t<decltype(r)> >::value && mutils::is_streamable<std::decay_t<decltype(s)> >::value && mutils::is_streamable<std::decay_t<decltype(t)> >::value && mutils::is_streamable<std::decay_t<decltype(u)> >::value && mutils::is_streamable<std::decay_t<decltype(v)> >::value && mutils::is_streamable<std::decay_t<decltype(w)> >::value && mutils::is_streamable<std::decay_t<decltype(x)> >::value && mutils::is_streamable<std::decay_t<decltype(y)> >::value ; \
     } 
 
 #define DEFAULT_DESERIALIZE27(Name,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q,r,s,t,u,v,w,x,y,z) \
@@ -1672,6 +2272,43 @@
         bytes_read += mutils::bytes_size(*x_obj); \
         auto y_obj = mutils::from_bytes<std::decay_t<decltype(y)> >(dsm, buf + bytes_read); \
         return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj,*u_obj,*v_obj,*w_obj,*x_obj,*y_obj, *(mutils::from_bytes<std::decay_t<decltype(z)> >(dsm, buf + bytes_read + mutils::bytes_size(*y_obj)))); \
+    } \
+    template <typename StreamSource> \
+    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \
+        auto a_obj = mutils::from_stream<std::decay_t<decltype(a)> >(dsm, source); \
+        auto b_obj = mutils::from_stream<std::decay_t<decltype(b)> >(dsm, source); \
+        auto c_obj = mutils::from_stream<std::decay_t<decltype(c)> >(dsm, source); \
+        auto d_obj = mutils::from_stream<std::decay_t<decltype(d)> >(dsm, source); \
+        auto e_obj = mutils::from_stream<std::decay_t<decltype(e)> >(dsm, source); \
+        auto f_obj = mutils::from_stream<std::decay_t<decltype(f)> >(dsm, source); \
+        auto g_obj = mutils::from_stream<std::decay_t<decltype(g)> >(dsm, source); \
+        auto h_obj = mutils::from_stream<std::decay_t<decltype(h)> >(dsm, source); \
+        auto i_obj = mutils::from_stream<std::decay_t<decltype(i)> >(dsm, source); \
+        auto j_obj = mutils::from_stream<std::decay_t<decltype(j)> >(dsm, source); \
+        auto k_obj = mutils::from_stream<std::decay_t<decltype(k)> >(dsm, source); \
+        auto l_obj = mutils::from_stream<std::decay_t<decltype(l)> >(dsm, source); \
+        auto m_obj = mutils::from_stream<std::decay_t<decltype(m)> >(dsm, source); \
+        auto n_obj = mutils::from_stream<std::decay_t<decltype(n)> >(dsm, source); \
+        auto o_obj = mutils::from_stream<std::decay_t<decltype(o)> >(dsm, source); \
+        auto p_obj = mutils::from_stream<std::decay_t<decltype(p)> >(dsm, source); \
+        auto q_obj = mutils::from_stream<std::decay_t<decltype(q)> >(dsm, source); \
+        auto r_obj = mutils::from_stream<std::decay_t<decltype(r)> >(dsm, source); \
+        auto s_obj = mutils::from_stream<std::decay_t<decltype(s)> >(dsm, source); \
+        auto t_obj = mutils::from_stream<std::decay_t<decltype(t)> >(dsm, source); \
+        auto u_obj = mutils::from_stream<std::decay_t<decltype(u)> >(dsm, source); \
+        auto v_obj = mutils::from_stream<std::decay_t<decltype(v)> >(dsm, source); \
+        auto w_obj = mutils::from_stream<std::decay_t<decltype(w)> >(dsm, source); \
+        auto x_obj = mutils::from_stream<std::decay_t<decltype(x)> >(dsm, source); \
+        auto y_obj = mutils::from_stream<std::decay_t<decltype(y)> >(dsm, source); \
+        auto z_obj = mutils::from_stream<std::decay_t<decltype(z)> >(dsm, source); \
+        if constexpr(std::is_constructible<Name, std::decay_t<decltype(a)>&&,std::decay_t<decltype(b)>&&,std::decay_t<decltype(c)>&&,std::decay_t<decltype(d)>&&,std::decay_t<decltype(e)>&&,std::decay_t<decltype(f)>&&,std::decay_t<decltype(g)>&&,std::decay_t<decltype(h)>&&,std::decay_t<decltype(i)>&&,std::decay_t<decltype(j)>&&,std::decay_t<decltype(k)>&&,std::decay_t<decltype(l)>&&,std::decay_t<decltype(m)>&&,std::decay_t<decltype(n)>&&,std::decay_t<decltype(o)>&&,std::decay_t<decltype(p)>&&,std::decay_t<decltype(q)>&&,std::decay_t<decltype(r)>&&,std::decay_t<decltype(s)>&&,std::decay_t<decltype(t)>&&,std::decay_t<decltype(u)>&&,std::decay_t<decltype(v)>&&,std::decay_t<decltype(w)>&&,std::decay_t<decltype(x)>&&,std::decay_t<decltype(y)>&&,std::decay_t<decltype(z)>&&>::value) { \
+            return std::make_unique<Name>(std::move(*a_obj),std::move(*b_obj),std::move(*c_obj),std::move(*d_obj),std::move(*e_obj),std::move(*f_obj),std::move(*g_obj),std::move(*h_obj),std::move(*i_obj),std::move(*j_obj),std::move(*k_obj),std::move(*l_obj),std::move(*m_obj),std::move(*n_obj),std::move(*o_obj),std::move(*p_obj),std::move(*q_obj),std::move(*r_obj),std::move(*s_obj),std::move(*t_obj),std::move(*u_obj),std::move(*v_obj),std::move(*w_obj),std::move(*x_obj),std::move(*y_obj),std::move(*z_obj)); \
+        } else { \
+            return std::make_unique<Name>(*a_obj,*b_obj,*c_obj,*d_obj,*e_obj,*f_obj,*g_obj,*h_obj,*i_obj,*j_obj,*k_obj,*l_obj,*m_obj,*n_obj,*o_obj,*p_obj,*q_obj,*r_obj,*s_obj,*t_obj,*u_obj,*v_obj,*w_obj,*x_obj,*y_obj,*z_obj); \
+        } \
+    } \
+    static constexpr bool from_stream_supported(){ \
+        return mutils::is_streamable<std::decay_t<decltype(a)> >::value && mutils::is_streamable<std::decay_t<decltype(b)> >::value && mutils::is_streamable<std::decay_t<decltype(c)> >::value && mutils::is_streamable<std::decay_t<decltype(d)> >::value && mutils::is_streamable<std::decay_t<decltype(e)> >::value && mutils::is_streamable<std::decay_t<decltype(f)> >::value && mutils::is_streamable<std::decay_t<decltype(g)> >::value && mutils::is_streamable<std::decay_t<decltype(h)> >::value && mutils::is_streamable<std::decay_t<decltype(i)> >::value && mutils::is_streamable<std::decay_t<decltype(j)> >::value && mutils::is_streamable<std::decay_t<decltype(k)> >::value && mutils::is_streamable<std::decay_t<decltype(l)> >::value && mutils::is_streamable<std::decay_t<decltype(m)> >::value && mutils::is_streamable<std::decay_t<decltype(n)> >::value && mutils::is_streamable<std::decay_t<decltype(o)> >::value && mutils::is_streamable<std::decay_t<decltype(p)> >::value && mutils::is_streamable<std::decay_t<decltype(q)> >::value && mutils::is_streamable<std::decay_t<decltype(r)> >::value && mutils::is_streamable<std::decay_t<decltype(s)> >::value && mutils::is_streamable<std::decay_t<decltype(t)> >::value && mutils::is_streamable<std::decay_t<decltype(u)> >::value && mutils::is_streamable<std::decay_t<decltype(v)> >::value && mutils::is_streamable<std::decay_t<decltype(w)> >::value && mutils::is_streamable<std::decay_t<decltype(x)> >::value && mutils::is_streamable<std::decay_t<decltype(y)> >::value && mutils::is_streamable<std::decay_t<decltype(z)> >::value ; \
     } 
 
 
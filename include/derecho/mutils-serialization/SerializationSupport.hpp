@@ -197,6 +197,34 @@ struct DeserializationManager {
     }
 };
 
+/**
+ * A source of serialized bytes that become available a piece at a time, such
+ * as an object that is received in chunks. from_stream deserializes an object
+ * from a ByteSource as its bytes arrive, so the object's whole serialized form
+ * never has to be in one buffer.
+ */
+class ByteSource {
+public:
+    virtual ~ByteSource() = default;
+    /**
+     * Returns a pointer to the next unread bytes and the number of bytes
+     * there, waiting until some are available. The piece is never empty;
+     * if the source ends before any more bytes arrive, this throws instead.
+     */
+    virtual std::pair<const uint8_t*, std::size_t> next_bytes() = 0;
+    /**
+     * Marks the first size bytes of the piece last returned by next_bytes()
+     * as read, so that the next call to next_bytes() returns the bytes after
+     * them. size must not be more than the size of that piece.
+     */
+    virtual void consume(std::size_t size) = 0;
+    /**
+     * Copies the next size bytes to dest, however many pieces they span,
+     * and marks them as read.
+     */
+    void read(void* dest, std::size_t size);
+};
+
 /**
  * Just calls sizeof(T)
  */
@@ -495,6 +523,25 @@ std::enable_if_t<std::is_pod<T>::value, context_ptr<const std::decay_t<T>>>
 from_bytes_noalloc(DeserializationManager*, uint8_t const* const buffer,
                    context_ptr<const std::decay_t<T>> = context_ptr<const std::decay_t<T>>{});
 
+/**
+ * Calls T::from_stream(ctx,source) when T is a ByteRepresentable.
+ * reads sizeof(T) bytes when T is a POD.
+ * custom logic is implemented for strings and vectors.
+ * Only types for which is_streamable<T> is true can be read from a stream.
+ */
+template <typename T>
+std::enable_if_t<std::is_base_of<ByteRepresentable CMA T>::value,
+                 std::unique_ptr<T>>
+from_stream(DeserializationManager* ctx, ByteSource& source) {
+    static_assert(!std::is_same<std::decay_t<T>, ByteRepresentable>::value,
+                  "Error: must deserialize as implementing type, not as ByteRepresentable");
+    return T::from_stream(ctx, source);
+}
+
+template <typename T>
+std::enable_if_t<std::is_pod<T>::value, std::unique_ptr<std::decay_t<T>>>
+from_stream(DeserializationManager*, ByteSource& source);
+
 /**
  * Calls mutils::from_bytes_noalloc<T>(ctx,buf), dereferences the result, and
  * passes it to fun.  Returns whatever fun returns.  Memory safe, assuming fun
@@ -626,6 +673,34 @@ struct is_string<std::string> : std::true_type {};
 template <>
 struct is_string<const std::string> : std::true_type {};
 
+// True for the types that from_stream can deserialize: PODs, strings, vectors
+// of streamable types (except vector<bool>), and ByteRepresentable types that
+// declare a from_stream_supported() that returns true, which
+// DEFAULT_SERIALIZATION_SUPPORT does when all of their fields are streamable.
+// A subclass that only inherits its from_stream is not streamable, since the
+// inherited one would build the base class.
+template <typename T, typename = void>
+struct is_streamable : std::false_type {};
+
+template <typename T>
+struct is_streamable<T, std::enable_if_t<std::is_pod<T>::value>> : std::true_type {};
+
+template <typename T>
+struct is_streamable<T, std::enable_if_t<is_string<T>::value>> : std::true_type {};
+
+template <typename T>
+struct is_streamable<std::vector<T>, std::enable_if_t<!std::is_same<T, bool>::value>> : is_streamable<T> {};
+
+template <typename T>
+struct is_streamable<const std::vector<T>, std::enable_if_t<!std::is_same<T, bool>::value>> : is_streamable<T> {};
+
+template <typename T>
+struct is_streamable<T, std::enable_if_t<T::from_stream_supported()
+                                         && std::is_same<decltype(T::from_stream(std::declval<DeserializationManager*>(),
+                                                                                 std::declval<ByteSource&>())),
+                                                         std::unique_ptr<T>>::value>>
+        : std::true_type {};
+
 /**
  * Constructs a buffer-consuming function that will copy its input to the
  * provided destination buffer at the specified index. The created function
@@ -842,6 +917,15 @@ std::enable_if_t<is_unordered_map<T>::value, context_ptr<const T>>
 from_bytes_noalloc(DeserializationManager* ctx, uint8_t const* const buffer,
                    context_ptr<const T> = context_ptr<const T>{});
 
+// Forward declarations of from_stream functions for STL types
+
+template <typename T>
+std::unique_ptr<type_check<is_string, T>> from_stream(DeserializationManager*, ByteSource& source);
+
+template <typename T>
+std::enable_if_t<is_vector<std::remove_cv_t<T>>::value, std::unique_ptr<T>>
+from_stream(DeserializationManager* ctx, ByteSource& source);
+
 // End forward declarations of STL support
 
 // Implementations of post_object functions for STL types
@@ -1231,6 +1315,15 @@ from_bytes(DeserializationManager*, uint8_t const* buffer) {
         return nullptr;
 }
 
+template <typename T>
+std::enable_if_t<std::is_pod<T>::value, std::unique_ptr<std::decay_t<T>>>
+from_stream(DeserializationManager*, ByteSource& source) {
+    using T2 = std::decay_t<T>;
+    auto pod = std::make_unique<T2>();
+    source.read(pod.get(), sizeof(T2));
+    return pod;
+}
+
 template <typename T>
 std::enable_if_t<std::is_pod<T>::value, context_ptr<std::decay_t<T>>>
 from_bytes_noalloc(DeserializationManager*, uint8_t* buffer,
@@ -1271,6 +1364,24 @@ from_bytes_noalloc(DeserializationManager*, uint8_t const* const buffer,
     return context_ptr<const T>(new std::string{reinterpret_cast<char const*>(buffer)});
 }
 
+template <typename T>
+std::unique_ptr<type_check<is_string, T>> from_stream(DeserializationManager*, ByteSource& source) {
+    // The string's length isn't serialized, so read up to its null terminator
+    std::string str;
+    while(true) {
+        const auto [bytes, size] = source.next_bytes();
+        const uint8_t* terminator = static_cast<const uint8_t*>(std::memchr(bytes, '\0', size));
+        if(terminator) {
+            str.append(reinterpret_cast<const char*>(bytes), terminator - bytes);
+            source.consume(terminator - bytes + 1);
+            break;
+        }
+        str.append(reinterpret_cast<const char*>(bytes), size);
+        source.consume(size);
+    }
+    return std::make_unique<T>(std::move(str));
+}
+
 template <typename T>
 std::enable_if_t<is_set<std::remove_cv_t<T>>::value, std::unique_ptr<T>>
 from_bytes(DeserializationManager* ctx, const uint8_t* _buffer) {
@@ -1435,6 +1546,34 @@ from_bytes_noalloc(DeserializationManager* ctx, uint8_t const* const buffer,
     return context_ptr<const T>{from_bytes<T>(ctx, buffer).release()};
 }
 
+// Note: T is the type of the vector, not the vector's type parameter T
+template <typename T>
+std::enable_if_t<is_vector<std::remove_cv_t<T>>::value, std::unique_ptr<T>>
+from_stream(DeserializationManager* ctx, ByteSource& source) {
+#ifdef MUTILS_DEBUG
+    const static std::string typenonce = type_name<T>();
+    auto remote_string = from_stream<std::string>(ctx, source);
+    assert(typenonce == *remote_string);
+#endif
+    using member = typename T::value_type;
+    static_assert(!std::is_same<bool, member>::value, "Error: vector<bool> cannot be deserialized from a stream");
+    int size;
+    source.read(&size, sizeof(int));
+    if constexpr(std::is_pod<member>::value) {
+        // Read the elements straight into the vector, so they are copied only once
+        auto accum = std::make_unique<std::remove_cv_t<T>>(size);
+        source.read(accum->data(), size * sizeof(member));
+        return accum;
+    } else {
+        auto accum = std::make_unique<std::remove_cv_t<T>>();
+        accum->reserve(size);
+        for(int i = 0; i < size; ++i) {
+            accum->push_back(std::move(*from_stream<member>(ctx, source)));
+        }
+        return accum;
+    }
+}
+
 template <typename T>
 std::enable_if_t<is_map<T>::value || is_unordered_map<T>::value, std::unique_ptr<T>>
 from_bytes(DeserializationManager* ctx, uint8_t const* buffer) {
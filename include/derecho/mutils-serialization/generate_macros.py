@@ -31,7 +31,20 @@ from_bytes_last_field = ('        auto {field}_obj = mutils::from_bytes<std::dec
                          '*(mutils::from_bytes<std::decay_t<decltype({last_field})> >(dsm, buf + bytes_read + mutils::bytes_size(*{field}_obj)))); \\\n')
 from_bytes_one_field_return = '        return std::make_unique<Name>(*a_obj); \\\n'
 from_bytes_two_fields_return = '        return std::make_unique<Name>(*a_obj, *(mutils::from_bytes<std::decay_t<decltype(b)> >(dsm, buf + mutils::bytes_size(*a_obj)))); \\\n'
-from_bytes_end = '    } \n\n' # Ends both from_bytes and the macro definition
+from_stream_begin = ('    template <typename StreamSource> \\\n'
+                     '    static std::unique_ptr<Name> from_stream(mutils::DeserializationManager* dsm, StreamSource& source){ \\\n')
+from_stream_field = '        auto {field}_obj = mutils::from_stream<std::decay_t<decltype({field})> >(dsm, source); \\\n'
+# Moves the fields into the constructor if it can take them as rvalues, so that a constructor
+# that takes its fields by value doesn't copy a large field that was just received
+from_stream_return = ('        if constexpr(std::is_constructible<Name, {rvalue_types_list}>::value) {{ \\\n'
+                      '            return std::make_unique<Name>({moved_ptrs_list}); \\\n'
+                      '        }} else {{ \\\n'
+                      '            return std::make_unique<Name>({obj_ptrs_list}); \\\n'
+                      '        }} \\\n')
+streamable_begin = ('    static constexpr bool from_stream_supported(){ \\\n'
+                    '        return')
+streamable_part = ' mutils::is_streamable<std::decay_t<decltype({field})> >::value '
+streamable_end = '    } \n\n' # Ends both from_stream_supported and the macro definition
 
 ### Comment block that goes at the top of the file ###
 header_comments = """
@@ -142,7 +155,20 @@ with open(OUTPUT_FILENAME, 'w') as output:
             output.write(from_bytes_last_field.format(field=field_vars[curr_num_fields-2],
                 last_field=field_vars[-1],
                 obj_ptrs_list=','.join(['*' + var + '_obj' for var in field_vars[:-1]])))
-        output.write(from_bytes_end)
+        output.write(closing_brace)
+        # Write the "from_stream" block, which reads the fields in order as they arrive
+        output.write(from_stream_begin)
+        for field in field_vars:
+            output.write(from_stream_field.format(field=field))
+        output.write(from_stream_return.format(
+            rvalue_types_list=','.join(['std::decay_t<decltype(' + var + ')>&&' for var in field_vars]),
+            moved_ptrs_list=','.join(['std::move(*' + var + '_obj)' for var in field_vars]),
+            obj_ptrs_list=','.join(['*' + var + '_obj' for var in field_vars])))
+        output.write(closing_brace)
+        output.write(streamable_begin)
+        output.write('&&'.join([streamable_part.format(field=field) for field in field_vars]))
+        output.write(bytes_size_line_end)
+        output.write(streamable_end)
     output.write(file_footer)
 
 
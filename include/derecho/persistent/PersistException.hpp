@@ -41,6 +41,18 @@ struct persistent_file_error : public persistent_exception {
               error_num(errno_value) {}
 };
 
+/**
+ * Indicates that a log entry's checksum does not match its contents, i.e. the
+ * entry or its data was corrupted on disk or in transit.
+ */
+struct persistent_checksum_error : public persistent_exception {
+    // Use int64_t instead of version_t so this file won't depend on Persistent.hpp
+    const int64_t corrupted_version;
+    persistent_checksum_error(int64_t ver)
+            : persistent_exception("Checksum mismatch in log entry for version " + std::to_string(ver)),
+              corrupted_version(ver) {}
+};
+
 /**
  * Type of persistent exception that indicates a requested index, version, etc.
  * was out-of-range for the log. Subtypes specify the type of thing that was out of range.
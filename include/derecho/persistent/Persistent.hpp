@@ -13,16 +13,22 @@
 #include "derecho/utils/logger.hpp"
 #include "derecho/utils/time.h"
 
+#include <condition_variable>
 #include <functional>
+#include <future>
 #include <inttypes.h>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <pthread.h>
+#include <queue>
 #include <string>
 #include <sys/types.h>
+#include <thread>
 #include <time.h>
 #include <typeindex>
+#include <vector>
 
 #if defined(_PERFORMANCE_DEBUG) || !defined(NDEBUG)
 #include "derecho/utils/time.h"
@@ -164,7 +170,9 @@ public:
 
     /**
      * Persist versions either up to a specified version, if provided, or up
-     * to the current version.
+     * to the current version. The fields are flushed concurrently: the calling
+     * thread flushes the first field and the registry's I/O threads flush the
+     * rest, and this call returns only after all of them have finished.
      *
      * @param latest_version The version to persist up to, or std::nullopt_t if
      * the fields should be persisted up to their current in-memory version.
@@ -179,6 +187,15 @@ public:
     /** Returns the minimum of the latest persisted versions among all Persistent fields. */
     version_t getMinimumLatestPersistedVersion();
 
+    /**
+     * Returns the latest persisted version of each Persistent field, keyed by
+     * the hash of the field's name (the same key used by the registry). A node
+     * that already has some of a subgroup's logs sends this to the node it is
+     * receiving the subgroup's state from, so that each field's log is only
+     * sent from where the local copy ends.
+     */
+    std::map<std::size_t, version_t> getLatestPersistedVersions();
+
     /**
      * Set the earliest version for serialization, exclusive. This version will
      * be stored in a thread-local variable. When to_bytes() is next called on
@@ -188,16 +205,33 @@ public:
      */
     static void setEarliestVersionToSerialize(version_t ver) noexcept(true);
 
-    /** Reset the earliest version for serialization to an invalid "uninitialized" state */
+    /**
+     * Set the earliest version for serialization, exclusive, separately for
+     * each Persistent field, keyed by the hash of the field's name as returned
+     * by getLatestPersistedVersions(). Like setEarliestVersionToSerialize(),
+     * this is stored in a thread-local variable. Fields that are not in the
+     * map use the version set by setEarliestVersionToSerialize().
+     * @param versions A map from field name hash to the version after which
+     * to begin serializing that field's log
+     */
+    static void setEarliestVersionsToSerialize(const std::map<std::size_t, version_t>& versions);
+
+    /** Reset the earliest version for serialization, including the per-field
+     * versions, to an invalid "uninitialized" state */
     static void resetEarliestVersionToSerialize() noexcept(true);
 
     /** Returns the earliest version for serialization. */
     static int64_t getEarliestVersionToSerialize() noexcept(true);
 
+    /** Returns the earliest version for serialization of the Persistent field with the given name. */
+    static int64_t getEarliestVersionToSerialize(const std::string& obj_name) noexcept(true);
+
     /**
      * Truncates the log, deleting all versions newer than the provided argument.
      * Since this throws away recently-used data, it should only be used during
-     * failure recovery when those versions must be rolled back.
+     * failure recovery when those versions must be rolled back. As with
+     * persist(), the fields are truncated concurrently and the call returns
+     * once all of them have finished.
      */
     void truncate(version_t last_version);
 
@@ -299,6 +333,31 @@ protected:
      */
     std::map<std::size_t, PersistentObject*> m_registry;
 
+    /**
+     * I/O threads that flush and truncate fields on behalf of persist() and
+     * truncate(). There is one per registered field beyond the first; they
+     * are started the first time they are needed and run until the registry
+     * is destroyed, so no thread is created on the persistence path.
+     */
+    std::vector<std::thread> m_ioThreads;
+    /** Field operations waiting for an I/O thread, guarded by m_ioQueueMutex. */
+    std::queue<std::packaged_task<void()>> m_ioQueue;
+    std::mutex m_ioQueueMutex;
+    std::condition_variable m_ioQueueCV;
+    /** Set by the destructor to make the I/O threads exit, guarded by m_ioQueueMutex. */
+    bool m_ioShutdown;
+
+    /**
+     * Applies field_op to every registered field concurrently, running it on
+     * the calling thread for the first field and on the I/O threads for the
+     * others, and returns once all of them have finished. If any of them
+     * throws, the first exception is rethrown after the others finish.
+     */
+    void forEachFieldConcurrently(const std::function<void(PersistentObject*)>& field_op);
+
+    /** The main loop of an I/O thread. */
+    void ioThreadLoop();
+
     /**
      * The last (most recent) signature to be added to a persistent log entry.
      * This is cached in memory since it is needed for the next call to sign()
@@ -315,6 +374,11 @@ protected:
      * Set the earliest version to serialize for recovery.
      */
     static thread_local int64_t earliest_version_to_serialize;
+    /**
+     * Per-field overrides of earliest_version_to_serialize, keyed by the hash
+     * of the field's name.
+     */
+    static thread_local std::map<std::size_t, version_t> earliest_versions_to_serialize;
 
     /**
      * Determines the next version in any signed field after the provided version,
@@ -379,6 +443,54 @@ public:
     virtual void applyDelta(uint8_t const* const buf) = 0;
 };
 
+/**
+ * LogEntryView is a read-only handle on an object deserialized in place from a
+ * Persistent<T>'s memory-mapped log. The log stays pinned (see
+ * PersistLog::pinEntries()) for the lifetime of the view, so trim() and
+ * truncate() cannot invalidate the entry it refers to. The pin is a read lock
+ * on the log, which means:
+ * - append() to the same log stalls until the view is destroyed, so views are
+ *   meant to be short-lived and must not be held by the thread that creates new
+ *   versions, or across a call that waits for new versions to be delivered.
+ * - the view must be destroyed on the thread that created it, since a read
+ *   lock can only be released by the thread that holds it. That is why a view
+ *   can be neither copied nor moved; getView() and getDeltaView() return it by
+ *   guaranteed copy elision.
+ *
+ * Whether the object is actually zero-copy depends on T::from_bytes_noalloc():
+ * POD types and types with a zero-copy from_bytes_noalloc() point straight into
+ * the log, while the others fall back to whatever that function allocates.
+ */
+template <typename T>
+class LogEntryView {
+private:
+    PersistLog* m_pLog;
+    mutils::context_ptr<const T> m_pObject;
+
+public:
+    LogEntryView(PersistLog* pinned_log, mutils::context_ptr<const T> object)
+            : m_pLog(pinned_log), m_pObject(std::move(object)) {}
+    LogEntryView(const LogEntryView&) = delete;
+    LogEntryView(LogEntryView&&) = delete;
+    LogEntryView& operator=(const LogEntryView&) = delete;
+    LogEntryView& operator=(LogEntryView&&) = delete;
+    ~LogEntryView() {
+        // The object may refer to the log, so release it before the pin.
+        m_pObject.reset();
+        m_pLog->unpinEntries();
+    }
+
+    const T& operator*() const {
+        return *m_pObject;
+    }
+    const T* operator->() const {
+        return m_pObject.get();
+    }
+    const T* get() const {
+        return m_pObject.get();
+    }
+};
+
 // _NameMaker is a tool makeing the name for the log corresponding to a
 // given Persistent<ObjectType> object.
 template <typename ObjectType, StorageType storageType>
@@ -438,6 +550,17 @@ protected:
     inline void initialize_object_from_log(const std::function<std::unique_ptr<ObjectType>(void)>& object_factory,
                                            mutils::DeserializationManager* dm);
 
+    /** finish deserialization once the log tail is applied: take the received
+     *  object, or rebuild it from the log if it was left out, and register
+     *  with the PersistentRegistry.
+     *  @param  object_name         Object name
+     *  @param  wrapped_obj_ptr     The received object, or null
+     *  @param  dm                  The deserialization manager for local log entries
+     */
+    inline void initialize_received_object(const char* object_name,
+                                           std::unique_ptr<ObjectType>& wrapped_obj_ptr,
+                                           mutils::DeserializationManager& dm);
+
 public:
     /**
      * Persistent(std::function<std::unique_ptr<ObjectType>(void)>&,const char*,PersistentRegistry*,bool,mutils::DeserializationManager)
@@ -476,7 +599,10 @@ public:
      * the object name, a unique_ptr to the wrapped object, and a unique_ptr to
      * the log.
      * @param object_name           The name is used for persistent data in file.
-     * @param wrapped_obj_ptr       A unique pointer to the wrapped object.
+     * @param wrapped_obj_ptr       A unique pointer to the wrapped object. If
+     *                              it is null, the object is rebuilt from the
+     *                              latest entry in the local log after the log
+     *                              tail is applied.
      * @param enable_signatures     True if the received log has signatures in it, false if not
      * @param log_tail              A pointer to the beginning of the log within the serialized buffer
      * @param persistent_registry   A pointer to the persistent registry
@@ -490,6 +616,22 @@ public:
             PersistentRegistry* persistent_registry = nullptr,
             mutils::DeserializationManager dm = {{}});
 
+    /**
+     * Persistent(const char*,std::unique_ptr<ObjectType>&,bool,mutils::ByteSource&,
+     *            PersistentRegistry*,mutils::DeserializationManager)
+     *
+     * Like constructor 3, but it reads the log tail from a stream as it is
+     * applied, so only one log entry at a time has to be in memory.
+     * @param log_tail              The stream to read the log from
+     */
+    Persistent(
+            const char* object_name,
+            std::unique_ptr<ObjectType>& wrapped_obj_ptr,
+            bool enable_signatures,
+            mutils::ByteSource& log_tail,
+            PersistentRegistry* persistent_registry = nullptr,
+            mutils::DeserializationManager dm = {{}});
+
     /**
      * Persistent(PersistentRegistry*,bool)
      *
@@ -757,6 +899,78 @@ public:
              bool exact,
              mutils::DeserializationManager* dm = nullptr) const;
 
+    /**
+     * getView(const version_t,mutils::DeserializationManager*)
+     *
+     * Get a version of ObjectType as a LogEntryView deserialized in place from the log, instead of a copy. The view
+     * keeps the log pinned, which stalls append(), until it is destroyed on the calling thread.
+     *
+     * This function is enabled only if ObjectType does not implement the IDeltaSupport<> interface, since the log
+     * entries of delta types are not full states. Use visitDeltas() for those.
+     *
+     * @tparam DummyObjectType  A copy of ObjectType, see getDeltaSignature().
+     *
+     * @param ver   if 'ver' does not match a log entry, the latest state before 'ver' is returned.
+     * @param dm    the deserialization manager
+     *
+     * @return a view on the ObjectType object in the log.
+     *
+     * @throws persistent_invalid_version, when the state at 'ver' has no state.
+     */
+    template <typename DummyObjectType = ObjectType>
+    std::enable_if_t<!std::is_base_of<IDeltaSupport<DummyObjectType>, DummyObjectType>::value, LogEntryView<ObjectType>>
+    getView(const version_t ver,
+            mutils::DeserializationManager* dm = nullptr) const;
+
+    /**
+     * getDeltaView(const version_t,bool,mutils::DeserializationManager*)
+     *
+     * Get the delta at a given version as a LogEntryView deserialized in place from the log. The view keeps the log
+     * pinned, which stalls append(), until it is destroyed on the calling thread.
+     *
+     * This function is enabled only if ObjectType implements IDeltaSupport<> interface.
+     *
+     * @tparam DeltaType    User-specified DeltaType. DeltaType must be a pod type or implement mutils::ByteRepresentable.
+     *
+     * @param ver   version
+     * @param exact true for the version only, otherwise, a recent version before asked version also works.
+     * @param dm    the deserialization manager
+     *
+     * @return a view on the DeltaType object in the log.
+     *
+     * @throws persistent_invalid_version, when version 'ver' is not found in the log.
+     */
+    template <typename DeltaType>
+    std::enable_if_t<std::is_base_of<IDeltaSupport<ObjectType>, ObjectType>::value, LogEntryView<DeltaType>>
+    getDeltaView(const version_t ver,
+                 bool exact,
+                 mutils::DeserializationManager* dm = nullptr) const;
+
+    /**
+     * visitDeltas(const version_t,const Func&,mutils::DeserializationManager*)
+     *
+     * Run a visitor over every delta from the earliest one in the log up to and including the state at 'ver', in log
+     * order. Each delta is deserialized in place and handed to 'fun' as a const DeltaType&, so the historical state
+     * can be inspected or folded without materializing an ObjectType or copying any delta. The log is pinned once for
+     * the whole walk.
+     *
+     * This function is enabled only if ObjectType implements IDeltaSupport<> interface.
+     *
+     * @tparam DeltaType    User-specified DeltaType. DeltaType must be a pod type or implement mutils::ByteRepresentable.
+     * @tparam Func         User-specified function type, which is usually deduced.
+     *
+     * @param ver   the version to stop at; a version without an entry stops at the latest entry before it.
+     * @param fun   the visitor, called with the delta of each entry in turn.
+     * @param dm    the deserialization manager
+     *
+     * @throws persistent_invalid_version, when there is no log entry at or before 'ver'.
+     */
+    template <typename DeltaType, typename Func>
+    std::enable_if_t<std::is_base_of<IDeltaSupport<ObjectType>, ObjectType>::value, std::void_t<DeltaType>>
+    visitDeltas(const version_t ver,
+                const Func& fun,
+                mutils::DeserializationManager* dm = nullptr) const;
+
     /**
      * getDeltaSignature(const version_t,const Func&,unsigned char*,version_t&,mutils::DeserializationManager*)
      *
@@ -1126,6 +1340,16 @@ protected:
     std::shared_ptr<spdlog::logger> m_logger;
     // get the static name maker.
     static _NameMaker<ObjectType, storageType>& getNameMaker(const std::string& prefix = std::string(""));
+    /**
+     * Returns true if a receiver whose copy of this log ends at
+     * earliest_version can rebuild the current object from that log once the
+     * serialized log entries are appended to it, in which case serialization
+     * leaves the object out. This requires that earliest_version is an entry
+     * of this log, so the appended entries leave no gap, and that ObjectType
+     * does not use IDeltaSupport, since rebuilding a delta object would
+     * replay the receiver's whole log, which may have been trimmed.
+     */
+    bool isRecoverableFromLogTail(version_t earliest_version) const;
 
     //serialization supports
 public:
@@ -1133,17 +1357,26 @@ public:
     // Serialization and Deserialization of Persistent<T>
     // Serialization of the persistent<T> is packed in the following order
     // 1) the log name
-    // 2) current state of the object
-    // 3) number of log entries
-    // 4) the log entries from the earliest to the latest
+    // 2) a flag indicating whether the current state of the object follows
+    // 3) current state of the object, unless the receiver can rebuild it
+    //    from its own log (see isRecoverableFromLogTail)
+    // 4) a flag indicating whether the log has signatures
+    // 5) number of log entries
+    // 6) the log entries from the earliest to the latest
     // TODO.
-    //Note: this rely on PersistentRegistry::earliest_version_to_serialize
+    //Note: this rely on PersistentRegistry::earliest_version_to_serialize,
+    //or the per-field version set by setEarliestVersionsToSerialize
     std::size_t to_bytes(uint8_t* ret) const;
     std::size_t bytes_size() const;
     void post_object(const std::function<void(uint8_t const* const, std::size_t)>& f) const;
     // NOTE: we do not set up the registry here. This will only happen in the
     // construction of Replicated<T>
     static std::unique_ptr<Persistent> from_bytes(mutils::DeserializationManager* dsm, uint8_t const* v);
+    // reads the same layout from a stream, for when the serialized bytes arrive a piece at a time
+    static std::unique_ptr<Persistent> from_stream(mutils::DeserializationManager* dsm, mutils::ByteSource& source);
+    static constexpr bool from_stream_supported() {
+        return mutils::is_streamable<ObjectType>::value;
+    }
     // derived from ByteRepresentable
     virtual void ensure_registered(mutils::DeserializationManager&) {}
     /**
@@ -6,8 +6,12 @@
 #include "PersistLog.hpp"
 #include "util.hpp"
 #include <derecho/utils/logger.hpp>
+#include <atomic>
+#include <memory>
 #include <pthread.h>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace persistent {
 
@@ -50,10 +54,16 @@ union LogEntry {
         uint64_t hlc_r;           // realtime component of hlc
         uint64_t hlc_l;           // logic component of hlc
         int64_t prev_signed_ver;  // previous signed version, whose signature is included in this version's signature
+        uint32_t checksum;        // CRC32C of ver, sdlen, hlc_r, hlc_l and the data (not the signature)
+        uint32_t flags;           // LOG_ENTRY_FLAG_* bits
     } fields;
     uint8_t bytes[MAX_LOG_ENTRY_SIZE];
 };
 
+// LogEntry::flags bit set if LogEntry::checksum is valid. Entries written without
+// checksums (including those written before checksums existed) have it cleared.
+#define LOG_ENTRY_FLAG_CHECKSUM (0x1u)
+
 // TODO: make this hard-wired number configurable.
 // Currently, we allow 1M(2^20-1) log entries and
 // 512GB data size. The max log entry and max size are
@@ -114,6 +124,17 @@ protected:
     const uint64_t m_iMaxLogEntry;
     // max data size
     const uint64_t m_iMaxDataSize;
+    // whether new log entries get a checksum
+    const bool m_bChecksums;
+    // entries below this index were loaded from disk and have their checksums
+    // verified when they are first read; entries appended afterwards are trusted.
+    int64_t m_iUnverifiedTail;
+    // the head of the log when it was loaded from disk
+    int64_t m_iLoadedHead;
+    // one bit per entry loaded from disk, starting at m_iLoadedHead, set once
+    // the entry's checksum has been verified. The bits are atomic because
+    // entries are verified under the read lock, possibly by several readers.
+    std::unique_ptr<std::atomic<uint64_t>[]> m_pVerifiedEntries;
     // pointer to the Persistence-module logger
     std::shared_ptr<spdlog::logger> m_logger;
 
@@ -211,6 +232,8 @@ public:
     virtual version_t persist(std::optional<version_t> latest_version,
                               bool preLocked = false) override;
     virtual void processEntryAtVersion(version_t ver, const std::function<void(const void*, std::size_t)>& func) override;
+    virtual void pinEntries() override;
+    virtual void unpinEntries() override;
     virtual void addSignature(version_t ver, const uint8_t* signature, version_t previous_signed_version) override;
     virtual bool getSignature(version_t ver, uint8_t* signature, version_t& previous_signed_version) override;
     virtual bool getSignatureByIndex(int64_t index, uint8_t* signature, version_t& prev_ver) override;
@@ -223,6 +246,7 @@ public:
     virtual void post_object(const std::function<void(uint8_t const* const, std::size_t)>& f,
                              version_t ver) override;
     virtual void applyLogTail(uint8_t const* v) override;
+    virtual void applyLogTail(mutils::ByteSource& source) override;
 
     template <typename TKey, typename KeyGetter>
     void trim(const TKey& key, const KeyGetter& keyGetter) {
@@ -268,6 +292,30 @@ public:
      */
     static const uint64_t getMinimumLatestPersistedVersion(const std::string& prefix);
 
+    /**
+     * Loads every log in the persistence directory whose name starts with one
+     * of the given subgroup/shard prefixes, one task per log, and keeps them
+     * until takePreloadedLog() claims them. This lets a node that hosts many
+     * Persistent<T> fields open, map and scan all of their logs concurrently
+     * before the fields are constructed one at a time. A log that fails to
+     * load is skipped, so that the field's constructor reports the error.
+     * @param prefixes pairs of a subgroup/shard prefix and whether the fields
+     * with that prefix have signatures enabled
+     */
+    static void preloadLogs(const std::vector<std::pair<std::string, bool>>& prefixes);
+
+    /**
+     * Claims a log loaded by preloadLogs().
+     * @return The log with the given name, or nullptr if it was not preloaded
+     * from dataPath with the same signature setting
+     */
+    static std::unique_ptr<FilePersistLog> takePreloadedLog(const std::string& name,
+                                                            const std::string& dataPath,
+                                                            bool enableSignatures);
+
+    /** Unmaps any preloaded log that no field claimed. */
+    static void discardPreloadedLogs();
+
 private:
     /** verify the existence of the meta file */
     bool checkOrCreateMetaFile();
@@ -362,6 +410,43 @@ private:
         return pivot;
     }
 
+    /**
+     * Compute the checksum of a log entry.
+     * @param ple - pointer to the log entry
+     * @param pdata - pointer to the entry's data, after the signature
+     * @return the CRC32C of the entry's version, length, HLC and data
+     */
+    uint32_t computeChecksum(const LogEntry* ple, const void* pdata) const;
+    /**
+     * Check the checksum of a log entry, if it has one.
+     * @param ple - pointer to the log entry
+     * @param pdata - pointer to the entry's data, after the signature
+     * @return false if the entry has a checksum and it does not match, true otherwise
+     */
+    bool checksumMatches(const LogEntry* ple, const void* pdata) const;
+    /**
+     * Check that a log entry's data length is large enough for the signature
+     * and fits in the data file.
+     * @param ple - pointer to the log entry
+     */
+    bool dataSizeIsValid(const LogEntry* ple) const;
+    /**
+     * Throw persistent_checksum_error if the entry at idx was loaded from disk
+     * and its checksum does not match. Each loaded entry is checked only the
+     * first time it is read.
+     * @param idx - the index of the log entry
+     */
+    void verifyLoadedEntry(int64_t idx);
+    /**
+     * Scan the log entries loaded from disk for torn or corrupted entries.
+     * Every entry is checked for a monotonically growing version and contiguous
+     * data; the newest entry, which a crash is most likely to have damaged,
+     * also has its checksum verified. The others are verified when read.
+     * Note: no lock protected, use FPL_WRLOCK
+     * @return the index one past the last valid entry
+     */
+    int64_t scanLoadedEntries();
+
     /* Validate the log before we append. It will throw exception if
      * - there is no space
      * - the version is not monotonic
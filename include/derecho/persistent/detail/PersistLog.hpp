@@ -10,6 +10,7 @@
 #include "../HLC.hpp"
 #include "../PersistException.hpp"
 #include "../PersistentInterface.hpp"
+#include <derecho/mutils-serialization/SerializationSupport.hpp>
 #include <functional>
 #include <inttypes.h>
 #include <map>
@@ -194,6 +195,21 @@ public:
      */
     virtual void processEntryAtVersion(version_t ver, const std::function<void(const void*, std::size_t)>& func) = 0;
 
+    /**
+     * Pin the log so that the pointers returned by getEntry()/getEntryByIndex()
+     * stay valid until the matching unpinEntries() call. While the log is
+     * pinned, trim(), truncate() and append() block, so a pin should be held
+     * only for as long as the caller reads the entries. The getters above may
+     * still be called by the pinning thread.
+     */
+    virtual void pinEntries() = 0;
+
+    /**
+     * Release a pin acquired with pinEntries(). Must be called on the thread
+     * that pinned the log.
+     */
+    virtual void unpinEntries() = 0;
+
     /**
      * Persist the log, either until the specified version or until the latest version
      * @param latest_version - Optional version number. If provided, persist()
@@ -300,6 +316,13 @@ public:
      */
     virtual void applyLogTail(uint8_t const* v) = 0;
 
+    /**
+     * Check/Merge the LogTail to the existing log as it is read from a stream,
+     * so that the serialized log never has to be in one buffer.
+     * @param source - the stream the serialized log bytes are read from
+     */
+    virtual void applyLogTail(mutils::ByteSource& source) = 0;
+
     /**
      * Truncate the log strictly newer than 'ver'.
      * @param ver - all log entry strictly after ver will be truncated.
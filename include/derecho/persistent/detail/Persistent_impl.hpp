@@ -84,7 +84,10 @@ inline void Persistent<ObjectType, storageType>::initialize_log(const char* obje
     switch(storageType) {
         // file system
         case ST_FILE:
-            this->m_pLog = std::make_unique<FilePersistLog>(object_name, enable_signatures);
+            this->m_pLog = FilePersistLog::takePreloadedLog(object_name, getPersFilePath(), enable_signatures);
+            if(this->m_pLog == nullptr) {
+                this->m_pLog = std::make_unique<FilePersistLog>(object_name, enable_signatures);
+            }
             if(this->m_pLog == nullptr) {
                 throw persistent_exception("Failed to create FilePersistLog for an unknown reason");
             }
@@ -173,7 +176,7 @@ Persistent<ObjectType, storageType>::Persistent(
         bool enable_signatures,
         const uint8_t* log_tail,
         PersistentRegistry* persistent_registry,
-        mutils::DeserializationManager)
+        mutils::DeserializationManager dm)
         : m_pRegistry(persistent_registry),
           m_logger(PersistLogger::get()) {
     // Initialize log
@@ -182,9 +185,41 @@ Persistent<ObjectType, storageType>::Persistent(
     if(log_tail != nullptr) {
         this->m_pLog->applyLogTail(log_tail);
     }
-    // Initialize Wrapped Object
-    assert(wrapped_obj_ptr != nullptr);
-    this->m_pWrappedObject = std::move(wrapped_obj_ptr);
+    initialize_received_object(object_name, wrapped_obj_ptr, dm);
+}
+
+template <typename ObjectType,
+          StorageType storageType>
+Persistent<ObjectType, storageType>::Persistent(
+        const char* object_name,
+        std::unique_ptr<ObjectType>& wrapped_obj_ptr,
+        bool enable_signatures,
+        mutils::ByteSource& log_tail,
+        PersistentRegistry* persistent_registry,
+        mutils::DeserializationManager dm)
+        : m_pRegistry(persistent_registry),
+          m_logger(PersistLogger::get()) {
+    // Initialize log
+    initialize_log(object_name, enable_signatures);
+    // patch it
+    this->m_pLog->applyLogTail(log_tail);
+    initialize_received_object(object_name, wrapped_obj_ptr, dm);
+}
+
+template <typename ObjectType,
+          StorageType storageType>
+inline void Persistent<ObjectType, storageType>::initialize_received_object(
+        const char* object_name,
+        std::unique_ptr<ObjectType>& wrapped_obj_ptr,
+        mutils::DeserializationManager& dm) {
+    // Initialize Wrapped Object. If the sender left it out, the patched log ends with its latest version.
+    if(wrapped_obj_ptr != nullptr) {
+        this->m_pWrappedObject = std::move(wrapped_obj_ptr);
+    } else {
+        assert(this->getNumOfVersions() > 0);
+        dbg_debug(m_logger, "{0} rebuilding the wrapped object from the local log", object_name);
+        this->m_pWrappedObject = this->getByIndex(this->getLatestIndex(), &dm);
+    }
     // Register with PersistentRegistry
     if(this->m_pRegistry) {
         this->m_pRegistry->registerPersistent(this->m_pLog->m_sName, this);
@@ -286,10 +321,19 @@ std::unique_ptr<ObjectType> Persistent<ObjectType, storageType>::getByIndex(
         // ObjectType* ot = new ObjectType{};
         std::unique_ptr<ObjectType> p = ObjectType::create(dm);
         // TODO: accelerate this by checkpointing
-        for(int64_t i = this->m_pLog->getEarliestIndex(); i <= idx; i++) {
-            const uint8_t* entry_data = (const uint8_t*)this->m_pLog->getEntryByIndex(i);
-            p->applyDelta(entry_data);
+        // Pin the log once for the whole replay, so a concurrent trim cannot
+        // move the head past an entry that is still to be applied.
+        this->m_pLog->pinEntries();
+        try {
+            for(int64_t i = this->m_pLog->getEarliestIndex(); i <= idx; i++) {
+                const uint8_t* entry_data = (const uint8_t*)this->m_pLog->getEntryByIndex(i);
+                p->applyDelta(entry_data);
+            }
+        } catch(...) {
+            this->m_pLog->unpinEntries();
+            throw;
         }
+        this->m_pLog->unpinEntries();
 
         return p;
     } else {
@@ -372,6 +416,73 @@ Persistent<ObjectType, storageType>::getDelta(
     return mutils::from_bytes<DeltaType>(dm, (const uint8_t*)this->m_pLog->getEntryByIndex(idx));
 }
 
+template <typename ObjectType,
+          StorageType storageType>
+template <typename DummyObjectType>
+std::enable_if_t<!std::is_base_of<IDeltaSupport<DummyObjectType>, DummyObjectType>::value, LogEntryView<ObjectType>>
+Persistent<ObjectType, storageType>::getView(const version_t ver,
+                                             mutils::DeserializationManager* dm) const {
+    this->m_pLog->pinEntries();
+    try {
+        const uint8_t* pdat = reinterpret_cast<const uint8_t*>(this->m_pLog->getEntry(ver));
+        if(pdat == nullptr) {
+            throw persistent_invalid_version(ver);
+        }
+        // From here on, the view owns the pin
+        return LogEntryView<ObjectType>(this->m_pLog.get(), mutils::from_bytes_noalloc<const ObjectType>(dm, pdat));
+    } catch(...) {
+        this->m_pLog->unpinEntries();
+        throw;
+    }
+}
+
+template <typename ObjectType,
+          StorageType storageType>
+template <typename DeltaType>
+std::enable_if_t<std::is_base_of<IDeltaSupport<ObjectType>, ObjectType>::value, LogEntryView<DeltaType>>
+Persistent<ObjectType, storageType>::getDeltaView(const version_t ver,
+                                                  bool exact,
+                                                  mutils::DeserializationManager* dm) const {
+    this->m_pLog->pinEntries();
+    try {
+        const uint8_t* pdat = reinterpret_cast<const uint8_t*>(this->m_pLog->getEntry(ver, exact));
+        if(pdat == nullptr) {
+            throw persistent_invalid_version(ver);
+        }
+        // From here on, the view owns the pin
+        return LogEntryView<DeltaType>(this->m_pLog.get(), mutils::from_bytes_noalloc<const DeltaType>(dm, pdat));
+    } catch(...) {
+        this->m_pLog->unpinEntries();
+        throw;
+    }
+}
+
+template <typename ObjectType,
+          StorageType storageType>
+template <typename DeltaType, typename Func>
+std::enable_if_t<std::is_base_of<IDeltaSupport<ObjectType>, ObjectType>::value, std::void_t<DeltaType>>
+Persistent<ObjectType, storageType>::visitDeltas(const version_t ver,
+                                                 const Func& fun,
+                                                 mutils::DeserializationManager* dm) const {
+    this->m_pLog->pinEntries();
+    try {
+        int64_t last_idx = this->m_pLog->getVersionIndex(ver);
+        if(last_idx == INVALID_INDEX) {
+            throw persistent_invalid_version(ver);
+        }
+        for(int64_t idx = this->m_pLog->getEarliestIndex(); idx <= last_idx; idx++) {
+            const uint8_t* delta_data = reinterpret_cast<const uint8_t*>(this->m_pLog->getEntryByIndex(idx));
+            mutils::deserialize_and_run(dm, delta_data, [&fun](const DeltaType& delta) {
+                fun(delta);
+            });
+        }
+    } catch(...) {
+        this->m_pLog->unpinEntries();
+        throw;
+    }
+    this->m_pLog->unpinEntries();
+}
+
 template <typename ObjectType,
           StorageType storageType>
 template <typename DeltaType, typename DummyObjectType>
@@ -662,48 +773,82 @@ version_t Persistent<ObjectType, storageType>::persist(std::optional<version_t>
 #endif  //_PERFORMANCE_DEBUG
 }
 
+template <typename ObjectType,
+          StorageType storageType>
+bool Persistent<ObjectType, storageType>::isRecoverableFromLogTail(version_t earliest_version) const {
+    if constexpr(std::is_base_of<IDeltaSupport<ObjectType>, ObjectType>::value) {
+        // Rebuilding a delta object replays every delta from the first entry of
+        // the receiver's log, which is wrong if that log has been trimmed, so
+        // the receiver always gets the object itself.
+        return false;
+    } else {
+        if(earliest_version == INVALID_VERSION || this->m_pLog->getLength() == 0) {
+            return false;
+        }
+        // The receiver's log must end at an entry of this log, not merely at a
+        // version within its range, so that the serialized entries after it
+        // leave no gap and the receiver's last entry becomes this log's last
+        // entry, which holds the current object.
+        return this->m_pLog->getVersionIndex(earliest_version, true) != INVALID_INDEX;
+    }
+}
+
 template <typename ObjectType,
           StorageType storageType>
 std::size_t Persistent<ObjectType, storageType>::to_bytes(uint8_t* ret) const {
     std::size_t sz = 0;
+    const version_t earliest_version = PersistentRegistry::getEarliestVersionToSerialize(this->m_pLog->m_sName);
+    const bool include_wrapped_object = !isRecoverableFromLogTail(earliest_version);
     // object name
     dbg_trace(m_logger, "{0}[{1}] object_name starts at {2}", this->m_pLog->m_sName, __func__, sz);
     sz += mutils::to_bytes(this->m_pLog->m_sName, ret + sz);
+    // flag to indicate whether the wrapped object follows
+    sz += mutils::to_bytes(include_wrapped_object, ret + sz);
     // wrapped object
-    dbg_trace(m_logger, "{0}[{1}] wrapped_object starts at {2}", this->m_pLog->m_sName, __func__, sz);
-    sz += mutils::to_bytes(*this->m_pWrappedObject, ret + sz);
+    if(include_wrapped_object) {
+        dbg_trace(m_logger, "{0}[{1}] wrapped_object starts at {2}", this->m_pLog->m_sName, __func__, sz);
+        sz += mutils::to_bytes(*this->m_pWrappedObject, ret + sz);
+    }
     // flag to indicate whether the log has signatures
     dbg_trace(m_logger, "{0}[{1}] signatures_enabled starts at {2}", this->m_pLog->m_sName, __func__, sz);
     const bool signatures_enabled = this->m_pLog->signature_size > 0;
     sz += mutils::to_bytes(signatures_enabled, ret + sz);
     // and the log
     dbg_trace(m_logger, "{0}[{1}] log starts at {2}", this->m_pLog->m_sName, __func__, sz);
-    sz += this->m_pLog->to_bytes(ret + sz, PersistentRegistry::getEarliestVersionToSerialize());
+    sz += this->m_pLog->to_bytes(ret + sz, earliest_version);
     return sz;
 }
 
 template <typename ObjectType,
           StorageType storageType>
 std::size_t Persistent<ObjectType, storageType>::bytes_size() const {
-    // object name, wrapped object, signature flag, and log
+    const version_t earliest_version = PersistentRegistry::getEarliestVersionToSerialize(this->m_pLog->m_sName);
+    // object name, wrapped object flag, wrapped object, signature flag, and log
     return mutils::bytes_size(this->m_pLog->m_sName)
-           + mutils::bytes_size(*this->m_pWrappedObject)
            + sizeof(bool)
-           + this->m_pLog->bytes_size(PersistentRegistry::getEarliestVersionToSerialize());
+           + (isRecoverableFromLogTail(earliest_version) ? 0 : mutils::bytes_size(*this->m_pWrappedObject))
+           + sizeof(bool)
+           + this->m_pLog->bytes_size(earliest_version);
 }
 
 template <typename ObjectType,
           StorageType storageType>
 void Persistent<ObjectType, storageType>::post_object(const std::function<void(uint8_t const* const, std::size_t)>& f)
         const {
+    const version_t earliest_version = PersistentRegistry::getEarliestVersionToSerialize(this->m_pLog->m_sName);
+    const bool include_wrapped_object = !isRecoverableFromLogTail(earliest_version);
     // object name
     mutils::post_object(f, this->m_pLog->m_sName);
+    // flag to indicate whether the wrapped object follows
+    mutils::post_object(f, include_wrapped_object);
     // wrapped object
-    mutils::post_object(f, *this->m_pWrappedObject);
+    if(include_wrapped_object) {
+        mutils::post_object(f, *this->m_pWrappedObject);
+    }
     // flag to indicate whether the log has signatures
     mutils::post_object(f, (this->m_pLog->signature_size > 0));
     // and the log
-    this->m_pLog->post_object(f, PersistentRegistry::getEarliestVersionToSerialize());
+    this->m_pLog->post_object(f, earliest_version);
 }
 
 template <typename ObjectType,
@@ -714,9 +859,15 @@ std::unique_ptr<Persistent<ObjectType, storageType>> Persistent<ObjectType, stor
     auto obj_name = mutils::from_bytes<std::string>(dsm, v);
     ofst += mutils::bytes_size(*obj_name);
 
-    dbg_trace(PersistLogger::get(), "{0} wrapped_obj is loaded at {1}", __func__, ofst);
-    auto wrapped_obj = mutils::from_bytes<ObjectType>(dsm, v + ofst);
-    ofst += mutils::bytes_size(*wrapped_obj);
+    bool has_wrapped_obj = *mutils::from_bytes_noalloc<bool>(dsm, v + ofst);
+    ofst += mutils::bytes_size(has_wrapped_obj);
+    // If the wrapped object was left out, the constructor rebuilds it from the local log
+    std::unique_ptr<ObjectType> wrapped_obj;
+    if(has_wrapped_obj) {
+        dbg_trace(PersistLogger::get(), "{0} wrapped_obj is loaded at {1}", __func__, ofst);
+        wrapped_obj = mutils::from_bytes<ObjectType>(dsm, v + ofst);
+        ofst += mutils::bytes_size(*wrapped_obj);
+    }
 
     dbg_trace(PersistLogger::get(), "{0} signatures_enabled is loaded at {1}", __func__, ofst);
     bool signatures_enabled = *mutils::from_bytes_noalloc<bool>(dsm, v + ofst);
@@ -727,7 +878,28 @@ std::unique_ptr<Persistent<ObjectType, storageType>> Persistent<ObjectType, stor
         pr = &dsm->mgr<PersistentRegistry>();
     }
     dbg_trace(PersistLogger::get(), "{0}[{1}] create object from serialized bytes.", obj_name->c_str(), __func__);
-    return std::make_unique<Persistent>(obj_name->data(), wrapped_obj, signatures_enabled, v + ofst, pr);
+    return std::make_unique<Persistent>(obj_name->data(), wrapped_obj, signatures_enabled, v + ofst, pr,
+                                        mutils::DeserializationManager{dsm ? dsm->registered_v : mutils::RemoteDeserialization_v{}});
+}
+
+template <typename ObjectType,
+          StorageType storageType>
+std::unique_ptr<Persistent<ObjectType, storageType>> Persistent<ObjectType, storageType>::from_stream(mutils::DeserializationManager* dsm, mutils::ByteSource& source) {
+    auto obj_name = mutils::from_stream<std::string>(dsm, source);
+    bool has_wrapped_obj = *mutils::from_stream<bool>(dsm, source);
+    // If the wrapped object was left out, the constructor rebuilds it from the local log
+    std::unique_ptr<ObjectType> wrapped_obj;
+    if(has_wrapped_obj) {
+        wrapped_obj = mutils::from_stream<ObjectType>(dsm, source);
+    }
+    bool signatures_enabled = *mutils::from_stream<bool>(dsm, source);
+    PersistentRegistry* pr = nullptr;
+    if(dsm != nullptr) {
+        pr = &dsm->mgr<PersistentRegistry>();
+    }
+    dbg_trace(PersistLogger::get(), "{0}[{1}] create object from a stream, reading the log as it arrives.", obj_name->c_str(), __func__);
+    return std::make_unique<Persistent>(obj_name->data(), wrapped_obj, signatures_enabled, source, pr,
+                                        mutils::DeserializationManager{dsm ? dsm->registered_v : mutils::RemoteDeserialization_v{}});
 }
 
 template <typename ObjectType,
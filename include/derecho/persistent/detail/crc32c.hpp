@@ -0,0 +1,27 @@
+#pragma once
+#ifndef PERSISTENT_CRC32C_HPP
+#define PERSISTENT_CRC32C_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace persistent {
+
+/**
+ * Extends a CRC32C (Castagnoli) checksum with the contents of a buffer. To
+ * checksum a sequence of buffers, start with crc = 0 and pass the result of
+ * each call to the next one.
+ *
+ * Uses the SSE4.2 crc32 instruction if the CPU supports it, and a table-driven
+ * implementation otherwise; both produce the same result.
+ *
+ * @param crc The checksum of the data preceding this buffer, or 0
+ * @param buf The buffer
+ * @param len The length of the buffer in bytes
+ * @return The checksum of all the data up to and including this buffer
+ */
+uint32_t crc32c(uint32_t crc, const void* buf, std::size_t len);
+
+}  // namespace persistent
+
+#endif  // PERSISTENT_CRC32C_HPP
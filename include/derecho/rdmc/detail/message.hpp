@@ -3,6 +3,7 @@
 #define MESSAGE_HPP
 
 #include <derecho/config.h>
+#include <derecho/rdmc/rdmc.hpp>
 #include <cstdint>
 #include <utility>
 
@@ -38,6 +39,59 @@ inline uint32_t form_immediate(uint16_t total_blocks, uint16_t block_number) {
     return ((uint32_t)total_blocks) << 16 | ((uint32_t)block_number);
 }
 
+/*
+ * Sent to each receiver ahead of the first block of a message, so that the
+ * receiver can find a destination for the message and receive every block,
+ * including the first, directly into it.
+ */
+struct message_header {
+    uint64_t message_size;
+    // The block size of the message is the group's block size >> block_size_shift
+    uint8_t block_size_shift;
+    // The number of the message in its group, as a consistency check
+    uint32_t message_number;
+    // The first min(message_size, MESSAGE_PREFIX_SIZE) bytes of the message
+    uint8_t prefix[rdmc::MESSAGE_PREFIX_SIZE];
+};
+
+constexpr uint8_t MAX_BLOCK_SIZE_SHIFT = 15;
+
+/*
+ * Immediate values of ready_for_block messages: a receiver that is waiting
+ * for a new message asks its first-block sender for the message's header.
+ */
+constexpr uint32_t READY_FOR_BLOCK = 0;
+constexpr uint32_t READY_FOR_HEADER = 1;
+
+/*
+ * Immediate values of the control messages of a multi-root group, which are
+ * sent on the ready_for_block connections. A member announces each header or
+ * block it has for a neighbor, and the neighbor answers with a ready once it
+ * has posted a receive for it. The root is the sender of the message the
+ * header or block belongs to.
+ */
+enum class control_type : uint8_t {
+    announce_block = 0,
+    announce_header = 1,
+    ready_for_block = 2,
+    ready_for_header = 3
+};
+constexpr uint32_t MAX_CONTROL_ROOT = 0x3fff;
+
+struct ParsedControl {
+    control_type type;
+    uint16_t root;
+    uint16_t block_number;
+};
+
+inline ParsedControl parse_control(uint32_t imm) {
+    return ParsedControl{(control_type)(imm >> 30), (uint16_t)((imm >> 16) & MAX_CONTROL_ROOT),
+                         (uint16_t)(imm & 0x0000ffff)};
+}
+inline uint32_t form_control(control_type type, uint16_t root, uint16_t block_number) {
+    return ((uint32_t)type) << 30 | ((uint32_t)root & MAX_CONTROL_ROOT) << 16 | (uint32_t)block_number;
+}
+
 /**
  * @endcond
  */
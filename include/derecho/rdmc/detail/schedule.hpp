@@ -6,6 +6,7 @@
 #include <cmath>
 #include <cstdint>
 #include <optional>
+#include <string>
 #include <vector>
 
 using std::vector;
@@ -107,4 +108,46 @@ public:
     size_t get_total_steps(size_t num_blocks) const;
 };
 
+/**
+ * A chain through the members ordered by where they run, so that each block
+ * stays within a host until every member on that host has it, then within a
+ * rack, and crosses every host and rack boundary only once. Each member's
+ * location is a path from the widest level to the narrowest, separated by
+ * '/' (for example "rack1/host3"); members with an empty location are not
+ * assumed to share anything with the others.
+ */
+class topology_schedule : public schedule {
+private:
+    // The members in the order blocks flow through them, and the position of
+    // each member in that order
+    const vector<uint32_t> chain_order;
+    const vector<uint32_t> chain_positions;
+    const chain_schedule chain;
+
+    optional<block_transfer> from_chain(optional<block_transfer> transfer) const;
+
+public:
+    /**
+     * @param members The number of members in the group
+     * @param index This member's index in the group
+     * @param member_locations The location of each member of the group
+     */
+    topology_schedule(uint32_t members, uint32_t index,
+                      const vector<std::string>& member_locations);
+
+    /**
+     * Orders the members of a group so that members whose locations share a
+     * longer prefix are next to each other. Member 0 comes first, followed by
+     * the other members of its narrowest location, and ties are broken by
+     * member index.
+     */
+    static vector<uint32_t> order_by_location(const vector<std::string>& member_locations);
+
+    vector<uint32_t> get_connections() const;
+    optional<block_transfer> get_outgoing_transfer(size_t num_blocks, size_t send_step) const;
+    optional<block_transfer> get_incoming_transfer(size_t num_blocks, size_t receive_step) const;
+    optional<block_transfer> get_first_block(size_t num_blocks) const;
+    size_t get_total_steps(size_t num_blocks) const;
+};
+
 #endif /* SCHEDULE_HPP */
@@ -4,6 +4,7 @@
 
 #include <derecho/config.h>
 #include <derecho/rdmc/rdmc.hpp>
+#include "detail/message.hpp"
 #include "detail/schedule.hpp"
 
 #ifdef USE_VERBS_API
@@ -13,6 +14,8 @@
 #endif
 
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <optional>
 #include <map>
 #include <memory>
@@ -22,6 +25,8 @@
 
 using rdmc::completion_callback_t;
 using rdmc::incoming_message_callback_t;
+using rdmc::multi_root_completion_callback_t;
+using rdmc::multi_root_incoming_message_callback_t;
 using std::map;
 using std::unique_ptr;
 using std::vector;
@@ -29,62 +34,121 @@ using std::optional;
 
 class group {
 protected:
-    const vector<uint32_t> members;  // first element is the sender
+    const vector<uint32_t> members;  // for a polling_group, the first element is the sender
     const uint16_t group_number;
     const size_t block_size;
     const uint32_t num_members;
     const uint32_t member_index;  // our index in the members list
 
-    const unique_ptr<schedule> transfer_schedule;
-
     std::mutex monitor;
 
-    std::shared_ptr<rdma::memory_region> mr;
-    size_t mr_offset;
-    size_t message_size;
-    size_t num_blocks;
+    // The number of messages that each sender may have in progress at once
+    const size_t max_in_flight;
 
-    completion_callback_t completion_callback;
-    incoming_message_callback_t incoming_message_upcall;
+    // Parameters of the model used to pick the block size of each message
+    const bool adaptive_block_size;
+    const size_t min_block_size;
+    const double block_overhead_us;
+    const double link_bytes_per_us;
+
+    static struct {
+        rdma::message_type header;
+        rdma::message_type data_block;
+        rdma::message_type ready_for_block;
+    } message_types;
 
     group(uint16_t group_number, size_t block_size,
-          vector<uint32_t> members, uint32_t member_index,
-          incoming_message_callback_t upcall,
-          completion_callback_t callback,
-          unique_ptr<schedule> transfer_schedule);
+          vector<uint32_t> members, uint32_t member_index);
+
+    uint8_t choose_block_size_shift(const schedule& transfer_schedule, size_t length) const;
 
 public:
+    static void initialize_message_types();
+
     virtual ~group();
 
-    virtual void receive_block(uint32_t send_imm, size_t size) = 0;
-    virtual void receive_ready_for_block(uint32_t step, uint32_t sender) = 0;
+    virtual void receive_header(uint32_t sender) = 0;
+    virtual void receive_block(uint32_t sender, uint32_t send_imm, size_t size) = 0;
+    virtual void receive_ready_for_block(uint32_t immediate, uint32_t sender) = 0;
+    virtual void complete_header_send(uint32_t target) = 0;
     virtual void complete_block_send() = 0;
     virtual void send_message(std::shared_ptr<rdma::memory_region> message_mr,
                               size_t offset, size_t length)
             = 0;
+    virtual rdmc::group_resources get_resources() = 0;
 };
 
 class polling_group : public group {
 private:
+    const unique_ptr<schedule> transfer_schedule;
+
+    completion_callback_t completion_callback;
+    incoming_message_callback_t incoming_message_upcall;
+
+    // The state of one message that this node is receiving, forwarding or
+    // sending.
+    struct message_state {
+        size_t message_number;
+        std::shared_ptr<rdma::memory_region> mr;
+        size_t mr_offset;
+        size_t message_size;
+        size_t num_blocks;
+        // The block size of the message, which is block_size >> block_size_shift
+        size_t message_block_size;
+        uint8_t block_size_shift;
+        size_t first_block_number = 0;
+
+        // Blocks received so far, the step of the receive schedule we are
+        // on, and the block we expect to receive next.
+        vector<bool> received_blocks;
+        size_t num_received_blocks = 0;
+        size_t receive_step = 0;
+        size_t incoming_block;
+
+        size_t send_step = 0;  // Number of blocks sent/stalls so far
+    };
+    struct completed_message {
+        std::shared_ptr<rdma::memory_region> mr;
+        size_t offset;
+        size_t size;
+    };
+
+    // Messages that have not completed yet, oldest first, at most
+    // max_in_flight of them. Messages are received and sent in order: a
+    // node can receive one message while it is still forwarding the blocks
+    // of earlier ones, but all the transfers of a message on a connection
+    // come before those of the next message, so only the newest one can
+    // still be receiving blocks.
+    std::deque<message_state> messages;
+    // The number that will be assigned to the next message sent or received
+    size_t next_message_number = 0;
+    // The number of the message whose blocks we are sending; every earlier
+    // message has been completely sent.
+    size_t sending_message_number = 0;
+    // Messages that completed, whose completion callbacks must be called
+    // once the monitor is released
+    vector<completed_message> completed_messages;
+
     // Set of receivers who are ready to receive the next block from us.
     std::set<uint32_t> receivers_ready;
+    // Receivers waiting for the header of their next message from us, and
+    // for each receiver that gets its first block from us, the number of the
+    // next message whose header it needs.
+    std::set<uint32_t> receivers_awaiting_header;
+    map<uint32_t, size_t> next_header_numbers;
+    // Whether we have asked for the header of the next message and not yet
+    // received it
+    bool header_requested = false;
 
-    unique_ptr<rdma::memory_region> first_block_mr;
-    optional<size_t> first_block_number;
-    unique_ptr<uint8_t[]> first_block_buffer;
-
-    size_t incoming_block;
-    size_t message_number = 0;
+    // The header of the message being received, and the headers of the
+    // messages being sent or forwarded, one slot per message in flight
+    message_header incoming_header;
+    vector<message_header> outgoing_headers;
+    unique_ptr<rdma::memory_region> incoming_header_mr;
+    unique_ptr<rdma::memory_region> outgoing_headers_mr;
 
     size_t outgoing_block;
     bool sending = false;  // Whether a block send is in progress
-    size_t send_step = 0;  // Number of blocks sent/stalls so far
-
-    // Total number of blocks received and the number of chunks
-    // received for ecah block, respectively.
-    size_t num_received_blocks = 0;
-    size_t receive_step = 0;
-    vector<bool> received_blocks;
 
     // maps from member_indices to the queue pairs
 #ifdef USE_VERBS_API
@@ -94,34 +158,197 @@ private:
     map<size_t, rdma::endpoint> endpoints;
     map<size_t, rdma::endpoint> rfb_endpoints;
 #endif
-    static struct {
-        rdma::message_type data_block;
-        rdma::message_type ready_for_block;
-    } message_types;
 
 public:
-    static void initialize_message_types();
-
     polling_group(uint16_t group_number, size_t block_size,
                   vector<uint32_t> members, uint32_t member_index,
                   incoming_message_callback_t upcall,
                   completion_callback_t callback,
                   unique_ptr<schedule> transfer_schedule);
 
-    virtual void receive_block(uint32_t send_imm, size_t size);
-    virtual void receive_ready_for_block(uint32_t step, uint32_t sender);
+    virtual void receive_header(uint32_t sender);
+    virtual void receive_block(uint32_t sender, uint32_t send_imm, size_t size);
+    virtual void receive_ready_for_block(uint32_t immediate, uint32_t sender);
+    virtual void complete_header_send(uint32_t target);
     virtual void complete_block_send();
 
     virtual void send_message(std::shared_ptr<rdma::memory_region> message_mr,
                               size_t offset, size_t length);
+    virtual rdmc::group_resources get_resources();
 
 private:
-    void post_recv(schedule::block_transfer transfer);
+    message_state& get_message(size_t message_number);
+    void request_header();
+    void send_headers();
+    void post_recv(const message_state& message, schedule::block_transfer transfer);
     void send_next_block();
-    void complete_message();
-    void prepare_for_next_message();
-    void send_ready_for_block(uint32_t neighbor);
+    void complete_messages();
+    void call_completion_callbacks(std::unique_lock<std::mutex>& lock);
+    void send_ready_for_block(uint32_t neighbor, uint32_t immediate = READY_FOR_BLOCK);
     void connect(uint32_t neighbor);
 };
 
+/**
+ * A group in which every member can send. The messages of each sender (their
+ * root) follow the schedule of a polling_group whose member list is rotated
+ * to start at the root, but all the roots share one pair of connections to
+ * each neighbor. Since the transfers of different roots interleave on a
+ * connection, a member never waits on a neighbor for a block the neighbor
+ * does not have yet: the neighbor announces each header or block as soon as
+ * it can send it, the member posts a receive for it and answers with a
+ * ready, and the neighbor makes its sends in the order the readies arrive.
+ * The receives on each connection are therefore posted in the same order as
+ * the sends, and every block lands directly in its destination.
+ */
+class multi_root_group : public group {
+public:
+    // Makes the schedule of a member for the messages of a root, given the
+    // member's index in the member list rotated to start at the root
+    typedef std::function<unique_ptr<schedule>(uint32_t root, uint32_t rotated_index)> schedule_factory_t;
+
+private:
+    // The number of blocks of one root that we may have announced to a
+    // neighbor and not yet finished sending to it
+    static constexpr uint32_t MAX_ANNOUNCED_BLOCKS = 2;
+
+    struct message_state {
+        size_t message_number;
+        std::shared_ptr<rdma::memory_region> mr;
+        size_t mr_offset;
+        size_t message_size;
+        size_t num_blocks;
+        // The block size of the message, which is block_size >> block_size_shift
+        size_t message_block_size;
+
+        // For each block, the member we receive it from and whether that
+        // member has announced it yet. Empty for our own messages.
+        vector<uint32_t> block_sources;
+        vector<bool> announced_blocks;
+        vector<bool> received_blocks;
+        size_t num_received_blocks = 0;
+
+        // The next step of the send schedule to announce
+        size_t send_step = 0;
+        // Header and block sends of this message that have not completed
+        size_t sends_remaining = 0;
+    };
+    // Our state for the messages of one root
+    struct root_state {
+        // Our schedule for this root's messages
+        unique_ptr<schedule> transfer_schedule;
+        // The member we get the headers of this root's messages from, and the
+        // members that get them from us
+        uint32_t header_source;
+        vector<uint32_t> header_children;
+
+        // Messages that have not completed yet, oldest first, at most
+        // max_in_flight of them
+        std::deque<message_state> messages;
+        size_t next_message_number = 0;
+        // The message whose sends we are announcing; every earlier message has
+        // had all its sends announced
+        size_t announcing_message_number = 0;
+
+        // Whether the header source announced a header that we have not
+        // posted a receive for yet, and whether a header receive is posted
+        bool header_announced = false;
+        bool header_receive_posted = false;
+        // Block announcements from each neighbor that we could not match to
+        // a message yet, because the message's header has not arrived
+        map<uint32_t, std::deque<uint16_t>> unmatched_announcements;
+
+        // For each header child, the number of the next header to send it,
+        // and the children whose ready for it we are waiting for
+        map<uint32_t, size_t> next_header_numbers;
+        std::set<uint32_t> header_announcements_outstanding;
+        // For each target, the blocks we have announced and not finished sending
+        map<uint32_t, uint32_t> announced_blocks;
+    };
+    // A header or block on its way between us and a neighbor
+    struct pending_transfer {
+        uint32_t root;
+        size_t message_number;
+        uint32_t neighbor;
+        // The block, or none for the message's header
+        optional<uint16_t> block_number;
+    };
+    struct completed_message {
+        uint32_t root;
+        std::shared_ptr<rdma::memory_region> mr;
+        size_t offset;
+        size_t size;
+    };
+
+    multi_root_completion_callback_t completion_callback;
+    multi_root_incoming_message_callback_t incoming_message_upcall;
+
+    // Indexed by root
+    vector<root_state> roots;
+
+    // Blocks we announced to each neighbor and have no ready for yet
+    map<uint32_t, std::deque<pending_transfer>> announced_sends;
+    // Sends that their targets are ready for, in the order the readies arrived
+    std::deque<pending_transfer> ready_sends;
+    // The send in progress, if any
+    optional<pending_transfer> current_send;
+    // The receives posted on each neighbor's connection, in the order they
+    // were posted
+    map<uint32_t, std::deque<pending_transfer>> posted_receives;
+
+    vector<completed_message> completed_messages;
+
+    // One header slot per root for receiving, and max_in_flight slots per
+    // root for the headers being sent or forwarded
+    vector<message_header> incoming_headers;
+    vector<message_header> outgoing_headers;
+    unique_ptr<rdma::memory_region> incoming_headers_mr;
+    unique_ptr<rdma::memory_region> outgoing_headers_mr;
+
+    // maps from member_indices to the queue pairs
+#ifdef USE_VERBS_API
+    map<size_t, rdma::queue_pair> queue_pairs;
+    map<size_t, rdma::queue_pair> rfb_queue_pairs;
+#else
+    map<size_t, rdma::endpoint> endpoints;
+    map<size_t, rdma::endpoint> rfb_endpoints;
+#endif
+
+public:
+    multi_root_group(uint16_t group_number, size_t block_size,
+                     vector<uint32_t> members, uint32_t member_index,
+                     multi_root_incoming_message_callback_t upcall,
+                     multi_root_completion_callback_t callback,
+                     const schedule_factory_t& make_schedule);
+
+    virtual void receive_header(uint32_t sender);
+    virtual void receive_block(uint32_t sender, uint32_t send_imm, size_t size);
+    virtual void receive_ready_for_block(uint32_t immediate, uint32_t sender);
+    virtual void complete_header_send(uint32_t target);
+    virtual void complete_block_send();
+
+    virtual void send_message(std::shared_ptr<rdma::memory_region> message_mr,
+                              size_t offset, size_t length);
+    virtual rdmc::group_resources get_resources();
+
+private:
+    // Converts between member indices and indices in the member list rotated
+    // to start at a root, which is what each root's schedule uses
+    uint32_t to_member(uint32_t root, uint32_t rotated_index) const;
+    uint32_t to_rotated(uint32_t root, uint32_t member) const;
+
+    message_state& get_message(root_state& root, size_t message_number);
+    message_state& add_message(uint32_t root, const message_header& header);
+    void accept_header(uint32_t root);
+    void announce_headers(uint32_t root);
+    void announce_blocks(uint32_t root);
+    void match_announcements(uint32_t root, uint32_t sender);
+    void send_next();
+    void complete_send();
+    void complete_messages(uint32_t root);
+    void call_completion_callbacks(std::unique_lock<std::mutex>& lock);
+    void post_recv(const message_state& message, uint32_t sender, uint32_t root, uint16_t block_number);
+    void send_control(uint32_t neighbor, control_type type, uint32_t root, uint16_t block_number = 0);
+    void connect(uint32_t neighbor, uint32_t num_roots);
+};
+
 #endif /* GROUP_SEND_HPP */
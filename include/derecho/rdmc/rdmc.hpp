@@ -34,7 +34,8 @@ enum send_algorithm {
     BINOMIAL_SEND = 1,
     CHAIN_SEND = 2,
     SEQUENTIAL_SEND = 3,
-    TREE_SEND = 4
+    TREE_SEND = 4,
+    TOPOLOGY_SEND = 5
 };
 
 struct receive_destination {
@@ -42,11 +43,33 @@ struct receive_destination {
     size_t offset;
 };
 
-typedef std::function<receive_destination(size_t size)>
+/**
+ * The number of bytes at the start of each message that are sent to its
+ * receivers with the message's header, so that they can choose where to
+ * receive the message based on its contents.
+ */
+constexpr size_t MESSAGE_PREFIX_SIZE = 128;
+
+/**
+ * The function a group calls when a new message arrives, with the message's
+ * size and its first min(size, MESSAGE_PREFIX_SIZE) bytes. It must return a
+ * registered destination that can hold size bytes.
+ */
+typedef std::function<receive_destination(size_t size, const uint8_t* prefix)>
         incoming_message_callback_t;
 typedef std::function<void(uint8_t* buffer, size_t size)> completion_callback_t;
 typedef std::function<void(std::optional<uint32_t> suspected_victim)>
         failure_callback_t;
+typedef std::function<receive_destination(uint32_t root, size_t size, const uint8_t* prefix)>
+        multi_root_incoming_message_callback_t;
+typedef std::function<void(uint32_t root, uint8_t* buffer, size_t size)>
+        multi_root_completion_callback_t;
+
+/** The connections and registered memory held by one RDMC group. */
+struct group_resources {
+    size_t num_connections = 0;
+    size_t registered_bytes = 0;
+};
 
 bool initialize(const std::map<uint32_t, std::pair<ip_addr_t, uint16_t>>& addresses,
                 uint32_t node_rank) __attribute__((warn_unused_result));
@@ -59,11 +82,12 @@ void shutdown();
  * @param members A vector of node IDs representing the members of this group.
  * The order of this vector will be used as the rank order of the members.
  * @param block_size The size, in bytes, of blocks to use when sending in this
- * group.
+ * group. If DERECHO/rdmc_adaptive_block_size is enabled, this is the largest
+ * block size, and each message may use a smaller one that divides it.
  * @param algorithm Which RDMC send algorithm to use in this group.
  * @param incoming_receive The function to call when there is a new incoming
- * message in this group; it must provide a destination to receive the message
- * into.
+ * message in this group, with the message's size and its first bytes; it must
+ * provide a destination to receive the message into.
  * @param send_callback The function to call when RDMC completes receiving a
  * message in this group
  * @param failure_callback The function to call when RDMC detects a failure in
@@ -76,8 +100,48 @@ bool create_group(uint16_t group_number, std::vector<uint32_t> members,
                   completion_callback_t send_callback,
                   failure_callback_t failure_callback)
         __attribute__((warn_unused_result));
+/**
+ * Creates a new RDMC group in which every member can send. Unlike a group
+ * created with create_group, whose first member is its only sender, all the
+ * senders share one set of connections and buffers, and the schedule of each
+ * sender's messages is that of a group rotated to start at the sender.
+ * @param group_number The group's unique identifier.
+ * @param members A vector of node IDs representing the members of this group.
+ * @param block_size The size, in bytes, of blocks to use when sending in this
+ * group, as for create_group.
+ * @param algorithm Which RDMC send algorithm to use for each sender's messages.
+ * @param incoming_receive The function to call when there is a new incoming
+ * message in this group; it is given the index in members of the message's
+ * sender, the message's size and its first bytes, and must provide a
+ * destination to receive the message into.
+ * @param send_callback The function to call when RDMC completes receiving (or
+ * sending) a message in this group, with the index of the message's sender.
+ * @param failure_callback The function to call when RDMC detects a failure in
+ * this group.
+ * @return True if group creation succeeds, false if it fails.
+ */
+bool create_multi_root_group(uint16_t group_number, std::vector<uint32_t> members,
+                             size_t block_size, send_algorithm algorithm,
+                             multi_root_incoming_message_callback_t incoming_receive,
+                             multi_root_completion_callback_t send_callback,
+                             failure_callback_t failure_callback)
+        __attribute__((warn_unused_result));
 void destroy_group(uint16_t group_number);
+/**
+ * @return The connections and registered memory that a group holds on this
+ * node, or all zeros if there is no such group.
+ */
+group_resources get_group_resources(uint16_t group_number);
 
+/**
+ * Sends a message in a group of which this node is the root, or in a
+ * multi-root group of which it is a member. Up to
+ * DERECHO/rdmc_max_in_flight_messages messages from this node may be in
+ * flight in a group at once, and they are delivered in the order they were
+ * sent; sending another throws group_busy. The memory must stay valid until
+ * the group's completion callback is called for the message.
+ * @return False if RDMC is shut down or the group does not exist.
+ */
 bool send(uint16_t group_number, std::shared_ptr<rdma::memory_region> mr,
           size_t offset, size_t length) __attribute__((warn_unused_result));
 
@@ -13,6 +13,7 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
 #include <rdma/fabric.h>
 #include <rdma/fi_errno.h>
 #include <thread>
@@ -36,6 +37,7 @@ class lf_completion_entry_ctxt {
 private:
     uint32_t    _ce_idx;     // index into the comepletion entry vector. - 0xFFFFFFFF for invalid
     uint32_t    _remote_id;  // thread id of the sender
+    uint64_t    _seq;        // sequence number of the operation it was posted with, 0 if untagged
     /**
      * @brief Managed flag
      * There two kinds of completion contexts:
@@ -52,6 +54,7 @@ public:
     lf_completion_entry_ctxt(bool managed = true):
         _ce_idx(0xffffffff),
         _remote_id(0xffffffff),
+        _seq(0),
         _managed(managed) {}
 
     // getters and setters
@@ -59,9 +62,26 @@ public:
     inline uint32_t remote_id() { return _remote_id; }
     inline void set_ce_idx(const uint32_t& idx) { _ce_idx = idx; }
     inline void set_remote_id(const uint32_t& rid) { _remote_id = rid; }
+    inline uint64_t seq() { return _seq; }
+    inline void set_seq(const uint64_t& seq) { _seq = seq; }
     inline bool is_managed() { return _managed; }
 };
 
+/**
+ * A connected LibFabric endpoint and its event queue, which are closed when
+ * this is destroyed. Resources that share one can keep using the connection
+ * after the resources that created it are gone.
+ */
+struct lf_connection {
+    struct fid_ep* const ep;
+    struct fid_eq* const eq;
+    lf_connection(struct fid_ep* ep, struct fid_eq* eq) : ep(ep), eq(eq) {}
+    lf_connection(const lf_connection&) = delete;
+    ~lf_connection();
+};
+
+struct cm_con_data_t;
+
 /**
  * Represents the set of RDMA resources needed to maintain a two-way connection
  * to a single remote node.
@@ -75,6 +95,41 @@ private:
      *     side. Otherwise, it initiate a connection to remote side.
      */
     void connect_endpoint(bool is_lf_server);
+    /**
+     * Exchanges connection management info with the remote node over the
+     * SST's TCP connection, including the key and address of each side's
+     * write buffer, and records the remote buffer's key and address.
+     *
+     * @param remote_cm_data Set to the info received from the remote node
+     */
+    void exchange_connection_info(struct cm_con_data_t& remote_cm_data);
+    /**
+     * Registers the write and read buffers with the domain, reusing the
+     * registration of a buffer that is already registered.
+     *
+     * @param size_w The size of the write buffer (in bytes).
+     * @param size_r The size of the read buffer (in bytes).
+     */
+    void register_buffers(int size_w, int size_r);
+    /**
+     * A registration in the registration cache and the number of resources
+     * using it.
+     */
+    struct cached_mr_t {
+        struct fid_mr* mr;
+        uint32_t ref_count;
+    };
+    /**
+     * The registration cache. Every resources of an SST uses the local row as
+     * its read buffer, so caching registrations by address and size registers
+     * that row once per SST instead of once per remote node.
+     */
+    static std::mutex mr_cache_mutex;
+    static std::map<std::pair<uint8_t*, size_t>, cached_mr_t> mr_cache;
+    /** Gets a registration of the given buffer, registering it if it is not in the cache. */
+    static struct fid_mr* acquire_cached_mr(uint8_t* buf, size_t size);
+    /** Releases a registration from acquire_cached_mr, deregistering it once no resources use it. */
+    static void release_cached_mr(struct fid_mr* mr);
     /** Initialize resource endpoint using fi_info
      *
      * @param fi The fi_info object
@@ -127,6 +182,8 @@ public:
     fi_addr_t remote_fi_addr;
     /** the event queue */
     struct fid_eq* eq;
+    /** Owns ep and eq, and may be shared with the resources of a later SST */
+    std::shared_ptr<lf_connection> connection;
 
     /**
      * Out-of-Band memory and send management
@@ -305,6 +362,24 @@ public:
      */
     _resources(int r_id, uint8_t* write_addr, uint8_t* read_addr, int size_w,
                int size_r, int is_lf_server);
+    /**
+     * Constructor
+     * Initializes the resources for new read and write buffers, but reuses the
+     * endpoint of existing resources connected to the same remote node instead
+     * of connecting a new one. Only the new buffers' keys and addresses are
+     * exchanged with the remote node, which must construct its resources for
+     * this node the same way.
+     *
+     * @param r_id The node id of the remote node.
+     * @param write_addr A pointer to the memory to use as the write buffer.
+     * @param read_addr A pointer to the memory to use as the read buffer.
+     * @param size_w The size of the write buffer (in bytes).
+     * @param size_r The size of the read buffer (in bytes).
+     * @param connected_resources Resources already connected to node r_id,
+     *        whose endpoint these resources will share.
+     */
+    _resources(int r_id, uint8_t* write_addr, uint8_t* read_addr, int size_w,
+               int size_r, const _resources& connected_resources);
     /** Destroys the resources. */
     virtual ~_resources();
 };
@@ -319,6 +394,11 @@ public:
     resources(int r_id, uint8_t* write_addr, uint8_t* read_addr, int size_w,
               int size_r, int is_lf_server) : _resources(r_id, write_addr, read_addr, size_w, size_r, is_lf_server) {
     }
+    /** Constructor: simply forwards to _resources::_resources, reusing a connection */
+    resources(int r_id, uint8_t* write_addr, uint8_t* read_addr, int size_w,
+              int size_r, const resources& connected_resources)
+            : _resources(r_id, write_addr, read_addr, size_w, size_r, connected_resources) {
+    }
     /**
      * Report that the remote node this object is connected to has failed.
      * This will cause all future remote operations to be no-ops.
@@ -409,9 +489,10 @@ void lf_initialize(const std::map<uint32_t, std::pair<ip_addr_t, uint16_t>>& int
                    const std::map<uint32_t, std::pair<ip_addr_t, uint16_t>>& external_ip_addrs_and_ports,
                    uint32_t node_id);
 /** Polls for completion of a single posted remote write.
+ * @param seq If not null, set to the sequence number of the completed operation's context
  * @return a pair: <completion_entry_index,<remote_id,result(1/0)>>
  */
-std::pair<uint32_t, std::pair<int32_t, int32_t>> lf_poll_completion();
+std::pair<uint32_t, std::pair<int32_t, int32_t>> lf_poll_completion(uint64_t* seq = nullptr);
 /** Shutdown the polling thread. */
 void shutdown_polling_thread();
 /** Destroys the global libfabric resources. */
@@ -12,18 +12,23 @@
 namespace sst {
 namespace util {
 class PollingData {
-    // map:node_id->[list of return values]
-    std::vector<std::map<int32_t, std::list<int32_t>>> completion_entries;
+    // map:node_id->[list of (return value, sequence number)]
+    std::vector<std::map<int32_t, std::list<std::pair<int32_t, uint64_t>>>> completion_entries;
     std::map<std::thread::id, uint32_t> tid_to_index;
     std::vector<bool> if_waiting;
     std::condition_variable poll_cv;
     std::mutex poll_mutex;
     bool check_waiting();
 public:
-    void insert_completion_entry(uint32_t index, std::pair<int32_t, int32_t> ce);
+    void insert_completion_entry(uint32_t index, std::pair<int32_t, int32_t> ce, uint64_t seq = 0);
 
     // std::optional<std::pair<int32_t, int32_t>> get_completion_entry(const std::thread::id id);
-    std::optional<int32_t> get_completion_entry(const std::thread::id tid, const int nid);
+    /**
+     * Pops the next completion entry for node nid. If seq is not 0, entries
+     * tagged with a lower sequence number are completions of operations the
+     * caller has already given up on, so they are discarded first.
+     */
+    std::optional<int32_t> get_completion_entry(const std::thread::id tid, const int nid, uint64_t seq = 0);
 
     uint32_t get_index(const std::thread::id id);
 
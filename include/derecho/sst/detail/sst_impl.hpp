@@ -34,10 +34,6 @@ SST<DerivedSST>::~SST() {
     for(auto& thread : background_threads) {
         if(thread.joinable()) thread.join();
     }
-
-    if(rows != nullptr) {
-        delete[](const_cast<uint8_t*>(rows));
-    }
 }
 
 /**
@@ -155,6 +151,15 @@ void SST<DerivedSST>::put(const std::vector<uint32_t> receiver_ranks, size_t off
 
 template <typename DerivedSST>
 void SST<DerivedSST>::put_with_completion(const std::vector<uint32_t> receiver_ranks, size_t offset, size_t size) {
+    for(auto index : try_put_with_completion(receiver_ranks, offset, size)) {
+        freeze(index);
+    }
+}
+
+template <typename DerivedSST>
+std::vector<uint32_t> SST<DerivedSST>::try_put_with_completion(const std::vector<uint32_t> receiver_ranks,
+                                                               size_t offset, size_t size,
+                                                               std::vector<uint32_t>* acknowledged_ranks) {
     assert(offset + size <= rowLen);
     unsigned int num_writes_posted = 0;
     std::vector<bool> posted_write_to(num_members, false);
@@ -164,28 +169,35 @@ void SST<DerivedSST>::put_with_completion(const std::vector<uint32_t> receiver_r
     uint32_t ce_idx = util::polling_data.get_index(tid);
 
     util::polling_data.set_waiting(tid);
-#ifdef USE_VERBS_API
-    verbs_sender_ctxt ce_ctxt[receiver_ranks.size()];
-#else
-    lf_completion_entry_ctxt ce_ctxt[receiver_ranks.size()];
-#endif
+    // A write that timed out can still complete after this function has
+    // returned, so each write gets its own context, which the polling thread
+    // deletes when the write completes. Each write is also tagged with a
+    // sequence number, so that the late completion of a write that timed out
+    // is not taken for the completion of a later write to the same row.
+    thread_local uint64_t last_write_seq = 0;
+    std::vector<uint64_t> write_seq(num_members, 0);
     for(auto index : receiver_ranks) {
         // don't write to yourself or a frozen row
         if(index == my_index || row_is_frozen[index]) {
             continue;
         }
         // perform a remote RDMA write on the owner of the row
-        ce_ctxt[index].set_remote_id(res_vec[index]->remote_id);
-        ce_ctxt[index].set_ce_idx(ce_idx);
-        res_vec[index]->post_remote_write_with_completion(&ce_ctxt[index], offset, size);
+#ifdef USE_VERBS_API
+        verbs_sender_ctxt* ce_ctxt = new verbs_sender_ctxt(false);
+#else
+        lf_completion_entry_ctxt* ce_ctxt = new lf_completion_entry_ctxt(false);
+#endif
+        write_seq[index] = ++last_write_seq;
+        ce_ctxt->set_remote_id(res_vec[index]->remote_id);
+        ce_ctxt->set_ce_idx(ce_idx);
+        ce_ctxt->set_seq(write_seq[index]);
+        res_vec[index]->post_remote_write_with_completion(ce_ctxt, offset, size);
         posted_write_to[index] = true;
         num_writes_posted++;
     }
 
-    // track which nodes respond successfully
-    std::vector<bool> polled_successfully_from(num_members, false);
-
     std::vector<uint32_t> failed_node_indexes;
+    std::vector<uint32_t> timed_out_node_indexes;
 
     unsigned long start_time_msec;
     unsigned long cur_time_msec;
@@ -203,7 +215,7 @@ void SST<DerivedSST>::put_with_completion(const std::vector<uint32_t> receiver_r
         }
         std::optional<int32_t> result;
         while(true) {
-            result = util::polling_data.get_completion_entry(tid,res_vec[index]->remote_id);
+            result = util::polling_data.get_completion_entry(tid, res_vec[index]->remote_id, write_seq[index]);
             if (result) {
                 break;
             }
@@ -213,8 +225,12 @@ void SST<DerivedSST>::put_with_completion(const std::vector<uint32_t> receiver_r
                 break;
             }
         }
-        if (result && result.value() == 1) {
-            polled_successfully_from[index] = true;
+        if(!result) {
+            timed_out_node_indexes.push_back(index);
+        } else if(result.value() == 1) {
+            if(acknowledged_ranks) {
+                acknowledged_ranks->push_back(index);
+            }
         } else {
             failed_node_indexes.push_back(index);
         }
@@ -225,6 +241,7 @@ void SST<DerivedSST>::put_with_completion(const std::vector<uint32_t> receiver_r
     for(auto index : failed_node_indexes) {
         freeze(index);
     }
+    return timed_out_node_indexes;
 }
 
 template <typename DerivedSST>
@@ -269,6 +286,18 @@ void SST<DerivedSST>::sync_with_members() const {
     }
 }
 
+template <typename DerivedSST>
+std::map<uint32_t, const resources*> SST<DerivedSST>::get_connections() {
+    std::lock_guard<std::mutex> lock(freeze_mutex);
+    std::map<uint32_t, const resources*> connections;
+    for(uint32_t row_index = 0; row_index < num_members; ++row_index) {
+        if(row_index != my_index && !row_is_frozen[row_index] && res_vec[row_index]) {
+            connections.emplace(members[row_index], res_vec[row_index].get());
+        }
+    }
+    return connections;
+}
+
 /**
  * Same as before but syncs with only a subset of the members
  */
@@ -55,14 +55,22 @@ struct verbs_sender_ctxt {
         struct {
             uint32_t remote_id;  // id of the remote node
             uint32_t ce_idx;     // index into the completion entry list
+            uint64_t seq;        // sequence number of the operation it was posted with, 0 if untagged
         } sender_info;
     } ctxt;
+    // if false, the context was allocated with new and the polling thread deletes it on completion
+    bool managed;
+
+    verbs_sender_ctxt(bool managed = true) : ctxt{}, managed(managed) {}
     // getters
     uint32_t remote_id() { return ctxt.sender_info.remote_id; }
     uint32_t ce_idx() { return ctxt.sender_info.ce_idx; }
+    uint64_t seq() { return ctxt.sender_info.seq; }
+    bool is_managed() { return managed; }
     // setters
     void set_remote_id(const uint32_t& rid) { ctxt.sender_info.remote_id = rid; }
     void set_ce_idx(const uint32_t& cidx) { ctxt.sender_info.ce_idx = cidx; }
+    void set_seq(const uint64_t& seq) { ctxt.sender_info.seq = seq; }
 };
 
 /**
@@ -314,8 +322,9 @@ void filter_external_to(const std::vector<derecho::node_id_t>& live_nodes_list);
 void verbs_initialize(const std::map<uint32_t, std::pair<ip_addr_t, uint16_t>>& ip_addrs_and_sst_ports,
                       const std::map<uint32_t, std::pair<ip_addr_t, uint16_t>>& ip_addrs_and_external_ports,
                       uint32_t node_id);
-/** Polls for completion of a single posted remote write. */
-std::pair<uint32_t, std::pair<int, int>> verbs_poll_completion();
+/** Polls for completion of a single posted remote write.
+ * @param seq If not null, set to the sequence number of the completed operation's context */
+std::pair<uint32_t, std::pair<int, int>> verbs_poll_completion(uint64_t* seq = nullptr);
 void shutdown_polling_thread();
 /** Destroys the global verbs resources. */
 void verbs_destroy();
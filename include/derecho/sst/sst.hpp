@@ -3,6 +3,7 @@
 #include <derecho/config.h>
 #include <derecho/conf/conf.hpp>
 #include <derecho/utils/logger.hpp>
+#include <derecho/utils/registered_memory.hpp>
 #include "predicates.hpp"
 
 #ifdef USE_VERBS_API
@@ -18,6 +19,7 @@
 #include <functional>
 #include <iostream>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <numeric>
@@ -135,6 +137,7 @@ struct SSTParams {
     const failure_upcall_t failure_upcall;
     const std::vector<char> already_failed;
     const bool start_predicate_thread;
+    const std::map<uint32_t, const resources*> previous_connections;
 
     /**
      *
@@ -151,17 +154,24 @@ struct SSTParams {
      * should be started immediately on construction of the SST. If false,
      * predicate evaluation will not start until start_predicate_evalution()
      * is called.
+     * @param previous_connections The RDMA resources of a previous SST that is
+     * still alive, indexed by node ID, as returned by its get_connections().
+     * The new SST reuses the connection to each of these nodes instead of
+     * connecting to it again; every one of these nodes must do the same for
+     * this node. Only supported with the LibFabric API; ignored otherwise.
      */
     SSTParams(const std::vector<uint32_t>& _members,
               const uint32_t my_node_id,
               const failure_upcall_t failure_upcall = nullptr,
               const std::vector<char> already_failed = {},
-              const bool start_predicate_thread = true)
+              const bool start_predicate_thread = true,
+              const std::map<uint32_t, const resources*> previous_connections = {})
             : members(_members),
               my_node_id(my_node_id),
               failure_upcall(failure_upcall),
               already_failed(already_failed),
-              start_predicate_thread(start_predicate_thread) {}
+              start_predicate_thread(start_predicate_thread),
+              previous_connections(previous_connections) {}
 };
 
 template <class DerivedSST>
@@ -171,9 +181,8 @@ private:
     void init_SSTFields(Fields&... fields) {
         rowLen = 0;
         compute_rowLen(rowLen, fields...);
-        void* mem_ptr = new uint8_t[rowLen * num_members];
-        memset(mem_ptr, 0, rowLen * num_members);
-        rows = (volatile uint8_t*)mem_ptr;
+        table_memory = derecho::RegisteredMemory(rowLen * num_members, derecho::get_registered_memory_options());
+        rows = (volatile uint8_t*)table_memory.get();
         // snapshot = new uint8_t[rowLen * num_members];
         volatile uint8_t* base = rows;
         set_bases_and_rowLens(base, rowLen, fields...);
@@ -193,6 +202,12 @@ public:
 private:
     /** timeout settings for poll completion queue */
     const uint32_t poll_cq_timeout_ms;
+    /**
+     * The registered memory that holds the SST rows. It is declared before
+     * res_vec so that it is unmapped only after the resources have
+     * deregistered it.
+     */
+    derecho::RegisteredMemory table_memory;
     /** Pointer to memory where the SST rows are stored. */
     volatile uint8_t* rows;
     // uint8_t* snapshot;
@@ -224,6 +239,8 @@ private:
 
     /** RDMA resources vector, one for each member. */
     std::vector<std::unique_ptr<resources>> res_vec;
+    /** Resources of a previous SST whose connections SSTInit should reuse, indexed by node ID. */
+    std::map<uint32_t, const resources*> reusable_connections;
 
     /** Indicates whether the predicate evaluation thread should start after being
      * forked in the constructor. */
@@ -245,6 +262,7 @@ public:
               row_is_frozen(num_members),
               failure_upcall(params.failure_upcall),
               res_vec(num_members),
+              reusable_connections(params.previous_connections),
               thread_start(params.start_predicate_thread) {
         //Figure out my SST index
         my_index = (uint)-1;
@@ -294,13 +312,21 @@ public:
                 res_vec[sst_index] = std::make_unique<resources>(
                         node_rank, write_addr, read_addr, rowLen, rowLen);
 #else  // use libfabric api by default
-                res_vec[sst_index] = std::make_unique<resources>(
-                        node_rank, write_addr, read_addr, rowLen, rowLen, (my_node_id < node_rank));
+                auto reusable_connection = reusable_connections.find(node_rank);
+                if(reusable_connection != reusable_connections.end()) {
+                    res_vec[sst_index] = std::make_unique<resources>(
+                            node_rank, write_addr, read_addr, rowLen, rowLen, *reusable_connection->second);
+                } else {
+                    res_vec[sst_index] = std::make_unique<resources>(
+                            node_rank, write_addr, read_addr, rowLen, rowLen, (my_node_id < node_rank));
+                }
 #endif
                 // update qp_num_to_index
                 // qp_num_to_index[res_vec[sst_index].get()->qp->qp_num] = sst_index;
             }
         }
+        // The previous SST may be destroyed any time after this
+        reusable_connections.clear();
 
         std::thread detector(&SST::detect, this);
         background_threads.push_back(std::move(detector));
@@ -317,6 +343,14 @@ public:
     /** Syncs with a subset of the members */
     void sync_with_members(std::vector<uint32_t> row_indices) const;
 
+    /**
+     * Returns the RDMA resources for each remote member whose row is not
+     * frozen, indexed by node ID, so that an SST constructed for the next set
+     * of members can reuse their connections. The pointers remain valid as
+     * long as this SST exists.
+     */
+    std::map<uint32_t, const resources*> get_connections();
+
     /** Marks a row as frozen, so it will no longer update, and its corresponding
      * node will not receive writes. */
     void freeze(uint32_t row_index);
@@ -408,6 +442,30 @@ public:
 
     void put_with_completion(const std::vector<uint32_t> receiver_ranks, size_t offset, size_t size);
 
+    /**
+     * Writes a contiguous subset of the local row to some of the remote nodes
+     * and waits for the writes to complete, like put_with_completion(), but
+     * only freezes the rows whose write completed with an error. The rows
+     * whose write did not complete before the completion queue timeout are
+     * returned instead, so that the caller can decide whether they failed.
+     * @param receiver_ranks The rows to write to
+     * @param offset The offset of the data to write within the row
+     * @param size The number of bytes to write
+     * @param acknowledged_ranks If not null, the rows whose write completed
+     * successfully are appended to this vector
+     * @return The rows whose write timed out
+     */
+    std::vector<uint32_t> try_put_with_completion(const std::vector<uint32_t> receiver_ranks,
+                                                  size_t offset, size_t size,
+                                                  std::vector<uint32_t>* acknowledged_ranks = nullptr);
+
+    /** Writes a contiguous subset of the local row to all remote nodes and
+     * waits for completion; see the other try_put_with_completion(). */
+    std::vector<uint32_t> try_put_with_completion(size_t offset, size_t size,
+                                                  std::vector<uint32_t>* acknowledged_ranks = nullptr) {
+        return try_put_with_completion(all_indices, offset, size, acknowledged_ranks);
+    }
+
 private:
     using byte_p = volatile uint8_t*;
 
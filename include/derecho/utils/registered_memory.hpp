@@ -0,0 +1,94 @@
+/**
+ * @file registered_memory.hpp
+ *
+ * An allocator for memory that will be registered with the RDMA layer, which
+ * backs large regions with huge pages and can bind them to a NUMA node, and
+ * process-wide accounting of the time spent allocating and registering it.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace derecho {
+
+/** How RegisteredMemory is mapped. */
+struct RegisteredMemoryOptions {
+    /** The largest page size to back memory with; 0 means normal pages only. */
+    std::size_t max_hugepage_size = 0;
+    /** The NUMA node to bind memory to, or -1 to leave its placement to the kernel. */
+    int numa_node = -1;
+};
+
+/**
+ * Reads RegisteredMemoryOptions from DERECHO/registered_memory_hugepages and
+ * DERECHO/registered_memory_numa_node.
+ * @throw derecho_exception if registered_memory_hugepages is not one of none, 2mb or 1gb
+ */
+RegisteredMemoryOptions get_registered_memory_options();
+
+/**
+ * A zero-filled, anonymous memory mapping intended to be registered with the
+ * RDMA layer, which is unmapped when this is destroyed. The pages are faulted
+ * in when it is constructed, so registering it does not have to.
+ *
+ * A region of at least half a huge page is backed by the largest huge page
+ * size allowed by the options for which the system has pages available,
+ * trying 1GB, then 2MB, then normal pages, so that small regions never pin a
+ * mostly empty huge page. If the options name a NUMA node, the mapping is
+ * bound to it before any page is touched; if the binding fails, the memory
+ * is placed by the kernel instead.
+ */
+class RegisteredMemory {
+    uint8_t* base;
+    std::size_t size;
+    std::size_t page_size;
+
+public:
+    /** Constructs an empty RegisteredMemory that owns no mapping. */
+    RegisteredMemory() : base(nullptr), size(0), page_size(0) {}
+    /**
+     * Maps at least size bytes of memory.
+     * @throw derecho_exception if the memory cannot be mapped
+     */
+    RegisteredMemory(std::size_t size, const RegisteredMemoryOptions& options);
+    RegisteredMemory(const RegisteredMemory&) = delete;
+    RegisteredMemory(RegisteredMemory&& other);
+    RegisteredMemory& operator=(const RegisteredMemory&) = delete;
+    RegisteredMemory& operator=(RegisteredMemory&& other);
+    ~RegisteredMemory();
+
+    uint8_t* get() const { return base; }
+    /** @return The size of the mapping, which is rounded up to a whole number of pages. */
+    std::size_t get_size() const { return size; }
+    /** @return The size of the pages backing the mapping. */
+    std::size_t get_page_size() const { return page_size; }
+    bool is_hugepage_backed() const;
+};
+
+/** Process-wide accounting of registered memory, for operators to inspect. */
+struct RegisteredMemoryStats {
+    /** The number of RegisteredMemory mappings made so far, and how many of them used huge pages. */
+    std::size_t num_allocations = 0;
+    std::size_t num_hugepage_allocations = 0;
+    /** Bytes in RegisteredMemory mappings that currently exist. */
+    std::size_t mapped_bytes = 0;
+    /** Time spent mapping and faulting in RegisteredMemory. */
+    std::chrono::nanoseconds allocation_time{0};
+    /** The number of memory registrations made so far, and the time they took. */
+    std::size_t num_registrations = 0;
+    std::chrono::nanoseconds registration_time{0};
+    /** The number of registrations avoided by reusing a cached registration of the same memory. */
+    std::size_t num_registration_cache_hits = 0;
+};
+
+RegisteredMemoryStats get_registered_memory_stats();
+
+/** Adds one memory registration that took the given time to the stats. */
+void record_memory_registration(std::chrono::nanoseconds registration_time);
+
+/** Counts a registration that reused a cached one in the stats. */
+void record_registration_cache_hit();
+
+}  // namespace derecho
@@ -55,7 +55,7 @@ int main(int argc, char *argv[]) {
 
     // create the group
     success = rdmc::create_group(0, members, block_size, type,
-                                 [&mr](size_t length) -> rdmc::receive_destination {
+                                 [&mr](size_t length, const uint8_t *prefix) -> rdmc::receive_destination {
                                      return {mr, 0};
                                  },
                                  [&count](uint8_t *data, size_t size) {
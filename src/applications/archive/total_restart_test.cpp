@@ -6,6 +6,7 @@
  * to test total restart by manually killing all the nodes while it is running,
  * then re-starting them in different orders.
  */
+#include <chrono>
 #include <iostream>
 #include <time.h>
 
@@ -72,6 +73,7 @@ int main(int argc, char** argv) {
     }
 
     derecho::Conf::initialize(argc, argv);
+    const auto start_time = std::chrono::steady_clock::now();
 
     derecho::UserMessageCallbacks callback_set{
             nullptr,
@@ -94,6 +96,22 @@ int main(int argc, char** argv) {
     derecho::Group<PersistentThing> group(callback_set, subgroup_info, {},
                                           std::vector<derecho::view_upcall_t>{},
                                           thing_factory);
+    const auto group_ready_time = std::chrono::steady_clock::now();
+
+    const derecho::RestartTimings& restart_timings = group.get_restart_timings();
+    if(restart_timings.total.count() > 0) {
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        //End-to-end includes everything from process startup to having a usable Group
+        std::cout << "Restart timing (us): end_to_end=" << duration_cast<microseconds>(group_ready_time - start_time).count()
+                  << " total=" << duration_cast<microseconds>(restart_timings.total).count()
+                  << " load_view=" << duration_cast<microseconds>(restart_timings.load_view).count()
+                  << " load_ragged_trim=" << duration_cast<microseconds>(restart_timings.load_ragged_trim).count()
+                  << " contact_leader=" << duration_cast<microseconds>(restart_timings.contact_leader).count()
+                  << " load_logs=" << duration_cast<microseconds>(restart_timings.load_logs).count()
+                  << " truncate_logs=" << duration_cast<microseconds>(restart_timings.truncate_logs).count()
+                  << " send_logs=" << duration_cast<microseconds>(restart_timings.send_logs).count() << std::endl;
+    }
 
     auto my_rank = group.get_my_rank();
     if (my_rank == -1) {
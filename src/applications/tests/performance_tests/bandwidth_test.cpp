@@ -3,8 +3,11 @@
  * 1. the number of nodes 2. the number of senders (all sending, half nodes sending, one sending)
  * 3. message size 4. window size 5. number of messages sent per sender
  * 6. delivery mode (atomic multicast or unordered)
+ * 7. the percentage of small messages, for mixed-size workloads
  * The test waits for every node to join and then each sender starts sending messages continuously
- * in the only subgroup that consists of all the nodes
+ * in the only subgroup that consists of all the nodes. Small messages are
+ * max_smc_payload_size bytes and the others are max_payload_size bytes; run a mixed
+ * workload with DERECHO/hybrid_multicast set to false and to true to compare transports.
  * Upon completion, the results are appended to file data_derecho_bw on the leader
  */
 #include "aggregate_bandwidth.hpp"
@@ -13,6 +16,7 @@
 
 #include <derecho/core/derecho.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <fstream>
@@ -36,12 +40,15 @@ struct exp_result {
     unsigned int window_size;
     uint32_t num_messages;
     uint32_t delivery_mode;
+    uint32_t small_message_percent;
+    bool hybrid_multicast;
     double bw;
 
     void print(std::ofstream& fout) {
         fout << num_nodes << " " << num_senders_selector << " "
              << max_msg_size << " " << window_size << " "
              << num_messages << " " << delivery_mode << " "
+             << small_message_percent << " " << hybrid_multicast << " "
              << bw << endl;
     }
 };
@@ -59,8 +66,9 @@ int main(int argc, char* argv[]) {
 
     if((argc - dashdash_pos) < 5) {
         cout << "Invalid command line arguments." << endl;
-        cout << "USAGE: " << argv[0] << " [ derecho-config-list -- ] num_nodes, sender_selector (0 - all senders, 1 - half senders, 2 - one sender), num_messages, delivery_mode (0 - ordered mode, 1 - unordered mode) [proc_name]" << endl;
+        cout << "USAGE: " << argv[0] << " [ derecho-config-list -- ] num_nodes, sender_selector (0 - all senders, 1 - half senders, 2 - one sender), num_messages, delivery_mode (0 - ordered mode, 1 - unordered mode) [proc_name] [small_message_percent]" << endl;
         std::cout << "Note: proc_name sets the process's name as displayed in ps and pkill commands, default is " DEFAULT_PROC_NAME << std::endl;
+        std::cout << "Note: small_message_percent is the percentage of messages of size max_smc_payload_size, default is 0" << std::endl;
         return -1;
     }
 
@@ -81,6 +89,7 @@ int main(int argc, char* argv[]) {
     } else {
         pthread_setname_np(pthread_self(), DEFAULT_PROC_NAME);
     }
+    const uint32_t small_message_percent = dashdash_pos + 6 < argc ? std::stoi(argv[dashdash_pos + 6]) : 0;
     // Read configurations from the command line options as well as the default config file
     Conf::initialize(argc, argv);
 
@@ -136,6 +145,15 @@ int main(int argc, char* argv[]) {
     uint32_t node_rank = group.get_my_rank();
 
     long long unsigned int max_msg_size = getConfUInt64(derecho::Conf::SUBGROUP_DEFAULT_MAX_PAYLOAD_SIZE);
+    uint64_t small_msg_size = std::min<uint64_t>(max_msg_size, getConfUInt64(derecho::Conf::SUBGROUP_DEFAULT_MAX_SMC_PAYLOAD_SIZE));
+    // message i is small if (i % 100) < small_message_percent, so the mix is spread evenly
+    auto message_size = [&](uint32_t i) {
+        return (i % 100) < small_message_percent ? small_msg_size : max_msg_size;
+    };
+    long long unsigned int bytes_per_sender = 0;
+    for(uint i = 0; i < num_messages; ++i) {
+        bytes_per_sender += message_size(i);
+    }
 
     // this function sends all the messages
     auto send_all = [&]() {
@@ -143,7 +161,7 @@ int main(int argc, char* argv[]) {
         for(uint i = 0; i < num_messages; ++i) {
             // the lambda function writes the message contents into the provided memory buffer
             // in this case, we do not touch the memory region
-            raw_subgroup.send(max_msg_size, [](uint8_t* buf) {});
+            raw_subgroup.send(message_size(i), [](uint8_t* buf) {});
         }
     };
 
@@ -170,11 +188,11 @@ int main(int argc, char* argv[]) {
     // calculate bandwidth measured locally
     double bw;
     if(senders_mode == PartialSendMode::ALL_SENDERS) {
-        bw = (max_msg_size * num_messages * num_nodes + 0.0) / nanoseconds_elapsed;
+        bw = (bytes_per_sender * num_nodes + 0.0) / nanoseconds_elapsed;
     } else if(senders_mode == PartialSendMode::HALF_SENDERS) {
-        bw = (max_msg_size * num_messages * (num_nodes / 2) + 0.0) / nanoseconds_elapsed;
+        bw = (bytes_per_sender * (num_nodes / 2) + 0.0) / nanoseconds_elapsed;
     } else {
-        bw = (max_msg_size * num_messages + 0.0) / nanoseconds_elapsed;
+        bw = (bytes_per_sender + 0.0) / nanoseconds_elapsed;
     }
     // aggregate bandwidth from all nodes
     double avg_bw = aggregate_bandwidth(members_order, members_order[node_rank], bw);
@@ -182,7 +200,8 @@ int main(int argc, char* argv[]) {
     if(node_rank == 0) {
         log_results(exp_result{num_nodes, num_senders_selector, max_msg_size,
                                getConfUInt32(derecho::Conf::SUBGROUP_DEFAULT_WINDOW_SIZE), num_messages,
-                               delivery_mode, avg_bw},
+                               delivery_mode, small_message_percent,
+                               getConfBoolean(derecho::Conf::DERECHO_HYBRID_MULTICAST), avg_bw},
                     "data_derecho_bw");
     }
 
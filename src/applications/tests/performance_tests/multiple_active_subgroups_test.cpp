@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <atomic>
 #include <fstream>
 #include <functional>
@@ -5,6 +6,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <time.h>
 #include <vector>
 
@@ -25,46 +27,70 @@ struct exp_result {
     uint32_t window_size;
     uint32_t num_messages;
     uint32_t num_subgroups;
+    uint32_t small_message_percent;
+    bool hybrid_multicast;
+    uint32_t num_sender_threads;
     double bw;
+    double min_subgroup_bw;
 
     void print(std::ofstream& fout) {
         fout << num_nodes << " "
              << max_msg_size << " " << window_size << " "
              << num_messages << " "
              << num_subgroups << " "
-             << bw << endl;
+             << small_message_percent << " " << hybrid_multicast << " "
+             << num_sender_threads << " "
+             << bw << " " << min_subgroup_bw << endl;
     }
 };
 
 int main(int argc, char* argv[]) {
-    if(argc < 4 || (argc > 4 && strcmp("--", argv[argc - 4]))) {
+    int dashdash_pos = argc - 1;
+    while(dashdash_pos > 0) {
+        if(strcmp(argv[dashdash_pos], "--") == 0) {
+            break;
+        }
+        dashdash_pos--;
+    }
+
+    if((argc - dashdash_pos) < 4) {
         cout << "Invalid command line arguments." << endl;
         cout << "Usage:" << argv[0]
-             << "[ derecho-config-list -- ] num_nodes, num_subgroups, num_messages"
+             << "[ derecho-config-list -- ] num_nodes, num_subgroups, num_messages [small_message_percent]"
              << endl;
+        cout << "Note: small_message_percent is the percentage of messages of size max_smc_payload_size, default is 0" << endl;
         return 1;
     }
     pthread_setname_np(pthread_self(), "main");
 
     // initialize the special arguments for this test
-    const uint num_nodes = std::stoi(argv[argc - 3]);
-    const uint num_subgroups = std::stoi(argv[argc - 2]);
-    const uint num_messages = std::stoi(argv[argc - 1]);
+    const uint num_nodes = std::stoi(argv[dashdash_pos + 1]);
+    const uint num_subgroups = std::stoi(argv[dashdash_pos + 2]);
+    const uint num_messages = std::stoi(argv[dashdash_pos + 3]);
+    const uint small_message_percent = dashdash_pos + 4 < argc ? std::stoi(argv[dashdash_pos + 4]) : 0;
 
     // Read configurations from the command line options as well as the default config file
     Conf::initialize(argc, argv);
 
     // variable 'done' tracks the end of the test
     std::atomic<bool> done = false;
+    // the time at which each subgroup delivered its last message
+    vector<struct timespec> subgroup_end_times(num_subgroups);
     // callback into the application code at each message delivery
     auto stability_callback = [&num_messages,
                                &done,
                                &num_nodes,
                                &num_subgroups,
-                               num_delivered = 0u](uint32_t subgroup, uint32_t sender_id,
-                                                   long long int index,
-                                                   std::optional<std::pair<uint8_t*, long long int>> data,
-                                                   persistent::version_t ver) mutable {
+                               &subgroup_end_times,
+                               num_delivered = 0u,
+                               num_delivered_per_subgroup = vector<uint>(num_subgroups, 0)](
+                                      uint32_t subgroup, uint32_t sender_id,
+                                      long long int index,
+                                      std::optional<std::pair<uint8_t*, long long int>> data,
+                                      persistent::version_t ver) mutable {
+        if(++num_delivered_per_subgroup[subgroup] == num_messages * num_nodes) {
+            clock_gettime(CLOCK_REALTIME, &subgroup_end_times[subgroup]);
+        }
         // increment the total number of messages delivered
         ++num_delivered;
         if(num_delivered == num_messages * num_subgroups * num_nodes) {
@@ -104,6 +130,15 @@ int main(int argc, char* argv[]) {
     uint32_t node_rank = group.get_my_rank();
 
     long long unsigned int max_msg_size = getConfUInt64(Conf::SUBGROUP_DEFAULT_MAX_PAYLOAD_SIZE);
+    uint64_t small_msg_size = std::min<uint64_t>(max_msg_size, getConfUInt64(Conf::SUBGROUP_DEFAULT_MAX_SMC_PAYLOAD_SIZE));
+    // message i is small if (i % 100) < small_message_percent, so the mix is spread evenly
+    auto message_size = [&](uint i) {
+        return (i % 100) < small_message_percent ? small_msg_size : max_msg_size;
+    };
+    long long unsigned int bytes_per_subgroup = 0;
+    for(uint i = 0; i < num_messages; ++i) {
+        bytes_per_subgroup += message_size(i);
+    }
 
     // this function sends all the messages
     auto send_in_all_subgroups = [&]() {
@@ -113,7 +148,7 @@ int main(int argc, char* argv[]) {
         }
         for(uint i = 0; i < num_messages; ++i) {
             for(uint j = 0; j < num_subgroups; ++j) {
-                raw_subgroups[j].get().send(max_msg_size, [](uint8_t* buf) {});
+                raw_subgroups[j].get().send(message_size(i), [](uint8_t* buf) {});
             }
         }
     };
@@ -128,19 +163,37 @@ int main(int argc, char* argv[]) {
     // end timer
     struct timespec end_time;
     clock_gettime(CLOCK_REALTIME, &end_time);
-    long long int nanoseconds_elapsed = (end_time.tv_sec - start_time.tv_sec) * (long long int)1e9 + (end_time.tv_nsec - start_time.tv_nsec);
-    // calculate bandwidth measured locally
+    auto nanoseconds_since_start = [&start_time](const struct timespec& time) {
+        return (time.tv_sec - start_time.tv_sec) * (long long int)1e9 + (time.tv_nsec - start_time.tv_nsec);
+    };
+    long long int nanoseconds_elapsed = nanoseconds_since_start(end_time);
+    // calculate bandwidth measured locally, over all subgroups together
     double bw;
-    bw = (max_msg_size * num_messages * num_subgroups * num_nodes + 0.0) / nanoseconds_elapsed;
+    bw = (bytes_per_subgroup * num_subgroups * num_nodes + 0.0) / nanoseconds_elapsed;
+    // each subgroup's own bandwidth shows whether a slow subgroup held up the others
+    double min_subgroup_bw = 0;
+    for(uint i = 0; i < num_subgroups; ++i) {
+        double subgroup_bw = (bytes_per_subgroup * num_nodes + 0.0) / nanoseconds_since_start(subgroup_end_times[i]);
+        cout << "Subgroup " << i << " throughput: " << subgroup_bw << " GB/s" << endl;
+        if(i == 0 || subgroup_bw < min_subgroup_bw) {
+            min_subgroup_bw = subgroup_bw;
+        }
+    }
+    cout << "Aggregate throughput of " << num_subgroups << " subgroups: " << bw << " GB/s" << endl;
     // aggregate bandwidth from all nodes
-    double avg_bw = aggregate_bandwidth(members_order, members_order[node_rank], bw);
+    std::pair<double, double> avg_bw = aggregate_bandwidth(members_order, members_order[node_rank],
+                                                           std::make_pair(bw, min_subgroup_bw));
     // log the result at the leader node
     if(node_rank == 0) {
         log_results(exp_result{num_nodes, max_msg_size,
                                getConfUInt32(Conf::SUBGROUP_DEFAULT_WINDOW_SIZE),
                                num_messages,
                                num_subgroups,
-                               avg_bw},
+                               small_message_percent,
+                               getConfBoolean(Conf::DERECHO_HYBRID_MULTICAST),
+                               getConfUInt32(Conf::DERECHO_NUM_SENDER_THREADS),
+                               avg_bw.first,
+                               avg_bw.second},
                     "data_multiple_active_subgroups");
     }
 
@@ -0,0 +1,134 @@
+/**
+ * @file rdmc_group_setup_test.cpp
+ *
+ * Measures what it costs to set up the RDMC groups of a shard in which every
+ * member is a sender. Start num_nodes nodes; once the view containing all of
+ * them is installed, each node reports how long it spent creating the RDMC
+ * groups of that view, how many groups it belongs to, and how many
+ * connections and bytes of registered memory they use. Compare runs with
+ * DERECHO/rdmc_shared_shard_groups set to false (one group per sender) and to
+ * true (one group per shard). RDMC groups are only created if the subgroup's
+ * max_payload_size is larger than its max_smc_payload_size.
+ */
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "log_results.hpp"
+#include <derecho/conf/conf.hpp>
+#include <derecho/core/derecho.hpp>
+#include <derecho/mutils-serialization/SerializationSupport.hpp>
+
+using std::endl;
+using namespace std::chrono;
+
+/**
+ * A replicated object with almost no state, so that state transfer does not
+ * contribute to the cost of installing a view.
+ */
+class SetupTestObject : public mutils::ByteRepresentable {
+    uint64_t value;
+
+public:
+    SetupTestObject(uint64_t value) : value(value) {}
+
+    uint64_t get_value() const {
+        return value;
+    }
+
+    DEFAULT_SERIALIZATION_SUPPORT(SetupTestObject, value);
+    REGISTER_RPC_FUNCTIONS(SetupTestObject, P2P_TARGETS(get_value));
+};
+
+struct exp_result {
+    uint32_t num_nodes;
+    bool shared_shard_groups;
+    std::size_t num_groups;
+    std::size_t num_connections;
+    std::size_t registered_bytes;
+    double msec;
+
+    void print(std::ofstream& fout) {
+        fout << num_nodes << " " << shared_shard_groups << " "
+             << num_groups << " " << num_connections << " "
+             << registered_bytes << " " << msec << endl;
+    }
+};
+
+#define DEFAULT_PROC_NAME "rdmc_group_setup_test"
+
+int main(int argc, char* argv[]) {
+    const int NUM_ARGS = 1;
+    int dashdash_pos = argc - 1;
+    while(dashdash_pos > 0) {
+        if(strcmp(argv[dashdash_pos], "--") == 0) {
+            break;
+        }
+        dashdash_pos--;
+    }
+
+    if((argc - dashdash_pos) < (NUM_ARGS + 1)) {
+        std::cout << "Invalid command line arguments." << std::endl;
+        std::cout << "USAGE: " << argv[0] << " [ derecho-config-list -- ] <num_nodes> [proc_name]" << std::endl;
+        std::cout << "Note: proc_name sets the process's name as displayed in ps and pkill commands, default is " DEFAULT_PROC_NAME << std::endl;
+        return -1;
+    }
+
+    derecho::Conf::initialize(argc, argv);
+
+    const uint32_t num_nodes = std::stoi(argv[dashdash_pos + 1]);
+
+    if(dashdash_pos + NUM_ARGS + 1 < argc) {
+        pthread_setname_np(pthread_self(), argv[dashdash_pos + NUM_ARGS + 1]);
+    } else {
+        pthread_setname_np(pthread_self(), DEFAULT_PROC_NAME);
+    }
+
+    std::mutex views_mutex;
+    std::condition_variable full_view_installed;
+    bool group_is_full = false;
+    auto view_upcall = [&](const derecho::View& view) {
+        std::lock_guard<std::mutex> lock(views_mutex);
+        if(!group_is_full && view.members.size() >= num_nodes) {
+            group_is_full = true;
+            full_view_installed.notify_all();
+        }
+    };
+
+    derecho::SubgroupInfo subgroup_info{&derecho::one_subgroup_entire_view};
+    auto object_factory = [](persistent::PersistentRegistry*, derecho::subgroup_id_t) {
+        return std::make_unique<SetupTestObject>(0);
+    };
+
+    derecho::Group<SetupTestObject> group(derecho::UserMessageCallbacks{},
+                                          subgroup_info, {}, {view_upcall}, object_factory);
+    std::cout << "Finished constructing/joining Group" << std::endl;
+
+    {
+        std::unique_lock<std::mutex> lock(views_mutex);
+        full_view_installed.wait(lock, [&]() { return group_is_full; });
+    }
+    group.barrier_sync();
+
+    const derecho::RDMCGroupStats stats = group.get_rdmc_group_stats();
+    const bool shared_shard_groups = derecho::getConfBoolean(derecho::Conf::DERECHO_RDMC_SHARED_SHARD_GROUPS);
+    double msec = static_cast<double>(duration_cast<nanoseconds>(stats.setup_time).count()) / 1000000;
+    if(stats.num_groups == 0) {
+        std::cout << "No RDMC groups were created; set max_payload_size larger than max_smc_payload_size" << std::endl;
+    }
+    std::cout << "RDMC group setup for " << num_nodes << " members: " << msec << " millisecond, "
+              << stats.num_groups << " groups, " << stats.num_connections << " connections, "
+              << stats.registered_bytes << " registered bytes." << std::endl;
+    if(group.get_my_rank() == 0) {
+        log_results(exp_result{num_nodes, shared_shard_groups, stats.num_groups,
+                               stats.num_connections, stats.registered_bytes, msec},
+                    "data_rdmc_group_setup_test");
+    }
+    group.barrier_sync();
+    group.leave();
+}
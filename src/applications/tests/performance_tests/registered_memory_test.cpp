@@ -0,0 +1,175 @@
+/**
+ * @file registered_memory_test.cpp
+ *
+ * Measures the cost of allocating and registering RDMA memory. Start
+ * num_nodes nodes; once the view containing all of them is installed, each
+ * node reports how much memory Derecho has mapped for its SSTs and RDMC
+ * buffers, how long the mapping and registration took, and how many
+ * registrations the SST registration cache saved. Each node then maps and
+ * registers num_regions regions of region_size bytes itself and reports the
+ * average time per region for each step. Compare runs with different values
+ * of DERECHO/registered_memory_hugepages and DERECHO/registered_memory_numa_node;
+ * huge pages must be reserved (e.g. in /proc/sys/vm/nr_hugepages) to be used.
+ */
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "log_results.hpp"
+#include <derecho/conf/conf.hpp>
+#include <derecho/core/derecho.hpp>
+#include <derecho/mutils-serialization/SerializationSupport.hpp>
+#include <derecho/utils/registered_memory.hpp>
+
+using std::endl;
+using namespace std::chrono;
+
+/**
+ * A replicated object with almost no state, so that the memory Derecho
+ * registers is only that of its SSTs and RDMC groups.
+ */
+class MemoryTestObject : public mutils::ByteRepresentable {
+    uint64_t value;
+
+public:
+    MemoryTestObject(uint64_t value) : value(value) {}
+
+    uint64_t get_value() const {
+        return value;
+    }
+
+    DEFAULT_SERIALIZATION_SUPPORT(MemoryTestObject, value);
+    REGISTER_RPC_FUNCTIONS(MemoryTestObject, P2P_TARGETS(get_value));
+};
+
+struct exp_result {
+    uint32_t num_nodes;
+    std::string hugepages;
+    int32_t numa_node;
+    std::size_t region_size;
+    uint32_t num_regions;
+    std::size_t num_hugepage_regions;
+    double avg_allocation_usec;
+    double avg_registration_usec;
+    std::size_t group_registrations;
+    std::size_t group_cache_hits;
+
+    void print(std::ofstream& fout) {
+        fout << num_nodes << " " << hugepages << " " << numa_node << " "
+             << region_size << " " << num_regions << " " << num_hugepage_regions << " "
+             << avg_allocation_usec << " " << avg_registration_usec << " "
+             << group_registrations << " " << group_cache_hits << endl;
+    }
+};
+
+static double to_msec(nanoseconds time) {
+    return static_cast<double>(time.count()) / 1000000;
+}
+
+#define DEFAULT_PROC_NAME "registered_memory_test"
+
+int main(int argc, char* argv[]) {
+    const int NUM_ARGS = 3;
+    int dashdash_pos = argc - 1;
+    while(dashdash_pos > 0) {
+        if(strcmp(argv[dashdash_pos], "--") == 0) {
+            break;
+        }
+        dashdash_pos--;
+    }
+
+    if((argc - dashdash_pos) < (NUM_ARGS + 1)) {
+        std::cout << "Invalid command line arguments." << std::endl;
+        std::cout << "USAGE: " << argv[0] << " [ derecho-config-list -- ] <num_nodes> <region_size> <num_regions> [proc_name]" << std::endl;
+        std::cout << "Note: proc_name sets the process's name as displayed in ps and pkill commands, default is " DEFAULT_PROC_NAME << std::endl;
+        return -1;
+    }
+
+    derecho::Conf::initialize(argc, argv);
+
+    const uint32_t num_nodes = std::stoi(argv[dashdash_pos + 1]);
+    const std::size_t region_size = std::stoull(argv[dashdash_pos + 2]);
+    const uint32_t num_regions = std::stoi(argv[dashdash_pos + 3]);
+
+    if(dashdash_pos + NUM_ARGS + 1 < argc) {
+        pthread_setname_np(pthread_self(), argv[dashdash_pos + NUM_ARGS + 1]);
+    } else {
+        pthread_setname_np(pthread_self(), DEFAULT_PROC_NAME);
+    }
+
+    std::mutex views_mutex;
+    std::condition_variable full_view_installed;
+    bool group_is_full = false;
+    auto view_upcall = [&](const derecho::View& view) {
+        std::lock_guard<std::mutex> lock(views_mutex);
+        if(!group_is_full && view.members.size() >= num_nodes) {
+            group_is_full = true;
+            full_view_installed.notify_all();
+        }
+    };
+
+    derecho::SubgroupInfo subgroup_info{&derecho::one_subgroup_entire_view};
+    auto object_factory = [](persistent::PersistentRegistry*, derecho::subgroup_id_t) {
+        return std::make_unique<MemoryTestObject>(0);
+    };
+
+    derecho::Group<MemoryTestObject> group(derecho::UserMessageCallbacks{},
+                                           subgroup_info, {}, {view_upcall}, object_factory);
+    std::cout << "Finished constructing/joining Group" << std::endl;
+
+    {
+        std::unique_lock<std::mutex> lock(views_mutex);
+        full_view_installed.wait(lock, [&]() { return group_is_full; });
+    }
+    group.barrier_sync();
+
+    const derecho::RegisteredMemoryStats group_stats = derecho::get_registered_memory_stats();
+    std::cout << "Group memory: " << group_stats.num_allocations << " mappings ("
+              << group_stats.num_hugepage_allocations << " with huge pages), "
+              << group_stats.mapped_bytes << " bytes mapped in " << to_msec(group_stats.allocation_time)
+              << " millisecond; " << group_stats.num_registrations << " registrations in "
+              << to_msec(group_stats.registration_time) << " millisecond, "
+              << group_stats.num_registration_cache_hits << " registration cache hits." << std::endl;
+
+    //Map and register the regions in two separate steps so each can be timed
+    const derecho::RegisteredMemoryOptions options = derecho::get_registered_memory_options();
+    std::vector<derecho::RegisteredMemory> regions;
+    std::size_t num_hugepage_regions = 0;
+    steady_clock::time_point allocation_start = steady_clock::now();
+    for(uint32_t i = 0; i < num_regions; i++) {
+        regions.emplace_back(region_size, options);
+        if(regions.back().is_hugepage_backed()) {
+            num_hugepage_regions++;
+        }
+    }
+    nanoseconds allocation_time = steady_clock::now() - allocation_start;
+    std::vector<std::unique_ptr<rdma::memory_region>> memory_regions;
+    steady_clock::time_point registration_start = steady_clock::now();
+    for(const auto& region : regions) {
+        memory_regions.emplace_back(std::make_unique<rdma::memory_region>(region.get(), region.get_size()));
+    }
+    nanoseconds registration_time = steady_clock::now() - registration_start;
+
+    double avg_allocation_usec = to_msec(allocation_time) * 1000 / num_regions;
+    double avg_registration_usec = to_msec(registration_time) * 1000 / num_regions;
+    std::cout << num_regions << " regions of " << region_size << " bytes (" << num_hugepage_regions
+              << " with huge pages): " << avg_allocation_usec << " microsecond to map, "
+              << avg_registration_usec << " microsecond to register, per region." << std::endl;
+
+    if(group.get_my_rank() == 0) {
+        log_results(exp_result{num_nodes, derecho::getConfString(derecho::Conf::DERECHO_REGISTERED_MEMORY_HUGEPAGES),
+                               options.numa_node, region_size, num_regions, num_hugepage_regions,
+                               avg_allocation_usec, avg_registration_usec,
+                               group_stats.num_registrations, group_stats.num_registration_cache_hits},
+                    "data_registered_memory_test");
+    }
+    //Deregister the regions before they are unmapped
+    memory_regions.clear();
+    group.barrier_sync();
+    group.leave();
+}
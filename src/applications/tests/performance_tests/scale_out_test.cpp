@@ -0,0 +1,135 @@
+/**
+ * @file scale_out_test.cpp
+ *
+ * Measures how long it takes a group to grow from one node to num_nodes nodes
+ * when all the other nodes try to join at once. Start the first node, then
+ * start the other num_nodes - 1 nodes together (e.g. on loopback, from a shell
+ * loop). The first node reports the time from when it installed the initial
+ * view until it installed a view containing all num_nodes nodes, and how many
+ * view changes that took. Compare runs with different values of
+ * DERECHO/max_joins_per_view and DERECHO/join_batch_window_ms.
+ */
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "log_results.hpp"
+#include <derecho/conf/conf.hpp>
+#include <derecho/core/derecho.hpp>
+#include <derecho/mutils-serialization/SerializationSupport.hpp>
+
+using std::endl;
+using namespace std::chrono;
+
+/**
+ * A replicated object with almost no state, so that state transfer does not
+ * contribute to the cost of a view change.
+ */
+class ScaleOutObject : public mutils::ByteRepresentable {
+    uint64_t value;
+
+public:
+    ScaleOutObject(uint64_t value) : value(value) {}
+
+    uint64_t get_value() const {
+        return value;
+    }
+
+    DEFAULT_SERIALIZATION_SUPPORT(ScaleOutObject, value);
+    REGISTER_RPC_FUNCTIONS(ScaleOutObject, P2P_TARGETS(get_value));
+};
+
+struct exp_result {
+    uint32_t num_nodes;
+    uint32_t max_joins_per_view;
+    uint32_t join_batch_window_ms;
+    uint32_t num_view_changes;
+    double msec;
+
+    void print(std::ofstream& fout) {
+        fout << num_nodes << " " << max_joins_per_view << " "
+             << join_batch_window_ms << " " << num_view_changes << " "
+             << msec << endl;
+    }
+};
+
+#define DEFAULT_PROC_NAME "scale_out_test"
+
+int main(int argc, char* argv[]) {
+    const int NUM_ARGS = 1;
+    int dashdash_pos = argc - 1;
+    while(dashdash_pos > 0) {
+        if(strcmp(argv[dashdash_pos], "--") == 0) {
+            break;
+        }
+        dashdash_pos--;
+    }
+
+    if((argc - dashdash_pos) < (NUM_ARGS + 1)) {
+        std::cout << "Invalid command line arguments." << std::endl;
+        std::cout << "USAGE: " << argv[0] << " [ derecho-config-list -- ] <num_nodes> [proc_name]" << std::endl;
+        std::cout << "Note: proc_name sets the process's name as displayed in ps and pkill commands, default is " DEFAULT_PROC_NAME << std::endl;
+        return -1;
+    }
+
+    derecho::Conf::initialize(argc, argv);
+
+    const uint32_t num_nodes = std::stoi(argv[dashdash_pos + 1]);
+
+    if(dashdash_pos + NUM_ARGS + 1 < argc) {
+        pthread_setname_np(pthread_self(), argv[dashdash_pos + NUM_ARGS + 1]);
+    } else {
+        pthread_setname_np(pthread_self(), DEFAULT_PROC_NAME);
+    }
+
+    //Record when the first view and the first full view were installed
+    std::mutex views_mutex;
+    std::condition_variable full_view_installed;
+    uint32_t num_views = 0;
+    bool group_is_full = false;
+    steady_clock::time_point first_view_time;
+    steady_clock::time_point full_view_time;
+    auto view_upcall = [&](const derecho::View& view) {
+        std::lock_guard<std::mutex> lock(views_mutex);
+        if(num_views == 0) {
+            first_view_time = steady_clock::now();
+        }
+        num_views++;
+        if(!group_is_full && view.members.size() >= num_nodes) {
+            full_view_time = steady_clock::now();
+            group_is_full = true;
+            full_view_installed.notify_all();
+        }
+    };
+
+    derecho::SubgroupInfo subgroup_info{&derecho::one_subgroup_entire_view};
+    auto object_factory = [](persistent::PersistentRegistry*, derecho::subgroup_id_t) {
+        return std::make_unique<ScaleOutObject>(0);
+    };
+
+    derecho::Group<ScaleOutObject> group(derecho::UserMessageCallbacks{},
+                                         subgroup_info, {}, {view_upcall}, object_factory);
+    std::cout << "Finished constructing/joining Group" << std::endl;
+
+    {
+        std::unique_lock<std::mutex> lock(views_mutex);
+        full_view_installed.wait(lock, [&]() { return group_is_full; });
+    }
+    if(group.get_my_rank() == 0) {
+        double msec = static_cast<double>(duration_cast<nanoseconds>(full_view_time - first_view_time).count()) / 1000000;
+        std::cout << "time to reach " << num_nodes << " members:" << msec << " millisecond, "
+                  << num_views - 1 << " view changes." << std::endl;
+        log_results(exp_result{num_nodes,
+                               derecho::getConfUInt32(derecho::Conf::DERECHO_MAX_JOINS_PER_VIEW),
+                               derecho::getConfUInt32(derecho::Conf::DERECHO_JOIN_BATCH_WINDOW_MS),
+                               num_views - 1, msec},
+                    "data_scale_out_test");
+    }
+    group.barrier_sync();
+    group.leave();
+}
@@ -0,0 +1,122 @@
+/**
+ * @file state_transfer_test.cpp
+ *
+ * Measures how long it takes a node to join a group whose single subgroup
+ * holds an object of a given size, which is dominated by the state transfer
+ * from the shard leader. Start the first num_nodes - 1 nodes, wait for them to
+ * form the group, then start the last node; it reports its join time and the
+ * state-transfer throughput. Running all the nodes on one machine measures
+ * state transfer over loopback.
+ */
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log_results.hpp"
+#include <derecho/conf/conf.hpp>
+#include <derecho/core/derecho.hpp>
+#include <derecho/mutils-serialization/SerializationSupport.hpp>
+
+using std::endl;
+using namespace std::chrono;
+
+/**
+ * A replicated object that is nothing but a byte array of a fixed size.
+ */
+class StateObject : public mutils::ByteRepresentable {
+    std::vector<uint8_t> data;
+
+public:
+    StateObject(std::size_t data_size) : data(data_size, 0xab) {}
+    //Deserialization constructor
+    StateObject(const std::vector<uint8_t>& data) : data(data) {}
+
+    std::size_t get_size() const {
+        return data.size();
+    }
+
+    DEFAULT_SERIALIZATION_SUPPORT(StateObject, data);
+    REGISTER_RPC_FUNCTIONS(StateObject, P2P_TARGETS(get_size));
+};
+
+struct exp_result {
+    uint32_t num_nodes;
+    uint64_t object_size;
+    double join_msec;
+    double transfer_gbps;
+
+    void print(std::ofstream& fout) {
+        fout << num_nodes << " " << object_size << " "
+             << join_msec << " " << transfer_gbps << endl;
+    }
+};
+
+#define DEFAULT_PROC_NAME "state_transfer_test"
+
+int main(int argc, char* argv[]) {
+    const int NUM_ARGS = 2;
+    int dashdash_pos = argc - 1;
+    while(dashdash_pos > 0) {
+        if(strcmp(argv[dashdash_pos], "--") == 0) {
+            break;
+        }
+        dashdash_pos--;
+    }
+
+    if((argc - dashdash_pos) < (NUM_ARGS + 1)) {
+        std::cout << "Invalid command line arguments." << std::endl;
+        std::cout << "USAGE: " << argv[0] << " [ derecho-config-list -- ] <num_nodes> <object_size> [proc_name]" << std::endl;
+        std::cout << "Note: object_size is in bytes, e.g. 1048576 for 1MB or 10737418240 for 10GB" << std::endl;
+        std::cout << "Note: proc_name sets the process's name as displayed in ps and pkill commands, default is " DEFAULT_PROC_NAME << std::endl;
+        return -1;
+    }
+
+    derecho::Conf::initialize(argc, argv);
+
+    const uint32_t num_nodes = std::stoi(argv[dashdash_pos + 1]);
+    const uint64_t object_size = std::stoull(argv[dashdash_pos + 2]);
+
+    if(dashdash_pos + NUM_ARGS + 1 < argc) {
+        pthread_setname_np(pthread_self(), argv[dashdash_pos + NUM_ARGS + 1]);
+    } else {
+        pthread_setname_np(pthread_self(), DEFAULT_PROC_NAME);
+    }
+
+    derecho::SubgroupInfo subgroup_info{&derecho::one_subgroup_entire_view};
+
+    //Only the first node's object is constructed with the factory; joining nodes receive its state
+    auto state_factory = [object_size](persistent::PersistentRegistry*, derecho::subgroup_id_t) {
+        return std::make_unique<StateObject>(object_size);
+    };
+
+    steady_clock::time_point begin_time = steady_clock::now();
+    derecho::Group<StateObject> group(derecho::UserMessageCallbacks{},
+                                      subgroup_info, {}, {}, state_factory);
+    steady_clock::time_point end_time = steady_clock::now();
+    std::cout << "Finished constructing/joining Group" << std::endl;
+
+    const int32_t my_rank = group.get_my_rank();
+    if(my_rank != 0) {
+        int64_t nsec = duration_cast<nanoseconds>(end_time - begin_time).count();
+        double msec = static_cast<double>(nsec) / 1000000;
+        double transfer_gbps = static_cast<double>(object_size) / nsec;
+        std::cout << "join time:" << msec << " millisecond." << std::endl;
+        std::cout << "transfer throughput:" << transfer_gbps << "GB/s." << std::endl;
+        std::cout << std::flush;
+        if(my_rank == static_cast<int32_t>(num_nodes) - 1) {
+            log_results(exp_result{num_nodes, object_size, msec, transfer_gbps},
+                        "data_state_transfer_test");
+        }
+    }
+
+    //Wait for the last node to join before anyone leaves
+    while(group.get_members().size() < num_nodes) {
+        std::this_thread::sleep_for(milliseconds(10));
+    }
+    group.barrier_sync();
+    group.leave();
+}
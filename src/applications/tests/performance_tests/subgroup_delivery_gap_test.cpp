@@ -0,0 +1,168 @@
+/**
+ * @file subgroup_delivery_gap_test.cpp
+ *
+ * Measures how long a subgroup that is not affected by a membership change
+ * stops delivering messages while the change happens. The first
+ * num_stable_nodes nodes form subgroup 0 and send messages in it
+ * continuously; subgroup 1 contains the first node and any extra nodes. After
+ * the stable nodes have formed the group, start one extra node at a time,
+ * num_rounds times in total (e.g. from a shell loop). Each extra node joins
+ * subgroup 1 and leaves as soon as it has joined. The first stable node
+ * reports the longest time between two consecutive deliveries in subgroup 0.
+ * Comparing runs with DERECHO/defer_wedge_until_commit set to true and
+ * false shows how much shorter subgroup 0's pause is when the view is not
+ * wedged until the change commits. Subgroup 0 still pauses from the commit
+ * until the new view is installed either way.
+ */
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log_results.hpp"
+#include <derecho/conf/conf.hpp>
+#include <derecho/core/derecho.hpp>
+
+using std::endl;
+using namespace std::chrono;
+using namespace derecho;
+
+struct exp_result {
+    uint32_t num_stable_nodes;
+    uint32_t num_rounds;
+    bool defer_wedge_until_commit;
+    double max_gap_msec;
+
+    void print(std::ofstream& fout) {
+        fout << num_stable_nodes << " " << num_rounds << " "
+             << defer_wedge_until_commit << " " << max_gap_msec << endl;
+    }
+};
+
+#define DEFAULT_PROC_NAME "subgroup_delivery_gap_test"
+
+int main(int argc, char* argv[]) {
+    const int NUM_ARGS = 2;
+    int dashdash_pos = argc - 1;
+    while(dashdash_pos > 0) {
+        if(strcmp(argv[dashdash_pos], "--") == 0) {
+            break;
+        }
+        dashdash_pos--;
+    }
+
+    if((argc - dashdash_pos) < (NUM_ARGS + 1)) {
+        std::cout << "Invalid command line arguments." << std::endl;
+        std::cout << "USAGE: " << argv[0] << " [ derecho-config-list -- ] <num_stable_nodes> <num_rounds> [proc_name]" << std::endl;
+        std::cout << "Note: each round is one extra node joining and then leaving the group" << std::endl;
+        std::cout << "Note: proc_name sets the process's name as displayed in ps and pkill commands, default is " DEFAULT_PROC_NAME << std::endl;
+        return -1;
+    }
+
+    Conf::initialize(argc, argv);
+
+    const uint32_t num_stable_nodes = std::stoi(argv[dashdash_pos + 1]);
+    const uint32_t num_rounds = std::stoi(argv[dashdash_pos + 2]);
+    const bool defer_wedge_until_commit = getConfBoolean(Conf::DERECHO_DEFER_WEDGE_UNTIL_COMMIT);
+
+    if(dashdash_pos + NUM_ARGS + 1 < argc) {
+        pthread_setname_np(pthread_self(), argv[dashdash_pos + NUM_ARGS + 1]);
+    } else {
+        pthread_setname_np(pthread_self(), DEFAULT_PROC_NAME);
+    }
+
+    //Track the longest time between two deliveries in subgroup 0
+    std::mutex gap_mutex;
+    std::optional<steady_clock::time_point> last_delivery_time;
+    nanoseconds max_delivery_gap{0};
+    auto stability_callback = [&](subgroup_id_t subgroup, node_id_t sender_id, message_id_t index,
+                                  std::optional<std::pair<uint8_t*, long long int>> data,
+                                  persistent::version_t ver) {
+        if(subgroup != 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(gap_mutex);
+        const auto now = steady_clock::now();
+        if(last_delivery_time) {
+            max_delivery_gap = std::max(max_delivery_gap, duration_cast<nanoseconds>(now - *last_delivery_time));
+        }
+        last_delivery_time = now;
+    };
+
+    //Stable members count the views in which a churning node left
+    std::mutex rounds_mutex;
+    std::condition_variable rounds_done;
+    uint32_t rounds_completed = 0;
+    auto view_upcall = [&](const View& view) {
+        std::lock_guard<std::mutex> lock(rounds_mutex);
+        if(view.members.size() <= num_stable_nodes && view.departed.size() > 0) {
+            rounds_completed++;
+            rounds_done.notify_all();
+        }
+    };
+
+    auto membership_function = [num_stable_nodes](
+                                       const std::vector<std::type_index>& subgroup_type_order,
+                                       const std::unique_ptr<View>& prev_view, View& curr_view) {
+        if(curr_view.members.size() < num_stable_nodes) {
+            throw subgroup_provisioning_exception();
+        }
+        subgroup_shard_layout_t subgroup_vector(2);
+        //Subgroup 0 is the stable nodes, which never change while the test runs
+        std::vector<node_id_t> stable_members(curr_view.members.begin(),
+                                              curr_view.members.begin() + num_stable_nodes);
+        subgroup_vector[0].emplace_back(curr_view.make_subview(stable_members));
+        //Subgroup 1 is the first node and all of the churning nodes
+        std::vector<node_id_t> churn_members{curr_view.members[0]};
+        churn_members.insert(churn_members.end(),
+                             curr_view.members.begin() + num_stable_nodes, curr_view.members.end());
+        subgroup_vector[1].emplace_back(curr_view.make_subview(churn_members));
+        curr_view.next_unassigned_rank = curr_view.members.size();
+        subgroup_allocation_map_t subgroup_allocation;
+        subgroup_allocation.emplace(std::type_index(typeid(RawObject)), std::move(subgroup_vector));
+        return subgroup_allocation;
+    };
+
+    Group<RawObject> group(UserMessageCallbacks{stability_callback},
+                           SubgroupInfo(membership_function), {}, {view_upcall},
+                           &raw_object_factory);
+    std::cout << "Finished constructing/joining Group" << std::endl;
+
+    if(group.get_my_rank() >= static_cast<int32_t>(num_stable_nodes)) {
+        //This is a churning node: leave right away
+        group.leave();
+        return 0;
+    }
+
+    const uint64_t msg_size = getConfUInt64(Conf::SUBGROUP_DEFAULT_MAX_PAYLOAD_SIZE);
+    std::atomic<bool> stop_sending = false;
+    std::thread sender_thread([&]() {
+        Replicated<RawObject>& stable_subgroup = group.get_subgroup<RawObject>(0);
+        while(!stop_sending) {
+            stable_subgroup.send(msg_size, [](uint8_t* buf) {});
+        }
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(rounds_mutex);
+        rounds_done.wait(lock, [&]() { return rounds_completed >= num_rounds; });
+    }
+    stop_sending = true;
+    sender_thread.join();
+    if(group.get_my_rank() == 0) {
+        std::lock_guard<std::mutex> lock(gap_mutex);
+        double msec = static_cast<double>(max_delivery_gap.count()) / 1000000;
+        std::cout << "longest gap between deliveries in subgroup 0:" << msec << " millisecond." << std::endl;
+        log_results(exp_result{num_stable_nodes, num_rounds, defer_wedge_until_commit, msec},
+                    "data_subgroup_delivery_gap");
+    }
+    group.barrier_sync();
+    group.leave();
+}
@@ -0,0 +1,156 @@
+/**
+ * @file view_change_churn_test.cpp
+ *
+ * Measures how long view changes take while nodes repeatedly join and leave
+ * a group. Start num_stable_nodes nodes and wait for them to form the group;
+ * then start one extra node at a time, num_rounds times in total (e.g. from a
+ * shell loop). Each extra node leaves as soon as it has joined, so every round
+ * costs the stable members two view changes. The stable members leave after
+ * the last round, and the first of them reports the average time of those
+ * view changes, each measured by Group::get_last_view_change_timings() from
+ * the start of the view change until the new view is installed. This leaves
+ * out the time a churning node spends starting up and waiting to be proposed.
+ * Comparing runs with DERECHO/reuse_sst_connections set to true and false
+ * shows the cost of connecting the SST endpoints on each view change.
+ */
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "log_results.hpp"
+#include <derecho/conf/conf.hpp>
+#include <derecho/core/derecho.hpp>
+#include <derecho/mutils-serialization/SerializationSupport.hpp>
+
+using std::endl;
+using namespace std::chrono;
+
+/**
+ * A replicated object with almost no state, so that state transfer does not
+ * contribute to the cost of a view change.
+ */
+class ChurnObject : public mutils::ByteRepresentable {
+    uint64_t value;
+
+public:
+    ChurnObject(uint64_t value) : value(value) {}
+
+    uint64_t get_value() const {
+        return value;
+    }
+
+    DEFAULT_SERIALIZATION_SUPPORT(ChurnObject, value);
+    REGISTER_RPC_FUNCTIONS(ChurnObject, P2P_TARGETS(get_value));
+};
+
+struct exp_result {
+    uint32_t num_stable_nodes;
+    uint32_t num_rounds;
+    bool reuse_sst_connections;
+    double msec;
+
+    void print(std::ofstream& fout) {
+        fout << num_stable_nodes << " " << num_rounds << " "
+             << reuse_sst_connections << " " << msec << endl;
+    }
+};
+
+#define DEFAULT_PROC_NAME "view_change_churn_test"
+
+int main(int argc, char* argv[]) {
+    const int NUM_ARGS = 2;
+    int dashdash_pos = argc - 1;
+    while(dashdash_pos > 0) {
+        if(strcmp(argv[dashdash_pos], "--") == 0) {
+            break;
+        }
+        dashdash_pos--;
+    }
+
+    if((argc - dashdash_pos) < (NUM_ARGS + 1)) {
+        std::cout << "Invalid command line arguments." << std::endl;
+        std::cout << "USAGE: " << argv[0] << " [ derecho-config-list -- ] <num_stable_nodes> <num_rounds> [proc_name]" << std::endl;
+        std::cout << "Note: each round is one extra node joining and then leaving the group" << std::endl;
+        std::cout << "Note: proc_name sets the process's name as displayed in ps and pkill commands, default is " DEFAULT_PROC_NAME << std::endl;
+        return -1;
+    }
+
+    derecho::Conf::initialize(argc, argv);
+
+    const uint32_t num_stable_nodes = std::stoi(argv[dashdash_pos + 1]);
+    const uint32_t num_rounds = std::stoi(argv[dashdash_pos + 2]);
+    const bool reuse_sst_connections = derecho::getConfBoolean(derecho::Conf::DERECHO_REUSE_SST_CONNECTIONS);
+
+    if(dashdash_pos + NUM_ARGS + 1 < argc) {
+        pthread_setname_np(pthread_self(), argv[dashdash_pos + NUM_ARGS + 1]);
+    } else {
+        pthread_setname_np(pthread_self(), DEFAULT_PROC_NAME);
+    }
+
+    //Stable members add up the durations of the view changes caused by the churning nodes
+    std::unique_ptr<derecho::Group<ChurnObject>> group;
+    std::atomic<bool> group_constructed = false;
+    std::mutex rounds_mutex;
+    std::condition_variable rounds_done;
+    uint32_t rounds_completed = 0;
+    uint32_t num_view_changes = 0;
+    nanoseconds total_view_change_time{0};
+    auto view_upcall = [&](const derecho::View& view) {
+        //Skip the views installed while the stable members formed the group
+        if(!group_constructed) {
+            return;
+        }
+        //The timings of a view change are recorded before its view upcalls run
+        const derecho::ViewChangeTimings timings = group->get_last_view_change_timings();
+        std::lock_guard<std::mutex> lock(rounds_mutex);
+        if(timings.vid == view.vid) {
+            total_view_change_time += timings.total;
+            num_view_changes++;
+        }
+        if(view.members.size() <= num_stable_nodes && view.departed.size() > 0) {
+            rounds_completed++;
+            rounds_done.notify_all();
+        }
+    };
+
+    derecho::SubgroupInfo subgroup_info{&derecho::one_subgroup_entire_view};
+    auto churn_factory = [](persistent::PersistentRegistry*, derecho::subgroup_id_t) {
+        return std::make_unique<ChurnObject>(0);
+    };
+
+    group = std::make_unique<derecho::Group<ChurnObject>>(derecho::UserMessageCallbacks{},
+                                                          subgroup_info, std::vector<derecho::DeserializationContext*>{},
+                                                          std::vector<derecho::view_upcall_t>{view_upcall}, churn_factory);
+    group_constructed = true;
+    std::cout << "Finished constructing/joining Group" << std::endl;
+
+    if(group->get_members().size() > num_stable_nodes) {
+        //This is a churning node: leave right away
+        group->leave();
+        return 0;
+    }
+
+    uint32_t view_changes_measured;
+    nanoseconds view_change_time;
+    {
+        std::unique_lock<std::mutex> lock(rounds_mutex);
+        rounds_done.wait(lock, [&]() { return rounds_completed >= num_rounds; });
+        view_changes_measured = num_view_changes;
+        view_change_time = total_view_change_time;
+    }
+    if(group->get_my_rank() == 0 && view_changes_measured > 0) {
+        double msec = static_cast<double>(view_change_time.count()) / 1000000 / view_changes_measured;
+        std::cout << "average view change time over " << view_changes_measured << " view changes:"
+                  << msec << " millisecond." << std::endl;
+        log_results(exp_result{num_stable_nodes, num_rounds, reuse_sst_connections, msec},
+                    "data_view_change_churn");
+    }
+    group->barrier_sync();
+    group->leave();
+}
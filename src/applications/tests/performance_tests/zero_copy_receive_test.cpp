@@ -0,0 +1,230 @@
+/**
+ * @file zero_copy_receive_test.cpp
+ *
+ * Measures the benefit of receiving large ordered_sends directly into a
+ * replicated object's own storage. Each node runs a blob store whose put
+ * function keeps every blob in a registered storage arena. If the store
+ * provides receive buffers (use_receive_buffers = 1), RDMC writes each blob
+ * from another member straight into an arena slot and put only records it;
+ * otherwise (use_receive_buffers = 0) put copies each blob out of Derecho's
+ * buffer into a slot, as a store would normally have to. Blobs from this
+ * node's own sends are always copied. max_payload_size must be larger than
+ * max_smc_payload_size so that the blobs are sent with RDMC.
+ */
+#include "aggregate_bandwidth.hpp"
+#include "log_results.hpp"
+
+#include <derecho/conf/conf.hpp>
+#include <derecho/core/bytes_object.hpp>
+#include <derecho/core/derecho.hpp>
+#include <derecho/mutils-serialization/SerializationSupport.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <vector>
+
+using std::endl;
+using namespace std::chrono;
+
+/**
+ * State shared between the (replicated) BlobStore and the main thread,
+ * including the registered arena the store keeps its blobs in.
+ */
+struct TestState : public derecho::DeserializationContext {
+    std::atomic<bool> experiment_done;
+    steady_clock::time_point receive_complete_time;
+    bool use_receive_buffers;
+    std::size_t slot_size;
+    std::size_t num_slots;
+    std::unique_ptr<uint8_t[]> storage;
+    std::shared_ptr<rdma::memory_region> storage_mr;
+    std::atomic<std::size_t> next_slot;
+
+    /** Takes the next slot of the arena, reusing the slots round-robin. */
+    std::size_t claim_slot() {
+        return (next_slot++ % num_slots) * slot_size;
+    }
+};
+
+/**
+ * A replicated blob store with one RPC function, put, that stores a blob in
+ * the arena of the shared TestState and counts the blobs it has stored.
+ */
+class BlobStore : public mutils::ByteRepresentable, public derecho::ProvidesReceiveBuffers {
+    uint64_t num_puts;
+    const uint64_t total_num_messages;
+    uint64_t num_zero_copy_puts;
+    // Pointer to a TestState object held by the main thread
+    TestState* test_state;
+
+public:
+    void put(const derecho::Bytes& blob) {
+        uint8_t* storage = test_state->storage.get();
+        if(blob.get() >= storage && blob.get() < storage + test_state->slot_size * test_state->num_slots) {
+            // The blob was received into its slot
+            ++num_zero_copy_puts;
+        } else {
+            std::memcpy(storage + test_state->claim_slot(), blob.get(), blob.size());
+        }
+        ++num_puts;
+        if(num_puts == total_num_messages) {
+            test_state->receive_complete_time = steady_clock::now();
+            test_state->experiment_done = true;
+        }
+    }
+
+    uint64_t get_num_zero_copy_puts() const {
+        return num_zero_copy_puts;
+    }
+
+    std::optional<derecho::ReceiveBuffer> get_receive_buffer(derecho::rpc::FunctionTag function_tag,
+                                                             derecho::node_id_t sender,
+                                                             std::size_t message_size) override {
+        if(!test_state->use_receive_buffers || !calls_function(function_tag, RPC_NAME(put))
+           || message_size > test_state->slot_size) {
+            return std::nullopt;
+        }
+        return derecho::ReceiveBuffer{test_state->storage_mr, test_state->claim_slot()};
+    }
+
+    REGISTER_RPC_FUNCTIONS(BlobStore, ORDERED_TARGETS(put));
+    DEFAULT_SERIALIZE(num_puts, total_num_messages, num_zero_copy_puts);
+    // Custom deserialization so we can use the DeserializationManager
+    static std::unique_ptr<BlobStore> from_bytes(mutils::DeserializationManager* dsm, uint8_t const* buffer);
+    DEFAULT_DESERIALIZE_NOALLOC(BlobStore);
+    // Deserialization constructor. The TestState pointer should be supplied by the deserialization context.
+    BlobStore(uint64_t num_puts, uint64_t total_num_messages, uint64_t num_zero_copy_puts, TestState* test_state)
+            : num_puts(num_puts),
+              total_num_messages(total_num_messages),
+              num_zero_copy_puts(num_zero_copy_puts),
+              test_state(test_state) {}
+    // Constructor called by factory function
+    BlobStore(uint64_t total_num_messages, TestState* test_state)
+            : num_puts(0), total_num_messages(total_num_messages), num_zero_copy_puts(0), test_state(test_state) {}
+};
+
+std::unique_ptr<BlobStore> BlobStore::from_bytes(mutils::DeserializationManager* dsm, uint8_t const* buffer) {
+    auto num_puts_ptr = mutils::from_bytes<uint64_t>(dsm, buffer);
+    std::size_t offset = mutils::bytes_size(*num_puts_ptr);
+    auto total_num_ptr = mutils::from_bytes<uint64_t>(dsm, buffer + offset);
+    offset += mutils::bytes_size(*total_num_ptr);
+    auto num_zero_copy_ptr = mutils::from_bytes<uint64_t>(dsm, buffer + offset);
+    assert(dsm && dsm->registered<TestState>());
+    return std::make_unique<BlobStore>(*num_puts_ptr, *total_num_ptr, *num_zero_copy_ptr, &(dsm->mgr<TestState>()));
+}
+
+struct exp_result {
+    uint32_t num_nodes;
+    long long unsigned int blob_size;
+    uint32_t count;
+    bool use_receive_buffers;
+    double avg_msec;
+    double avg_gbps;
+
+    void print(std::ofstream& fout) {
+        fout << num_nodes << " " << blob_size << " "
+             << count << " " << use_receive_buffers << " "
+             << avg_msec << " " << avg_gbps << endl;
+    }
+};
+
+#define DEFAULT_PROC_NAME "zero_copy_test"
+
+int main(int argc, char* argv[]) {
+    int dashdash_pos = argc - 1;
+    while(dashdash_pos > 0) {
+        if(strcmp(argv[dashdash_pos], "--") == 0) {
+            break;
+        }
+        dashdash_pos--;
+    }
+
+    if((argc - dashdash_pos) < 4) {
+        std::cout << "Invalid command line arguments." << std::endl;
+        std::cout << "USAGE: " << argv[0] << " [ derecho-config-list -- ] <num_nodes> <count> <use_receive_buffers> [proc_name]" << std::endl;
+        std::cout << "Note: proc_name sets the process's name as displayed in ps and pkill commands, default is " DEFAULT_PROC_NAME << std::endl;
+        return -1;
+    }
+
+    derecho::Conf::initialize(argc, argv);
+
+    //The serialized Bytes object includes its size field, and the RPC message also has an
+    //InvocationID and the header fields defined by remote_invocation_utilities::header_space().
+    const std::size_t rpc_header_size = sizeof(std::size_t) + sizeof(std::size_t)
+                                        + derecho::remote_invocation_utilities::header_space();
+    const uint64_t max_payload_size = derecho::getConfUInt64(derecho::Conf::SUBGROUP_DEFAULT_MAX_PAYLOAD_SIZE);
+
+    const uint32_t num_nodes = std::stoi(argv[dashdash_pos + 1]);
+    const uint64_t blob_size = max_payload_size - rpc_header_size;
+    const uint32_t count = std::stoi(argv[dashdash_pos + 2]);
+    const bool use_receive_buffers = std::stoi(argv[dashdash_pos + 3]) != 0;
+    const uint64_t total_num_messages = static_cast<uint64_t>(count) * num_nodes;
+
+    if(dashdash_pos + 4 < argc) {
+        pthread_setname_np(pthread_self(), argv[dashdash_pos + 4]);
+    } else {
+        pthread_setname_np(pthread_self(), DEFAULT_PROC_NAME);
+    }
+
+    // Each sender has at most window_size messages that are not yet delivered,
+    // so a slot is never reused while a message is still being received into it
+    TestState shared_test_state;
+    shared_test_state.experiment_done = false;
+    shared_test_state.use_receive_buffers = use_receive_buffers;
+    // Leave room for Derecho's own header in front of the RPC message
+    shared_test_state.slot_size = max_payload_size + 4096;
+    shared_test_state.num_slots = 2 * derecho::getConfUInt32(derecho::Conf::SUBGROUP_DEFAULT_WINDOW_SIZE) * num_nodes;
+    const std::size_t storage_size = shared_test_state.slot_size * shared_test_state.num_slots;
+    shared_test_state.storage = std::make_unique<uint8_t[]>(storage_size);
+    shared_test_state.storage_mr = std::make_shared<rdma::memory_region>(shared_test_state.storage.get(), storage_size);
+    shared_test_state.next_slot = 0;
+
+    derecho::SubgroupInfo subgroup_info{&derecho::one_subgroup_entire_view};
+    auto blob_store_factory = [&](persistent::PersistentRegistry*, derecho::subgroup_id_t) {
+        return std::make_unique<BlobStore>(total_num_messages, &shared_test_state);
+    };
+    std::vector<derecho::DeserializationContext*> context_vector{&shared_test_state};
+
+    derecho::Group<BlobStore> group(derecho::UserMessageCallbacks{nullptr}, subgroup_info, context_vector,
+                                    std::vector<derecho::view_upcall_t>{}, blob_store_factory);
+    std::cout << "Finished constructing/joining Group" << std::endl;
+    while(group.get_members().size() < num_nodes) {
+    }
+
+    std::vector<uint8_t> blob_buffer(blob_size, 0);
+    derecho::Bytes blob(blob_buffer.data(), blob_size);
+    derecho::Replicated<BlobStore>& handle = group.get_subgroup<BlobStore>();
+
+    steady_clock::time_point begin_time = steady_clock::now();
+    for(uint32_t i = 0; i < count; i++) {
+        handle.ordered_send<RPC_NAME(put)>(blob);
+    }
+    while(!shared_test_state.experiment_done) {
+    }
+
+    int64_t nsec = duration_cast<nanoseconds>(shared_test_state.receive_complete_time - begin_time).count();
+    double thp_gbps = (static_cast<double>(total_num_messages) * blob_size) / nsec;
+    double msec = static_cast<double>(nsec) / 1000000;
+    std::cout << "timespan:" << msec << " millisecond." << std::endl;
+    std::cout << "throughput:" << thp_gbps << "GB/s." << std::endl;
+    std::cout << "blobs received without a copy: " << handle.get_ref().get_num_zero_copy_puts()
+              << " of " << total_num_messages << std::endl;
+
+    // aggregate bandwidth from all nodes
+    auto members_order = group.get_members();
+    uint32_t node_rank = group.get_my_rank();
+    std::pair<double, double> bw_laten = aggregate_bandwidth(members_order, members_order[node_rank],
+                                                             std::make_pair(thp_gbps, msec));
+    if(node_rank == 0) {
+        log_results(exp_result{num_nodes, blob_size, count, use_receive_buffers,
+                               bw_laten.second, bw_laten.first},
+                    "data_zero_copy_receive_test");
+    }
+
+    group.barrier_sync();
+    group.leave();
+}
@@ -0,0 +1,177 @@
+/**
+ * @file chunk_ring_test.cpp
+ *
+ * Checks that receiving an object through a ChunkRing, the way state transfer
+ * does, takes a bounded amount of memory when the object is much larger than
+ * a chunk. A writer thread serializes an object of object_size bytes into a
+ * ring of num_chunks chunks of chunk_size bytes, while the main thread
+ * deserializes it from the ring with mutils::from_stream. Every allocation is
+ * counted, and the test fails if, apart from the received object itself,
+ * receiving it ever took more memory than the ring plus a little slack, or if
+ * the received object differs from the one that was sent.
+ */
+#include <derecho/core/detail/chunk_ring.hpp>
+#include <derecho/mutils-serialization/SerializationSupport.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using std::cout;
+using std::endl;
+
+/* Every allocation is preceded by a header that records its size, so that the
+ * number of bytes allocated can be tracked. */
+static constexpr std::size_t ALLOCATION_HEADER_SIZE = alignof(std::max_align_t);
+static std::atomic<std::size_t> allocated_bytes = 0;
+static std::atomic<std::size_t> peak_allocated_bytes = 0;
+
+void* operator new(std::size_t size) {
+    uint8_t* block = static_cast<uint8_t*>(std::malloc(size + ALLOCATION_HEADER_SIZE));
+    if(!block) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<std::size_t*>(block) = size;
+    const std::size_t now_allocated = allocated_bytes += size;
+    std::size_t peak = peak_allocated_bytes;
+    while(now_allocated > peak && !peak_allocated_bytes.compare_exchange_weak(peak, now_allocated)) {
+    }
+    return block + ALLOCATION_HEADER_SIZE;
+}
+
+void operator delete(void* ptr) noexcept {
+    if(ptr) {
+        uint8_t* block = static_cast<uint8_t*>(ptr) - ALLOCATION_HEADER_SIZE;
+        allocated_bytes -= *reinterpret_cast<std::size_t*>(block);
+        std::free(block);
+    }
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete[](void* ptr) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+class BigObject : public mutils::ByteRepresentable {
+public:
+    std::string name;
+    std::vector<uint8_t> data;
+    uint64_t checksum;
+
+    // Takes its fields by value, so that from_stream can move the received data into it
+    BigObject(std::string name, std::vector<uint8_t> data, uint64_t checksum)
+            : name(std::move(name)), data(std::move(data)), checksum(checksum) {}
+
+    DEFAULT_SERIALIZATION_SUPPORT(BigObject, name, data, checksum);
+};
+
+int main(int argc, char* argv[]) {
+    if(argc < 4) {
+        cout << "Usage: " << argv[0] << " <object_size> <chunk_size> <num_chunks>" << endl;
+        return 1;
+    }
+    const std::size_t object_size = std::stoull(argv[1]);
+    const std::size_t chunk_size = std::stoull(argv[2]);
+    const std::size_t num_chunks = std::stoull(argv[3]);
+    if(object_size <= chunk_size * num_chunks) {
+        cout << "object_size must be larger than the ring (chunk_size * num_chunks) for the test to mean anything" << endl;
+        return 1;
+    }
+    static_assert(mutils::is_streamable<BigObject>::value, "BigObject should be deserializable from a stream");
+
+    std::vector<uint8_t> data(object_size);
+    for(std::size_t i = 0; i < object_size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 7 + i / 4096);
+    }
+    const BigObject sent("big object", std::move(data), object_size * 31);
+    const std::size_t serialized_size = mutils::bytes_size(sent);
+
+    const std::size_t bytes_before_receive = allocated_bytes;
+    peak_allocated_bytes = bytes_before_receive;
+    std::unique_ptr<BigObject> received;
+    {
+        derecho::ChunkRing ring(num_chunks, chunk_size);
+        // Serialize the object into the ring the way Replicated<T>::send_object_chunks does
+        std::thread writer([&]() {
+            uint8_t* chunk = nullptr;
+            std::size_t chunk_used = 0;
+            auto copy_to_ring = [&](const uint8_t* bytes, std::size_t size) {
+                while(size > 0) {
+                    if(!chunk) {
+                        chunk = ring.next_free_chunk();
+                        chunk_used = 0;
+                    }
+                    const std::size_t copy_size = std::min(size, chunk_size - chunk_used);
+                    memcpy(chunk + chunk_used, bytes, copy_size);
+                    chunk_used += copy_size;
+                    bytes += copy_size;
+                    size -= copy_size;
+                    if(chunk_used == chunk_size) {
+                        ring.chunk_filled(chunk_used);
+                        chunk = nullptr;
+                    }
+                }
+            };
+            try {
+                mutils::post_object(copy_to_ring, sent);
+                if(chunk) {
+                    ring.chunk_filled(chunk_used);
+                }
+            } catch(const std::exception& e) {
+                cout << "Writer stopped: " << e.what() << endl;
+            }
+            ring.close();
+        });
+        try {
+            received = mutils::from_stream<BigObject>(nullptr, ring);
+        } catch(const std::exception& e) {
+            cout << "FAILED: deserializing from the ring threw: " << e.what() << endl;
+            ring.stop_reading();
+            writer.join();
+            return 1;
+        }
+        ring.stop_reading();
+        writer.join();
+    }
+    const std::size_t peak_receive_bytes = peak_allocated_bytes - bytes_before_receive;
+
+    // The received object is allocated while it is received, so it doesn't count
+    const std::size_t received_object_bytes = received->data.capacity() + received->name.capacity() + sizeof(BigObject);
+    const std::size_t ring_bytes = chunk_size * num_chunks;
+    // Thread state and other small allocations
+    const std::size_t slack_bytes = 64 * 1024;
+    cout << "Received an object of " << serialized_size << " serialized bytes through a ring of "
+         << num_chunks << " chunks of " << chunk_size << " bytes" << endl;
+    cout << "Peak memory allocated while receiving: " << peak_receive_bytes << " bytes, of which "
+         << received_object_bytes << " are the received object" << endl;
+    if(received->name != sent.name || received->data != sent.data || received->checksum != sent.checksum) {
+        cout << "FAILED: the received object differs from the one that was sent" << endl;
+        return 1;
+    }
+    if(peak_receive_bytes > received_object_bytes + ring_bytes + slack_bytes) {
+        cout << "FAILED: receiving the object took " << peak_receive_bytes - received_object_bytes
+             << " bytes besides the object itself, more than the ring's " << ring_bytes << " bytes" << endl;
+        return 1;
+    }
+    cout << "Receive memory stayed within the ring" << endl;
+    return 0;
+}
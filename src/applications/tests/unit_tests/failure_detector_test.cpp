@@ -0,0 +1,129 @@
+/**
+ * @file failure_detector_test.cpp
+ *
+ * Runs the fixed and phi-accrual failure detectors against a simulated peer
+ * whose heartbeat acknowledgments are delayed by random jitter and by
+ * occasional long stalls, and which crashes halfway through the run.
+ * Time is simulated, so the test is deterministic for a given seed and runs
+ * instantly. For each detector it reports how many heartbeats were sent, how
+ * many times the healthy peer was falsely suspected, and how long after the
+ * crash the peer was suspected.
+ */
+#include <derecho/core/detail/failure_detector.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+
+using namespace derecho;
+using std::cout;
+using std::endl;
+using namespace std::chrono;
+
+struct HarnessParams {
+    uint32_t duration_ms;
+    uint32_t crash_time_ms;
+    uint32_t cq_timeout_ms;
+    double jitter_ms;
+    double stall_probability;
+    uint32_t stall_ms;
+    uint32_t seed;
+};
+
+struct HarnessResult {
+    uint32_t heartbeats_sent = 0;
+    uint32_t false_suspicions = 0;
+    std::optional<milliseconds> detection_time;
+};
+
+/**
+ * Sends heartbeats to one simulated peer, feeding every acknowledgment and
+ * every timeout to the detector the same way MulticastGroup's heartbeat
+ * thread does.
+ */
+HarnessResult run_harness(FailureDetector& detector, const HarnessParams& params) {
+    const node_id_t peer = 1;
+    std::mt19937 random_engine(params.seed);
+    std::normal_distribution<double> jitter_distribution(0, params.jitter_ms);
+    std::bernoulli_distribution stall_distribution(params.stall_probability);
+
+    HarnessResult result;
+    const FailureDetector::clock::time_point start_time{};
+    const auto crash_time = start_time + milliseconds(params.crash_time_ms);
+    const auto end_time = start_time + milliseconds(params.duration_ms);
+    FailureDetector::clock::time_point now = start_time;
+    detector.heartbeat(peer, now);
+    milliseconds heartbeat_interval = detector.next_heartbeat_interval(true);
+    while(now < end_time) {
+        now += heartbeat_interval;
+        result.heartbeats_sent++;
+        const bool crashed = now >= crash_time;
+        auto ack_delay = duration_cast<microseconds>(duration<double, std::milli>(std::abs(jitter_distribution(random_engine))));
+        if(stall_distribution(random_engine)) {
+            ack_delay += milliseconds(params.stall_ms);
+        }
+        const bool timed_out = crashed || ack_delay >= milliseconds(params.cq_timeout_ms);
+        if(!timed_out) {
+            now += ack_delay;
+            detector.heartbeat(peer, now);
+        } else {
+            now += milliseconds(params.cq_timeout_ms);
+            if(detector.should_suspect(peer, now)) {
+                if(crashed) {
+                    result.detection_time = duration_cast<milliseconds>(now - crash_time);
+                    break;
+                }
+                result.false_suspicions++;
+            }
+            if(!crashed) {
+                //The stalled acknowledgment eventually arrives
+                detector.heartbeat(peer, now - milliseconds(params.cq_timeout_ms) + ack_delay);
+            }
+        }
+        heartbeat_interval = detector.next_heartbeat_interval(!timed_out);
+    }
+    return result;
+}
+
+void print_result(const std::string& name, const HarnessResult& result) {
+    cout << name << ": heartbeats sent: " << result.heartbeats_sent
+         << ", false suspicions: " << result.false_suspicions << ", detection time: ";
+    if(result.detection_time) {
+        cout << result.detection_time->count() << " ms" << endl;
+    } else {
+        cout << "never" << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if(argc < 5) {
+        cout << "Usage: " << argv[0] << " <heartbeat_ms> <max_heartbeat_ms> <phi_threshold> <phi_min_std_deviation_ms> [duration_ms] [stall_probability] [stall_ms] [seed]" << endl;
+        return 1;
+    }
+    const uint32_t heartbeat_ms = std::stoi(argv[1]);
+    const uint32_t max_heartbeat_ms = std::stoi(argv[2]);
+    const double phi_threshold = std::stod(argv[3]);
+    const double min_std_deviation_ms = std::stod(argv[4]);
+    HarnessParams params;
+    params.duration_ms = argc > 5 ? std::stoi(argv[5]) : 100000;
+    params.crash_time_ms = params.duration_ms / 2;
+    params.cq_timeout_ms = 100;
+    params.jitter_ms = 0.05;
+    params.stall_probability = argc > 6 ? std::stod(argv[6]) : 0.001;
+    params.stall_ms = argc > 7 ? std::stoi(argv[7]) : 150;
+    params.seed = argc > 8 ? std::stoi(argv[8]) : 42;
+
+    FixedFailureDetector fixed_detector(heartbeat_ms);
+    print_result("fixed", run_harness(fixed_detector, params));
+
+    PhiAccrualFailureDetector phi_detector(phi_threshold, min_std_deviation_ms, heartbeat_ms, max_heartbeat_ms);
+    HarnessResult phi_result = run_harness(phi_detector, params);
+    print_result("phi_accrual", phi_result);
+
+    //The crashed peer must eventually be suspected
+    return phi_result.detection_time ? 0 : 1;
+}
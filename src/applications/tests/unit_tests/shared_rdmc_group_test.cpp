@@ -0,0 +1,137 @@
+/**
+ * @file shared_rdmc_group_test.cpp
+ *
+ * Checks that a shard whose members all send at once makes progress when its
+ * members share one RDMC group (DERECHO/rdmc_shared_shard_groups = true).
+ * Every member sends num_msgs messages of msg_size bytes, which must be
+ * larger than SUBGROUP/DEFAULT/max_smc_payload_size so that they go through
+ * RDMC, and checks the contents of every message it delivers. In a shared
+ * group a member receives the headers of the other senders while its own
+ * sender thread is posting sends, so a lock-order bug between the two shows
+ * up as a hang; the test fails if no message is delivered for timeout_sec
+ * seconds.
+ */
+#include <derecho/conf/conf.hpp>
+#include <derecho/core/derecho.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace derecho;
+using std::cout;
+using std::endl;
+
+static uint8_t expected_byte(node_id_t sender_id, uint32_t msg_num, std::size_t offset) {
+    return static_cast<uint8_t>(sender_id * 31 + msg_num * 7 + offset);
+}
+
+int main(int argc, char* argv[]) {
+    if(argc < 5) {
+        cout << "Usage: " << argv[0] << " <num_nodes> <num_msgs> <msg_size> <timeout_sec> [configuration options...]" << endl;
+        return 1;
+    }
+    const uint32_t num_nodes = std::stoi(argv[1]);
+    const uint32_t num_msgs = std::stoi(argv[2]);
+    const std::size_t msg_size = std::stoull(argv[3]);
+    const uint32_t timeout_sec = std::stoi(argv[4]);
+
+    Conf::initialize(argc, argv);
+    if(!getConfBoolean(Conf::DERECHO_RDMC_SHARED_SHARD_GROUPS)) {
+        cout << "This test needs " << Conf::DERECHO_RDMC_SHARED_SHARD_GROUPS << " = true" << endl;
+        return 1;
+    }
+    if(msg_size <= getConfUInt64(Conf::SUBGROUP_DEFAULT_MAX_SMC_PAYLOAD_SIZE)) {
+        cout << "msg_size must be larger than " << Conf::SUBGROUP_DEFAULT_MAX_SMC_PAYLOAD_SIZE
+             << " for the messages to be sent with RDMC" << endl;
+        return 1;
+    }
+
+    SubgroupInfo subgroup_info([num_nodes](const std::vector<std::type_index>& subgroup_type_order,
+                                           const std::unique_ptr<derecho::View>& prev_view, derecho::View& curr_view) {
+        if(curr_view.members.size() < num_nodes) {
+            throw subgroup_provisioning_exception();
+        }
+        return one_subgroup_entire_view(subgroup_type_order, prev_view, curr_view);
+    });
+
+    std::mutex delivery_mutex;
+    std::condition_variable delivery_cv;
+    uint64_t num_delivered = 0;
+    std::map<node_id_t, uint32_t> next_msg_num;
+    std::atomic<bool> contents_ok = true;
+    auto delivery_callback = [&](subgroup_id_t subgroup_id, node_id_t sender_id, message_id_t index,
+                                 std::optional<std::pair<uint8_t*, long long int>> data,
+                                 persistent::version_t ver) {
+        uint8_t* buf;
+        long long int size;
+        std::tie(buf, size) = data.value();
+        std::lock_guard<std::mutex> lock(delivery_mutex);
+        const uint32_t msg_num = next_msg_num[sender_id]++;
+        if(static_cast<std::size_t>(size) != msg_size) {
+            contents_ok = false;
+        } else {
+            for(std::size_t i = 0; i < msg_size; i++) {
+                if(buf[i] != expected_byte(sender_id, msg_num, i)) {
+                    contents_ok = false;
+                    break;
+                }
+            }
+        }
+        num_delivered++;
+        delivery_cv.notify_all();
+    };
+
+    Group<RawObject> group(UserMessageCallbacks{delivery_callback}, subgroup_info, {},
+                           std::vector<view_upcall_t>{}, &raw_object_factory);
+    cout << "Finished constructing/joining Group" << endl;
+    const node_id_t my_id = getConfUInt32(Conf::DERECHO_LOCAL_ID);
+    Replicated<RawObject>& subgroup = group.get_subgroup<RawObject>();
+
+    std::thread sender([&]() {
+        for(uint32_t msg_num = 0; msg_num < num_msgs; msg_num++) {
+            subgroup.send(msg_size, [&](uint8_t* buf) {
+                for(std::size_t i = 0; i < msg_size; i++) {
+                    buf[i] = expected_byte(my_id, msg_num, i);
+                }
+            });
+        }
+    });
+
+    const uint64_t total_msgs = static_cast<uint64_t>(num_msgs) * num_nodes;
+    bool stalled = false;
+    {
+        std::unique_lock<std::mutex> lock(delivery_mutex);
+        while(num_delivered < total_msgs) {
+            const uint64_t delivered_before = num_delivered;
+            if(!delivery_cv.wait_for(lock, std::chrono::seconds(timeout_sec),
+                                     [&]() { return num_delivered != delivered_before; })) {
+                stalled = true;
+                break;
+            }
+        }
+    }
+    if(stalled) {
+        // The sender thread may be stuck too, so do not wait for it
+        cout << "FAILED: no message delivered for " << timeout_sec << " seconds after "
+             << num_delivered << " of " << total_msgs << endl;
+        std::_Exit(1);
+    }
+    sender.join();
+    if(!contents_ok) {
+        cout << "FAILED: a message was delivered with the wrong contents" << endl;
+        std::_Exit(1);
+    }
+    cout << "Delivered all " << total_msgs << " messages" << endl;
+    group.barrier_sync();
+    group.leave();
+    return 0;
+}
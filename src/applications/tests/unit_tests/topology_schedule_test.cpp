@@ -0,0 +1,177 @@
+/**
+ * @file topology_schedule_test.cpp
+ *
+ * Runs every RDMC send schedule on a simulated cluster of racks and hosts,
+ * with members assigned to racks and hosts round-robin so that rank order
+ * says nothing about where a member runs. Each block transfer costs the time
+ * of the link it crosses (within a host, within a rack, or between racks),
+ * and all the transfers of a step run in parallel, so a step takes as long
+ * as its slowest transfer. For each schedule it checks that every member
+ * receives every block exactly once from a member that already had it, and
+ * reports the number of steps, how many block transfers crossed a host or
+ * rack boundary, and the simulated time to send one message. The test fails
+ * if topology_send moves a block across a host or rack boundary more often
+ * than the minimum of once per boundary that it is meant to achieve.
+ */
+#include <derecho/rdmc/detail/schedule.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::cout;
+using std::endl;
+
+struct Location {
+    uint32_t rack;
+    uint32_t host;
+};
+
+struct LinkCosts {
+    double same_host_us;
+    double same_rack_us;
+    double cross_rack_us;
+};
+
+struct ScheduleResult {
+    bool valid = true;
+    size_t total_steps = 0;
+    size_t cross_host_transfers = 0;
+    size_t cross_rack_transfers = 0;
+    double time_us = 0;
+};
+
+/**
+ * Plays out a schedule step by step for one message of num_blocks blocks.
+ * @param make_schedule Constructs the schedule of the member with the given index
+ */
+template <typename ScheduleFactory>
+ScheduleResult simulate(uint32_t num_members, size_t num_blocks, const std::vector<Location>& locations,
+                        const LinkCosts& costs, ScheduleFactory make_schedule) {
+    std::vector<std::unique_ptr<schedule>> schedules;
+    for(uint32_t member = 0; member < num_members; member++) {
+        schedules.push_back(make_schedule(member));
+    }
+    ScheduleResult result;
+    result.total_steps = schedules[0]->get_total_steps(num_blocks);
+    //Member 0 is the root, and starts with every block
+    std::vector<std::vector<bool>> has_block(num_members, std::vector<bool>(num_blocks, false));
+    has_block[0] = std::vector<bool>(num_blocks, true);
+    for(size_t step = 0; step < result.total_steps; step++) {
+        double step_time_us = 0;
+        std::vector<std::pair<uint32_t, size_t>> received;
+        for(uint32_t sender = 0; sender < num_members; sender++) {
+            auto transfer = schedules[sender]->get_outgoing_transfer(num_blocks, step);
+            if(!transfer) {
+                continue;
+            }
+            const uint32_t receiver = transfer->target;
+            auto incoming = schedules[receiver]->get_incoming_transfer(num_blocks, step);
+            if(!incoming || incoming->target != sender || incoming->block_number != transfer->block_number
+               || !has_block[sender][transfer->block_number] || has_block[receiver][transfer->block_number]) {
+                cout << "Invalid transfer of block " << transfer->block_number << " from " << sender
+                     << " to " << receiver << " at step " << step << endl;
+                result.valid = false;
+                return result;
+            }
+            received.emplace_back(receiver, transfer->block_number);
+            double cost_us = costs.same_host_us;
+            if(locations[sender].rack != locations[receiver].rack) {
+                cost_us = costs.cross_rack_us;
+                result.cross_rack_transfers++;
+                result.cross_host_transfers++;
+            } else if(locations[sender].host != locations[receiver].host) {
+                cost_us = costs.same_rack_us;
+                result.cross_host_transfers++;
+            }
+            step_time_us = std::max(step_time_us, cost_us);
+        }
+        //Blocks received in a step can only be forwarded in a later step
+        for(const auto& block : received) {
+            has_block[block.first][block.second] = true;
+        }
+        result.time_us += step_time_us;
+    }
+    for(uint32_t member = 0; member < num_members; member++) {
+        for(size_t block = 0; block < num_blocks; block++) {
+            if(!has_block[member][block]) {
+                cout << "Member " << member << " never received block " << block << endl;
+                result.valid = false;
+            }
+        }
+    }
+    return result;
+}
+
+void print_result(const std::string& name, const ScheduleResult& result) {
+    cout << name << ": " << (result.valid ? "valid" : "INVALID") << ", steps: " << result.total_steps
+         << ", cross-host transfers: " << result.cross_host_transfers
+         << ", cross-rack transfers: " << result.cross_rack_transfers
+         << ", time: " << result.time_us << " us" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    if(argc < 4) {
+        cout << "Usage: " << argv[0] << " <num_racks> <hosts_per_rack> <processes_per_host> [num_blocks] [same_host_us] [same_rack_us] [cross_rack_us]" << endl;
+        return 1;
+    }
+    const uint32_t num_racks = std::stoi(argv[1]);
+    const uint32_t hosts_per_rack = std::stoi(argv[2]);
+    const uint32_t processes_per_host = std::stoi(argv[3]);
+    const size_t num_blocks = argc > 4 ? std::stoi(argv[4]) : 64;
+    LinkCosts costs;
+    costs.same_host_us = argc > 5 ? std::stod(argv[5]) : 1;
+    costs.same_rack_us = argc > 6 ? std::stod(argv[6]) : 5;
+    costs.cross_rack_us = argc > 7 ? std::stod(argv[7]) : 20;
+
+    //Deal the members out to racks, and to the hosts within each rack, round-robin
+    const uint32_t num_members = num_racks * hosts_per_rack * processes_per_host;
+    if(num_members < 2) {
+        cout << "An RDMC group needs at least 2 members" << endl;
+        return 1;
+    }
+    std::vector<Location> locations(num_members);
+    std::vector<std::string> member_locations(num_members);
+    for(uint32_t member = 0; member < num_members; member++) {
+        locations[member].rack = member % num_racks;
+        locations[member].host = (member / num_racks) % hosts_per_rack;
+        member_locations[member] = "rack" + std::to_string(locations[member].rack)
+                                   + "/host" + std::to_string(locations[member].host);
+    }
+    cout << num_members << " members, " << num_blocks << " blocks" << endl;
+
+    bool all_valid = true;
+    auto run = [&](const std::string& name, auto make_schedule) {
+        ScheduleResult result = simulate(num_members, num_blocks, locations, costs, make_schedule);
+        print_result(name, result);
+        all_valid = all_valid && result.valid;
+    };
+    run("binomial_send", [&](uint32_t member) { return std::make_unique<binomial_schedule>(num_members, member); });
+    run("chain_send", [&](uint32_t member) { return std::make_unique<chain_schedule>(num_members, member); });
+    run("sequential_send", [&](uint32_t member) { return std::make_unique<sequential_schedule>(num_members, member); });
+    run("tree_send", [&](uint32_t member) { return std::make_unique<tree_schedule>(num_members, member); });
+    ScheduleResult topology_result = simulate(num_members, num_blocks, locations, costs, [&](uint32_t member) {
+        return std::make_unique<topology_schedule>(num_members, member, member_locations);
+    });
+    print_result("topology_send", topology_result);
+    all_valid = all_valid && topology_result.valid;
+
+    //Every host and rack has members, so each block must enter every host and rack but the root's exactly once
+    const size_t min_cross_host_transfers = num_blocks * (num_racks * hosts_per_rack - 1);
+    const size_t min_cross_rack_transfers = num_blocks * (num_racks - 1);
+    if(topology_result.cross_host_transfers > min_cross_host_transfers) {
+        cout << "FAILED: topology_send made " << topology_result.cross_host_transfers
+             << " cross-host transfers, more than the minimum of " << min_cross_host_transfers << endl;
+        all_valid = false;
+    }
+    if(topology_result.cross_rack_transfers > min_cross_rack_transfers) {
+        cout << "FAILED: topology_send made " << topology_result.cross_rack_transfers
+             << " cross-rack transfers, more than the minimum of " << min_cross_rack_transfers << endl;
+        all_valid = false;
+    }
+
+    return all_valid ? 0 : 1;
+}
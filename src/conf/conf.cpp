@@ -44,6 +44,10 @@ struct option Conf::long_options[] = {
         MAKE_LONG_OPT_ENTRY(DERECHO_P2P_LOOP_BUSY_WAIT_BEFORE_SLEEP_MS),
         MAKE_LONG_OPT_ENTRY(DERECHO_HEARTBEAT_MS),
         MAKE_LONG_OPT_ENTRY(DERECHO_SST_POLL_CQ_TIMEOUT_MS),
+        MAKE_LONG_OPT_ENTRY(DERECHO_FAILURE_DETECTOR),
+        MAKE_LONG_OPT_ENTRY(DERECHO_MAX_HEARTBEAT_MS),
+        MAKE_LONG_OPT_ENTRY(DERECHO_PHI_SUSPICION_THRESHOLD),
+        MAKE_LONG_OPT_ENTRY(DERECHO_PHI_MIN_STD_DEVIATION_MS),
         MAKE_LONG_OPT_ENTRY(DERECHO_RESTART_TIMEOUT_MS),
         MAKE_LONG_OPT_ENTRY(DERECHO_ENABLE_BACKUP_RESTART_LEADERS),
         MAKE_LONG_OPT_ENTRY(DERECHO_DISABLE_PARTITIONING_SAFETY),
@@ -51,6 +55,28 @@ struct option Conf::long_options[] = {
         MAKE_LONG_OPT_ENTRY(DERECHO_MAX_P2P_REPLY_PAYLOAD_SIZE),
         MAKE_LONG_OPT_ENTRY(DERECHO_P2P_WINDOW_SIZE),
         MAKE_LONG_OPT_ENTRY(DERECHO_MAX_NODE_ID),
+        MAKE_LONG_OPT_ENTRY(DERECHO_STATE_TRANSFER_CHUNK_SIZE),
+        MAKE_LONG_OPT_ENTRY(DERECHO_RDMA_STATE_TRANSFER),
+        MAKE_LONG_OPT_ENTRY(DERECHO_REUSE_SST_CONNECTIONS),
+        MAKE_LONG_OPT_ENTRY(DERECHO_MAX_JOINS_PER_VIEW),
+        MAKE_LONG_OPT_ENTRY(DERECHO_JOIN_BATCH_WINDOW_MS),
+        MAKE_LONG_OPT_ENTRY(DERECHO_DEFER_WEDGE_UNTIL_COMMIT),
+        MAKE_LONG_OPT_ENTRY(DERECHO_RDMC_ARENA_SIZE),
+        MAKE_LONG_OPT_ENTRY(DERECHO_RDMC_POOL_MAX_IDLE_BYTES),
+        MAKE_LONG_OPT_ENTRY(DERECHO_RDMC_ARENA_HUGEPAGES),
+        MAKE_LONG_OPT_ENTRY(DERECHO_RDMC_ADAPTIVE_BLOCK_SIZE),
+        MAKE_LONG_OPT_ENTRY(DERECHO_RDMC_MIN_BLOCK_SIZE),
+        MAKE_LONG_OPT_ENTRY(DERECHO_RDMC_BLOCK_OVERHEAD_US),
+        MAKE_LONG_OPT_ENTRY(DERECHO_RDMC_LINK_BANDWIDTH_GBPS),
+        MAKE_LONG_OPT_ENTRY(DERECHO_RDMC_MAX_IN_FLIGHT_MESSAGES),
+        MAKE_LONG_OPT_ENTRY(DERECHO_RDMC_SHARED_SHARD_GROUPS),
+        MAKE_LONG_OPT_ENTRY(DERECHO_RDMC_NODE_LOCATIONS),
+        MAKE_LONG_OPT_ENTRY(DERECHO_HYBRID_MULTICAST),
+        MAKE_LONG_OPT_ENTRY(DERECHO_HYBRID_RDMC_MIN_SIZE),
+        MAKE_LONG_OPT_ENTRY(DERECHO_REGISTERED_MEMORY_HUGEPAGES),
+        MAKE_LONG_OPT_ENTRY(DERECHO_REGISTERED_MEMORY_NUMA_NODE),
+        MAKE_LONG_OPT_ENTRY(DERECHO_NUM_SENDER_THREADS),
+        MAKE_LONG_OPT_ENTRY(DERECHO_SENDER_THREAD_SUBGROUPS),
         MAKE_LONG_OPT_ENTRY(LAYOUT_JSON_LAYOUT),
         MAKE_LONG_OPT_ENTRY(LAYOUT_JSON_LAYOUT_FILE),
         // [SUBGROUP/<subgroup name>]
@@ -72,6 +98,7 @@ struct option Conf::long_options[] = {
         MAKE_LONG_OPT_ENTRY(PERS_MAX_LOG_ENTRY),
         MAKE_LONG_OPT_ENTRY(PERS_MAX_DATA_SIZE),
         MAKE_LONG_OPT_ENTRY(PERS_PRIVATE_KEY_FILE),
+        MAKE_LONG_OPT_ENTRY(PERS_ENABLE_CHECKSUMS),
         // [LOGGER]
         MAKE_LONG_OPT_ENTRY(LOGGER_LOG_FILE_DEPTH),
         MAKE_LONG_OPT_ENTRY(LOGGER_LOG_TO_TERMINAL),
@@ -0,0 +1,79 @@
+#include <derecho/core/detail/chunk_ring.hpp>
+
+#include <derecho/core/derecho_exception.hpp>
+
+namespace derecho {
+
+ChunkRing::ChunkRing(std::size_t num_chunks, std::size_t chunk_size)
+        : chunk_size(chunk_size),
+          filled_sizes(num_chunks, 0) {
+    for(std::size_t i = 0; i < num_chunks; ++i) {
+        chunks.emplace_back(std::make_unique<uint8_t[]>(chunk_size));
+    }
+}
+
+uint8_t* ChunkRing::next_free_chunk() {
+    std::unique_lock<std::mutex> lock(ring_mutex);
+    ring_cv.wait(lock, [this]() { return chunks_filled - chunks_consumed < chunks.size() || reader_stopped; });
+    if(reader_stopped) {
+        throw derecho_exception("The object in a chunk ring was deserialized before all of its chunks were received");
+    }
+    return chunks[chunks_filled % chunks.size()].get();
+}
+
+void ChunkRing::chunk_filled(std::size_t size) {
+    // An empty chunk would look like the end of the bytes to the reader, so it is never handed over
+    if(size == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(ring_mutex);
+        filled_sizes[chunks_filled % chunks.size()] = size;
+        ++chunks_filled;
+    }
+    ring_cv.notify_all();
+}
+
+void ChunkRing::close() {
+    {
+        std::lock_guard<std::mutex> lock(ring_mutex);
+        writer_closed = true;
+    }
+    ring_cv.notify_all();
+}
+
+void ChunkRing::stop_reading() {
+    {
+        std::lock_guard<std::mutex> lock(ring_mutex);
+        reader_stopped = true;
+    }
+    ring_cv.notify_all();
+}
+
+std::pair<const uint8_t*, std::size_t> ChunkRing::next_bytes() {
+    std::unique_lock<std::mutex> lock(ring_mutex);
+    ring_cv.wait(lock, [this]() { return chunks_consumed < chunks_filled || writer_closed; });
+    if(chunks_consumed == chunks_filled) {
+        throw derecho_exception("A chunk ring was closed before the object in it was fully received");
+    }
+    const std::size_t index = chunks_consumed % chunks.size();
+    return {chunks[index].get() + read_offset, filled_sizes[index] - read_offset};
+}
+
+void ChunkRing::consume(std::size_t size) {
+    bool chunk_freed = false;
+    {
+        std::lock_guard<std::mutex> lock(ring_mutex);
+        read_offset += size;
+        if(read_offset == filled_sizes[chunks_consumed % chunks.size()]) {
+            ++chunks_consumed;
+            read_offset = 0;
+            chunk_freed = true;
+        }
+    }
+    if(chunk_freed) {
+        ring_cv.notify_all();
+    }
+}
+
+}  // namespace derecho
@@ -157,4 +157,8 @@ void tcp_connections::filter_to(const std::vector<node_id_t>& live_nodes_list) {
 derecho::LockedReference<std::unique_lock<std::mutex>, socket> tcp_connections::get_socket(node_id_t node_id) {
     return derecho::LockedReference<std::unique_lock<std::mutex>, socket>(sockets.at(node_id), sockets_mutex);
 }
+
+derecho::LockedReference<std::unique_lock<std::mutex>, std::map<node_id_t, socket>> tcp_connections::get_all_sockets() {
+    return derecho::LockedReference<std::unique_lock<std::mutex>, std::map<node_id_t, socket>>(sockets, sockets_mutex);
+}
 }  // namespace tcp
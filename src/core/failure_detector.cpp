@@ -0,0 +1,137 @@
+#include <derecho/core/detail/failure_detector.hpp>
+
+#include <derecho/conf/conf.hpp>
+#include <derecho/core/derecho_exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace derecho {
+
+FixedFailureDetector::FixedFailureDetector(uint32_t heartbeat_ms)
+        : heartbeat_interval(heartbeat_ms) {}
+
+void FixedFailureDetector::heartbeat(node_id_t who, clock::time_point when) {
+    std::lock_guard<std::mutex> lock(history_mutex);
+    auto& last = last_heartbeat[who];
+    last = std::max(last, when);
+}
+
+bool FixedFailureDetector::heard_from_since(node_id_t who, clock::time_point since) const {
+    std::lock_guard<std::mutex> lock(history_mutex);
+    auto last_heartbeat_entry = last_heartbeat.find(who);
+    return last_heartbeat_entry != last_heartbeat.end() && last_heartbeat_entry->second >= since;
+}
+
+bool FixedFailureDetector::should_suspect(node_id_t who, clock::time_point now) {
+    return true;
+}
+
+void FixedFailureDetector::remove(node_id_t who) {
+    std::lock_guard<std::mutex> lock(history_mutex);
+    last_heartbeat.erase(who);
+}
+
+std::chrono::milliseconds FixedFailureDetector::next_heartbeat_interval(bool all_acknowledged) {
+    return heartbeat_interval;
+}
+
+PhiAccrualFailureDetector::PhiAccrualFailureDetector(double phi_threshold, double min_std_deviation_ms,
+                                                     uint32_t heartbeat_ms, uint32_t max_heartbeat_ms)
+        : phi_threshold(phi_threshold),
+          min_std_deviation_ms(min_std_deviation_ms),
+          min_heartbeat_interval(heartbeat_ms),
+          max_heartbeat_interval(std::max(heartbeat_ms, max_heartbeat_ms)),
+          heartbeat_interval(heartbeat_ms) {}
+
+void PhiAccrualFailureDetector::heartbeat(node_id_t who, clock::time_point when) {
+    std::lock_guard<std::mutex> lock(history_mutex);
+    auto history_entry = histories.find(who);
+    if(history_entry == histories.end()) {
+        histories[who].last_heartbeat = when;
+        return;
+    }
+    HeartbeatHistory& history = history_entry->second;
+    if(when <= history.last_heartbeat) {
+        return;
+    }
+    const double interval_ms = std::chrono::duration<double, std::milli>(when - history.last_heartbeat).count();
+    history.last_heartbeat = when;
+    history.intervals_ms.push_back(interval_ms);
+    history.interval_sum += interval_ms;
+    history.interval_squared_sum += interval_ms * interval_ms;
+    if(history.intervals_ms.size() > WINDOW_SIZE) {
+        const double oldest = history.intervals_ms.front();
+        history.intervals_ms.pop_front();
+        history.interval_sum -= oldest;
+        history.interval_squared_sum -= oldest * oldest;
+    }
+}
+
+bool PhiAccrualFailureDetector::heard_from_since(node_id_t who, clock::time_point since) const {
+    std::lock_guard<std::mutex> lock(history_mutex);
+    auto history_entry = histories.find(who);
+    return history_entry != histories.end() && history_entry->second.last_heartbeat >= since;
+}
+
+double PhiAccrualFailureDetector::phi(node_id_t who, clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(history_mutex);
+    auto history_entry = histories.find(who);
+    if(history_entry == histories.end()) {
+        return 0;
+    }
+    const HeartbeatHistory& history = history_entry->second;
+    //Until some intervals have been seen, assume they are as long as the longest heartbeat interval
+    double mean_ms = max_heartbeat_interval.count();
+    double variance = 0;
+    if(!history.intervals_ms.empty()) {
+        const double count = history.intervals_ms.size();
+        mean_ms = history.interval_sum / count;
+        variance = std::max(0.0, history.interval_squared_sum / count - mean_ms * mean_ms);
+    }
+    const double std_deviation_ms = std::max(std::sqrt(variance), min_std_deviation_ms);
+    const double silent_ms = std::chrono::duration<double, std::milli>(now - history.last_heartbeat).count();
+    //Logistic approximation of the normal CDF, which stays finite in the far tail
+    const double y = (silent_ms - mean_ms) / std_deviation_ms;
+    const double e = std::exp(-y * (1.5976 + 0.070566 * y * y));
+    if(silent_ms > mean_ms) {
+        return -std::log10(e / (1.0 + e));
+    } else {
+        return -std::log10(1.0 - 1.0 / (1.0 + e));
+    }
+}
+
+bool PhiAccrualFailureDetector::should_suspect(node_id_t who, clock::time_point now) {
+    return phi(who, now) > phi_threshold;
+}
+
+void PhiAccrualFailureDetector::remove(node_id_t who) {
+    std::lock_guard<std::mutex> lock(history_mutex);
+    histories.erase(who);
+}
+
+std::chrono::milliseconds PhiAccrualFailureDetector::next_heartbeat_interval(bool all_acknowledged) {
+    std::lock_guard<std::mutex> lock(history_mutex);
+    if(all_acknowledged) {
+        heartbeat_interval = std::min(heartbeat_interval * 2, max_heartbeat_interval);
+    } else {
+        heartbeat_interval = min_heartbeat_interval;
+    }
+    return heartbeat_interval;
+}
+
+std::unique_ptr<FailureDetector> make_failure_detector(uint32_t heartbeat_ms) {
+    const std::string& detector_type = getConfString(Conf::DERECHO_FAILURE_DETECTOR);
+    if(detector_type == "fixed") {
+        return std::make_unique<FixedFailureDetector>(heartbeat_ms);
+    } else if(detector_type == "phi_accrual") {
+        return std::make_unique<PhiAccrualFailureDetector>(
+                getConfDouble(Conf::DERECHO_PHI_SUSPICION_THRESHOLD),
+                getConfDouble(Conf::DERECHO_PHI_MIN_STD_DEVIATION_MS),
+                heartbeat_ms,
+                getConfUInt32(Conf::DERECHO_MAX_HEARTBEAT_MS));
+    }
+    throw derecho_exception("Unknown failure detector type: " + detector_type);
+}
+
+}  // namespace derecho
@@ -0,0 +1,238 @@
+#include <derecho/core/detail/message_buffer_pool.hpp>
+
+#include <derecho/conf/conf.hpp>
+#include <derecho/core/derecho_exception.hpp>
+#include <derecho/utils/logger.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <string>
+
+#include <pthread.h>
+
+namespace derecho {
+
+/** The huge page size that DERECHO/rdmc_arena_hugepages asks for. */
+static constexpr std::size_t HUGEPAGE_SIZE = 2 * 1024 * 1024;
+
+BufferArena::BufferArena(std::size_t size, std::size_t buffer_size, const RegisteredMemoryOptions& memory_options)
+        : memory(size, memory_options),
+          base(memory.get()),
+          size(memory.get_size()),
+          buffer_size(buffer_size),
+          hugepage_backed(memory.is_hugepage_backed()) {
+    mr = std::make_shared<rdma::memory_region>(base, this->size);
+}
+
+BufferArena::~BufferArena() {
+    //Deregister the memory before it is unmapped
+    mr.reset();
+}
+
+MessageBuffer::MessageBuffer(MessageBuffer&& other)
+        : buffer(other.buffer),
+          mr(std::move(other.mr)),
+          offset(other.offset),
+          size(other.size),
+          pool(std::move(other.pool)),
+          arena(std::move(other.arena)) {
+    other.buffer = nullptr;
+    other.offset = 0;
+    other.size = 0;
+}
+
+MessageBuffer& MessageBuffer::operator=(MessageBuffer&& other) {
+    if(this != &other) {
+        release();
+        buffer = other.buffer;
+        mr = std::move(other.mr);
+        offset = other.offset;
+        size = other.size;
+        pool = std::move(other.pool);
+        arena = std::move(other.arena);
+        other.buffer = nullptr;
+        other.offset = 0;
+        other.size = 0;
+    }
+    return *this;
+}
+
+MessageBuffer::~MessageBuffer() {
+    release();
+}
+
+void MessageBuffer::release() {
+    if(pool && buffer) {
+        pool->release(arena, buffer);
+    }
+    buffer = nullptr;
+    mr.reset();
+    offset = 0;
+    size = 0;
+    pool.reset();
+    arena.reset();
+}
+
+MessageBufferPool::MessageBufferPool(std::size_t arena_size, std::size_t max_idle_bytes,
+                                     const RegisteredMemoryOptions& memory_options)
+        : arena_size(arena_size),
+          max_idle_bytes(max_idle_bytes),
+          memory_options(memory_options),
+          grower_thread(&MessageBufferPool::grow_loop, this) {}
+
+MessageBufferPool::~MessageBufferPool() {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        thread_shutdown = true;
+    }
+    pool_cv.notify_all();
+    grower_thread.join();
+}
+
+std::size_t MessageBufferPool::size_class_of(std::size_t size) {
+    std::size_t buffer_size = MIN_BUFFER_SIZE;
+    while(buffer_size < size) {
+        buffer_size <<= 1;
+    }
+    return buffer_size;
+}
+
+std::size_t MessageBufferPool::buffers_per_arena(std::size_t buffer_size) const {
+    return std::max<std::size_t>(1, arena_size / buffer_size);
+}
+
+void MessageBufferPool::grow_loop() {
+    pthread_setname_np(pthread_self(), "buffer_grower");
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    while(true) {
+        pool_cv.wait(lock, [this]() { return thread_shutdown || !grow_requests.empty(); });
+        if(thread_shutdown) {
+            return;
+        }
+        const std::size_t buffer_size = *grow_requests.begin();
+        const std::size_t num_buffers = buffers_per_arena(buffer_size);
+        //Map and register the memory without the lock, so buffers can still be taken and released meanwhile
+        lock.unlock();
+        std::shared_ptr<BufferArena> arena;
+        try {
+            arena = std::make_shared<BufferArena>(num_buffers * buffer_size, buffer_size, memory_options);
+        } catch(const std::exception& e) {
+            dbg_default_error("Could not register an RDMC buffer arena for {}-byte buffers: {}", buffer_size, e.what());
+        }
+        lock.lock();
+        grow_requests.erase(buffer_size);
+        SizeClass& size_class = size_classes[buffer_size];
+        if(arena) {
+            for(std::size_t i = 0; i < num_buffers; ++i) {
+                size_class.free_buffers.emplace_back(arena, arena->base + i * buffer_size);
+            }
+            size_class.arenas.emplace_back(arena);
+            registered_bytes += arena->size;
+            peak_registered_bytes = std::max(peak_registered_bytes, registered_bytes);
+            dbg_default_debug("Registered a {}-byte RDMC buffer arena for {}-byte buffers; {} bytes registered in total",
+                              arena->size, buffer_size, registered_bytes);
+        } else {
+            size_class.failed_grows++;
+        }
+        pool_cv.notify_all();
+    }
+}
+
+MessageBuffer MessageBufferPool::try_acquire(std::size_t size) {
+    const std::size_t buffer_size = size_class_of(size);
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    SizeClass& size_class = size_classes[buffer_size];
+    const uint64_t failed_grows = size_class.failed_grows;
+    while(size_class.free_buffers.empty()) {
+        if(size_class.failed_grows != failed_grows || thread_shutdown) {
+            return MessageBuffer();
+        }
+        //Ask again on every wakeup, since another thread may have taken the buffers of the arena added for this one
+        grow_requests.insert(buffer_size);
+        pool_cv.notify_all();
+        pool_cv.wait(lock);
+    }
+    MessageBuffer message_buffer;
+    std::shared_ptr<BufferArena> arena = std::move(size_class.free_buffers.back().first);
+    message_buffer.buffer = size_class.free_buffers.back().second;
+    size_class.free_buffers.pop_back();
+    message_buffer.mr = arena->mr;
+    message_buffer.offset = message_buffer.buffer - arena->base;
+    message_buffer.size = buffer_size;
+    message_buffer.pool = shared_from_this();
+    arena->num_buffers_in_use++;
+    message_buffer.arena = std::move(arena);
+    size_class.buffers_in_use++;
+    in_use_bytes += buffer_size;
+    //Refill a size class that is running low before it runs out, unless the pool
+    //already holds enough free memory that release() would give an arena back
+    if(size_class.free_buffers.size() < std::max<std::size_t>(1, buffers_per_arena(buffer_size) / 4)
+       && registered_bytes - in_use_bytes < max_idle_bytes) {
+        grow_requests.insert(buffer_size);
+        pool_cv.notify_all();
+    }
+    return message_buffer;
+}
+
+MessageBuffer MessageBufferPool::acquire(std::size_t size) {
+    MessageBuffer message_buffer = try_acquire(size);
+    if(!message_buffer.buffer) {
+        throw derecho_exception("Could not register memory for a " + std::to_string(size) + "-byte RDMC buffer");
+    }
+    return message_buffer;
+}
+
+void MessageBufferPool::release(const std::shared_ptr<BufferArena>& arena, uint8_t* buffer) {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    SizeClass& size_class = size_classes.at(arena->buffer_size);
+    arena->num_buffers_in_use--;
+    size_class.buffers_in_use--;
+    in_use_bytes -= arena->buffer_size;
+    if(arena->num_buffers_in_use == 0 && registered_bytes - in_use_bytes - arena->size >= max_idle_bytes) {
+        //Free the whole arena instead of returning the buffer to the free list
+        size_class.free_buffers.erase(std::remove_if(size_class.free_buffers.begin(), size_class.free_buffers.end(),
+                                                     [&arena](const std::pair<std::shared_ptr<BufferArena>, uint8_t*>& free_buffer) {
+                                                         return free_buffer.first == arena;
+                                                     }),
+                                      size_class.free_buffers.end());
+        size_class.arenas.erase(std::find(size_class.arenas.begin(), size_class.arenas.end(), arena));
+        registered_bytes -= arena->size;
+        dbg_default_debug("Released a {}-byte RDMC buffer arena for {}-byte buffers; {} bytes registered in total",
+                          arena->size, arena->buffer_size, registered_bytes);
+        return;
+    }
+    size_class.free_buffers.emplace_back(arena, buffer);
+    pool_cv.notify_all();
+}
+
+BufferPoolStats MessageBufferPool::get_stats() const {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    BufferPoolStats stats;
+    stats.registered_bytes = registered_bytes;
+    stats.peak_registered_bytes = peak_registered_bytes;
+    stats.in_use_bytes = in_use_bytes;
+    for(const auto& size_class_pair : size_classes) {
+        const SizeClass& size_class = size_class_pair.second;
+        stats.num_arenas += size_class.arenas.size();
+        for(const auto& arena : size_class.arenas) {
+            if(arena->hugepage_backed) {
+                stats.num_hugepage_arenas++;
+            }
+        }
+        stats.size_classes.push_back({size_class_pair.first, size_class.arenas.size(),
+                                      size_class.buffers_in_use, size_class.free_buffers.size()});
+    }
+    return stats;
+}
+
+std::shared_ptr<MessageBufferPool> make_message_buffer_pool() {
+    RegisteredMemoryOptions memory_options = get_registered_memory_options();
+    if(getConfBoolean(Conf::DERECHO_RDMC_ARENA_HUGEPAGES)) {
+        memory_options.max_hugepage_size = std::max(memory_options.max_hugepage_size, HUGEPAGE_SIZE);
+    }
+    return std::make_shared<MessageBufferPool>(getConfUInt64(Conf::DERECHO_RDMC_ARENA_SIZE),
+                                               getConfUInt64(Conf::DERECHO_RDMC_POOL_MAX_IDLE_BYTES),
+                                               memory_options);
+}
+
+}  // namespace derecho
@@ -1,5 +1,6 @@
 #include <derecho/core/detail/multicast_group.hpp>
 
+#include <derecho/core/derecho_exception.hpp>
 #include <derecho/core/detail/derecho_internal.hpp>
 #include <derecho/persistent/Persistent.hpp>
 #include <derecho/persistent/PersistentInterface.hpp>
@@ -13,6 +14,9 @@
 #include <cassert>
 #include <chrono>
 #include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <thread>
 
 namespace derecho {
@@ -49,6 +53,10 @@ MulticastGroup::MulticastGroup(
           subgroup_settings_map(subgroup_settings_by_id),
           received_intervals(sst->num_received.size(), {-1, -1}),
           rdmc_group_num_offset(0),
+          buffer_pool(make_message_buffer_pool()),
+          max_rdmc_messages_in_flight(std::max(1u, getConfUInt32(Conf::DERECHO_RDMC_MAX_IN_FLIGHT_MESSAGES))),
+          hybrid_multicast(getConfBoolean(Conf::DERECHO_HYBRID_MULTICAST)),
+          hybrid_rdmc_min_size(getConfUInt64(Conf::DERECHO_HYBRID_RDMC_MIN_SIZE)),
           future_message_indices(total_num_subgroups, 0),
           next_sends(total_num_subgroups),
           committed_sst_index(total_num_subgroups, -1),
@@ -63,10 +71,13 @@ MulticastGroup::MulticastGroup(
           minimum_verified_version(total_num_subgroups),
           delivered_version(total_num_subgroups),
           sender_timeout(sender_timeout),
+          failure_detector(make_failure_detector(sender_timeout)),
           sst(sst),
           sst_multicast_group_ptrs(total_num_subgroups),
           last_transfer_medium(total_num_subgroups),
           persistence_manager(persistence_manager_ref) {
+    // The sender threads must exist before any predicate or RDMC callback can notify them
+    assign_sender_threads();
     for(uint i = 0; i < total_num_subgroups; ++i) {
         minimum_persisted_version[i] = std::make_unique<std::atomic<persistent::version_t>>(persistent::INVALID_VERSION);
         minimum_verified_version[i] = std::make_unique<std::atomic<persistent::version_t>>(persistent::INVALID_VERSION);
@@ -76,15 +87,6 @@ MulticastGroup::MulticastGroup(
         node_id_to_sst_index[members[i]] = i;
     }
 
-    for(const auto& p : subgroup_settings_by_id) {
-        subgroup_id_t id = p.first;
-        const SubgroupSettings& settings = p.second;
-        auto num_shard_members = settings.members.size();
-        while(free_message_buffers[id].size() < settings.profile.window_size * num_shard_members) {
-            free_message_buffers[id].emplace_back(settings.profile.max_msg_size);
-        }
-    }
-
     initialize_sst_row();
     bool no_member_failed = true;
     if(already_failed.size()) {
@@ -100,7 +102,7 @@ MulticastGroup::MulticastGroup(
         rdmc_sst_groups_created = create_rdmc_sst_groups();
     }
     register_predicates();
-    sender_thread = std::thread(&MulticastGroup::send_loop, this);
+    start_sender_threads();
     timeout_thread = std::thread(&MulticastGroup::check_failures_loop, this);
 }
 
@@ -120,6 +122,10 @@ MulticastGroup::MulticastGroup(
           subgroup_settings_map(subgroup_settings_by_id),
           received_intervals(sst->num_received.size(), {-1, -1}),
           rdmc_group_num_offset(old_group.rdmc_group_num_offset + old_group.num_members),
+          buffer_pool(old_group.buffer_pool),
+          max_rdmc_messages_in_flight(old_group.max_rdmc_messages_in_flight),
+          hybrid_multicast(old_group.hybrid_multicast),
+          hybrid_rdmc_min_size(old_group.hybrid_rdmc_min_size),
           future_message_indices(total_num_subgroups, 0),
           next_sends(total_num_subgroups),
           committed_sst_index(total_num_subgroups, -1),
@@ -134,13 +140,22 @@ MulticastGroup::MulticastGroup(
           minimum_verified_version(total_num_subgroups),
           delivered_version(total_num_subgroups),
           sender_timeout(old_group.sender_timeout),
+          failure_detector(std::move(old_group.failure_detector)),
           sst(sst),
           sst_multicast_group_ptrs(total_num_subgroups),
           last_transfer_medium(total_num_subgroups),
           persistence_manager(old_group.persistence_manager) {
+    assign_sender_threads();
     // Make sure rdmc_group_num_offset didn't overflow.
     assert(old_group.rdmc_group_num_offset <= std::numeric_limits<uint16_t>::max() - old_group.num_members - num_members);
 
+    // The heartbeat history of nodes that are still members carries over to the new view
+    for(const node_id_t old_member : old_group.members) {
+        if(std::find(members.begin(), members.end(), old_member) == members.end()) {
+            failure_detector->remove(old_member);
+        }
+    }
+
     // initialize persisted_version and verified_version
     for (uint i = 0; i< total_num_subgroups; ++i) {
         minimum_persisted_version[i] = std::make_unique<std::atomic<persistent::version_t>>(persistent::INVALID_VERSION);
@@ -171,32 +186,8 @@ MulticastGroup::MulticastGroup(
         return std::move(msg);
     };
 
-    for(const auto& p : subgroup_settings_by_id) {
-        subgroup_id_t id = p.first;
-        const SubgroupSettings& settings = p.second;
-        auto num_shard_members = settings.members.size();
-        while(free_message_buffers[id].size() < settings.profile.window_size * num_shard_members) {
-            free_message_buffers[id].emplace_back(settings.profile.max_msg_size);
-        }
-    }
-
-    // Reclaim RDMCMessageBuffers from the old group, and supplement them with
-    // additional if the group has grown.
+    // Buffers of the old group's messages return to the shared pool when they are discarded
     std::lock_guard<std::recursive_mutex> lock(old_group.msg_state_mtx);
-    for(const auto& p : subgroup_settings_by_id) {
-        const subgroup_id_t subgroup_num = p.first;
-        const SubgroupSettings& settings = p.second;
-        auto num_shard_members = settings.members.size();
-        // for later: don't move extra message buffers
-        free_message_buffers[subgroup_num].swap(old_group.free_message_buffers[subgroup_num]);
-        while(free_message_buffers[subgroup_num].size() < settings.profile.window_size * num_shard_members) {
-            free_message_buffers[subgroup_num].emplace_back(settings.profile.max_msg_size);
-        }
-    }
-
-    for(auto& msg : old_group.current_receives) {
-        free_message_buffers[msg.first.first].push_back(std::move(msg.second.message_buffer));
-    }
     old_group.current_receives.clear();
 
     // Assume that any locally stable messages failed. If we were the sender
@@ -211,28 +202,22 @@ MulticastGroup::MulticastGroup(
             if(q.second.sender_id == members[member_index]) {
                 pending_sends[p.first].push(convert_msg(q.second, p.first));
             } else {
-                free_message_buffers[p.first].push_back(std::move(q.second.message_buffer));
+                q.second.message_buffer.release();
             }
         }
     }
     old_group.locally_stable_rdmc_messages.clear();
 
-    for(const auto& p : subgroup_settings_by_id) {
-        subgroup_id_t id = p.first;
-        const SubgroupSettings& settings = p.second;
-        auto num_shard_members = settings.members.size();
-        while(free_message_buffers[id].size() < settings.profile.window_size * num_shard_members) {
-            free_message_buffers[id].emplace_back(settings.profile.max_msg_size);
-        }
-    }
-
     old_group.locally_stable_sst_messages.clear();
 
     // Any messages that were being sent should be re-attempted.
     for(const auto& p : subgroup_settings_by_id) {
         auto subgroup_num = p.first;
-        if(old_group.current_sends.size() > subgroup_num && old_group.current_sends[subgroup_num]) {
-            pending_sends[subgroup_num].push(convert_msg(*old_group.current_sends[subgroup_num], subgroup_num));
+        if(old_group.current_sends.size() > subgroup_num) {
+            for(auto& msg : old_group.current_sends[subgroup_num]) {
+                pending_sends[subgroup_num].push(convert_msg(msg, subgroup_num));
+            }
+            old_group.current_sends[subgroup_num].clear();
         }
 
         if(old_group.pending_sends.size() > subgroup_num) {
@@ -273,11 +258,14 @@ MulticastGroup::MulticastGroup(
         rdmc_sst_groups_created = create_rdmc_sst_groups();
     }
     register_predicates();
-    sender_thread = std::thread(&MulticastGroup::send_loop, this);
+    start_sender_threads();
     timeout_thread = std::thread(&MulticastGroup::check_failures_loop, this);
 }
 
 bool MulticastGroup::create_rdmc_sst_groups() {
+    const bool share_shard_groups = getConfBoolean(Conf::DERECHO_RDMC_SHARED_SHARD_GROUPS);
+    const uint16_t first_rdmc_group_num = rdmc_group_num_offset;
+    const auto setup_start = std::chrono::steady_clock::now();
     for(const auto& p : subgroup_settings_map) {
         uint32_t subgroup_num = p.first;
         const SubgroupSettings& subgroup_settings = p.second;
@@ -292,6 +280,56 @@ bool MulticastGroup::create_rdmc_sst_groups() {
                 subgroup_settings.num_received_offset, subgroup_settings.slot_offset, subgroup_settings.index_offset);
 
         if(subgroup_settings.profile.max_msg_size > subgroup_settings.profile.sst_max_msg_size) {
+            auto receive_destination = [this, subgroup_num](node_id_t sender_id, size_t length, const uint8_t* prefix) {
+                //Create a Message struct to receive the data into.
+                RDMCMessage msg;
+                msg.sender_id = sender_id;
+                // RDMC learns the exact size of the message from its header
+                // before the first block arrives, so length is the message size.
+                // The replicated object may want an RPC message in its own
+                // memory; ask it before taking the lock, since it runs user code.
+                const std::size_t prefix_size = std::min(length, rdmc::MESSAGE_PREFIX_SIZE);
+                const header* h = (const header*)prefix;
+                if(internal_callbacks.rpc_receive_buffer_callback && prefix_size >= sizeof(header)
+                   && h->cooked_send && h->header_size < prefix_size) {
+                    auto destination = internal_callbacks.rpc_receive_buffer_callback(
+                            subgroup_num, sender_id, prefix + h->header_size, prefix_size - h->header_size, length);
+                    if(destination && destination->mr && destination->offset + length <= destination->mr->size) {
+                        msg.message_buffer.buffer = destination->mr->buffer + destination->offset;
+                        msg.message_buffer.mr = destination->mr;
+                        msg.message_buffer.offset = destination->offset;
+                        msg.message_buffer.size = length;
+                    } else if(destination) {
+                        dbg_default_warn("Subgroup {}: ignoring a receive buffer that cannot hold a {}-byte message from {}",
+                                         subgroup_num, length, sender_id);
+                    }
+                }
+                if(!msg.message_buffer.buffer) {
+                    msg.message_buffer = buffer_pool->try_acquire(length);
+                }
+                // This runs on RDMC's polling thread, which must not throw, and
+                // RDMC cannot skip the message. If the pool could not register
+                // more memory, wait for the buffers of delivered messages to be
+                // released and try again.
+                if(!msg.message_buffer.buffer) {
+                    dbg_default_error("Subgroup {}: no RDMC buffer for a {}-byte message from {}; waiting for one",
+                                      subgroup_num, length, sender_id);
+                    do {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                        msg.message_buffer = buffer_pool->try_acquire(length);
+                    } while(!msg.message_buffer.buffer);
+                }
+
+                std::lock_guard<std::recursive_mutex> lock(msg_state_mtx);
+                rdmc::receive_destination ret{msg.message_buffer.mr, msg.message_buffer.offset};
+                current_receives[{subgroup_num, sender_id}].push_back(std::move(msg));
+
+                assert(ret.mr->buffer != nullptr);
+                return ret;
+            };
+            // With shared shard groups, the completion handler of each sender,
+            // by shard rank, for the one RDMC group created after this loop
+            std::map<uint32_t, rdmc::completion_callback_t> shared_group_handlers;
             for(uint shard_rank = 0, sender_rank = -1; shard_rank < num_shard_members; ++shard_rank) {
                 // don't create RDMC group if the shard member is never going to send
                 if(!shard_senders[shard_rank]) {
@@ -316,18 +354,23 @@ bool MulticastGroup::create_rdmc_sst_groups() {
                                       subgroup_num, shard_rank, index);
                     // Move message from current_receives to locally_stable_rdmc_messages.
                     if(node_id == members[member_index]) {
-                        assert(current_sends[subgroup_num]);
-                        locally_stable_rdmc_messages[subgroup_num][sequence_number] = std::move(*current_sends[subgroup_num]);
-                        current_sends[subgroup_num] = std::nullopt;
+                        // RDMC completes a sender's messages in the order they were sent
+                        assert(!current_sends[subgroup_num].empty());
+                        assert(current_sends[subgroup_num].front().index == index);
+                        locally_stable_rdmc_messages[subgroup_num][sequence_number] = std::move(current_sends[subgroup_num].front());
+                        current_sends[subgroup_num].pop_front();
                     } else {
                         auto it = current_receives.find({subgroup_num, node_id});
-                        assert(it != current_receives.end());
-                        auto& msg = it->second;
+                        assert(it != current_receives.end() && !it->second.empty());
+                        auto& msg = it->second.front();
                         msg.index = index;
                         // We set the size in this receive handler instead of in the incoming_message_handler
                         msg.size = size;
                         locally_stable_rdmc_messages[subgroup_num].emplace(sequence_number, std::move(msg));
-                        current_receives.erase(it);
+                        it->second.pop_front();
+                        if(it->second.empty()) {
+                            current_receives.erase(it);
+                        }
                     }
 
                     auto new_num_received = resolve_num_received(index, subgroup_settings.num_received_offset + sender_rank);
@@ -372,7 +415,7 @@ bool MulticastGroup::create_rdmc_sst_groups() {
                                 auto it2 = locally_stable_rdmc_messages[subgroup_num].begin();
                                 assert(it2->first == seq_num);
                                 auto& msg = it2->second;
-                                uint8_t* buf = msg.message_buffer.buffer.get();
+                                uint8_t* buf = msg.message_buffer.buffer;
                                 header* h = (header*)(buf);
                                 // no delivery for a NULL message
                                 if(msg.size > h->header_size && !(h->cooked_send) && callbacks.global_stability_callback) {
@@ -381,10 +424,10 @@ bool MulticastGroup::create_rdmc_sst_groups() {
                                                                         {{buf + h->header_size, msg.size - h->header_size}},
                                                                         persistent::INVALID_VERSION);
                                 }
-                                free_message_buffers[subgroup_num].push_back(std::move(msg.message_buffer));
                                 if(node_id == members[member_index]) {
                                     pending_message_timestamps[subgroup_num].erase(h->timestamp);
                                 }
+                                msg.message_buffer.release();
                                 locally_stable_rdmc_messages[subgroup_num].erase(it2);
                             }
                         }
@@ -409,10 +452,10 @@ bool MulticastGroup::create_rdmc_sst_groups() {
                 };
                 // Capture rdmc_receive_handler by copy! The reference to it won't be valid after this constructor ends!
                 auto receive_handler_plus_notify =
-                        [this, rdmc_receive_handler](uint8_t* data, size_t size) {
+                        [this, rdmc_receive_handler, subgroup_num](uint8_t* data, size_t size) {
                             rdmc_receive_handler(data, size);
                             // signal background writer thread
-                            sender_cv.notify_all();
+                            notify_sender(subgroup_num);
                         };
 
                 // Create a "rotated" vector of members in which the currently selected shard member (shard_rank) is first
@@ -427,11 +470,20 @@ bool MulticastGroup::create_rdmc_sst_groups() {
                     continue;
                 }
 
+                if(share_shard_groups) {
+                    if(node_id == members[member_index]) {
+                        shared_group_handlers[shard_rank] = receive_handler_plus_notify;
+                    } else {
+                        shared_group_handlers[shard_rank] = rdmc_receive_handler;
+                    }
+                    continue;
+                }
+
                 if(node_id == members[member_index]) {
                     //Create a group in which this node is the sender, and only self-receives happen
                     if(!rdmc::create_group(
                                rdmc_group_num_offset, rotated_shard_members, subgroup_settings.profile.block_size, subgroup_settings.profile.rdmc_send_algorithm,
-                               [](size_t length) -> rdmc::receive_destination {
+                               [](size_t length, const uint8_t* prefix) -> rdmc::receive_destination {
                                    assert_always(false);
                                    return {nullptr, 0};
                                },
@@ -444,23 +496,8 @@ bool MulticastGroup::create_rdmc_sst_groups() {
                 } else {
                     if(!rdmc::create_group(
                                rdmc_group_num_offset, rotated_shard_members, subgroup_settings.profile.block_size, subgroup_settings.profile.rdmc_send_algorithm,
-                               [this, subgroup_num, node_id](size_t length) {
-                                   std::lock_guard<std::recursive_mutex> lock(msg_state_mtx);
-                                   assert(!free_message_buffers[subgroup_num].empty());
-                                   //Create a Message struct to receive the data into.
-                                   RDMCMessage msg;
-                                   msg.sender_id = node_id;
-                                   // The length variable is not the exact size of the msg,
-                                   // but it is the nearest multiple of the block size greater then the size
-                                   // so we will set the size in the receive handler
-                                   msg.message_buffer = std::move(free_message_buffers[subgroup_num].back());
-                                   free_message_buffers[subgroup_num].pop_back();
-
-                                   rdmc::receive_destination ret{msg.message_buffer.mr, 0};
-                                   current_receives[{subgroup_num, node_id}] = std::move(msg);
-
-                                   assert(ret.mr->buffer != nullptr);
-                                   return ret;
+                               [receive_destination, node_id](size_t length, const uint8_t* prefix) {
+                                   return receive_destination(node_id, length, prefix);
                                },
                                rdmc_receive_handler, [](std::optional<uint32_t>) {})) {
                         return false;
@@ -468,8 +505,37 @@ bool MulticastGroup::create_rdmc_sst_groups() {
                     rdmc_group_num_offset++;
                 }
             }
+            if(!shared_group_handlers.empty()) {
+                // One group for the whole shard, in which every sender is a root
+                if(!rdmc::create_multi_root_group(
+                           rdmc_group_num_offset, shard_members, subgroup_settings.profile.block_size, subgroup_settings.profile.rdmc_send_algorithm,
+                           [receive_destination, shard_members](uint32_t root, size_t length, const uint8_t* prefix) {
+                               return receive_destination(shard_members[root], length, prefix);
+                           },
+                           [shared_group_handlers](uint32_t root, uint8_t* data, size_t size) {
+                               shared_group_handlers.at(root)(data, size);
+                           },
+                           [](std::optional<uint32_t>) {})) {
+                    return false;
+                }
+                if(shared_group_handlers.count(subgroup_settings.shard_rank)) {
+                    subgroup_to_rdmc_group[subgroup_num] = rdmc_group_num_offset;
+                }
+                rdmc_group_num_offset++;
+            }
         }
     }
+    rdmc_group_stats.setup_time = std::chrono::steady_clock::now() - setup_start;
+    rdmc_group_stats.num_groups = rdmc_group_num_offset - first_rdmc_group_num;
+    for(uint16_t rdmc_group_num = first_rdmc_group_num; rdmc_group_num < rdmc_group_num_offset; ++rdmc_group_num) {
+        rdmc::group_resources resources = rdmc::get_group_resources(rdmc_group_num);
+        rdmc_group_stats.num_connections += resources.num_connections;
+        rdmc_group_stats.registered_bytes += resources.registered_bytes;
+    }
+    dbg_default_debug("Created {} RDMC groups in {} us, with {} connections and {} registered bytes",
+                      rdmc_group_stats.num_groups,
+                      std::chrono::duration_cast<std::chrono::microseconds>(rdmc_group_stats.setup_time).count(),
+                      rdmc_group_stats.num_connections, rdmc_group_stats.registered_bytes);
     return true;
 }
 
@@ -500,7 +566,7 @@ void MulticastGroup::deliver_message(RDMCMessage& msg, const subgroup_id_t& subg
         return;
     }
 
-    uint8_t* buf = msg.message_buffer.buffer.get();
+    uint8_t* buf = msg.message_buffer.buffer;
     header* h = (header*)(buf);
     // cooked send
     if(h->cooked_send) {
@@ -539,7 +605,7 @@ void MulticastGroup::deliver_message(SSTMessage& msg, const subgroup_id_t& subgr
 
 bool MulticastGroup::version_message(RDMCMessage& msg, const subgroup_id_t& subgroup_num,
                                      const persistent::version_t& version, const uint64_t& msg_timestamp) {
-    uint8_t* buf = msg.message_buffer.buffer.get();
+    uint8_t* buf = msg.message_buffer.buffer;
     header* h = (header*)(buf);
     // null message filter
     if(msg.size == h->header_size) {
@@ -602,14 +668,14 @@ void MulticastGroup::deliver_messages_upto(
             assigned_version = persistent::combine_int32s(sst->vid[member_index], seq_num);
             if(rdmc_msg_ptr != locally_stable_rdmc_messages[subgroup_num].end()) {
                 auto& msg = rdmc_msg_ptr->second;
-                uint8_t* buf = msg.message_buffer.buffer.get();
+                uint8_t* buf = msg.message_buffer.buffer;
                 uint64_t msg_ts = ((header*)buf)->timestamp;
                 //Note: deliver_message frees the RDMC buffer in msg, which is why the timestamp must be saved before calling this
                 deliver_message(msg, subgroup_num, assigned_version, msg_ts / 1000);
                 delivered_version[subgroup_num]->store(assigned_version,std::memory_order_release);
                 non_null_msgs_delivered |= version_message(msg, subgroup_num, assigned_version, msg_ts);
                 // free the message buffer only after it version_message has been called
-                free_message_buffers[subgroup_num].push_back(std::move(msg.message_buffer));
+                msg.message_buffer.release();
                 locally_stable_rdmc_messages[subgroup_num].erase(rdmc_msg_ptr);
             } else {
                 dbg_default_trace("Subgroup {}, deliver_messages_upto delivering an SST message with seq_num = {}",
@@ -738,7 +804,7 @@ void MulticastGroup::sst_receive_handler(subgroup_id_t subgroup_num, const Subgr
                     auto it2 = locally_stable_rdmc_messages[subgroup_num].begin();
                     assert(it2->first == seq_num);
                     auto& msg = it2->second;
-                    uint8_t* buf = msg.message_buffer.buffer.get();
+                    uint8_t* buf = msg.message_buffer.buffer;
                     header* h = (header*)(buf);
                     if(msg.size > h->header_size && !(h->cooked_send) && callbacks.global_stability_callback) {
                         callbacks.global_stability_callback(subgroup_num, msg.sender_id,
@@ -746,10 +812,10 @@ void MulticastGroup::sst_receive_handler(subgroup_id_t subgroup_num, const Subgr
                                                             {{buf + h->header_size, msg.size - h->header_size}},
                                                             persistent::INVALID_VERSION);
                     }
-                    free_message_buffers[subgroup_num].push_back(std::move(msg.message_buffer));
                     if(node_id == members[member_index]) {
                         pending_message_timestamps[subgroup_num].erase(h->timestamp);
                     }
+                    msg.message_buffer.release();
                     locally_stable_rdmc_messages[subgroup_num].erase(it2);
                 }
             }
@@ -846,7 +912,7 @@ void MulticastGroup::delivery_trigger(subgroup_id_t subgroup_num, const Subgroup
                 dbg_default_trace("Subgroup {}, can deliver a locally stable RDMC message: min_stable_num={} and least_undelivered_seq_num={}",
                                   subgroup_num, min_stable_num, least_undelivered_rdmc_seq_num);
                 RDMCMessage& msg = locally_stable_rdmc_messages[subgroup_num].begin()->second;
-                uint8_t* buf = msg.message_buffer.buffer.get();
+                uint8_t* buf = msg.message_buffer.buffer;
                 uint64_t msg_ts = ((header*)buf)->timestamp;
                 //Note: deliver_message frees the RDMC buffer in msg, which is why the timestamp must be saved before calling this
                 assigned_version = persistent::combine_int32s(sst.vid[member_index], least_undelivered_rdmc_seq_num);
@@ -854,7 +920,7 @@ void MulticastGroup::delivery_trigger(subgroup_id_t subgroup_num, const Subgroup
                 delivered_version[subgroup_num]->store(assigned_version,std::memory_order_release);
                 non_null_msgs_delivered |= version_message(msg, subgroup_num, assigned_version, msg_ts);
                 // free the message buffer only after version_message has been called
-                free_message_buffers[subgroup_num].push_back(std::move(msg.message_buffer));
+                msg.message_buffer.release();
                 sst.delivered_num[member_index][subgroup_num] = least_undelivered_rdmc_seq_num;
                 locally_stable_rdmc_messages[subgroup_num].erase(locally_stable_rdmc_messages[subgroup_num].begin());
             } else if(least_undelivered_sst_seq_num < least_undelivered_rdmc_seq_num && least_undelivered_sst_seq_num <= min_stable_num) {
@@ -1053,7 +1119,7 @@ void MulticastGroup::register_predicates() {
                     return true;
                 };
                 auto sender_trig = [=](DerechoSST& sst) {
-                    sender_cv.notify_all();
+                    notify_sender(subgroup_num);
                     next_message_to_deliver[subgroup_num]++;
                 };
                 sender_pred_handles.emplace_back(sst->predicates.insert(sender_pred, sender_trig,
@@ -1072,8 +1138,8 @@ void MulticastGroup::register_predicates() {
                     }
                     return true;
                 };
-                auto sender_trig = [this](DerechoSST& sst) {
-                    sender_cv.notify_all();
+                auto sender_trig = [this, subgroup_num](DerechoSST& sst) {
+                    notify_sender(subgroup_num);
                 };
                 sender_pred_handles.emplace_back(sst->predicates.insert(sender_pred, sender_trig,
                                                                         sst::PredicateType::RECURRENT));
@@ -1117,14 +1183,22 @@ void MulticastGroup::wedge() {
         rdmc::destroy_group(i + rdmc_group_num_offset);
     }
 
-    sender_cv.notify_all();
-    if(sender_thread.joinable()) {
-        sender_thread.join();
+    for(auto& sender : sender_threads) {
+        sender->cv.notify_all();
+        if(sender->thread.joinable()) {
+            sender->thread.join();
+        }
     }
 }
 
-void MulticastGroup::send_loop() {
+void MulticastGroup::wedge_subgroups(const std::set<subgroup_id_t>& subgroups) {
+    std::lock_guard<std::recursive_mutex> lock(msg_state_mtx);
+    wedged_subgroups.insert(subgroups.begin(), subgroups.end());
+}
+
+void MulticastGroup::send_loop(SenderThread& sender) {
     pthread_setname_np(pthread_self(), "sender_thread");
+    std::size_t next_subgroup_index = 0;
     subgroup_id_t subgroup_to_send = 0;
     auto should_send_to_subgroup = [&](subgroup_id_t subgroup_num) {
         if(!rdmc_sst_groups_created) {
@@ -1141,7 +1215,9 @@ void MulticastGroup::send_loop() {
         uint32_t num_shard_senders = get_num_senders(shard_senders);
         assert(shard_sender_index >= 0);
 
-        if(sst->num_received[member_index][subgroup_settings.num_received_offset + shard_sender_index] < msg.index - 1) {
+        // Up to max_rdmc_messages_in_flight of our own messages may still be in RDMC
+        if(sst->num_received[member_index][subgroup_settings.num_received_offset + shard_sender_index]
+           < msg.index - static_cast<int32_t>(max_rdmc_messages_in_flight)) {
             return false;
         }
 
@@ -1167,10 +1243,11 @@ void MulticastGroup::send_loop() {
         return true;
     };
     auto should_send = [&]() {
-        for(uint i = 1; i <= total_num_subgroups; ++i) {
-            auto subgroup_num = (subgroup_to_send + i) % total_num_subgroups;
+        for(std::size_t i = 0; i < sender.subgroups.size(); ++i) {
+            auto subgroup_num = sender.subgroups[(next_subgroup_index + i) % sender.subgroups.size()];
             if(should_send_to_subgroup(subgroup_num)) {
                 subgroup_to_send = subgroup_num;
+                next_subgroup_index = (next_subgroup_index + i + 1) % sender.subgroups.size();
                 return true;
             }
         }
@@ -1179,28 +1256,97 @@ void MulticastGroup::send_loop() {
     auto should_wake = [&]() { return thread_shutdown || should_send(); };
     std::unique_lock<std::recursive_mutex> lock(msg_state_mtx);
     while(!thread_shutdown) {
-        sender_cv.wait(lock, should_wake);
+        sender.cv.wait(lock, should_wake);
         if(!thread_shutdown) {
-            current_sends[subgroup_to_send] = std::move(pending_sends[subgroup_to_send].front());
+            current_sends[subgroup_to_send].push_back(std::move(pending_sends[subgroup_to_send].front()));
+            pending_sends[subgroup_to_send].pop();
+            RDMCMessage& msg = current_sends[subgroup_to_send].back();
             dbg_default_trace("Calling send in subgroup {} on message {} from sender {}",
-                              subgroup_to_send, current_sends[subgroup_to_send]->index, current_sends[subgroup_to_send]->sender_id);
+                              subgroup_to_send, msg.index, msg.sender_id);
             // make sure there are > 1 members before issuing RDMC send
             if(subgroup_settings_map.at(subgroup_to_send).members.size() > 1) {
-                if(!rdmc::send(subgroup_to_rdmc_group.at(subgroup_to_send),
-                               current_sends[subgroup_to_send]->message_buffer.mr, 0,
-                               current_sends[subgroup_to_send]->size)) {
+                // Post the send without holding msg_state_mtx, so that the sender threads of
+                // other subgroups can send at the same time, and so that msg_state_mtx is never
+                // held while waiting for an RDMC group's lock: RDMC's polling thread may hold
+                // that lock while the receive upcall takes msg_state_mtx. The receivers' readies
+                // may already be posted, so the message can complete on the polling thread
+                // before rdmc::send returns. That is safe because the message is already in
+                // current_sends and nothing below touches msg; no other thread sends in this
+                // subgroup.
+                const uint32_t rdmc_group_num = subgroup_to_rdmc_group.at(subgroup_to_send);
+                std::shared_ptr<rdma::memory_region> mr = msg.message_buffer.mr;
+                const std::size_t offset = msg.message_buffer.offset;
+                const std::size_t size = msg.size;
+                lock.unlock();
+                const bool sent = rdmc::send(rdmc_group_num, mr, offset, size);
+                lock.lock();
+                if(!sent) {
                     throw std::runtime_error("rdmc::send returned false");
                 }
             } else {
                 // receive the message right here
                 singleton_shard_receive_handlers.at(subgroup_to_send)(
-                        current_sends[subgroup_to_send]->message_buffer.buffer.get(), current_sends[subgroup_to_send]->size);
+                        msg.message_buffer.buffer, msg.size);
             }
-            pending_sends[subgroup_to_send].pop();
         }
     }
 }
 
+void MulticastGroup::assign_sender_threads() {
+    const uint32_t num_sender_threads = std::max(1u, getConfUInt32(Conf::DERECHO_NUM_SENDER_THREADS));
+    subgroup_sender_threads.resize(total_num_subgroups);
+    for(subgroup_id_t subgroup_num = 0; subgroup_num < total_num_subgroups; ++subgroup_num) {
+        subgroup_sender_threads[subgroup_num] = subgroup_num % num_sender_threads;
+    }
+    // DERECHO/sender_thread_subgroups is a comma-separated list of <subgroup_id>:<thread> entries
+    const std::string& assignments = getConfString(Conf::DERECHO_SENDER_THREAD_SUBGROUPS);
+    std::size_t start = 0;
+    while(start < assignments.size()) {
+        std::size_t end = assignments.find(',', start);
+        if(end == std::string::npos) end = assignments.size();
+        std::string entry = assignments.substr(start, end - start);
+        start = end + 1;
+        if(entry.find_first_not_of(" \t") == std::string::npos) continue;
+
+        std::size_t colon = entry.find(':');
+        unsigned long subgroup_num, thread_index;
+        try {
+            if(colon == std::string::npos) throw std::invalid_argument(entry);
+            subgroup_num = std::stoul(entry.substr(0, colon));
+            thread_index = std::stoul(entry.substr(colon + 1));
+        } catch(std::logic_error&) {
+            throw derecho_exception("Malformed entry in sender_thread_subgroups: " + entry);
+        }
+        if(thread_index >= num_sender_threads) {
+            throw derecho_exception("sender_thread_subgroups assigns a subgroup to thread " + std::to_string(thread_index)
+                                    + ", but num_sender_threads is " + std::to_string(num_sender_threads));
+        }
+        // Entries for subgroups that do not exist in this group are ignored
+        if(subgroup_num < total_num_subgroups) {
+            subgroup_sender_threads[subgroup_num] = thread_index;
+        }
+    }
+
+    for(uint32_t thread_index = 0; thread_index < num_sender_threads; ++thread_index) {
+        sender_threads.emplace_back(std::make_unique<SenderThread>());
+    }
+    for(subgroup_id_t subgroup_num = 0; subgroup_num < total_num_subgroups; ++subgroup_num) {
+        sender_threads[subgroup_sender_threads[subgroup_num]]->subgroups.push_back(subgroup_num);
+    }
+}
+
+void MulticastGroup::start_sender_threads() {
+    for(auto& sender : sender_threads) {
+        if(!sender->subgroups.empty()) {
+            sender->thread = std::thread(&MulticastGroup::send_loop, this, std::ref(*sender));
+        }
+    }
+}
+
+void MulticastGroup::notify_sender(subgroup_id_t subgroup_num) {
+    sender_threads[subgroup_sender_threads[subgroup_num]]->cv.notify_all();
+}
+
 const uint64_t MulticastGroup::compute_global_stability_frontier(uint32_t subgroup_num) const {
     uint64_t global_stability_frontier = sst->local_stability_frontier[member_index][subgroup_num];
     auto shard_sst_indices = get_shard_sst_indices(subgroup_num);
@@ -1239,9 +1385,38 @@ const persistent::version_t MulticastGroup::get_global_verified_frontier(uint32_
 
 void MulticastGroup::check_failures_loop() {
     pthread_setname_np(pthread_self(), "timeout_thread");
+    // The sum of the multicast progress counters last seen in each member's row.
+    // The counters only grow, and only the member's sends, receives and
+    // deliveries write them, so a change means the member wrote to this node for
+    // a reason other than its heartbeat, which counts as a heartbeat.
+    // local_stability_frontier is left out, since the heartbeat itself writes it.
+    std::vector<std::optional<int64_t>> last_seen_progress(num_members);
+    const uint my_row = static_cast<uint>(member_index);
+    std::chrono::milliseconds heartbeat_interval(sender_timeout);
     while(!thread_shutdown) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(sender_timeout));
+        std::this_thread::sleep_for(heartbeat_interval);
         if(sst) {
+            const auto now = std::chrono::steady_clock::now();
+            for(uint row = 0; row < num_members; ++row) {
+                if(row == my_row) {
+                    continue;
+                }
+                int64_t progress = 0;
+                for(uint32_t subgroup_num = 0; subgroup_num < sst->seq_num.size(); ++subgroup_num) {
+                    progress += sst->seq_num[row][subgroup_num];
+                    progress += sst->delivered_num[row][subgroup_num];
+                }
+                for(uint32_t i = 0; i < sst->num_received.size(); ++i) {
+                    progress += sst->num_received[row][i];
+                }
+                for(uint32_t i = 0; i < sst->index.size(); ++i) {
+                    progress += sst->index[row][i];
+                }
+                if(last_seen_progress[row] && progress != *last_seen_progress[row]) {
+                    failure_detector->heartbeat(members[row], now);
+                }
+                last_seen_progress[row] = progress;
+            }
             {
                 std::unique_lock<std::recursive_mutex> lock(msg_state_mtx);
                 auto current_time = get_walltime();
@@ -1268,8 +1443,22 @@ void MulticastGroup::check_failures_loop() {
                     }
                 }
             }
-            sst->put_with_completion((uint8_t*)std::addressof(sst->local_stability_frontier[0][0]) - sst->getBaseAddress(),
-                                     sizeof(sst->local_stability_frontier[0][0]) * sst->local_stability_frontier.size());
+            std::vector<uint32_t> acknowledged_rows;
+            std::vector<uint32_t> timed_out_rows = sst->try_put_with_completion(
+                    (uint8_t*)std::addressof(sst->local_stability_frontier[0][0]) - sst->getBaseAddress(),
+                    sizeof(sst->local_stability_frontier[0][0]) * sst->local_stability_frontier.size(),
+                    &acknowledged_rows);
+            const auto completion_time = std::chrono::steady_clock::now();
+            for(uint32_t row : acknowledged_rows) {
+                failure_detector->heartbeat(members[row], completion_time);
+            }
+            // A timed-out heartbeat only means failure if the detector suspects the node
+            for(uint32_t row : timed_out_rows) {
+                if(failure_detector->should_suspect(members[row], completion_time)) {
+                    sst->freeze(row);
+                }
+            }
+            heartbeat_interval = failure_detector->next_heartbeat_interval(timed_out_rows.empty());
         }
     }
 }
@@ -1288,14 +1477,13 @@ void MulticastGroup::get_buffer_and_send_auto_null(subgroup_id_t subgroup_num) {
         msg.sender_id = members[member_index];
         msg.index = future_message_indices[subgroup_num];
         msg.size = msg_size;
-        msg.message_buffer = std::move(free_message_buffers[subgroup_num].back());
-        free_message_buffers[subgroup_num].pop_back();
+        msg.message_buffer = buffer_pool->acquire(msg_size);
 
         auto current_time = get_walltime();
         pending_message_timestamps[subgroup_num].insert(current_time);
 
         // Fill header
-        uint8_t* buf = msg.message_buffer.buffer.get();
+        uint8_t* buf = msg.message_buffer.buffer;
         ((header*)buf)->header_size = sizeof(header);
         ((header*)buf)->index = msg.index;
         ((header*)buf)->timestamp = current_time;
@@ -1303,7 +1491,7 @@ void MulticastGroup::get_buffer_and_send_auto_null(subgroup_id_t subgroup_num) {
 
         future_message_indices[subgroup_num]++;
         pending_sends[subgroup_num].push(std::move(msg));
-        sender_cv.notify_all();
+        notify_sender(subgroup_num);
     } else {
         uint8_t* buf = (uint8_t*)sst_multicast_group_ptrs[subgroup_num]->get_buffer(msg_size);
 
@@ -1338,6 +1526,9 @@ uint8_t* MulticastGroup::get_sendbuffer_ptr(subgroup_id_t subgroup_num,
         exp_msg += std::to_string(subgroup_settings.profile.max_msg_size);
         throw derecho_exception(exp_msg);
     }
+    if(wedged_subgroups.count(subgroup_num) > 0) {
+        return nullptr;
+    }
 
     std::vector<node_id_t> shard_members = subgroup_settings.members;
     auto num_shard_members = shard_members.size();
@@ -1365,42 +1556,13 @@ uint8_t* MulticastGroup::get_sendbuffer_ptr(subgroup_id_t subgroup_num,
         }
     }
 
-    if(msg_size > subgroup_settings.profile.sst_max_msg_size) {
-        if(thread_shutdown) {
-            return nullptr;
-        }
-
-        if(free_message_buffers[subgroup_num].empty()) {
-            return nullptr;
-        }
-
-        if(smc_send_in_progress[subgroup_num] || next_sends[subgroup_num]) {
-            return nullptr;
-        }
-
-        // Create new Message
-        RDMCMessage msg;
-        msg.sender_id = members[member_index];
-        msg.index = future_message_indices[subgroup_num];
-        msg.size = msg_size;
-        msg.message_buffer = std::move(free_message_buffers[subgroup_num].back());
-        free_message_buffers[subgroup_num].pop_back();
-
-        auto current_time = get_walltime();
-        pending_message_timestamps[subgroup_num].insert(current_time);
-
-        // Fill header
-        uint8_t* buf = msg.message_buffer.buffer.get();
-        ((header*)buf)->header_size = sizeof(header);
-        ((header*)buf)->index = msg.index;
-        ((header*)buf)->timestamp = current_time;
-        ((header*)buf)->cooked_send = cooked_send;
-
-        next_sends[subgroup_num] = std::move(msg);
-        future_message_indices[subgroup_num]++;
-
-        last_transfer_medium[subgroup_num] = true;
-        return buf + sizeof(header);
+    // Messages that do not fit in an SMC slot always go through RDMC. With
+    // hybrid multicast, a message that does fit goes through RDMC if it is
+    // large or if all the SMC slots are taken, as long as RDMC is idle.
+    const bool rdmc_available = subgroup_settings.profile.max_msg_size > subgroup_settings.profile.sst_max_msg_size;
+    if(msg_size > subgroup_settings.profile.sst_max_msg_size
+       || (hybrid_multicast && rdmc_available && msg_size >= hybrid_rdmc_min_size && rdmc_has_room(subgroup_num))) {
+        return get_rdmc_sendbuffer_ptr(subgroup_num, msg_size, cooked_send);
     } else {
         if(smc_send_in_progress[subgroup_num] || next_sends[subgroup_num]) {
             return nullptr;
@@ -1414,6 +1576,9 @@ uint8_t* MulticastGroup::get_sendbuffer_ptr(subgroup_id_t subgroup_num,
         uint8_t* buf = (uint8_t*)sst_multicast_group_ptrs[subgroup_num]->get_buffer(msg_size);
         if(!buf) {
             smc_send_in_progress[subgroup_num] = false;
+            if(hybrid_multicast && rdmc_available && rdmc_has_room(subgroup_num)) {
+                return get_rdmc_sendbuffer_ptr(subgroup_num, msg_size, cooked_send);
+            }
             return nullptr;
         }
         auto current_time = get_walltime();
@@ -1433,6 +1598,47 @@ uint8_t* MulticastGroup::get_sendbuffer_ptr(subgroup_id_t subgroup_num,
     }
 }
 
+uint8_t* MulticastGroup::get_rdmc_sendbuffer_ptr(subgroup_id_t subgroup_num,
+                                                 long long unsigned int msg_size,
+                                                 bool cooked_send) {
+    if(thread_shutdown) {
+        return nullptr;
+    }
+
+    if(smc_send_in_progress[subgroup_num] || next_sends[subgroup_num]) {
+        return nullptr;
+    }
+
+    // Create new Message
+    RDMCMessage msg;
+    msg.sender_id = members[member_index];
+    msg.index = future_message_indices[subgroup_num];
+    msg.size = msg_size;
+    msg.message_buffer = buffer_pool->acquire(msg_size);
+
+    auto current_time = get_walltime();
+    pending_message_timestamps[subgroup_num].insert(current_time);
+
+    // Fill header
+    uint8_t* buf = msg.message_buffer.buffer;
+    ((header*)buf)->header_size = sizeof(header);
+    ((header*)buf)->index = msg.index;
+    ((header*)buf)->timestamp = current_time;
+    ((header*)buf)->cooked_send = cooked_send;
+
+    next_sends[subgroup_num] = std::move(msg);
+    future_message_indices[subgroup_num]++;
+
+    last_transfer_medium[subgroup_num] = true;
+    return buf + sizeof(header);
+}
+
+bool MulticastGroup::rdmc_has_room(subgroup_id_t subgroup_num) const {
+    // The send thread can pass a new message to RDMC right away
+    return pending_sends[subgroup_num].empty()
+           && current_sends[subgroup_num].size() < max_rdmc_messages_in_flight;
+}
+
 bool MulticastGroup::send(subgroup_id_t subgroup_num, long long unsigned int payload_size,
                           const std::function<void(uint8_t* buf)>& msg_generator, bool cooked_send) {
     if(!rdmc_sst_groups_created) {
@@ -1459,7 +1665,7 @@ bool MulticastGroup::send(subgroup_id_t subgroup_num, long long unsigned int pay
         assert(next_sends[subgroup_num]);
         pending_sends[subgroup_num].push(std::move(*next_sends[subgroup_num]));
         next_sends[subgroup_num] = std::nullopt;
-        sender_cv.notify_all();
+        notify_sender(subgroup_num);
         return true;
     } else {
         committed_sst_index[subgroup_num]++;
@@ -1506,9 +1712,15 @@ void MulticastGroup::debug_print() {
         cout << endl;
     }
 
-    std::cout << "Printing memory usage of free_message_buffers" << std::endl;
-    for(const auto& p : free_message_buffers) {
-        std::cout << "Subgroup " << p.first << ", Number of free buffers " << p.second.size() << std::endl;
+    std::cout << "Printing memory usage of the RDMC buffer pool" << std::endl;
+    const BufferPoolStats pool_stats = buffer_pool->get_stats();
+    std::cout << "Registered bytes " << pool_stats.registered_bytes << " (peak " << pool_stats.peak_registered_bytes
+              << "), bytes in use " << pool_stats.in_use_bytes << ", arenas " << pool_stats.num_arenas
+              << " (" << pool_stats.num_hugepage_arenas << " on huge pages)" << std::endl;
+    for(const auto& size_class : pool_stats.size_classes) {
+        std::cout << "Buffer size " << size_class.buffer_size << ", arenas " << size_class.num_arenas
+                  << ", buffers in use " << size_class.buffers_in_use
+                  << ", free buffers " << size_class.free_buffers << std::endl;
     }
 }
 
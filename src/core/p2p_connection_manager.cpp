@@ -6,6 +6,7 @@
 #include <derecho/utils/logger.hpp>
 
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <mutex>
 #include <optional>
@@ -20,7 +21,8 @@ P2PConnectionManager::P2PConnectionManager(const P2PParams params)
           rpc_logger(spdlog::get(LoggerFactory::RPC_LOGGER_NAME)),
           p2p_connections(derecho::getConfUInt32(derecho::Conf::DERECHO_MAX_NODE_ID)),
           active_p2p_connections(new char[derecho::getConfUInt32(derecho::Conf::DERECHO_MAX_NODE_ID)]),
-          failure_upcall(params.failure_upcall) {
+          failure_upcall(params.failure_upcall),
+          failure_detector(derecho::make_failure_detector(derecho::getConfUInt32(derecho::Conf::DERECHO_HEARTBEAT_MS))) {
     // HARD-CODED. Adding another request type will break this
 
     request_params.window_sizes[P2P_REPLY] = params.p2p_window_size;
@@ -71,6 +73,7 @@ void P2PConnectionManager::remove_connections(const std::vector<node_id_t>& node
         std::lock_guard<std::mutex> connection_lock(p2p_connections[remote_id].first);
         p2p_connections[remote_id].second = nullptr;
         active_p2p_connections[remote_id] = false;
+        failure_detector->remove(remote_id);
     }
 }
 
@@ -130,6 +133,7 @@ std::optional<MessagePointer> P2PConnectionManager::probe_all() {
         // If we only test buf[0], it will fall in the wrong path if the least significant byte of the payload size is
         // zero.
         if(buf_type_pair && reinterpret_cast<size_t*>(buf_type_pair->first)[0] != 0) {
+            failure_detector->heartbeat(node_id, std::chrono::steady_clock::now());
             return MessagePointer{node_id, buf_type_pair->first, buf_type_pair->second};
         } else if(buf_type_pair) {
             // this means that we have a null reply
@@ -171,17 +175,20 @@ void P2PConnectionManager::check_failures_loop() {
 
     uint16_t tick_count = 0;
     const uint16_t one_second_count = 1000 / heartbeat_ms;
+    auto last_periodic_check = std::chrono::steady_clock::now();
+    // A write that timed out can still complete after its round is over, so
+    // the contexts are kept for the lifetime of the thread
+#ifdef USE_VERBS_API
+    std::map<uint32_t, verbs_sender_ctxt> ce_ctxt;
+#else
+    std::map<uint32_t, lf_completion_entry_ctxt> ce_ctxt;
+#endif
     while(!thread_shutdown) {
         std::this_thread::sleep_for(std::chrono::milliseconds(heartbeat_ms));
         tick_count++;
         std::unordered_set<node_id_t> posted_write_to;
 
         util::polling_data.set_waiting(tid);
-#ifdef USE_VERBS_API
-        std::map<uint32_t, verbs_sender_ctxt> ce_ctxt;
-#else
-        std::map<uint32_t, lf_completion_entry_ctxt> ce_ctxt;
-#endif
 
         for(node_id_t node_id = 0; node_id < p2p_connections.size(); ++node_id) {
             if(!active_p2p_connections[node_id]) continue;
@@ -194,6 +201,10 @@ void P2PConnectionManager::check_failures_loop() {
             if(node_id == my_node_id || (p2p_connections[node_id].second->num_rdma_writes < 1000 && tick_count < one_second_count)) {
                 continue;
             }
+            // skip the periodic check if a message from the node arrived since the last one
+            if(tick_count >= one_second_count && failure_detector->heard_from_since(node_id, last_periodic_check)) {
+                continue;
+            }
             p2p_connections[node_id].second->num_rdma_writes = 0;
             ce_ctxt[node_id].set_remote_id(node_id);
             ce_ctxt[node_id].set_ce_idx(ce_idx);
@@ -205,6 +216,7 @@ void P2PConnectionManager::check_failures_loop() {
         }
         if(tick_count >= one_second_count) {
             tick_count = 0;
+            last_periodic_check = std::chrono::steady_clock::now();
         }
 
         // track which nodes respond successfully
@@ -237,9 +249,10 @@ void P2PConnectionManager::check_failures_loop() {
                 }
             }
 
-            if (result && result.value() == 1) {
+            if(result && result.value() == 1) {
                 polled_successfully_from.insert(nid);
-            } else {
+                failure_detector->heartbeat(nid, std::chrono::steady_clock::now());
+            } else if(result || failure_detector->should_suspect(nid, std::chrono::steady_clock::now())) {
                 failed_nodes.push_back(nid);
             }
         }
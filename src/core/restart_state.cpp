@@ -8,6 +8,9 @@
 #include <derecho/persistent/Persistent.hpp>
 
 #include <chrono>
+#include <exception>
+#include <future>
+#include <list>
 #include <optional>
 
 namespace derecho {
@@ -16,6 +19,10 @@ void RestartState::load_ragged_trim(const View& curr_view) {
     auto vm_logger = spdlog::get(LoggerFactory::VIEWMANAGER_LOGGER_NAME);
     //If this method is called more than once, it should be idempotent
     logged_ragged_trim.clear();
+    /* Each subgroup's ragged trim is loaded from its own file, or synthesized by
+     * scanning its own object's logs, so the subgroups can be processed concurrently.
+     * The results are collected in order below, since logged_ragged_trim is not thread-safe. */
+    std::vector<std::future<std::unique_ptr<RaggedTrim>>> subgroup_trims;
     /* Iterate through all subgroups by type, rather than iterating through my_subgroups,
      * so that I have access to the type ID. This wastes time, but I don't have a map
      * from subgroup ID to subgroup_type_id within curr_view. */
@@ -27,42 +34,64 @@ void RestartState::load_ragged_trim(const View& curr_view) {
             if(subgroup_shard_ptr != curr_view.my_subgroups.end()) {
                 //If the subgroup ID is in my_subgroups, its value is this node's shard number
                 uint32_t shard_num = subgroup_shard_ptr->second;
-                std::unique_ptr<RaggedTrim> ragged_trim = persistent::loadObject<RaggedTrim>(
-                        ragged_trim_filename(subgroup_id, shard_num).c_str());
-                //If there was a logged ragged trim from an obsolete View, it's the same as not having a logged ragged trim
-                if(ragged_trim == nullptr || ragged_trim->vid < curr_view.vid) {
-                    dbg_debug(vm_logger, "No ragged trim information found for subgroup {}, synthesizing it from logs", subgroup_id);
-                    //Get the latest persisted version number from this subgroup's object's log
-                    //(this requires converting the type ID to a std::type_index)
-                    persistent::version_t last_persisted_version = persistent::getMinimumLatestPersistedVersion(curr_view.subgroup_type_order.at(type_id_and_indices.first),
-                                                                                                                subgroup_index, shard_num);
-                    if(last_persisted_version == persistent::INVALID_VERSION) {
-                        //There was no persistent file for this object; it must have been a volatile subgroup
-                        continue;
+                subgroup_type_id_t subgroup_type_id = type_id_and_indices.first;
+                subgroup_trims.emplace_back(std::async(std::launch::async, [&curr_view, vm_logger, subgroup_id, subgroup_type_id, subgroup_index, shard_num]() {
+                    std::unique_ptr<RaggedTrim> ragged_trim = persistent::loadObject<RaggedTrim>(
+                            ragged_trim_filename(subgroup_id, shard_num).c_str());
+                    //If there was a logged ragged trim from an obsolete View, it's the same as not having a logged ragged trim
+                    if(ragged_trim == nullptr || ragged_trim->vid < curr_view.vid) {
+                        dbg_debug(vm_logger, "No ragged trim information found for subgroup {}, synthesizing it from logs", subgroup_id);
+                        //Get the latest persisted version number from this subgroup's object's log
+                        //(this requires converting the type ID to a std::type_index)
+                        persistent::version_t last_persisted_version = persistent::getMinimumLatestPersistedVersion(curr_view.subgroup_type_order.at(subgroup_type_id),
+                                                                                                                    subgroup_index, shard_num);
+                        if(last_persisted_version == persistent::INVALID_VERSION) {
+                            //There was no persistent file for this object; it must have been a volatile subgroup
+                            return std::unique_ptr<RaggedTrim>();
+                        }
+                        int32_t last_vid, last_seq_num;
+                        std::tie(last_vid, last_seq_num) = persistent::unpack_version<int32_t>(last_persisted_version);
+                        //Divide the sequence number into sender rank and message counter
+                        uint32_t num_shard_senders = curr_view.subgroup_shard_views.at(subgroup_id).at(shard_num).num_senders();
+                        int32_t last_message_counter = last_seq_num / num_shard_senders;
+                        uint32_t last_sender = last_seq_num % num_shard_senders;
+                        /* Fill max_received_by_sender: In round-robin order, all senders ranked below
+                         * the last sender delivered last_message_counter, while all senders ranked above
+                         * the last sender have only delivered last_message_counter-1. */
+                        std::vector<int32_t> max_received_by_sender(num_shard_senders);
+                        for(uint sender_rank = 0; sender_rank <= last_sender; ++sender_rank) {
+                            max_received_by_sender[sender_rank] = last_message_counter;
+                        }
+                        for(uint sender_rank = last_sender + 1; sender_rank < num_shard_senders; ++sender_rank) {
+                            max_received_by_sender[sender_rank] = last_message_counter - 1;
+                        }
+                        ragged_trim = std::make_unique<RaggedTrim>(subgroup_id, shard_num, last_vid, -1, max_received_by_sender);
                     }
-                    int32_t last_vid, last_seq_num;
-                    std::tie(last_vid, last_seq_num) = persistent::unpack_version<int32_t>(last_persisted_version);
-                    //Divide the sequence number into sender rank and message counter
-                    uint32_t num_shard_senders = curr_view.subgroup_shard_views.at(subgroup_id).at(shard_num).num_senders();
-                    int32_t last_message_counter = last_seq_num / num_shard_senders;
-                    uint32_t last_sender = last_seq_num % num_shard_senders;
-                    /* Fill max_received_by_sender: In round-robin order, all senders ranked below
-                     * the last sender delivered last_message_counter, while all senders ranked above
-                     * the last sender have only delivered last_message_counter-1. */
-                    std::vector<int32_t> max_received_by_sender(num_shard_senders);
-                    for(uint sender_rank = 0; sender_rank <= last_sender; ++sender_rank) {
-                        max_received_by_sender[sender_rank] = last_message_counter;
-                    }
-                    for(uint sender_rank = last_sender + 1; sender_rank < num_shard_senders; ++sender_rank) {
-                        max_received_by_sender[sender_rank] = last_message_counter - 1;
-                    }
-                    ragged_trim = std::make_unique<RaggedTrim>(subgroup_id, shard_num, last_vid, -1, max_received_by_sender);
-                }
+                    return ragged_trim;
+                }));
+            }  // if(subgroup_shard_ptr != curr_view->my_subgroups.end())
+        }      // for(subgroup_index)
+    }
+    //Wait for every subgroup before rethrowing a failure, so no task outlives curr_view
+    std::exception_ptr load_error;
+    for(auto& subgroup_trim : subgroup_trims) {
+        try {
+            std::unique_ptr<RaggedTrim> ragged_trim = subgroup_trim.get();
+            if(ragged_trim) {
+                subgroup_id_t subgroup_id = ragged_trim->subgroup_id;
+                uint32_t shard_num = ragged_trim->shard_num;
                 //operator[] is intentional: default-construct an inner std::map at subgroup_id
                 //Note that the inner map will only one entry, except on the restart leader where it will have one for every shard
                 logged_ragged_trim[subgroup_id].emplace(shard_num, std::move(ragged_trim));
-            }  // if(subgroup_shard_ptr != curr_view->my_subgroups.end())
-        }      // for(subgroup_index)
+            }
+        } catch(...) {
+            if(!load_error) {
+                load_error = std::current_exception();
+            }
+        }
+    }
+    if(load_error) {
+        std::rethrow_exception(load_error);
     }
 }
 
@@ -109,78 +138,62 @@ RestartLeaderState::RestartLeaderState(std::unique_ptr<View> _curr_view, Restart
     }
 }
 
+/**
+ * How long await_quorum waits for a new connection at a time before checking
+ * whether any of the rejoin handshakes in progress have finished.
+ */
+static constexpr int REJOIN_POLL_INTERVAL_MS = 10;
+
 void RestartLeaderState::await_quorum(tcp::connection_listener& server_socket) {
+    using namespace std::chrono;
     bool ready_to_restart = false;
+    bool all_members_rejoined = false;
     int time_remaining_ms = getConfUInt32(Conf::DERECHO_RESTART_TIMEOUT_MS);
-    while(time_remaining_ms > 0) {
-        using namespace std::chrono;
-        auto start_time = high_resolution_clock::now();
-        std::optional<tcp::socket> client_socket = server_socket.try_accept(time_remaining_ms);
-        auto end_time = high_resolution_clock::now();
-        milliseconds time_waited = duration_cast<milliseconds>(end_time - start_time);
-        time_remaining_ms -= time_waited.count();
-        if(client_socket) {
-            uint64_t joiner_version_code;
-            client_socket->exchange(my_version_hashcode, joiner_version_code);
-            if(joiner_version_code != my_version_hashcode) {
-                rls_warn(vm_logger, "Rejected a connection from node at {}. Node was running on an incompatible platform or used an incompatible compiler.", client_socket->get_remote_ip());
-                continue;
-            }
-            JoinRequest join_request;
-            try {
-                client_socket->read(join_request);
-                client_socket->write(JoinResponse{JoinResponseCode::TOTAL_RESTART, my_id});
-            } catch(tcp::socket_error& ex) {
-                dbg_debug(vm_logger, "Node at {} disconnected before completing initial handshake", client_socket->get_remote_ip());
-                dbg_trace(vm_logger, "Exception description: {}", ex.what());
-                continue;
-            }
-            dbg_debug(vm_logger, "Node {} rejoined", join_request.joiner_id);
-            if(join_request.is_external) {
-                dbg_debug(vm_logger, "Rejected request from external client {} during total restart", join_request.joiner_id);
-                continue;
+    //Each connecting node's rejoin handshake runs on its own thread
+    std::list<std::future<std::unique_ptr<RejoinMessage>>> pending_rejoins;
+    while(time_remaining_ms > 0 || !pending_rejoins.empty()) {
+        if(time_remaining_ms > 0) {
+            auto start_time = steady_clock::now();
+            std::optional<tcp::socket> client_socket = server_socket.try_accept(
+                    std::min(time_remaining_ms, REJOIN_POLL_INTERVAL_MS));
+            time_remaining_ms -= duration_cast<milliseconds>(steady_clock::now() - start_time).count();
+            if(client_socket) {
+                pending_rejoins.emplace_back(std::async(std::launch::async,
+                                                        [this, socket = std::move(*client_socket)]() mutable {
+                                                            return receive_rejoin(std::move(socket));
+                                                        }));
             }
-            rejoined_node_ids.emplace(join_request.joiner_id);
-            //Receive the joining node's ports - this is part of the standard join logic
-            uint16_t joiner_gms_port = 0;
-            uint16_t joiner_state_transfer_port = 0;
-            uint16_t joiner_sst_port = 0;
-            uint16_t joiner_rdmc_port = 0;
-            uint16_t joiner_external_port = 0;
-            try {
-                client_socket->read(joiner_gms_port);
-                client_socket->read(joiner_state_transfer_port);
-                client_socket->read(joiner_sst_port);
-                client_socket->read(joiner_rdmc_port);
-                client_socket->read(joiner_external_port);
-            } catch(tcp::socket_error& ex) {
-                dbg_debug(vm_logger, "Node {} disconnected while sending its port information", join_request.joiner_id);
-                dbg_trace(vm_logger, "Exception in socket connected to node {}: {}", join_request.joiner_id, ex.what());
-                rejoined_node_ids.erase(join_request.joiner_id);
+        }
+        //Merge the logs of every node whose handshake has finished. Once the timeout
+        //has expired, wait for the remaining handshakes instead of abandoning them.
+        bool any_rejoined = false;
+        for(auto rejoin_iter = pending_rejoins.begin(); rejoin_iter != pending_rejoins.end();) {
+            if(time_remaining_ms > 0 && rejoin_iter->wait_for(seconds(0)) != std::future_status::ready) {
+                ++rejoin_iter;
                 continue;
             }
-            //Receive and process the joining node's logs of the last known View and RaggedTrim
-            bool received = receive_joiner_logs(join_request.joiner_id, *client_socket);
-            if(!received) {
-                rejoined_node_ids.erase(join_request.joiner_id);
-                continue;
+            std::unique_ptr<RejoinMessage> rejoin = rejoin_iter->get();
+            rejoin_iter = pending_rejoins.erase(rejoin_iter);
+            if(rejoin) {
+                merge_joiner_logs(*rejoin);
+                any_rejoined = true;
             }
-
-            const ip_addr_t& joiner_ip = client_socket->get_remote_ip();
-            rejoined_node_ips_and_ports[join_request.joiner_id] = {joiner_ip, joiner_gms_port,
-                                                                   joiner_state_transfer_port, joiner_sst_port,
-                                                                   joiner_rdmc_port, joiner_external_port};
-            //Done receiving from this socket (for now), so store it in waiting_join_sockets for later
-            waiting_join_sockets.emplace(join_request.joiner_id, std::move(*client_socket));
-            //Check for quorum
+        }
+        if(any_rejoined) {
+            //Check for quorum once for all the nodes that just rejoined
             ready_to_restart = has_restart_quorum();
-            //If all the members have rejoined, no need to keep waiting
+            //If all the members have rejoined, no need to keep waiting, except for handshakes in progress
             if(std::includes(rejoined_node_ids.begin(), rejoined_node_ids.end(),
                              last_known_view_members.begin(), last_known_view_members.end())) {
-                return;
+                all_members_rejoined = true;
+                time_remaining_ms = 0;
             }
-        } else if(!ready_to_restart) {
-            //Accept timed out, but we haven't heard from enough nodes yet, so reset the timer
+        }
+        if(all_members_rejoined && pending_rejoins.empty()) {
+            return;
+        }
+        if(time_remaining_ms <= 0 && pending_rejoins.empty() && !ready_to_restart) {
+            //The timeout expired, but we haven't heard from enough nodes yet, so reset the timer
             time_remaining_ms = getConfUInt32(Conf::DERECHO_RESTART_TIMEOUT_MS);
         }
     }
@@ -203,21 +216,79 @@ bool RestartLeaderState::has_restart_quorum() {
     return compute_restart_view();
 }
 
-bool RestartLeaderState::receive_joiner_logs(const node_id_t& joiner_id, tcp::socket& client_socket) {
+std::unique_ptr<RejoinMessage> RestartLeaderState::receive_rejoin(tcp::socket client_socket) {
+    uint64_t joiner_version_code;
+    JoinRequest join_request;
+    try {
+        client_socket.exchange(my_version_hashcode, joiner_version_code);
+        if(joiner_version_code != my_version_hashcode) {
+            rls_warn(vm_logger, "Rejected a connection from node at {}. Node was running on an incompatible platform or used an incompatible compiler.", client_socket.get_remote_ip());
+            return nullptr;
+        }
+        client_socket.read(join_request);
+        client_socket.write(JoinResponse{JoinResponseCode::TOTAL_RESTART, my_id});
+    } catch(tcp::socket_error& ex) {
+        dbg_debug(vm_logger, "Node at {} disconnected before completing initial handshake", client_socket.get_remote_ip());
+        dbg_trace(vm_logger, "Exception description: {}", ex.what());
+        return nullptr;
+    }
+    dbg_debug(vm_logger, "Node {} rejoined", join_request.joiner_id);
+    if(join_request.is_external) {
+        dbg_debug(vm_logger, "Rejected request from external client {} during total restart", join_request.joiner_id);
+        return nullptr;
+    }
+    const node_id_t joiner_id = join_request.joiner_id;
+    auto rejoin = std::make_unique<RejoinMessage>();
+    rejoin->joiner_id = joiner_id;
+    rejoin->ips_and_ports.ip_address = client_socket.get_remote_ip();
+    //Receive the joining node's ports - this is part of the standard join logic
+    try {
+        client_socket.read(rejoin->ips_and_ports.gms_port);
+        client_socket.read(rejoin->ips_and_ports.state_transfer_port);
+        client_socket.read(rejoin->ips_and_ports.sst_port);
+        client_socket.read(rejoin->ips_and_ports.rdmc_port);
+        client_socket.read(rejoin->ips_and_ports.external_port);
+    } catch(tcp::socket_error& ex) {
+        dbg_debug(vm_logger, "Node {} disconnected while sending its port information", joiner_id);
+        dbg_trace(vm_logger, "Exception in socket connected to node {}: {}", joiner_id, ex.what());
+        return nullptr;
+    }
     //Receive the joining node's saved View
-    std::unique_ptr<View> client_view;
     try {
         std::size_t size_of_view;
         client_socket.read(size_of_view);
-        uint8_t view_buffer[size_of_view];
-        client_socket.read(view_buffer, size_of_view);
-        client_view = mutils::from_bytes<View>(nullptr, view_buffer);
+        std::vector<uint8_t> view_buffer(size_of_view);
+        client_socket.read(view_buffer.data(), size_of_view);
+        rejoin->logged_view = mutils::from_bytes<View>(nullptr, view_buffer.data());
     } catch(tcp::socket_error& ex) {
         dbg_debug(vm_logger, "Node {} disconnected before sending its view", joiner_id);
         dbg_trace(vm_logger, "Exception in socket to node {}: {}", joiner_id, ex.what());
-        return false;
+        return nullptr;
     }
+    //Receive the joining node's RaggedTrims
+    try {
+        std::size_t num_of_ragged_trims;
+        client_socket.read(num_of_ragged_trims);
+        for(std::size_t i = 0; i < num_of_ragged_trims; ++i) {
+            std::size_t size_of_ragged_trim;
+            client_socket.read(size_of_ragged_trim);
+            std::vector<uint8_t> buffer(size_of_ragged_trim);
+            client_socket.read(buffer.data(), size_of_ragged_trim);
+            rejoin->ragged_trims.emplace_back(mutils::from_bytes<RaggedTrim>(nullptr, buffer.data()));
+        }
+    } catch(tcp::socket_error& ex) {
+        dbg_debug(vm_logger, "Node {} disconnected while sending its ragged trims", joiner_id);
+        dbg_trace(vm_logger, "Exception in socket to node {}: {}", joiner_id, ex.what());
+        return nullptr;
+    }
+    rejoin->socket = std::move(client_socket);
+    return rejoin;
+}
 
+void RestartLeaderState::merge_joiner_logs(RejoinMessage& rejoin) {
+    const node_id_t joiner_id = rejoin.joiner_id;
+    std::unique_ptr<View>& client_view = rejoin.logged_view;
+    rejoined_node_ids.emplace(joiner_id);
     if(client_view->vid > curr_view->vid) {
         dbg_trace(vm_logger, "Node {} had newer view {}, replacing view {} and discarding ragged trim",
                   joiner_id, client_view->vid, curr_view->vid);
@@ -233,28 +304,7 @@ bool RestartLeaderState::receive_joiner_logs(const node_id_t& joiner_id, tcp::so
             }
         }
     }
-    //Receive the joining node's RaggedTrims
-    std::size_t num_of_ragged_trims;
-    try {
-        client_socket.read(num_of_ragged_trims);
-    } catch(tcp::socket_error& ex) {
-        dbg_debug(vm_logger, "Node {} disconnected before sending its ragged trims", joiner_id);
-        dbg_trace(vm_logger, "Exception in socket to node {}: {}", joiner_id, ex.what());
-        return false;
-    }
-    for(std::size_t i = 0; i < num_of_ragged_trims; ++i) {
-        std::unique_ptr<RaggedTrim> ragged_trim;
-        try {
-            std::size_t size_of_ragged_trim;
-            client_socket.read(size_of_ragged_trim);
-            uint8_t buffer[size_of_ragged_trim];
-            client_socket.read(buffer, size_of_ragged_trim);
-            ragged_trim = mutils::from_bytes<RaggedTrim>(nullptr, buffer);
-        } catch(tcp::socket_error& ex) {
-            dbg_debug(vm_logger, "Node {} disconnected while sending its ragged trims", joiner_id);
-            dbg_trace(vm_logger, "Exception in socket to node {}: {}", joiner_id, ex.what());
-            return false;
-        }
+    for(std::unique_ptr<RaggedTrim>& ragged_trim : rejoin.ragged_trims) {
         dbg_trace(vm_logger, "Received ragged trim for subgroup {}, shard {} from node {}",
                   ragged_trim->subgroup_id, ragged_trim->shard_num, joiner_id);
         /* If the joining node has an obsolete View, we only care about the
@@ -299,7 +349,34 @@ bool RestartLeaderState::receive_joiner_logs(const node_id_t& joiner_id, tcp::so
         last_known_view_members.clear();
         last_known_view_members.insert(curr_view->members.begin(), curr_view->members.end());
     }
-    return true;
+    rejoined_node_ips_and_ports[joiner_id] = rejoin.ips_and_ports;
+    //Done receiving from this socket (for now), so store it in waiting_join_sockets for later
+    waiting_join_sockets.emplace(joiner_id, std::move(rejoin.socket));
+}
+
+int64_t RestartLeaderState::for_each_waiting_socket(const std::function<void(node_id_t, tcp::socket&)>& operation) {
+    std::vector<std::pair<node_id_t, std::future<void>>> operations;
+    for(auto& id_socket_pair : waiting_join_sockets) {
+        operations.emplace_back(id_socket_pair.first,
+                                std::async(std::launch::async, operation,
+                                           id_socket_pair.first, std::ref(id_socket_pair.second)));
+    }
+    int64_t failed_node = -1;
+    for(auto& id_operation_pair : operations) {
+        const node_id_t node_id = id_operation_pair.first;
+        try {
+            id_operation_pair.second.get();
+        } catch(tcp::socket_error& e) {
+            dbg_debug(vm_logger, "Communication with node {} failed: {}", node_id, e.what());
+            //Close the failed socket and forget that the node rejoined
+            waiting_join_sockets.erase(node_id);
+            members_sent_restart_view.erase(node_id);
+            rejoined_node_ips_and_ports.erase(node_id);
+            rejoined_node_ids.erase(node_id);
+            failed_node = node_id;
+        }
+    }
+    return failed_node;
 }
 
 bool RestartLeaderState::compute_restart_view() {
@@ -310,46 +387,42 @@ bool RestartLeaderState::compute_restart_view() {
 
 int64_t RestartLeaderState::send_restart_view() {
     members_sent_restart_view.clear();
-    for(auto waiting_sockets_iter = waiting_join_sockets.begin();
-        waiting_sockets_iter != waiting_join_sockets.end();) {
-        std::size_t view_buffer_size = mutils::bytes_size(*restart_view);
-        std::size_t leaders_buffer_size = mutils::bytes_size(nodes_with_longest_log);
-        uint8_t view_buffer[view_buffer_size];
-        uint8_t leaders_buffer[leaders_buffer_size];
-        try {
-            dbg_debug(vm_logger, "Sending post-recovery view {} to node {}", restart_view->vid, waiting_sockets_iter->first);
-            waiting_sockets_iter->second.write(view_buffer_size);
-            mutils::to_bytes(*restart_view, view_buffer);
-            waiting_sockets_iter->second.write(view_buffer, view_buffer_size);
-            dbg_debug(vm_logger, "Sending ragged-trim information to node {}", waiting_sockets_iter->first);
-            std::size_t num_ragged_trims = multimap_size(restart_state.logged_ragged_trim);
-            waiting_sockets_iter->second.write(num_ragged_trims);
-            //Unroll the maps and send each RaggedTrim individually, since it contains its subgroup_id and shard_num
-            for(const auto& subgroup_to_shard_map : restart_state.logged_ragged_trim) {
-                for(const auto& shard_trim_pair : subgroup_to_shard_map.second) {
-                    std::size_t trim_buffer_size = mutils::bytes_size(*shard_trim_pair.second);
-                    uint8_t trim_buffer[trim_buffer_size];
-                    waiting_sockets_iter->second.write(trim_buffer_size);
-                    mutils::to_bytes(*shard_trim_pair.second, trim_buffer);
-                    waiting_sockets_iter->second.write(trim_buffer, trim_buffer_size);
-                }
-            }
-            dbg_debug(vm_logger, "Sending longest-log locations to node {}", waiting_sockets_iter->first);
-            waiting_sockets_iter->second.write(leaders_buffer_size);
-            mutils::to_bytes(nodes_with_longest_log, leaders_buffer);
-            waiting_sockets_iter->second.write(leaders_buffer, leaders_buffer_size);
-            members_sent_restart_view.emplace(waiting_sockets_iter->first);
-            waiting_sockets_iter++;
-        } catch(tcp::socket_error& e) {
-            node_id_t failed_node = waiting_sockets_iter->first;
-            //All send failures will end up here.
-            //Close the failed socket, delete it from rejoined_node_ids, and return the ID of the failed node.
-            waiting_join_sockets.erase(waiting_sockets_iter);
-            rejoined_node_ips_and_ports.erase(failed_node);
-            rejoined_node_ids.erase(failed_node);
-            return failed_node;
+    //Serialize the message once, since it is the same for every node: the view, the
+    //ragged trims, and the locations of the longest logs, each preceded by its size.
+    //Unroll the ragged trim maps and send each RaggedTrim individually, since it contains its subgroup_id and shard_num
+    std::vector<uint8_t> message;
+    auto append_size = [&message](std::size_t size) {
+        const uint8_t* size_bytes = reinterpret_cast<const uint8_t*>(&size);
+        message.insert(message.end(), size_bytes, size_bytes + sizeof(size));
+    };
+    auto append_object = [&message, &append_size](const auto& object) {
+        std::size_t object_size = mutils::bytes_size(object);
+        append_size(object_size);
+        std::size_t offset = message.size();
+        message.resize(offset + object_size);
+        mutils::to_bytes(object, message.data() + offset);
+    };
+    append_object(*restart_view);
+    append_size(multimap_size(restart_state.logged_ragged_trim));
+    for(const auto& subgroup_to_shard_map : restart_state.logged_ragged_trim) {
+        for(const auto& shard_trim_pair : subgroup_to_shard_map.second) {
+            append_object(*shard_trim_pair.second);
         }
-    }  //for (waiting_join_sockets)
+    }
+    append_object(nodes_with_longest_log);
+
+    //Send the message to all the nodes at once; all send failures will end up in failed_node
+    int64_t failed_node = for_each_waiting_socket([&](node_id_t node_id, tcp::socket& socket) {
+        dbg_debug(vm_logger, "Sending post-recovery view {}, ragged-trim information and longest-log locations to node {}",
+                  restart_view->vid, node_id);
+        socket.write(message.data(), message.size());
+    });
+    for(const auto& id_socket_pair : waiting_join_sockets) {
+        members_sent_restart_view.emplace(id_socket_pair.first);
+    }
+    if(failed_node != -1) {
+        return failed_node;
+    }
 
     //Save this to a class member so that we still have it in send_objects_if_total_restart()
     restart_state.restart_shard_leaders = nodes_with_longest_log;
@@ -379,47 +452,37 @@ bool RestartLeaderState::resend_view_until_quorum_lost() {
 }
 
 void RestartLeaderState::send_abort() {
-    for(const node_id_t& member_sent_view : members_sent_restart_view) {
-        dbg_debug(vm_logger, "Sending view abort message to node {}", member_sent_view);
-        waiting_join_sockets.at(member_sent_view).write(CommitMessage::ABORT);
-    }
+    for_each_waiting_socket([this](node_id_t node_id, tcp::socket& socket) {
+        if(members_sent_restart_view.count(node_id) > 0) {
+            dbg_debug(vm_logger, "Sending view abort message to node {}", node_id);
+            socket.write(CommitMessage::ABORT);
+        }
+    });
 }
 
 int64_t RestartLeaderState::send_prepare() {
-    for(auto waiting_sockets_iter = waiting_join_sockets.begin();
-        waiting_sockets_iter != waiting_join_sockets.end();) {
-        try {
-            dbg_debug(vm_logger, "Sending view prepare message to node {}", waiting_sockets_iter->first);
-            waiting_sockets_iter->second.write(CommitMessage::PREPARE);
-            //Wait for an acknowledgment, to make sure the node has finished state transfer
-            CommitMessage response;
-            waiting_sockets_iter->second.read(response);
-            if(response == CommitMessage::ACK) {
-                dbg_debug(vm_logger, "Node {} acknowledged Prepare", waiting_sockets_iter->first);
-            } else {
-                dbg_warn(vm_logger, "Node {} responded to Prepare with something other than Ack!", waiting_sockets_iter->first);
-                throw tcp::socket_error("Received an unexpected message!");
-            }
-        } catch(tcp::socket_error& e) {
-            node_id_t failed_node = waiting_sockets_iter->first;
-            waiting_join_sockets.erase(waiting_sockets_iter);
-            members_sent_restart_view.erase(failed_node);
-            rejoined_node_ips_and_ports.erase(failed_node);
-            rejoined_node_ids.erase(failed_node);
-            return failed_node;
+    return for_each_waiting_socket([this](node_id_t node_id, tcp::socket& socket) {
+        dbg_debug(vm_logger, "Sending view prepare message to node {}", node_id);
+        socket.write(CommitMessage::PREPARE);
+        //Wait for an acknowledgment, to make sure the node has finished state transfer
+        CommitMessage response;
+        socket.read(response);
+        if(response == CommitMessage::ACK) {
+            dbg_debug(vm_logger, "Node {} acknowledged Prepare", node_id);
+        } else {
+            dbg_warn(vm_logger, "Node {} responded to Prepare with something other than Ack!", node_id);
+            throw tcp::socket_error("Received an unexpected message!");
         }
-        waiting_sockets_iter++;
-    }
-    return -1;
+    });
 }
 
 void RestartLeaderState::send_commit() {
-    for(auto waiting_sockets_iter = waiting_join_sockets.begin();
-        waiting_sockets_iter != waiting_join_sockets.end();) {
-        dbg_debug(vm_logger, "Sending view commit message to node {}", waiting_sockets_iter->first);
-        waiting_sockets_iter->second.write(CommitMessage::COMMIT);
-        waiting_sockets_iter = waiting_join_sockets.erase(waiting_sockets_iter);
-    }
+    //A node that fails now will be detected as failed in the restart view
+    for_each_waiting_socket([this](node_id_t node_id, tcp::socket& socket) {
+        dbg_debug(vm_logger, "Sending view commit message to node {}", node_id);
+        socket.write(CommitMessage::COMMIT);
+    });
+    waiting_join_sockets.clear();
 }
 
 void RestartLeaderState::print_longest_logs() const {
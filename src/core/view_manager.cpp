@@ -5,6 +5,7 @@
 #include <derecho/core/detail/view_manager.hpp>
 
 #include <derecho/core/derecho_exception.hpp>
+#include <derecho/core/detail/p2p_connection.hpp>
 #include <derecho/core/detail/public_key_store.hpp>
 #include <derecho/core/detail/version_code.hpp>
 #include <derecho/core/git_version.hpp>
@@ -15,7 +16,13 @@
 
 #include <mutils/macro_utils.hpp>
 
+#include <algorithm>
 #include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <optional>
 #include <tuple>
 
 namespace derecho {
@@ -24,6 +31,18 @@ using lock_guard_t = std::lock_guard<std::mutex>;
 using unique_lock_t = std::unique_lock<std::mutex>;
 using shared_lock_t = std::shared_lock<std::shared_timed_mutex>;
 
+/* Written before each object during state transfer to say how its data will be sent */
+static constexpr uint8_t STATE_OVER_TCP = 0;
+static constexpr uint8_t STATE_OVER_RDMA = 1;
+/* Written by a node once it has finished reading the other node's objects with RDMA */
+static constexpr uint8_t RDMA_READS_DONE = 2;
+/* The number of chunk buffers an object sent with RDMA is serialized into, so that
+ * serialization can run ahead of the other node's reads */
+static constexpr std::size_t RDMA_SEND_CHUNKS = 4;
+/* The number of chunks in the ring each received object is read into and deserialized from,
+ * which bounds the memory used to receive an object whatever its size */
+static constexpr std::size_t RECEIVE_RING_CHUNKS = 4;
+
 ViewManager::ViewManager(
         const SubgroupInfo& subgroup_info,
         const std::vector<std::type_index>& subgroup_type_order,
@@ -35,6 +54,9 @@ ViewManager::ViewManager(
           server_socket(getConfUInt16(Conf::DERECHO_GMS_PORT)),
           thread_shutdown(false),
           disable_partitioning_safety(getConfBoolean(Conf::DERECHO_DISABLE_PARTITIONING_SAFETY)),
+          max_joins_per_view(getConfUInt32(Conf::DERECHO_MAX_JOINS_PER_VIEW)),
+          join_batch_window(getConfUInt32(Conf::DERECHO_JOIN_BATCH_WINDOW_MS)),
+          defer_wedge_until_commit(getConfBoolean(Conf::DERECHO_DEFER_WEDGE_UNTIL_COMMIT)),
           view_upcalls(_view_upcalls),
           subgroup_info(subgroup_info),
           subgroup_type_order(subgroup_type_order),
@@ -64,9 +86,11 @@ ViewManager::~ViewManager() {
 
 /* ----------  1. Constructor Components ------------- */
 bool ViewManager::first_init() {
+    restart_start_time = std::chrono::steady_clock::now();
     if(any_persistent_objects) {
         //Attempt to load a saved View from disk, to see if one is there
         curr_view = persistent::loadObject<View>();
+        restart_timings.load_view = std::chrono::steady_clock::now() - restart_start_time;
     }
     //The presence of a logged View on disk means this node is restarting after a crash
     if(curr_view) {
@@ -138,6 +162,13 @@ bool ViewManager::restart_to_initial_view() {
     const uint32_t my_id = getConfUInt32(Conf::DERECHO_LOCAL_ID);
     const uint16_t my_gms_port = getConfUInt16(Conf::DERECHO_GMS_PORT);
     const bool enable_backup_restart_leaders = getConfBoolean(Conf::DERECHO_ENABLE_BACKUP_RESTART_LEADERS);
+    //Time spent loading ragged trims is reported separately, so subtract it from the time spent here
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto load_ragged_trim_before = restart_timings.load_ragged_trim;
+    auto record_contact_time = [&]() {
+        restart_timings.contact_leader += (std::chrono::steady_clock::now() - start_time)
+                                          - (restart_timings.load_ragged_trim - load_ragged_trim_before);
+    };
 
     // First, attempt to contact a current member to see if the system really is in total restart
     // Try the configured contact node, unless that is equal to this node
@@ -157,6 +188,7 @@ bool ViewManager::restart_to_initial_view() {
                 if(got_initial_view) {
                     // If the contact member successfully sent a View, return early; this method is done
                     setup_initial_tcp_connections(*curr_view, my_id);
+                    record_contact_time();
                     return in_total_restart;
                 } else if(!in_total_restart) {
                     // If the contact member told us that the group is not doing a restart but then crashed,
@@ -183,7 +215,7 @@ bool ViewManager::restart_to_initial_view() {
             //The subgroup_type_order can't be serialized, but it's constant across restarts
             curr_view->subgroup_type_order = subgroup_type_order;
             //Set up restart state and await rejoining nodes as the leader
-            restart_state->load_ragged_trim(*curr_view);
+            load_ragged_trim();
             restart_leader_state_machine = std::make_unique<RestartLeaderState>(
                     std::move(curr_view), *restart_state,
                     subgroup_info, my_id);
@@ -223,6 +255,7 @@ bool ViewManager::restart_to_initial_view() {
             }
         }
     }
+    record_contact_time();
     return in_total_restart;
 }
 
@@ -325,7 +358,7 @@ bool ViewManager::send_join_request() {
             //Restore this non-serializeable field to curr_view before using it
             curr_view->subgroup_type_order = subgroup_type_order;
             //Now that we know we need them, load ragged trims from disk
-            restart_state->load_ragged_trim(*curr_view);
+            load_ragged_trim();
             dbg_debug(vm_logger, "In restart mode, sending {} ragged trims to leader", restart_state->logged_ragged_trim.size());
             /* Protocol: Send the number of RaggedTrim objects, then serialize each RaggedTrim */
             /* Since we know this node is only a member of one shard per subgroup,
@@ -433,6 +466,7 @@ void ViewManager::check_view_committed(bool& view_confirmed, bool& leader_failed
 
 void ViewManager::truncate_logs() {
     assert(in_total_restart);
+    auto start_time = std::chrono::steady_clock::now();
     for(const auto& subgroup_and_map : restart_state->logged_ragged_trim) {
         for(const auto& shard_and_trim : subgroup_and_map.second) {
             persistent::saveObject(*shard_and_trim.second,
@@ -442,7 +476,8 @@ void ViewManager::truncate_logs() {
     dbg_debug(vm_logger, "Truncating persistent logs to conform to leader's ragged trim");
 
     const node_id_t my_id = getConfUInt32(Conf::DERECHO_LOCAL_ID);
-
+    //Each subgroup's object has its own logs, so they can all be truncated at once
+    std::vector<std::future<void>> subgroup_truncations;
     for(const auto& id_to_shard_map : restart_state->logged_ragged_trim) {
         subgroup_id_t subgroup_id = id_to_shard_map.first;
         uint32_t my_shard_id;
@@ -468,7 +503,25 @@ void ViewManager::truncate_logs() {
                 my_shard_ragged_trim->vid, my_shard_ragged_trim->max_received_by_sender);
         dbg_trace(vm_logger, "Truncating persistent log for subgroup {} to version {}", subgroup_id, max_delivered_version);
         dbg_flush(vm_logger);
-        subgroup_objects.at(subgroup_id)->truncate(max_delivered_version);
+        ReplicatedObject* subgroup_object = subgroup_objects.at(subgroup_id);
+        subgroup_truncations.emplace_back(std::async(std::launch::async, [subgroup_object, max_delivered_version]() {
+            subgroup_object->truncate(max_delivered_version);
+        }));
+    }
+    //Wait for every truncation to finish before reporting the first failure
+    std::exception_ptr truncate_error;
+    for(auto& truncation : subgroup_truncations) {
+        try {
+            truncation.get();
+        } catch(...) {
+            if(!truncate_error) {
+                truncate_error = std::current_exception();
+            }
+        }
+    }
+    restart_timings.truncate_logs += std::chrono::steady_clock::now() - start_time;
+    if(truncate_error) {
+        std::rethrow_exception(truncate_error);
     }
 }
 
@@ -491,6 +544,15 @@ void ViewManager::initialize_multicast_groups(const UserMessageCallbacks& callba
                 assert(subgroup_objects.find(subgroup_id) != subgroup_objects.end());
                 subgroup_objects.at(subgroup_id)->post_next_version(ver, msg_ts);
             };
+    internal_callbacks.rpc_receive_buffer_callback =
+            [this](subgroup_id_t subgroup_id, node_id_t sender, const uint8_t* rpc_header,
+                   std::size_t rpc_header_size, std::size_t message_size) -> std::optional<rdmc::receive_destination> {
+                auto object_it = subgroup_objects.find(subgroup_id);
+                if(object_it == subgroup_objects.end()) {
+                    return std::nullopt;
+                }
+                return object_it->second->get_receive_buffer(sender, rpc_header, rpc_header_size, message_size);
+            };
     dbg_debug(vm_logger, "Initializing SST and RDMC for the first time.");
     construct_multicast_group(callbacks, internal_callbacks, subgroup_settings_map, num_received_size, slot_size, index_field_size);
     curr_view->gmsSST->vid[curr_view->my_rank] = curr_view->vid;
@@ -500,6 +562,17 @@ void ViewManager::finish_setup() {
     //At this point curr_view has been committed by the leader
     if(in_total_restart) {
         //If we were doing total restart, it has completed successfully
+        restart_timings.total = std::chrono::steady_clock::now() - restart_start_time;
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        dbg_info(vm_logger, "Total restart completed in {} us: load view {} us, load ragged trim {} us, contact leader {} us, load logs {} us, truncate logs {} us, send logs {} us",
+                 duration_cast<microseconds>(restart_timings.total).count(),
+                 duration_cast<microseconds>(restart_timings.load_view).count(),
+                 duration_cast<microseconds>(restart_timings.load_ragged_trim).count(),
+                 duration_cast<microseconds>(restart_timings.contact_leader).count(),
+                 duration_cast<microseconds>(restart_timings.load_logs).count(),
+                 duration_cast<microseconds>(restart_timings.truncate_logs).count(),
+                 duration_cast<microseconds>(restart_timings.send_logs).count());
         restart_state.reset();
         in_total_restart = false;
         //The restart leader now gives up its leader role to the "real" leader
@@ -537,26 +610,43 @@ void ViewManager::finish_setup() {
     }
 }
 
-void ViewManager::send_logs() {
-    assert(in_total_restart);
+void ViewManager::load_ragged_trim() {
+    auto start_time = std::chrono::steady_clock::now();
+    restart_state->load_ragged_trim(*curr_view);
+    restart_timings.load_ragged_trim += std::chrono::steady_clock::now() - start_time;
+}
+
+void ViewManager::transfer_initial_objects(const std::set<std::pair<subgroup_id_t, node_id_t>>& subgroups_and_leaders) {
+    auto start_time = std::chrono::steady_clock::now();
     //The restart leader doesn't have curr_view
-    const View& restart_view = curr_view ? *curr_view : restart_leader_state_machine->get_restart_view();
-    /* If we're in total restart mode, prior_view_shard_leaders is equal
-     * to restart_state->restart_shard_leaders */
-    node_id_t my_id = getConfUInt32(Conf::DERECHO_LOCAL_ID);
-    for(subgroup_id_t subgroup_id = 0; subgroup_id < prior_view_shard_leaders.size(); ++subgroup_id) {
-        for(uint32_t shard = 0; shard < prior_view_shard_leaders[subgroup_id].size(); ++shard) {
-            if(my_id == prior_view_shard_leaders[subgroup_id][shard]) {
-                dbg_debug(vm_logger, "This node is the restart leader for subgroup {}, shard {}. Sending object data to shard members.", subgroup_id, shard);
-                //Send object data to all shard members, since they will all be in receive_objects()
-                for(node_id_t shard_member : restart_view.subgroup_shard_views[subgroup_id][shard].members) {
-                    if(shard_member != my_id) {
-                        send_subgroup_object(subgroup_id, shard_member);
+    const View& initial_view = curr_view ? *curr_view : restart_leader_state_machine->get_restart_view();
+    if(getConfBoolean(Conf::DERECHO_RDMA_STATE_TRANSFER)) {
+        // RDMA state transfer connects to the other nodes through the SST, which is otherwise set up after the view commits
+        initialize_sst(initial_view);
+    }
+    object_transfer_map_t objects_to_send;
+    if(in_total_restart) {
+        /* If we're in total restart mode, prior_view_shard_leaders is equal
+         * to restart_state->restart_shard_leaders */
+        node_id_t my_id = getConfUInt32(Conf::DERECHO_LOCAL_ID);
+        for(subgroup_id_t subgroup_id = 0; subgroup_id < prior_view_shard_leaders.size(); ++subgroup_id) {
+            for(uint32_t shard = 0; shard < prior_view_shard_leaders[subgroup_id].size(); ++shard) {
+                if(my_id == prior_view_shard_leaders[subgroup_id][shard]) {
+                    dbg_debug(vm_logger, "This node is the restart leader for subgroup {}, shard {}. Sending object data to shard members.", subgroup_id, shard);
+                    //Send object data to all shard members, since they will all be receiving objects
+                    for(node_id_t shard_member : initial_view.subgroup_shard_views[subgroup_id][shard].members) {
+                        if(shard_member != my_id) {
+                            objects_to_send[shard_member].emplace_back(subgroup_id, subgroup_objects.at(subgroup_id));
+                        }
                     }
                 }
             }
         }
     }
+    transfer_objects(objects_to_send, get_objects_to_receive(subgroups_and_leaders));
+    if(in_total_restart) {
+        restart_timings.send_logs += std::chrono::steady_clock::now() - start_time;
+    }
 }
 
 void ViewManager::setup_initial_tcp_connections(const View& initial_view, const node_id_t my_id) {
@@ -800,22 +890,56 @@ void ViewManager::initialize_rdmc_sst() {
         std::cout << "Global setup failed" << std::endl;
         exit(0);
     }
-    auto member_ips_and_sst_ports_map = make_member_ips_and_ports_map(*curr_view, PortType::SST);
-    node_id_t my_id = curr_view->members[curr_view->my_rank];
-    const std::map<node_id_t, std::pair<ip_addr_t, uint16_t>> self_ip_and_port_map = {
-            {my_id,
-             {getConfString(Conf::DERECHO_LOCAL_IP),
-              getConfUInt16(Conf::DERECHO_EXTERNAL_PORT)}}};
+    initialize_sst(*curr_view);
+}
+
+void ViewManager::initialize_sst(const View& view) {
+    const node_id_t my_id = getConfUInt32(Conf::DERECHO_LOCAL_ID);
+    if(!sst_initialized) {
+        auto member_ips_and_sst_ports_map = make_member_ips_and_ports_map(view, PortType::SST);
+        const std::map<node_id_t, std::pair<ip_addr_t, uint16_t>> self_ip_and_port_map = {
+                {my_id,
+                 {getConfString(Conf::DERECHO_LOCAL_IP),
+                  getConfUInt16(Conf::DERECHO_EXTERNAL_PORT)}}};
 
 #ifdef USE_VERBS_API
-    sst::verbs_initialize(member_ips_and_sst_ports_map,
-                          self_ip_and_port_map,
-                          my_id);
+        sst::verbs_initialize(member_ips_and_sst_ports_map,
+                              self_ip_and_port_map,
+                              my_id);
 #else
-    sst::lf_initialize(member_ips_and_sst_ports_map,
-                       self_ip_and_port_map,
-                       my_id);
+        sst::lf_initialize(member_ips_and_sst_ports_map,
+                           self_ip_and_port_map,
+                           my_id);
 #endif
+        sst_initialized = true;
+        sst_members = std::set<node_id_t>(view.members.begin(), view.members.end());
+        return;
+    }
+    // The SST was set up for an earlier initial view that aborted, whose members may have been different
+    for(auto member_iter = sst_members.begin(); member_iter != sst_members.end();) {
+        if(view.rank_of(*member_iter) == -1) {
+            dbg_debug(vm_logger, "Removing the SST TCP connection to node {}, which is not in the initial view", *member_iter);
+            sst::remove_node(*member_iter);
+            member_iter = sst_members.erase(member_iter);
+        } else {
+            ++member_iter;
+        }
+    }
+    // Connect to the new members in ascending order of ID, like sst::lf_initialize does
+    std::set<node_id_t> new_members;
+    for(const node_id_t member : view.members) {
+        if(sst_members.count(member) == 0) {
+            new_members.insert(member);
+        }
+    }
+    for(const node_id_t member : new_members) {
+        const int rank = view.rank_of(member);
+        if(!sst::add_node(member, {view.member_ips_and_ports[rank].ip_address,
+                                   view.member_ips_and_ports[rank].sst_port})) {
+            dbg_warn(vm_logger, "Failed to add an SST TCP connection to node {}", member);
+        }
+        sst_members.insert(member);
+    }
 }
 
 void ViewManager::create_threads() {
@@ -869,7 +993,7 @@ void ViewManager::register_predicates() {
     }
 
     auto start_join_pred = [this](const DerechoSST& sst) {
-        return active_leader && has_pending_join();
+        return active_leader && has_pending_join() && join_batch_ready();
     };
     if(!start_join_handle.is_valid()) {
         start_join_handle = curr_view->gmsSST->predicates.insert(
@@ -946,6 +1070,7 @@ void ViewManager::new_suspicion(DerechoSST& gmsSST) {
     }
 
     dbg_debug(vm_logger, "Suspected[] changed");
+    note_view_change_started();
     const int my_rank = curr_view->my_rank;
     //Cache this before changing failed[], so we can see if the leader changed
     const int old_leader_rank = curr_view->find_rank_of_leader();
@@ -967,6 +1092,7 @@ void ViewManager::new_suspicion(DerechoSST& gmsSST) {
 }
 
 void ViewManager::propose_changes(DerechoSST& gmsSST) {
+    note_view_change_started();
     const int my_rank = curr_view->my_rank;
     bool done_with_joins = !has_pending_join();
     while(!done_with_joins || suspected_not_equal(gmsSST, last_suspected)) {
@@ -1002,23 +1128,26 @@ void ViewManager::propose_changes(DerechoSST& gmsSST) {
             }
         }
 
-        //Second, check for joins
+        //Second, check for joins, handling as many pending joins at once as there is room for
         while(!done_with_joins) {
-            dbg_debug(vm_logger, "Leader handling a new member connection");
-            if((gmsSST.num_changes[curr_view->my_rank] - gmsSST.num_committed[curr_view->my_rank])
-               == static_cast<int>(curr_view->members.size())) {
-                dbg_debug(vm_logger, "Delaying handling the new member, there are already {} pending changes", curr_view->members.size());
+            const int max_pending_changes = curr_view->members.size() + max_joins_per_view;
+            const int num_pending_changes = gmsSST.num_changes[my_rank] - gmsSST.num_committed[my_rank];
+            const int free_change_slots = gmsSST.changes.size()
+                                          - (gmsSST.num_changes[my_rank] - gmsSST.num_installed[my_rank]);
+            const int batch_size = std::min({max_pending_changes - num_pending_changes, free_change_slots,
+                                             static_cast<int>(pending_join_sockets.size())});
+            if(batch_size <= 0) {
+                dbg_debug(vm_logger, "Delaying handling new members, there are already {} pending changes", num_pending_changes);
                 done_with_joins = true;
                 continue;
             }
+            dbg_debug(vm_logger, "Leader handling {} new member connections", batch_size);
 
-            proposed_join_sockets.splice(proposed_join_sockets.end(),
-                                         pending_join_sockets,
-                                         pending_join_sockets.begin());
-
-            bool success = receive_join(gmsSST, proposed_join_sockets.back().first, proposed_join_sockets.back().second);
-            //If the join failed, close the socket
-            if(!success) proposed_join_sockets.pop_back();
+            std::list<std::pair<node_id_t, tcp::socket>> joiners;
+            joiners.splice(joiners.end(), pending_join_sockets, pending_join_sockets.begin(),
+                           std::next(pending_join_sockets.begin(), batch_size));
+            oldest_pending_join_time = std::chrono::steady_clock::now();
+            receive_joins(gmsSST, std::move(joiners));
 
             done_with_joins = !has_pending_join();
         }
@@ -1071,40 +1200,66 @@ void ViewManager::redirect_join_attempt(tcp::socket& joiner_socket) {
 }
 
 void ViewManager::process_new_sockets() {
-    tcp::socket client_socket;
+    std::vector<tcp::socket> client_sockets;
     {
         auto pending_new_sockets_locked = pending_new_sockets.locked();
-        client_socket = std::move(pending_new_sockets_locked.access.front());
-        pending_new_sockets_locked.access.pop_front();
-    }
-    JoinRequest join_request;
-    try {
-        // Exchange version codes; close the socket if the remote node has an incompatible version
-        uint64_t joiner_version_code;
-        client_socket.exchange(my_version_hashcode, joiner_version_code);
-        if(joiner_version_code != my_version_hashcode) {
-            rls_default_warn("Rejected a connection from node at {}. Node was running on an incompatible platform or used an incompatible compiler.",
-                             client_socket.get_remote_ip());
-            return;
+        while(!pending_new_sockets_locked.access.empty()) {
+            client_sockets.emplace_back(std::move(pending_new_sockets_locked.access.front()));
+            pending_new_sockets_locked.access.pop_front();
         }
-        client_socket.read(join_request);
-    } catch(tcp::socket_error& ex) {
-        dbg_warn(vm_logger, "TCP connection to {} failed before it could send a join request. Ignoring request.", client_socket.get_remote_ip());
-        dbg_debug(vm_logger, "Error description: {}", ex.what());
-        return;
     }
-    if(join_request.is_external) {
-        dbg_info(vm_logger, "Received an external join request from client {} at address {}.", join_request.joiner_id, client_socket.get_remote_ip());
-        external_join_handler(client_socket, join_request.joiner_id);
-    } else {
-        if(active_leader) {
-            pending_join_sockets.emplace_back(join_request.joiner_id, std::move(client_socket));
+    // Exchange version codes and read the join requests from all the new sockets at once
+    std::vector<JoinRequest> join_requests(client_sockets.size());
+    std::vector<std::future<bool>> requests_received;
+    for(std::size_t i = 0; i < client_sockets.size(); ++i) {
+        requests_received.emplace_back(std::async(std::launch::async, [this, &client_socket = client_sockets[i], &join_request = join_requests[i]]() {
+            try {
+                // Exchange version codes; close the socket if the remote node has an incompatible version
+                uint64_t joiner_version_code;
+                client_socket.exchange(my_version_hashcode, joiner_version_code);
+                if(joiner_version_code != my_version_hashcode) {
+                    rls_default_warn("Rejected a connection from node at {}. Node was running on an incompatible platform or used an incompatible compiler.",
+                                     client_socket.get_remote_ip());
+                    return false;
+                }
+                client_socket.read(join_request);
+            } catch(tcp::socket_error& ex) {
+                dbg_warn(vm_logger, "TCP connection to {} failed before it could send a join request. Ignoring request.", client_socket.get_remote_ip());
+                dbg_debug(vm_logger, "Error description: {}", ex.what());
+                return false;
+            }
+            return true;
+        }));
+    }
+    for(std::size_t i = 0; i < client_sockets.size(); ++i) {
+        if(!requests_received[i].get()) {
+            continue;
+        }
+        const JoinRequest& join_request = join_requests[i];
+        tcp::socket& client_socket = client_sockets[i];
+        if(join_request.is_external) {
+            dbg_info(vm_logger, "Received an external join request from client {} at address {}.", join_request.joiner_id, client_socket.get_remote_ip());
+            external_join_handler(client_socket, join_request.joiner_id);
         } else {
-            redirect_join_attempt(client_socket);
+            if(active_leader) {
+                if(pending_join_sockets.empty()) {
+                    oldest_pending_join_time = std::chrono::steady_clock::now();
+                }
+                pending_join_sockets.emplace_back(join_request.joiner_id, std::move(client_socket));
+            } else {
+                redirect_join_attempt(client_socket);
+            }
         }
     }
-    return;
 }
+
+bool ViewManager::join_batch_ready() const {
+    if(max_joins_per_view > 0 && pending_join_sockets.size() >= max_joins_per_view) {
+        return true;
+    }
+    return std::chrono::steady_clock::now() - oldest_pending_join_time >= join_batch_window;
+}
+
 void ViewManager::external_join_handler(tcp::socket& client_socket, const node_id_t& joiner_id) {
     ExternalClientRequest request;
     try {
@@ -1228,6 +1383,7 @@ void ViewManager::acknowledge_proposed_change(DerechoSST& gmsSST) {
     const int myRank = gmsSST.get_local_index();
     const int leader = curr_view->find_rank_of_leader();
     dbg_debug(vm_logger, "Detected that leader proposed change #{}. Acknowledging.", gmsSST.num_changes[leader]);
+    note_view_change_started();
     if(myRank != leader) {
         // Echo the count
         gmssst::set(gmsSST.num_changes[myRank], gmsSST.num_changes[leader]);
@@ -1267,6 +1423,19 @@ void ViewManager::acknowledge_proposed_change(DerechoSST& gmsSST) {
         gmsSST.put(gmsSST.num_committed);
     }
     gmsSST.put(gmsSST.num_acked);
+    if(defer_wedge_until_commit) {
+        //Stop sending only in subgroups that lose a member; the view is wedged in start_meta_wedge
+        std::set<node_id_t> departing_nodes;
+        for(int change_index = 0; change_index < gmsSST.num_changes[myRank] - gmsSST.num_installed[myRank]; ++change_index) {
+            const node_id_t change_id = gmsSST.changes[myRank][change_index].change_id;
+            if(curr_view->rank_of(change_id) != -1) {
+                departing_nodes.emplace(change_id);
+            }
+        }
+        dbg_debug(vm_logger, "Wedging the subgroups affected by the departure of {} nodes.", departing_nodes.size());
+        curr_view->multicast_group->wedge_subgroups(subgroups_containing(departing_nodes));
+        return;
+    }
     dbg_debug(vm_logger, "Wedging current view.");
     curr_view->wedge();
     dbg_debug(vm_logger, "Done wedging current view.");
@@ -1281,6 +1450,8 @@ void ViewManager::start_meta_wedge(DerechoSST& gmsSST) {
     gmsSST.predicates.remove(change_commit_ready_handle);
     gmsSST.predicates.remove(leader_proposed_handle);
 
+    note_view_change_started();
+    end_view_change_stage(view_change_timings.suspicion);
     curr_view->wedge();
 
     /* We now need to wait for all other nodes to wedge the current view,
@@ -1305,6 +1476,7 @@ void ViewManager::start_meta_wedge(DerechoSST& gmsSST) {
 
 void ViewManager::terminate_epoch(DerechoSST& gmsSST) {
     dbg_debug(vm_logger, "MetaWedged is true; continuing epoch termination");
+    end_view_change_stage(view_change_timings.wedge);
 
     // go through all subgroups first and acknowledge all messages received through SST
     for(const auto& shard_settings_pair :
@@ -1501,6 +1673,7 @@ void ViewManager::deliver_ragged_trim(DerechoSST& gmsSST) {
 
 void ViewManager::finish_view_change(DerechoSST& gmsSST) {
     dbg_debug(vm_logger, "Ragged trim messages are persisted, finishing view change");
+    end_view_change_stage(view_change_timings.ragged_trim);
     std::unique_lock<std::shared_timed_mutex> write_lock(view_mutex);
 
     // Disable all the other SST predicates, except suspected_changed
@@ -1511,16 +1684,53 @@ void ViewManager::finish_view_change(DerechoSST& gmsSST) {
 
     const node_id_t my_id = curr_view->members[curr_view->my_rank];
 
-    //Send the new view from the leader to non-leaders in the old view using the TCP sockets
+    vector_int64_2d old_shard_leaders_by_id;
+    std::list<tcp::socket> joiner_sockets;
+    // The serialized View and old shard leaders, shared by all the sends
+    std::vector<uint8_t> view_bytes;
+    std::vector<uint8_t> shard_leaders_bytes;
+    // Sends to other members and joiners that are in progress; they all complete before state transfer
+    std::vector<std::future<void>> pending_sends;
+    // The sockets to the other members, locked once for all of the sends, since
+    // get_socket would hold the same lock for each whole send and serialize them
+    std::optional<LockedReference<std::unique_lock<std::mutex>, std::map<node_id_t, tcp::socket>>> member_sockets;
     if(active_leader) {
+        // Determine the shard leaders in the old view and re-index them by new subgroup IDs
+        old_shard_leaders_by_id = old_shard_leaders_by_new_ids(*curr_view, *next_view);
+        view_bytes.resize(mutils::bytes_size(*next_view));
+        mutils::to_bytes(*next_view, view_bytes.data());
+        // Send the new view to non-leaders in the old view using the TCP sockets, all at once
+        member_sockets.emplace(tcp_sockets.get_all_sockets());
         for(int i = 0; i < curr_view->num_members; ++i) {
             if(i != curr_view->my_rank && !curr_view->failed[i]) {
-                LockedReference<std::unique_lock<std::mutex>, tcp::socket> member_socket
-                        = tcp_sockets.get_socket(curr_view->members[i]);
-                dbg_debug(vm_logger, "Sending node at {} the new view over the state-transfer socket", member_socket.get().get_remote_ip());
-                send_view(*next_view, member_socket.get());
+                tcp::socket& member_socket = member_sockets->get().at(curr_view->members[i]);
+                pending_sends.emplace_back(std::async(std::launch::async, [this, &member_socket, &view_bytes]() {
+                    dbg_debug(vm_logger, "Sending node at {} the new view over the state-transfer socket", member_socket.get_remote_ip());
+                    member_socket.write(view_bytes.size());
+                    member_socket.write(view_bytes.data(), view_bytes.size());
+                }));
             }
         }
+        // If j joins have been committed, pop the next j sockets off
+        // proposed_join_sockets and send them the new View and old shard
+        // leaders list, concurrently with the sends to existing members
+        if(next_view->joined.size() > 0) {
+            shard_leaders_bytes.resize(mutils::bytes_size(old_shard_leaders_by_id));
+            mutils::to_bytes(old_shard_leaders_by_id, shard_leaders_bytes.data());
+        }
+        for(std::size_t c = 0; c < next_view->joined.size(); ++c) {
+            // save the socket for the commit step
+            joiner_sockets.emplace_back(std::move(proposed_join_sockets.front().second));
+            proposed_join_sockets.pop_front();
+            tcp::socket& joiner_socket = joiner_sockets.back();
+            pending_sends.emplace_back(std::async(std::launch::async, [this, &joiner_socket, &view_bytes, &shard_leaders_bytes]() {
+                dbg_debug(vm_logger, "Sending joining node at {} the new view and the old shard leaders vector over the joiner socket", joiner_socket.get_remote_ip());
+                joiner_socket.write(view_bytes.size());
+                joiner_socket.write(view_bytes.data(), view_bytes.size());
+                joiner_socket.write(shard_leaders_bytes.size());
+                joiner_socket.write(shard_leaders_bytes.data(), shard_leaders_bytes.size());
+            }));
+        }
     } else {
         //Standard procedure for receiving a View, copied from receive_view_and_leaders
         const node_id_t leader_id = curr_view->members[curr_view->find_rank_of_leader()];
@@ -1532,63 +1742,53 @@ void ViewManager::finish_view_change(DerechoSST& gmsSST) {
         next_view = mutils::from_bytes<View>(nullptr, buffer);
         next_view->subgroup_type_order = subgroup_type_order;
         next_view->my_rank = next_view->rank_of(my_id);
+        old_shard_leaders_by_id = old_shard_leaders_by_new_ids(*curr_view, *next_view);
     }
 
+    // On the leader, this overlaps with sending the View, which has already been serialized
     std::map<subgroup_id_t, SubgroupSettings> next_subgroup_settings;
     auto sizes = derive_subgroup_settings(*next_view, next_subgroup_settings);
     uint32_t new_num_received_size = std::get<0>(sizes);
     uint32_t new_slot_size = std::get<1>(sizes);
     uint32_t new_index_field_size = std::get<2>(sizes);
 
-    dbg_debug(vm_logger, "Ready to transition to the next View: {}", next_view->debug_string());
-    // Determine the shard leaders in the old view and re-index them by new subgroup IDs
-    vector_int64_2d old_shard_leaders_by_id = old_shard_leaders_by_new_ids(
-            *curr_view, *next_view);
-
-    std::list<tcp::socket> joiner_sockets;
-    if(active_leader && next_view->joined.size() > 0) {
-        // If j joins have been committed, pop the next j sockets off
-        // proposed_join_sockets and send them the new View and old shard
-        // leaders list
-        for(std::size_t c = 0; c < next_view->joined.size(); ++c) {
-            dbg_debug(vm_logger, "Sending joining node {} the new view over the joiner socket", proposed_join_sockets.front().first);
-            send_view(*next_view, proposed_join_sockets.front().second);
-            std::size_t size_of_vector = mutils::bytes_size(old_shard_leaders_by_id);
-            dbg_debug(vm_logger, "Sending node {} the old shard leaders vector on the joiner socket. size_of_vector is {}", proposed_join_sockets.front().first, size_of_vector);
-            proposed_join_sockets.front().second.write(size_of_vector);
-            mutils::post_object([this](const uint8_t* bytes, std::size_t size) {
-                proposed_join_sockets.front().second.write(bytes, size);
-            },
-                                old_shard_leaders_by_id);
-            // save the socket for the commit step
-            joiner_sockets.emplace_back(std::move(proposed_join_sockets.front().second));
-            proposed_join_sockets.pop_front();
-        }
+    // Wait for every send to finish; get() rethrows any socket error from a send
+    for(auto& pending_send : pending_sends) {
+        pending_send.get();
     }
+    pending_sends.clear();
+    member_sockets.reset();
+    end_view_change_stage(view_change_timings.view_send);
+    dbg_debug(vm_logger, "Ready to transition to the next View: {}", next_view->debug_string());
 
     // Set up TCP connections to the joined nodes
     update_tcp_connections();
-    // After doing that, shard leaders can send them RPC objects over state_transfer_port
-    send_objects_to_new_members(old_shard_leaders_by_id);
+    // RDMA state transfer connects to the joined nodes through the SST, so it needs the SST's TCP connections now
+    const bool rdma_state_transfer = getConfBoolean(Conf::DERECHO_RDMA_STATE_TRANSFER);
+    if(rdma_state_transfer) {
+        update_sst_connections();
+    }
 
-    // Re-initialize this node's RPC objects, which includes receiving them
-    // from shard leaders if it is newly a member of a subgroup
-    dbg_debug(vm_logger, "Receiving state for local Replicated Objects");
+    // Re-initialize this node's RPC objects. After constructing them, Group calls
+    // transfer_objects_to_new_view, so shard leaders send RPC objects to the joined
+    // nodes over state_transfer_port while receiving any state this node needs
+    dbg_debug(vm_logger, "Initializing local Replicated Objects and running state transfer");
     initialize_subgroup_objects(my_id, *next_view, old_shard_leaders_by_id);
 
     // Once state transfer completes, we can tell joining clients to commit the view
     if(active_leader) {
-        for(auto& joiner_socket : joiner_sockets) {
-            //Eventually, we could check for success here and abort the view if a node failed
-            dbg_debug(vm_logger, "Sending node at {} a PREPARE message on the joiner socket", joiner_socket.get_remote_ip());
-            joiner_socket.write(CommitMessage::PREPARE);
-        }
-        for(auto& joiner_socket : joiner_sockets) {
-            dbg_debug(vm_logger, "Sending node at {} a COMMIT message, then closing the joiner socket", joiner_socket.get_remote_ip());
-            joiner_socket.write(CommitMessage::COMMIT);
+        //Eventually, we could check for success after PREPARE and abort the view if a node failed
+        //Each message is a single enum, so writing them one socket at a time is fast enough
+        for(const CommitMessage message : {CommitMessage::PREPARE, CommitMessage::COMMIT}) {
+            for(auto& joiner_socket : joiner_sockets) {
+                dbg_debug(vm_logger, "Sending node at {} a {} message on the joiner socket", joiner_socket.get_remote_ip(),
+                          message == CommitMessage::PREPARE ? "PREPARE" : "COMMIT");
+                joiner_socket.write(message);
+            }
         }
         joiner_sockets.clear();
     }
+    end_view_change_stage(view_change_timings.state_transfer);
 
     // Delete the last three GMS predicates from the old SST in preparation for deleting it
     gmsSST.predicates.remove(leader_committed_handle);
@@ -1597,15 +1797,14 @@ void ViewManager::finish_view_change(DerechoSST& gmsSST) {
 
     dbg_debug(vm_logger, "Starting creation of new SST and DerechoGroup for view {}", next_view->vid);
     for(const node_id_t failed_node_id : next_view->departed) {
-        dbg_debug(vm_logger, "Removing global TCP connections for failed node {} from RDMC and SST", failed_node_id);
+        dbg_debug(vm_logger, "Removing global TCP connections for failed node {} from RDMC", failed_node_id);
 #ifdef USE_VERBS_API
         rdma::impl::verbs_remove_connection(failed_node_id);
 #else
         rdma::impl::lf_remove_connection(failed_node_id);
 #endif
-        sst::remove_node(failed_node_id);
     }
-    // if new members have joined, tell RDMC and SST to add socket connections to them
+    // if new members have joined, tell RDMC to add socket connections to them
     for(std::size_t i = 0; i < next_view->joined.size(); ++i) {
         // The new members will be the last joined.size() elements of the members lists
         int joiner_rank = next_view->num_members - next_view->joined.size() + i;
@@ -1625,13 +1824,9 @@ void ViewManager::finish_view_change(DerechoSST& gmsSST) {
         }
 #endif
     }
-    for(std::size_t i = 0; i < next_view->joined.size(); ++i) {
-        int joiner_rank = next_view->num_members - next_view->joined.size() + i;
-        if(!sst::add_node(next_view->members[joiner_rank],
-                          {next_view->member_ips_and_ports[joiner_rank].ip_address,
-                           next_view->member_ips_and_ports[joiner_rank].sst_port})) {
-            dbg_warn(vm_logger, "Failed to add an SST TCP connection to new node {}", next_view->members[joiner_rank]);
-        }
+    // With RDMA state transfer, the SST's connections were already updated before it
+    if(!rdma_state_transfer) {
+        update_sst_connections();
     }
 
     // This will block until everyone responds to SST/RDMC initial handshakes
@@ -1641,6 +1836,7 @@ void ViewManager::finish_view_change(DerechoSST& gmsSST) {
     // New members can now proceed to view_manager.finish_setup(), which will call put() and sync()
     next_view->gmsSST->push_row_except_slots();
     next_view->gmsSST->sync_with_members();
+    end_view_change_stage(view_change_timings.sst_rebuild);
     {
         lock_guard_t old_views_lock(old_views_mutex);
         old_views.push(std::move(curr_view));
@@ -1666,6 +1862,26 @@ void ViewManager::finish_view_change(DerechoSST& gmsSST) {
         curr_view->wedge();
     }
 
+    view_change_timings.vid = curr_view->vid;
+    view_change_timings.total = std::chrono::steady_clock::now() - view_change_start_time;
+    {
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        dbg_debug(vm_logger, "View change to view {} took {} us: suspicion {} us, wedge {} us, ragged trim {} us, view send {} us, state transfer {} us, SST rebuild {} us",
+                  view_change_timings.vid,
+                  duration_cast<microseconds>(view_change_timings.total).count(),
+                  duration_cast<microseconds>(view_change_timings.suspicion).count(),
+                  duration_cast<microseconds>(view_change_timings.wedge).count(),
+                  duration_cast<microseconds>(view_change_timings.ragged_trim).count(),
+                  duration_cast<microseconds>(view_change_timings.view_send).count(),
+                  duration_cast<microseconds>(view_change_timings.state_transfer).count(),
+                  duration_cast<microseconds>(view_change_timings.sst_rebuild).count());
+        std::lock_guard<std::mutex> timings_lock(view_change_timings_mutex);
+        last_view_change_timings = view_change_timings;
+    }
+    view_change_timings = ViewChangeTimings{};
+    view_change_start_time = std::chrono::steady_clock::time_point{};
+
     dbg_debug(vm_logger, "Delivering new-view upcalls for view {}", curr_view->vid);
     // Announce the new view to the application
     for(auto& view_upcall : view_upcalls) {
@@ -1679,6 +1895,32 @@ void ViewManager::finish_view_change(DerechoSST& gmsSST) {
 
 /* ------------- 3. Helper Functions for Predicates and Triggers ------------- */
 
+void ViewManager::note_view_change_started() {
+    if(view_change_start_time == std::chrono::steady_clock::time_point{}) {
+        view_change_start_time = std::chrono::steady_clock::now();
+        view_change_stage_start_time = view_change_start_time;
+    }
+}
+
+void ViewManager::end_view_change_stage(std::chrono::nanoseconds& stage_duration) {
+    const auto now = std::chrono::steady_clock::now();
+    stage_duration += now - view_change_stage_start_time;
+    view_change_stage_start_time = now;
+}
+
+std::set<subgroup_id_t> ViewManager::subgroups_containing(const std::set<node_id_t>& nodes) const {
+    std::set<subgroup_id_t> subgroups;
+    for(const auto& subgroup_settings_pair : curr_view->multicast_group->get_subgroup_settings()) {
+        for(const node_id_t shard_member : subgroup_settings_pair.second.members) {
+            if(nodes.count(shard_member) > 0) {
+                subgroups.emplace(subgroup_settings_pair.first);
+                break;
+            }
+        }
+    }
+    return subgroups;
+}
+
 void ViewManager::construct_multicast_group(const UserMessageCallbacks& callbacks,
                                             const MulticastGroupCallbacks& internal_callbacks,
                                             const std::map<subgroup_id_t, SubgroupSettings>& subgroup_settings,
@@ -1693,7 +1935,8 @@ void ViewManager::construct_multicast_group(const UserMessageCallbacks& callback
                     curr_view->members, curr_view->members[curr_view->my_rank],
                     [this](const uint32_t node_id) { report_failure(node_id); },
                     curr_view->failed, false),
-            num_subgroups, signature_size, num_received_size, slot_size, index_field_size);
+            num_subgroups, signature_size, num_received_size, slot_size, index_field_size,
+            max_joins_per_view);
 
     curr_view->multicast_group = std::make_unique<MulticastGroup>(
             curr_view->members, curr_view->members[curr_view->my_rank],
@@ -1708,12 +1951,24 @@ void ViewManager::transition_multicast_group(
     const auto num_subgroups = next_view->subgroup_shard_views.size();
     const std::size_t signature_size = persistence_manager.get_signature_size();
 
+    // Members that survive from the current view keep their SST connections, if enabled.
+    // Each side reuses a connection exactly when the peer's row in the current SST is not
+    // frozen, and a node whose row is frozen anywhere has been reported and is not in next_view.
+    std::map<uint32_t, const sst::resources*> surviving_connections;
+    if(getConfBoolean(Conf::DERECHO_REUSE_SST_CONNECTIONS)) {
+        surviving_connections = curr_view->gmsSST->get_connections();
+    }
+    dbg_debug(vm_logger, "Creating SST for view {}, reusing connections to {} members", next_view->vid, surviving_connections.size());
+    auto sst_start_time = std::chrono::steady_clock::now();
     next_view->gmsSST = std::make_shared<DerechoSST>(
             sst::SSTParams(
                     next_view->members, next_view->members[next_view->my_rank],
                     [this](const uint32_t node_id) { report_failure(node_id); },
-                    next_view->failed, false),
-            num_subgroups, signature_size, new_num_received_size, new_slot_size, new_index_field_size);
+                    next_view->failed, false, surviving_connections),
+            num_subgroups, signature_size, new_num_received_size, new_slot_size, new_index_field_size,
+            max_joins_per_view);
+    dbg_debug(vm_logger, "SST for view {} set up in {} us", next_view->vid,
+              std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sst_start_time).count());
 
     next_view->multicast_group = std::make_unique<MulticastGroup>(
             next_view->members, next_view->members[next_view->my_rank],
@@ -1731,41 +1986,70 @@ void ViewManager::transition_multicast_group(
     gmssst::set(next_view->gmsSST->vid[next_view->my_rank], next_view->vid);
 }
 
-bool ViewManager::receive_join(DerechoSST& gmsSST, const node_id_t joiner_id, tcp::socket& joiner_socket) {
-    struct in_addr joiner_ip_packed;
-    inet_aton(joiner_socket.get_remote_ip().c_str(), &joiner_ip_packed);
+void ViewManager::receive_joins(DerechoSST& gmsSST, std::list<std::pair<node_id_t, tcp::socket>>&& joiners) {
+    std::vector<IpAndPorts> joiner_addresses(joiners.size());
+    std::vector<std::future<bool>> handshakes;
+    std::set<node_id_t> batch_ids;
+    std::size_t joiner_index = 0;
+    for(auto& joiner : joiners) {
+        // A node ID can only be used by one of the joiners in a batch
+        const bool id_in_use = !batch_ids.emplace(joiner.first).second;
+        handshakes.emplace_back(std::async(std::launch::async,
+                                           [this, &joiner, id_in_use, &joiner_address = joiner_addresses[joiner_index]]() {
+                                               return receive_join(joiner.first, joiner.second, id_in_use, joiner_address);
+                                           }));
+        joiner_index++;
+    }
+    joiner_index = 0;
+    for(auto joiner_iter = joiners.begin(); joiner_iter != joiners.end(); joiner_index++) {
+        if(handshakes[joiner_index].get()) {
+            propose_join(gmsSST, joiner_iter->first, joiner_addresses[joiner_index]);
+            auto next_iter = std::next(joiner_iter);
+            proposed_join_sockets.splice(proposed_join_sockets.end(), joiners, joiner_iter);
+            joiner_iter = next_iter;
+        } else {
+            //If the join failed, close the socket
+            joiner_iter = joiners.erase(joiner_iter);
+        }
+    }
+}
 
+bool ViewManager::receive_join(const node_id_t joiner_id, tcp::socket& joiner_socket, bool id_in_use,
+                               IpAndPorts& joiner_address) {
     const node_id_t my_id = curr_view->members[curr_view->my_rank];
-    uint16_t joiner_gms_port = 0;
-    uint16_t joiner_state_transfer_port = 0;
-    uint16_t joiner_sst_port = 0;
-    uint16_t joiner_rdmc_port = 0;
-    uint16_t joiner_external_port = 0;
     try {
-        if(curr_view->rank_of(joiner_id) != -1) {
+        if(id_in_use || curr_view->rank_of(joiner_id) != -1) {
             dbg_warn(vm_logger, "Joining node at IP {} announced it has ID {}, which is already in the View!", joiner_socket.get_remote_ip(), joiner_id);
             joiner_socket.write(JoinResponse{JoinResponseCode::ID_IN_USE, my_id});
             return false;
         }
         joiner_socket.write(JoinResponse{JoinResponseCode::OK, my_id});
 
-        joiner_socket.read(joiner_gms_port);
-        joiner_socket.read(joiner_state_transfer_port);
-        joiner_socket.read(joiner_sst_port);
-        joiner_socket.read(joiner_rdmc_port);
-        joiner_socket.read(joiner_external_port);
+        joiner_address.ip_address = joiner_socket.get_remote_ip();
+        joiner_socket.read(joiner_address.gms_port);
+        joiner_socket.read(joiner_address.state_transfer_port);
+        joiner_socket.read(joiner_address.sst_port);
+        joiner_socket.read(joiner_address.rdmc_port);
+        joiner_socket.read(joiner_address.external_port);
     } catch(tcp::socket_error& ex) {
         dbg_warn(vm_logger, "TCP connection to node {} at IP {} failed during join-request handshake. Ignoring request.", joiner_id, joiner_socket.get_remote_ip());
         dbg_debug(vm_logger, "Socket error description: {}", ex.what());
         return false;
     }
+    return true;
+}
+
+void ViewManager::propose_join(DerechoSST& gmsSST, const node_id_t joiner_id, const IpAndPorts& joiner_address) {
+    struct in_addr joiner_ip_packed;
+    inet_aton(joiner_address.ip_address.c_str(), &joiner_ip_packed);
 
+    const node_id_t my_id = curr_view->members[curr_view->my_rank];
     dbg_debug(vm_logger, "Proposing change #{} to add node {}. Num_installed is currently {}", gmsSST.num_changes[curr_view->my_rank] + 1, joiner_id, gmsSST.num_installed[curr_view->my_rank]);
     size_t next_change_index = gmsSST.num_changes[curr_view->my_rank]
                                - gmsSST.num_installed[curr_view->my_rank];
     if(next_change_index == gmsSST.changes.size()) {
-        // This shouldn't happen because leader_start_join already checked that
-        // num_changes - num_committed < members.size(), but we should check
+        // This shouldn't happen because propose_changes already checked that
+        // there is room for the whole batch of joins, but we should check
         // anyway in case num_committed is much larger than num_installed
         throw derecho_exception("Too many changes at once! Processing a join, but ran out of room in the pending changes list.");
     }
@@ -1774,24 +2058,24 @@ bool ViewManager::receive_join(DerechoSST& gmsSST, const node_id_t joiner_id, tc
     gmssst::set(gmsSST.joiner_ips[curr_view->my_rank][next_change_index],
                 joiner_ip_packed.s_addr);
     gmssst::set(gmsSST.joiner_gms_ports[curr_view->my_rank][next_change_index],
-                joiner_gms_port);
+                joiner_address.gms_port);
     gmssst::set(gmsSST.joiner_state_transfer_ports[curr_view->my_rank][next_change_index],
-                joiner_state_transfer_port);
+                joiner_address.state_transfer_port);
     gmssst::set(gmsSST.joiner_sst_ports[curr_view->my_rank][next_change_index],
-                joiner_sst_port);
+                joiner_address.sst_port);
     gmssst::set(gmsSST.joiner_rdmc_ports[curr_view->my_rank][next_change_index],
-                joiner_rdmc_port);
+                joiner_address.rdmc_port);
     gmssst::set(gmsSST.joiner_external_ports[curr_view->my_rank][next_change_index],
-                joiner_external_port);
+                joiner_address.external_port);
 
     gmssst::increment(gmsSST.num_changes[curr_view->my_rank]);
     //Don't actually push the proposed join yet, because we don't know if it's the last change in the batch
 
-    if(!curr_view->is_wedged()) {
+    //A join doesn't stop any subgroup before it commits if the wedge is deferred
+    if(!defer_wedge_until_commit && !curr_view->is_wedged()) {
         dbg_debug(vm_logger, "Wedging view {}", curr_view->vid);
         curr_view->wedge();
     }
-    return true;
 }
 
 std::vector<int> ViewManager::process_suspicions(DerechoSST& gmsSST) {
@@ -1829,9 +2113,14 @@ std::vector<int> ViewManager::process_suspicions(DerechoSST& gmsSST) {
 
             dbg_debug(vm_logger, "GMS telling SST to freeze row {}", curr_rank);
             gmsSST.freeze(curr_rank);
-            //These two lines are the same as Vc.wedge()
-            curr_view->multicast_group->wedge();
-            gmssst::set(gmsSST.wedged[my_rank], true);
+            if(defer_wedge_until_commit) {
+                //Only the failed node's subgroups stop sending; the view is wedged in start_meta_wedge
+                curr_view->multicast_group->wedge_subgroups(subgroups_containing({curr_view->members[curr_rank]}));
+            } else {
+                //These two lines are the same as Vc.wedge()
+                curr_view->multicast_group->wedge();
+                gmssst::set(gmsSST.wedged[my_rank], true);
+            }
             //Synchronize Vc.failed with gmsSST.suspected
             curr_view->failed[curr_rank] = true;
             curr_view->num_failed++;
@@ -1866,42 +2155,435 @@ void ViewManager::send_view(const View& new_view, tcp::socket& client_socket) {
     mutils::post_object(bind_socket_write, new_view);
 }
 
-void ViewManager::send_objects_to_new_members(const vector_int64_2d& old_shard_leaders) {
-    node_id_t my_id = next_view->members[next_view->my_rank];
+void ViewManager::transfer_objects_to_new_view(const View& new_view,
+                                               const vector_int64_2d& old_shard_leaders,
+                                               const std::set<std::pair<subgroup_id_t, node_id_t>>& subgroups_and_leaders,
+                                               const std::map<subgroup_id_t, std::unique_ptr<ReplicatedObject>>& retired_objects) {
+    node_id_t my_id = new_view.members[new_view.my_rank];
+    object_transfer_map_t objects_to_send;
     for(subgroup_id_t subgroup_id = 0; subgroup_id < old_shard_leaders.size(); ++subgroup_id) {
         for(uint32_t shard = 0; shard < old_shard_leaders[subgroup_id].size(); ++shard) {
             //if I was the leader of the shard in the old view...
             if(my_id == old_shard_leaders[subgroup_id][shard]) {
                 //send its object state to the new members
-                for(node_id_t shard_joiner : next_view->subgroup_shard_views[subgroup_id][shard].joined) {
+                for(node_id_t shard_joiner : new_view.subgroup_shard_views[subgroup_id][shard].joined) {
                     if(shard_joiner != my_id) {
-                        send_subgroup_object(subgroup_id, shard_joiner);
+                        //If this node left the shard, its object is no longer in subgroup_objects
+                        auto retired_object = retired_objects.find(subgroup_id);
+                        ReplicatedObject* subgroup_object = retired_object != retired_objects.end()
+                                                                    ? retired_object->second.get()
+                                                                    : subgroup_objects.at(subgroup_id);
+                        objects_to_send[shard_joiner].emplace_back(subgroup_id, subgroup_object);
+                    }
+                }
+            }
+        }
+    }
+    transfer_objects(objects_to_send, get_objects_to_receive(subgroups_and_leaders));
+}
+
+ViewManager::object_transfer_map_t ViewManager::get_objects_to_receive(
+        const std::set<std::pair<subgroup_id_t, node_id_t>>& subgroups_and_leaders) {
+    object_transfer_map_t objects_to_receive;
+    //Iterating over the set in order keeps each node's list in ascending order of subgroup ID
+    for(const auto& subgroup_and_leader : subgroups_and_leaders) {
+        objects_to_receive[subgroup_and_leader.second].emplace_back(subgroup_and_leader.first,
+                                                                    subgroup_objects.at(subgroup_and_leader.first));
+    }
+    return objects_to_receive;
+}
+
+void ViewManager::transfer_objects(const object_transfer_map_t& objects_to_send,
+                                   const object_transfer_map_t& objects_to_receive) {
+    const std::vector<std::pair<subgroup_id_t, ReplicatedObject*>> no_objects;
+    std::set<node_id_t> other_nodes;
+    for(const auto& node_and_objects : objects_to_send) {
+        other_nodes.insert(node_and_objects.first);
+    }
+    for(const auto& node_and_objects : objects_to_receive) {
+        other_nodes.insert(node_and_objects.first);
+    }
+    if(other_nodes.empty()) {
+        dbg_debug(vm_logger, "No Replicated Objects to send or receive");
+        return;
+    }
+    //Each thread uses a different socket, so holding the lock on all of them here is enough
+    LockedReference<std::unique_lock<std::mutex>, std::map<node_id_t, tcp::socket>> sockets
+            = tcp_sockets.get_all_sockets();
+    /* State transfer gets its own RDMA connection to each node, since the joined nodes and
+     * the nodes in total restart have none until the view commits. Setting up a connection
+     * waits for the other node, and the server side of a LibFabric connection uses a global
+     * event queue, so they are set up one at a time in ascending order of node ID, which every
+     * node follows and so cannot deadlock. The SST buffers of each connection are unused,
+     * since state transfer reads and writes OOB memory, and must outlive the connection. */
+    std::map<node_id_t, std::unique_ptr<uint64_t[]>> rdma_connection_buffers;
+    std::map<node_id_t, std::unique_ptr<sst::resources>> rdma_connections;
+    if(getConfBoolean(Conf::DERECHO_RDMA_STATE_TRANSFER)) {
+        for(const node_id_t other_id : other_nodes) {
+            dbg_debug(vm_logger, "Setting up an RDMA connection to node {} for state transfer", other_id);
+            uint64_t* buffers = rdma_connection_buffers.emplace(other_id, std::make_unique<uint64_t[]>(2))
+                                        .first->second.get();
+#ifdef USE_VERBS_API
+            rdma_connections.emplace(other_id, std::make_unique<sst::resources>(
+                                                       other_id, reinterpret_cast<uint8_t*>(&buffers[0]),
+                                                       reinterpret_cast<uint8_t*>(&buffers[1]),
+                                                       sizeof(uint64_t), sizeof(uint64_t)));
+#else
+            rdma_connections.emplace(other_id, std::make_unique<sst::resources>(
+                                                       other_id, reinterpret_cast<uint8_t*>(&buffers[0]),
+                                                       reinterpret_cast<uint8_t*>(&buffers[1]),
+                                                       sizeof(uint64_t), sizeof(uint64_t),
+                                                       getConfUInt32(Conf::DERECHO_LOCAL_ID) > other_id));
+#endif
+        }
+    }
+    std::map<node_id_t, std::future<void>> transfers;
+    for(const node_id_t other_id : other_nodes) {
+        auto send_list = objects_to_send.find(other_id);
+        auto receive_list = objects_to_receive.find(other_id);
+        auto rdma_connection = rdma_connections.find(other_id);
+        transfers.emplace(other_id, std::async(std::launch::async,
+                                               [this, other_id,
+                                                &other_socket = sockets.get().at(other_id),
+                                                &send_objects = send_list != objects_to_send.end() ? send_list->second : no_objects,
+                                                &receive_objects = receive_list != objects_to_receive.end() ? receive_list->second : no_objects,
+                                                rdma_connection = rdma_connection != rdma_connections.end() ? rdma_connection->second.get() : nullptr]() {
+                                                   transfer_objects_with(other_id, other_socket, send_objects, receive_objects,
+                                                                         rdma_connection);
+                                               }));
+    }
+    //Wait for every transfer to stop before reporting a failure, since they all use the locked sockets
+    std::exception_ptr first_exception;
+    for(auto& transfer : transfers) {
+        try {
+            transfer.second.get();
+        } catch(tcp::socket_error& e) {
+            // Convert socket exceptions to a more readable error message, since this will cause a crash
+            if(!first_exception) {
+                first_exception = std::make_exception_ptr(derecho_exception(
+                        "Fatal error: Node " + std::to_string(transfer.first) + " failed during state transfer!"));
+            }
+        } catch(...) {
+            if(!first_exception) {
+                first_exception = std::current_exception();
+            }
+        }
+    }
+    if(first_exception) {
+        std::rethrow_exception(first_exception);
+    }
+    dbg_debug(vm_logger, "Done sending and receiving Replicated Objects with {} nodes", other_nodes.size());
+}
+
+void ViewManager::transfer_objects_with(node_id_t other_id, tcp::socket& other_socket,
+                                        const std::vector<std::pair<subgroup_id_t, ReplicatedObject*>>& objects_to_send,
+                                        const std::vector<std::pair<subgroup_id_t, ReplicatedObject*>>& objects_to_receive,
+                                        sst::resources* rdma_connection) {
+    /* Each direction of the socket carries the log tail lengths of the persistent
+     * objects the writer is about to receive, followed by the objects it sends.
+     * A log tail length is the latest version of each of the object's Persistent
+     * fields, so each field's log is sent from where the receiver's copy ends.
+     * Since the log tail lengths come first and don't depend on anything the
+     * other node does, neither node can end up waiting for the other's object
+     * while the other waits for its log tail length. If any objects were read
+     * with RDMA, the reader's acknowledgement comes last; it is written as soon
+     * as the reads are done, so it doesn't wait for anything in the other direction. */
+    using field_versions_t = std::map<std::size_t, persistent::version_t>;
+    std::promise<std::vector<field_versions_t>> log_tails_promise;
+    std::future<std::vector<field_versions_t>> log_tails_future = log_tails_promise.get_future();
+    std::promise<bool> objects_read_promise;
+    std::future<bool> objects_read_future = objects_read_promise.get_future();
+    // Set when the receiving thread exits, so that this thread stops waiting for the other node's RDMA reads
+    std::atomic<bool> receiver_stopped = false;
+    std::future<void> receiver = std::async(std::launch::async, [&]() {
+        struct stopped_flag_setter {
+            std::atomic<bool>& stopped;
+            ~stopped_flag_setter() { stopped = true; }
+        } set_stopped_on_exit{receiver_stopped};
+        std::vector<field_versions_t> log_tail_lengths(objects_to_send.size());
+        try {
+            for(std::size_t i = 0; i < objects_to_send.size(); ++i) {
+                if(objects_to_send[i].second->is_persistent()) {
+                    std::size_t num_fields;
+                    other_socket.read(num_fields);
+                    for(std::size_t field = 0; field < num_fields; ++field) {
+                        std::size_t field_key;
+                        persistent::version_t field_version;
+                        other_socket.read(field_key);
+                        other_socket.read(field_version);
+                        log_tail_lengths[i].emplace(field_key, field_version);
                     }
+                    dbg_debug(vm_logger, "Got log tail lengths of {} fields for subgroup {} from {}",
+                              num_fields, objects_to_send[i].first, other_id);
+                }
+            }
+        } catch(...) {
+            log_tails_promise.set_exception(std::current_exception());
+            objects_read_promise.set_exception(std::current_exception());
+            throw;
+        }
+        log_tails_promise.set_value(std::move(log_tail_lengths));
+        /* Each object is received into a ring of chunks, and another thread deserializes it
+         * from the ring as the chunks arrive. The previous object may still be deserializing
+         * while the next one is received, so at most two rings are in memory at once. */
+        const std::size_t receive_chunk_size = getConfUInt64(Conf::DERECHO_STATE_TRANSFER_CHUNK_SIZE);
+        std::future<void> previous_deserialization;
+        bool any_read_with_rdma = false;
+        // Numbers the chunks read with RDMA across all objects, like the sender does
+        uint64_t rdma_chunks_read = 0;
+        try {
+            for(const auto& subgroup_and_object : objects_to_receive) {
+                dbg_debug(vm_logger, "Receiving Replicated Object state for subgroup {} from node {}",
+                          subgroup_and_object.first, other_id);
+                uint8_t method;
+                other_socket.read(method);
+                std::size_t object_size;
+                other_socket.read(object_size);
+                const bool over_rdma = (method == STATE_OVER_RDMA);
+                any_read_with_rdma = any_read_with_rdma || over_rdma;
+                std::shared_ptr<ChunkRing> ring = std::make_shared<ChunkRing>(RECEIVE_RING_CHUNKS, receive_chunk_size);
+                std::future<void> deserialization = std::async(
+                        std::launch::async,
+                        [this, ring, object_size, other_id, subgroup_id = subgroup_and_object.first,
+                         subgroup_object = subgroup_and_object.second]() {
+                            // Once the object is deserialized, no more of its chunks will be consumed
+                            struct reading_stopper {
+                                ChunkRing& ring;
+                                ~reading_stopper() { ring.stop_reading(); }
+                            } stop_reading_on_exit{*ring};
+                            dbg_trace(vm_logger, "Deserializing received Replicated Object");
+                            try {
+                                subgroup_object->receive_object(*ring, object_size);
+                            } catch(const std::exception& e) {
+                                dbg_error(vm_logger, "Failed to deserialize the Replicated Object for subgroup {} from node {}: {}",
+                                          subgroup_id, other_id, e.what());
+                                throw;
+                            }
+                        });
+                {
+                    // Once this thread is done with the ring, whether or not every chunk arrived, the
+                    // deserializer must not wait for more. This is closed before the future is destroyed.
+                    struct ring_closer {
+                        ChunkRing& ring;
+                        ~ring_closer() { ring.close(); }
+                    } close_ring_on_exit{*ring};
+                    receive_object_state(other_id, other_socket, rdma_connection, over_rdma, object_size,
+                                         *ring, rdma_chunks_read);
                 }
+                if(previous_deserialization.valid()) {
+                    previous_deserialization.get();
+                }
+                previous_deserialization = std::move(deserialization);
+            }
+        } catch(...) {
+            objects_read_promise.set_exception(std::current_exception());
+            throw;
+        }
+        objects_read_promise.set_value(any_read_with_rdma);
+        if(previous_deserialization.valid()) {
+            previous_deserialization.get();
+        }
+        if(rdma_connection && !objects_to_send.empty()) {
+            // The other node is done reading this node's chunk buffers once it acknowledges them
+            uint8_t ack;
+            other_socket.read(ack);
+        }
+    });
+    /* With RDMA, each object is serialized a chunk at a time into a ring of chunk
+     * buffers registered as OOB memory, and only each chunk's size, address and
+     * memory key are written to the socket. After reading a chunk, the other node
+     * writes the number of chunks it has read into rdma_chunks_read, so this node
+     * knows which buffers it can reuse. */
+    const std::size_t chunk_size = getConfUInt64(Conf::DERECHO_STATE_TRANSFER_CHUNK_SIZE);
+    std::vector<std::unique_ptr<uint8_t[]>> rdma_chunks;
+    std::unique_ptr<uint64_t> rdma_chunks_read;
+    uint64_t rdma_chunks_sent = 0;
+    auto release_rdma_buffers = [&]() {
+        for(const auto& chunk : rdma_chunks) {
+            sst::P2PConnection::deregister_oob_memory(chunk.get());
+        }
+        rdma_chunks.clear();
+        if(rdma_chunks_read) {
+            sst::P2PConnection::deregister_oob_memory(rdma_chunks_read.get());
+            rdma_chunks_read.reset();
+        }
+    };
+    // If this thread throws, the receiving thread fails too once the socket breaks, and
+    // destroying its future waits for that before the promises are destroyed
+    try {
+        if(rdma_connection && !objects_to_send.empty()) {
+            memory_attribute_t attr;
+            attr.type = memory_attribute_t::memory_type_t::SYSTEM;
+            rdma_chunks_read = std::make_unique<uint64_t>(0);
+            sst::P2PConnection::register_oob_memory_ex(rdma_chunks_read.get(), sizeof(uint64_t), attr);
+            // Each chunk is registered on its own, since some providers can only access an OOB region from its start
+            for(std::size_t i = 0; i < RDMA_SEND_CHUNKS; ++i) {
+                rdma_chunks.emplace_back(std::make_unique<uint8_t[]>(chunk_size));
+                sst::P2PConnection::register_oob_memory_ex(rdma_chunks.back().get(), chunk_size, attr);
             }
         }
+        for(const auto& subgroup_and_object : objects_to_receive) {
+            if(subgroup_and_object.second->is_persistent()) {
+                field_versions_t log_tail_lengths = subgroup_and_object.second->get_latest_persisted_versions();
+                dbg_debug(vm_logger, "Sending log tail lengths of {} fields (minimum {}) for subgroup {} to node {}.",
+                          log_tail_lengths.size(), subgroup_and_object.second->get_minimum_latest_persisted_version(),
+                          subgroup_and_object.first, other_id);
+                other_socket.write(log_tail_lengths.size());
+                for(const auto& field_and_version : log_tail_lengths) {
+                    other_socket.write(field_and_version.first);
+                    other_socket.write(field_and_version.second);
+                }
+            }
+        }
+        std::vector<field_versions_t> log_tail_lengths = log_tails_future.get();
+        for(std::size_t i = 0; i < objects_to_send.size(); ++i) {
+            // The earliest versions to serialize are thread-local, so each transfer thread can set its own
+            persistent::PersistentRegistry::setEarliestVersionsToSerialize(log_tail_lengths[i]);
+            if(rdma_connection) {
+                std::size_t object_size = objects_to_send[i].second->object_size();
+                dbg_debug(vm_logger, "Sending Replicated Object state for subgroup {} to node {} with RDMA, size {}",
+                          objects_to_send[i].first, other_id, object_size);
+                other_socket.write(STATE_OVER_RDMA);
+                other_socket.write(object_size);
+                other_socket.write(reinterpret_cast<uint64_t>(rdma_chunks_read.get()));
+                other_socket.write(sst::P2PConnection::get_oob_memory_key(rdma_chunks_read.get()));
+                objects_to_send[i].second->send_object_chunks(
+                        chunk_size,
+                        [&]() {
+                            // Wait until the other node has read the chunk that last used this buffer
+                            const volatile uint64_t* chunks_read = rdma_chunks_read.get();
+                            while(rdma_chunks_sent - *chunks_read >= rdma_chunks.size()) {
+                                if(receiver_stopped) {
+                                    throw derecho_exception("Fatal error: Node " + std::to_string(other_id)
+                                                            + " failed during state transfer!");
+                                }
+                                std::this_thread::yield();
+                            }
+                            return rdma_chunks[rdma_chunks_sent % rdma_chunks.size()].get();
+                        },
+                        [&](std::size_t size) {
+                            uint8_t* chunk = rdma_chunks[rdma_chunks_sent % rdma_chunks.size()].get();
+                            other_socket.write(size);
+                            other_socket.write(reinterpret_cast<uint64_t>(chunk));
+                            other_socket.write(sst::P2PConnection::get_oob_memory_key(chunk));
+                            ++rdma_chunks_sent;
+                        });
+            } else {
+                dbg_debug(vm_logger, "Sending Replicated Object state for subgroup {} to node {} over the state-transfer socket",
+                          objects_to_send[i].first, other_id);
+                other_socket.write(STATE_OVER_TCP);
+                objects_to_send[i].second->send_object(other_socket);
+            }
+        }
+        persistent::PersistentRegistry::resetEarliestVersionToSerialize();
+        if(objects_read_future.get()) {
+            other_socket.write(RDMA_READS_DONE);
+        }
+        receiver.get();
+    } catch(...) {
+        persistent::PersistentRegistry::resetEarliestVersionToSerialize();
+        release_rdma_buffers();
+        throw;
     }
+    release_rdma_buffers();
 }
 
-/* Note for the future: Since this "send" requires first receiving the log tail length,
- * it's really a blocking receive-then-send. Since all nodes call send_subgroup_object
- * before initialize_subgroup_objects, there's a small chance of a deadlock: node A could
- * be attempting to send an object to node B at the same time as B is attempting to send a
- * different object to A, and neither node will be able to send the log tail length that
- * the other one is waiting on. */
-void ViewManager::send_subgroup_object(subgroup_id_t subgroup_id, node_id_t new_node_id) {
-    LockedReference<std::unique_lock<std::mutex>, tcp::socket> joiner_socket = tcp_sockets.get_socket(new_node_id);
-    assert(subgroup_objects.find(subgroup_id) != subgroup_objects.end());
-    ReplicatedObject* subgroup_object = subgroup_objects.at(subgroup_id);
-    if(subgroup_object->is_persistent()) {
-        //First, read the log tail length sent by the joining node
-        persistent::version_t persistent_log_length = 0;
-        joiner_socket.get().read(persistent_log_length);
-        persistent::PersistentRegistry::setEarliestVersionToSerialize(persistent_log_length);
-        dbg_debug(vm_logger, "Got log tail length {} from {}", persistent_log_length, joiner_socket.get().get_remote_ip());
+void ViewManager::receive_object_state(node_id_t other_id, tcp::socket& other_socket,
+                                       sst::resources* rdma_connection, bool over_rdma,
+                                       std::size_t object_size, ChunkRing& ring, uint64_t& rdma_chunks_read) {
+    if(!over_rdma) {
+        for(std::size_t offset = 0; offset < object_size;) {
+            const std::size_t chunk_size = std::min(ring.get_chunk_size(), object_size - offset);
+            uint8_t* chunk = ring.next_free_chunk();
+            other_socket.read(chunk, chunk_size);
+            ring.chunk_filled(chunk_size);
+            offset += chunk_size;
+        }
+        return;
+    }
+    if(!rdma_connection) {
+        throw derecho_exception("Node " + std::to_string(other_id)
+                                + " sent object state with RDMA, but this node has no RDMA connection to it."
+                                + " Check that " + Conf::DERECHO_RDMA_STATE_TRANSFER + " is the same at every node.");
+    }
+    uint64_t chunks_read_addr;
+    uint64_t chunks_read_key;
+    other_socket.read(chunks_read_addr);
+    other_socket.read(chunks_read_key);
+    dbg_debug(vm_logger, "Reading Replicated Object of size {} from node {} with RDMA", object_size, other_id);
+    // The number of chunks read so far, which is written to the sender after each read
+    std::unique_ptr<uint64_t> chunks_read_count = std::make_unique<uint64_t>(rdma_chunks_read);
+    std::vector<void*> registered_memory;
+    auto deregister_memory = [&]() {
+        for(void* memory : registered_memory) {
+            sst::P2PConnection::deregister_oob_memory(memory);
+        }
+    };
+    try {
+        memory_attribute_t attr;
+        attr.type = memory_attribute_t::memory_type_t::SYSTEM;
+        sst::P2PConnection::register_oob_memory_ex(chunks_read_count.get(), sizeof(uint64_t), attr);
+        registered_memory.emplace_back(chunks_read_count.get());
+        // The chunks are read into directly, and each is registered on its own like the sender's
+        for(std::size_t i = 0; i < ring.num_chunks(); ++i) {
+            sst::P2PConnection::register_oob_memory_ex(ring.get_chunk(i), ring.get_chunk_size(), attr);
+            registered_memory.emplace_back(ring.get_chunk(i));
+        }
+        for(std::size_t offset = 0; offset < object_size;) {
+            std::size_t chunk_size;
+            uint64_t chunk_addr;
+            uint64_t chunk_key;
+            other_socket.read(chunk_size);
+            other_socket.read(chunk_addr);
+            other_socket.read(chunk_key);
+            if(chunk_size > object_size - offset) {
+                throw derecho_exception("Node " + std::to_string(other_id)
+                                        + " sent more object state with RDMA than the object's size");
+            }
+            if(chunk_size > ring.get_chunk_size()) {
+                throw derecho_exception("Node " + std::to_string(other_id) + " sent a state-transfer chunk of "
+                                        + std::to_string(chunk_size) + " bytes, which is larger than this node's chunks."
+                                        + " Check that " + Conf::DERECHO_STATE_TRANSFER_CHUNK_SIZE + " is the same at every node.");
+            }
+            uint8_t* chunk = ring.next_free_chunk();
+            struct iovec chunk_iov;
+            chunk_iov.iov_base = chunk;
+            chunk_iov.iov_len = chunk_size;
+            rdma_connection->oob_remote_read(&chunk_iov, 1, reinterpret_cast<void*>(chunk_addr), chunk_key, chunk_size);
+            // Each read is at most one state-transfer chunk, so one that takes 10 seconds has failed
+            rdma_connection->wait_for_oob_op(OOB_OP_READ, 10000000);
+            ring.chunk_filled(chunk_size);
+            offset += chunk_size;
+            // Tell the sender it can reuse the chunk's buffer
+            *chunks_read_count = ++rdma_chunks_read;
+            struct iovec count_iov;
+            count_iov.iov_base = chunks_read_count.get();
+            count_iov.iov_len = sizeof(uint64_t);
+            rdma_connection->oob_remote_write(&count_iov, 1, reinterpret_cast<void*>(chunks_read_addr),
+                                              chunks_read_key, sizeof(uint64_t));
+            rdma_connection->wait_for_oob_op(OOB_OP_WRITE, 10000000);
+        }
+    } catch(...) {
+        deregister_memory();
+        throw;
+    }
+    deregister_memory();
+}
+
+void ViewManager::update_sst_connections() {
+    for(const node_id_t failed_node_id : next_view->departed) {
+        dbg_debug(vm_logger, "Removing the SST TCP connection to failed node {}", failed_node_id);
+        sst::remove_node(failed_node_id);
+    }
+    for(std::size_t i = 0; i < next_view->joined.size(); ++i) {
+        // The new members will be the last joined.size() elements of the members lists
+        int joiner_rank = next_view->num_members - next_view->joined.size() + i;
+        if(!sst::add_node(next_view->members[joiner_rank],
+                          {next_view->member_ips_and_ports[joiner_rank].ip_address,
+                           next_view->member_ips_and_ports[joiner_rank].sst_port})) {
+            dbg_warn(vm_logger, "Failed to add an SST TCP connection to new node {}", next_view->members[joiner_rank]);
+        }
     }
-    dbg_debug(vm_logger, "Sending Replicated Object state for subgroup {} to node {} over the state-transfer socket", subgroup_id, new_node_id);
-    subgroup_object->send_object(joiner_socket.get());
 }
 
 void ViewManager::update_tcp_connections() {
@@ -2596,6 +3278,21 @@ std::vector<IpAndPorts> ViewManager::get_member_addresses() {
     return curr_view->member_ips_and_ports;
 }
 
+ViewChangeTimings ViewManager::get_last_view_change_timings() const {
+    std::lock_guard<std::mutex> lock(view_change_timings_mutex);
+    return last_view_change_timings;
+}
+
+BufferPoolStats ViewManager::get_rdmc_buffer_pool_stats() {
+    shared_lock_t read_lock(view_mutex);
+    return curr_view->multicast_group->get_buffer_pool_stats();
+}
+
+RDMCGroupStats ViewManager::get_rdmc_group_stats() {
+    shared_lock_t read_lock(view_mutex);
+    return curr_view->multicast_group->get_rdmc_group_stats();
+}
+
 int32_t ViewManager::get_my_rank() {
     shared_lock_t read_lock(view_mutex);
     return curr_view->my_rank;
@@ -2689,10 +3386,6 @@ SharedLockedReference<const View> ViewManager::get_current_or_restart_view() {
     }
 }
 
-LockedReference<std::unique_lock<std::mutex>, tcp::socket> ViewManager::get_transfer_socket(node_id_t member_id) {
-    return tcp_sockets.get_socket(member_id);
-}
-
 void ViewManager::debug_print_status() const {
     std::cout << "curr_view = " << curr_view->debug_string() << std::endl;
 }
@@ -1,4 +1,5 @@
 #include <derecho/mutils-serialization/SerializationSupport.hpp>
+#include <algorithm>
 #include <string.h>
 using namespace std;
 
@@ -25,6 +26,18 @@ std::size_t bytes_size(const std::string& str) {
     return str.length() + 1;
 }
 
+void ByteSource::read(void* dest, std::size_t size) {
+    uint8_t* dest_bytes = static_cast<uint8_t*>(dest);
+    while(size > 0) {
+        const auto [bytes, available] = next_bytes();
+        const std::size_t copy_size = std::min(size, available);
+        memcpy(dest_bytes, bytes, copy_size);
+        consume(copy_size);
+        dest_bytes += copy_size;
+        size -= copy_size;
+    }
+}
+
 #ifdef MUTILS_DEBUG
 void ensure_registered(ByteRepresentable& b, DeserializationManager& dm) {
     b.ensure_registered(dm);
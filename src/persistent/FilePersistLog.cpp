@@ -1,18 +1,23 @@
 #include <derecho/persistent/detail/FilePersistLog.hpp>
 
 #include <derecho/conf/conf.hpp>
+#include <derecho/persistent/detail/crc32c.hpp>
 #include <derecho/persistent/detail/util.hpp>
 #include <derecho/persistent/detail/logger.hpp>
 #include <derecho/persistent/PersistException.hpp>
 
+#include <algorithm>
 #include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <string.h>
 #include <string>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <thread>
 #include <unistd.h>
 
 #if __GNUC__ > 7
@@ -31,6 +36,11 @@ namespace persistent {
 // internal structures //
 /////////////////////////
 
+/** Logs loaded by preloadLogs() that no field has claimed yet, keyed by name,
+ * with the signature setting they were loaded with. */
+static std::mutex preloaded_logs_mutex;
+static std::map<std::string, std::pair<bool, std::unique_ptr<FilePersistLog>>> preloaded_logs;
+
 ////////////////////////
 // visible to outside //
 ////////////////////////
@@ -43,6 +53,9 @@ FilePersistLog::FilePersistLog(const string& name, const string& dataPath, bool
           m_sDataFile(dataPath + "/" + name + "." + DATA_FILE_SUFFIX),
           m_iMaxLogEntry(derecho::getConfUInt64(derecho::Conf::PERS_MAX_LOG_ENTRY)),
           m_iMaxDataSize(derecho::getConfUInt64(derecho::Conf::PERS_MAX_DATA_SIZE)),
+          m_bChecksums(derecho::getConfBoolean(derecho::Conf::PERS_ENABLE_CHECKSUMS)),
+          m_iUnverifiedTail(0),
+          m_iLoadedHead(0),
           m_logger(PersistLogger::get()),
           m_iLogFileDesc(-1),
           m_iDataFileDesc(-1),
@@ -169,6 +182,24 @@ void FilePersistLog::load() {
             }
             close(fd);
             m_currMetaHeader = m_persMetaHeader;
+            // drop any torn or corrupted entries at the end of the log
+            int64_t valid_tail = scanLoadedEntries();
+            if(valid_tail < m_currMetaHeader.fields.tail) {
+                dbg_warn(m_logger, "{0}:log entries [{1},{2}) are corrupted, truncating the log to {1} entries.",
+                         this->m_sName, valid_tail, m_currMetaHeader.fields.tail);
+                m_currMetaHeader.fields.tail = valid_tail;
+                m_currMetaHeader.fields.ver = (valid_tail > m_currMetaHeader.fields.head)
+                                                      ? LOG_ENTRY_AT(valid_tail - 1)->fields.ver
+                                                      : INVALID_VERSION;
+                persistMetaHeaderAtomically(&m_currMetaHeader);
+            }
+            m_iUnverifiedTail = m_currMetaHeader.fields.tail;
+            m_iLoadedHead = m_currMetaHeader.fields.head;
+            const int64_t num_verified_words = (m_iUnverifiedTail - m_iLoadedHead + 63) / 64;
+            m_pVerifiedEntries = std::make_unique<std::atomic<uint64_t>[]>(num_verified_words);
+            for(int64_t word = 0; word < num_verified_words; word++) {
+                m_pVerifiedEntries[word].store(0, std::memory_order_relaxed);
+            }
             // update mhlc index
             for(int64_t idx = m_currMetaHeader.fields.head; idx < m_currMetaHeader.fields.tail; idx++) {
                 struct hlc_index_entry _ent;
@@ -276,6 +307,14 @@ void FilePersistLog::append(const std::function<void(void*,uint64_t)>& blob_gene
     NEXT_LOG_ENTRY->fields.ofst = NEXT_DATA_OFST;
     NEXT_LOG_ENTRY->fields.hlc_r = mhlc.m_rtc_us;
     NEXT_LOG_ENTRY->fields.hlc_l = mhlc.m_logic;
+    // the slot may be reused, so the flags are always rewritten
+    if(m_bChecksums) {
+        NEXT_LOG_ENTRY->fields.checksum = computeChecksum(NEXT_LOG_ENTRY, LOG_ENTRY_DATA(NEXT_LOG_ENTRY));
+        NEXT_LOG_ENTRY->fields.flags = LOG_ENTRY_FLAG_CHECKSUM;
+    } else {
+        NEXT_LOG_ENTRY->fields.checksum = 0;
+        NEXT_LOG_ENTRY->fields.flags = 0;
+    }
     /* No Sync required here. */
 
     // update meta header
@@ -581,6 +620,7 @@ const void* FilePersistLog::getEntryByIndex(int64_t eidx) {
               (LOG_ENTRY_AT(ridx))->fields.hlc_r,
               (LOG_ENTRY_AT(ridx))->fields.hlc_l);
 
+    verifyLoadedEntry(ridx);
     return LOG_ENTRY_DATA(LOG_ENTRY_AT(ridx));
 }
 
@@ -610,6 +650,7 @@ const void* FilePersistLog::getEntry(version_t ver, bool exact) {
 
     dbg_trace(m_logger, "{0} getEntry at ({1},{2})", this->m_sName, ple->fields.hlc_r, ple->fields.hlc_l);
 
+    verifyLoadedEntry(l_idx);
     return LOG_ENTRY_DATA(ple);
 }
 
@@ -697,6 +738,7 @@ const void* FilePersistLog::getEntry(const HLC& rhlc) {
 
     dbg_trace(m_logger, "{0} getEntry at ({1},{2})", this->m_sName, ple->fields.hlc_r, ple->fields.hlc_l);
 
+    verifyLoadedEntry(idx);
     return LOG_ENTRY_DATA(ple);
 }
 
@@ -719,6 +761,7 @@ void FilePersistLog::processEntryAtVersion(version_t ver,
     FPL_UNLOCK;
 
     if(ple != nullptr && ple->fields.ver == ver) {
+        verifyLoadedEntry(l_idx);
         dbg_trace(m_logger, "{} - calling process function on log entry {} of size {}", m_sName, ple->fields.ver, static_cast<size_t>(ple->fields.sdlen - this->signature_size));
         func(LOG_ENTRY_DATA(ple), static_cast<size_t>(ple->fields.sdlen - this->signature_size));
     } else {
@@ -726,6 +769,18 @@ void FilePersistLog::processEntryAtVersion(version_t ver,
     }
 }
 
+// A pin is a read lock on m_rwlock. The lock is created with the default
+// (reader-preferring) attributes, so the pinning thread can take the read lock
+// again inside getEntry() and friends without deadlocking against a queued
+// writer.
+void FilePersistLog::pinEntries() {
+    FPL_RDLOCK;
+}
+
+void FilePersistLog::unpinEntries() {
+    FPL_UNLOCK;
+}
+
 // trim by index
 void FilePersistLog::trimByIndex(int64_t idx) {
     dbg_trace(m_logger, "{0} trim at index: {1}", this->m_sName, idx);
@@ -923,6 +978,38 @@ void FilePersistLog::applyLogTail(uint8_t const* v) {
     m_currMetaHeader.fields.ver = latest_version;
 }
 
+void FilePersistLog::applyLogTail(mutils::ByteSource& source) {
+    // latest_version
+    int64_t latest_version;
+    source.read(&latest_version, sizeof(int64_t));
+    // nr_log_entry
+    int64_t nr_log_entry;
+    source.read(&nr_log_entry, sizeof(int64_t));
+    if(nr_log_entry < 0) {
+        dbg_error(m_logger, "{0} received a log tail with {1} log entries.", __func__, nr_log_entry);
+        throw persistent_exception("Invalid number of log entries in a log tail: " + std::to_string(nr_log_entry));
+    }
+    // log_entries, each read into a scratch buffer that only grows to the largest entry
+    std::vector<uint8_t> entry;
+    while(nr_log_entry--) {
+        entry.resize(sizeof(LogEntry));
+        source.read(entry.data(), sizeof(LogEntry));
+        const LogEntry* ple = reinterpret_cast<const LogEntry*>(entry.data());
+        // the header comes from the sender, so check the data length before allocating for it
+        if(!dataSizeIsValid(ple)) {
+            dbg_error(m_logger, "{0} received log entry version {1} with an invalid data length of {2} bytes.",
+                      __func__, ple->fields.ver, ple->fields.sdlen);
+            throw persistent_exception("Invalid data length in the log entry for version " + std::to_string(ple->fields.ver));
+        }
+        const uint64_t sdlen = ple->fields.sdlen;
+        entry.resize(sizeof(LogEntry) + sdlen);
+        source.read(entry.data() + sizeof(LogEntry), sdlen);
+        mergeLogEntryFromByteArray(entry.data());
+    }
+    // update the latest version.
+    m_currMetaHeader.fields.ver = latest_version;
+}
+
 size_t FilePersistLog::byteSizeOfLogEntry(const LogEntry* ple) {
     return sizeof(LogEntry) + ple->fields.sdlen;
 }
@@ -966,7 +1053,12 @@ size_t FilePersistLog::mergeLogEntryFromByteArray(const uint8_t* ba) {
         dbg_trace(m_logger, "{0} failed to merge log entry, we need {1} bytes data space, but we have only {2} bytes.", __func__, cple->fields.sdlen, NUM_FREE_BYTES);
         throw persistent_log_full("Insufficient space for log data");
     }
-    // 2) merge it!
+    // 2) was it damaged on the way?
+    if(!checksumMatches(cple, ba + sizeof(LogEntry) + signature_size)) {
+        dbg_error(m_logger, "{0} failed to merge log entry, checksum mismatch at version {1}.", __func__, cple->fields.ver);
+        throw persistent_checksum_error(cple->fields.ver);
+    }
+    // 3) merge it!
     memcpy(NEXT_DATA, (const void*)(ba + sizeof(LogEntry)), cple->fields.sdlen);
     memcpy(NEXT_LOG_ENTRY, cple, sizeof(LogEntry));
     NEXT_LOG_ENTRY->fields.ofst = NEXT_DATA_OFST;
@@ -1018,6 +1110,8 @@ void FilePersistLog::truncate(version_t ver) {
     }
     if(m_currMetaHeader.fields.ver > ver)
         m_currMetaHeader.fields.ver = ver;
+    if(m_iUnverifiedTail > m_currMetaHeader.fields.tail)
+        m_iUnverifiedTail = m_currMetaHeader.fields.tail;
     // STEP 3: update PERSISTENT STATE
     FPL_PERS_LOCK;
     try {
@@ -1032,6 +1126,70 @@ void FilePersistLog::truncate(version_t ver) {
     dbg_trace(m_logger, "{0} truncate at version: {1}....done", this->m_sName, ver);
 }
 
+uint32_t FilePersistLog::computeChecksum(const LogEntry* ple, const void* pdata) const {
+    // ofst is left out because it changes when an entry is merged into another
+    // log, and so are the signature and prev_signed_ver, which addSignature()
+    // fills in after the entry is appended.
+    uint32_t crc = crc32c(0, &ple->fields.ver, sizeof(ple->fields.ver));
+    crc = crc32c(crc, &ple->fields.sdlen, sizeof(ple->fields.sdlen));
+    crc = crc32c(crc, &ple->fields.hlc_r, sizeof(ple->fields.hlc_r));
+    crc = crc32c(crc, &ple->fields.hlc_l, sizeof(ple->fields.hlc_l));
+    return crc32c(crc, pdata, ple->fields.sdlen - signature_size);
+}
+
+bool FilePersistLog::checksumMatches(const LogEntry* ple, const void* pdata) const {
+    if(!(ple->fields.flags & LOG_ENTRY_FLAG_CHECKSUM)) {
+        return true;
+    }
+    if(!dataSizeIsValid(ple)) {
+        return false;
+    }
+    return computeChecksum(ple, pdata) == ple->fields.checksum;
+}
+
+bool FilePersistLog::dataSizeIsValid(const LogEntry* ple) const {
+    return ple->fields.sdlen >= signature_size && ple->fields.sdlen <= MAX_DATA_SIZE;
+}
+
+void FilePersistLog::verifyLoadedEntry(int64_t idx) {
+    if(idx >= m_iUnverifiedTail) {
+        return;
+    }
+    const uint64_t bit = idx - m_iLoadedHead;
+    std::atomic<uint64_t>& word = m_pVerifiedEntries[bit / 64];
+    const uint64_t mask = 1ull << (bit % 64);
+    if(word.load(std::memory_order_acquire) & mask) {
+        return;
+    }
+    const LogEntry* ple = LOG_ENTRY_AT(idx);
+    if(!checksumMatches(ple, LOG_ENTRY_DATA(ple))) {
+        dbg_error(m_logger, "{0} checksum mismatch in log entry {1}, version {2}.", this->m_sName, idx, ple->fields.ver);
+        throw persistent_checksum_error(ple->fields.ver);
+    }
+    word.fetch_or(mask, std::memory_order_release);
+}
+
+int64_t FilePersistLog::scanLoadedEntries() {
+    const int64_t head = m_currMetaHeader.fields.head;
+    const int64_t tail = m_currMetaHeader.fields.tail;
+    for(int64_t idx = head; idx < tail; idx++) {
+        const LogEntry* ple = LOG_ENTRY_AT(idx);
+        if(!dataSizeIsValid(ple)) {
+            return idx;
+        }
+        if(idx > head) {
+            const LogEntry* prev = LOG_ENTRY_AT(idx - 1);
+            if(ple->fields.ver <= prev->fields.ver || ple->fields.ofst != prev->fields.ofst + prev->fields.sdlen) {
+                return idx;
+            }
+        }
+    }
+    if(tail > head && !checksumMatches(LOG_ENTRY_AT(tail - 1), LOG_ENTRY_DATA(LOG_ENTRY_AT(tail - 1)))) {
+        return tail - 1;
+    }
+    return tail;
+}
+
 const uint64_t FilePersistLog::getMinimumLatestPersistedVersion(const std::string& prefix) {
     // STEP 1: list all meta files in the path
     DIR* dir = opendir(getPersFilePath().c_str());
@@ -1067,8 +1225,88 @@ const uint64_t FilePersistLog::getMinimumLatestPersistedVersion(const std::strin
             close(fd);
             if(!found || ver > mh.fields.ver)
                 ver = mh.fields.ver;
+            found = true;
         }
     }
+    // Restart scans the directory once per subgroup, possibly concurrently, so
+    // the directory stream must not be leaked.
+    closedir(dir);
     return ver;
 }
+
+void FilePersistLog::preloadLogs(const std::vector<std::pair<std::string, bool>>& prefixes) {
+    // A reset log is recreated empty by its own constructor, so there is nothing to load ahead
+    if(prefixes.empty() || derecho::getConfBoolean(derecho::Conf::PERS_RESET)) {
+        return;
+    }
+    const std::string data_path = getPersFilePath();
+    DIR* dir = opendir(data_path.c_str());
+    if(dir == NULL) {
+        // The directory does not exist yet, so there are no logs to load
+        return;
+    }
+    std::vector<std::pair<std::string, bool>> log_names;
+    struct dirent* dent;
+    const std::string meta_suffix = std::string(".") + META_FILE_SUFFIX;
+    while((dent = readdir(dir)) != NULL) {
+        std::string file_name(dent->d_name);
+        if(file_name.length() <= meta_suffix.length()
+           || file_name.compare(file_name.length() - meta_suffix.length(), meta_suffix.length(), meta_suffix) != 0) {
+            continue;
+        }
+        for(const auto& prefix : prefixes) {
+            if(file_name.compare(0, prefix.first.length(), prefix.first) == 0) {
+                log_names.emplace_back(file_name.substr(0, file_name.length() - meta_suffix.length()), prefix.second);
+                break;
+            }
+        }
+    }
+    closedir(dir);
+    // Each log reads and maps only its own files, so they can be loaded in
+    // parallel, by at most one worker thread per core
+    const std::size_t num_workers = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                                          log_names.size());
+    std::atomic<std::size_t> next_log = 0;
+    std::vector<std::thread> workers;
+    for(std::size_t i = 0; i < num_workers; i++) {
+        workers.emplace_back([&data_path, &log_names, &next_log]() {
+            for(std::size_t l = next_log++; l < log_names.size(); l = next_log++) {
+                const auto& log_name = log_names[l];
+                try {
+                    auto log = std::make_unique<FilePersistLog>(log_name.first, data_path, log_name.second);
+                    std::lock_guard<std::mutex> lock(preloaded_logs_mutex);
+                    preloaded_logs[log_name.first] = std::make_pair(log_name.second, std::move(log));
+                } catch(std::exception& e) {
+                    dbg_warn(PersistLogger::get(), "{}: failed to preload log {}: {}", __func__, log_name.first, e.what());
+                }
+            }
+        });
+    }
+    for(auto& worker : workers) {
+        worker.join();
+    }
+}
+
+std::unique_ptr<FilePersistLog> FilePersistLog::takePreloadedLog(const std::string& name,
+                                                                 const std::string& dataPath,
+                                                                 bool enableSignatures) {
+    std::lock_guard<std::mutex> lock(preloaded_logs_mutex);
+    auto preloaded = preloaded_logs.find(name);
+    if(preloaded == preloaded_logs.end()) {
+        return nullptr;
+    }
+    std::unique_ptr<FilePersistLog> log = std::move(preloaded->second.second);
+    bool loaded_with_signatures = preloaded->second.first;
+    preloaded_logs.erase(preloaded);
+    // The log must be released before the caller loads it again with different settings
+    if(loaded_with_signatures != enableSignatures || log->m_sDataPath != dataPath) {
+        return nullptr;
+    }
+    return log;
+}
+
+void FilePersistLog::discardPreloadedLogs() {
+    std::lock_guard<std::mutex> lock(preloaded_logs_mutex);
+    preloaded_logs.clear();
+}
 }  // namespace persistent
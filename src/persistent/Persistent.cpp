@@ -4,13 +4,21 @@
 #include <derecho/openssl/hash.hpp>
 #include <derecho/openssl/signature.hpp>
 
+#include <exception>
 #include <functional>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <queue>
+#include <thread>
 #include <string>
 #include <typeindex>
+#include <vector>
 
 namespace persistent {
 
 thread_local int64_t PersistentRegistry::earliest_version_to_serialize = INVALID_VERSION;
+thread_local std::map<std::size_t, version_t> PersistentRegistry::earliest_versions_to_serialize;
 
 PersistentRegistry::PersistentRegistry(
         ITemporalQueryFrontierProvider* tqfp,
@@ -19,13 +27,83 @@ PersistentRegistry::PersistentRegistry(
         uint32_t shard_num) : m_subgroupPrefix(generate_prefix(subgroup_type, subgroup_index, shard_num)),
                               m_logger(PersistLogger::get()),
                               m_temporalQueryFrontierProvider(tqfp),
+                              m_ioShutdown(false),
                               m_lastSignedVersion(INVALID_VERSION) {
 }
 
 PersistentRegistry::~PersistentRegistry() {
+    {
+        std::lock_guard<std::mutex> lock(m_ioQueueMutex);
+        m_ioShutdown = true;
+    }
+    m_ioQueueCV.notify_all();
+    for(auto& io_thread : m_ioThreads) {
+        io_thread.join();
+    }
     this->m_registry.clear();
 };
 
+void PersistentRegistry::ioThreadLoop() {
+    pthread_setname_np(pthread_self(), "persist_io");
+    while(true) {
+        std::packaged_task<void()> field_task;
+        {
+            std::unique_lock<std::mutex> lock(m_ioQueueMutex);
+            m_ioQueueCV.wait(lock, [this]() { return m_ioShutdown || !m_ioQueue.empty(); });
+            if(m_ioQueue.empty()) {
+                return;
+            }
+            field_task = std::move(m_ioQueue.front());
+            m_ioQueue.pop();
+        }
+        // Any exception is stored in the task's future for the caller to rethrow
+        field_task();
+    }
+}
+
+void PersistentRegistry::forEachFieldConcurrently(const std::function<void(PersistentObject*)>& field_op) {
+    if(m_registry.empty()) {
+        return;
+    }
+    std::vector<std::future<void>> field_results;
+    field_results.reserve(m_registry.size() - 1);
+    {
+        std::lock_guard<std::mutex> lock(m_ioQueueMutex);
+        // Fields register after the registry is constructed, so start any
+        // I/O threads that the fields registered since the last call need
+        while(m_ioThreads.size() < m_registry.size() - 1) {
+            m_ioThreads.emplace_back(&PersistentRegistry::ioThreadLoop, this);
+        }
+        for(auto itr = std::next(m_registry.begin()); itr != m_registry.end(); ++itr) {
+            PersistentObject* field = itr->second;
+            std::packaged_task<void()> field_task([&field_op, field]() { field_op(field); });
+            field_results.emplace_back(field_task.get_future());
+            m_ioQueue.push(std::move(field_task));
+        }
+    }
+    m_ioQueueCV.notify_all();
+    std::exception_ptr field_error;
+    try {
+        field_op(m_registry.begin()->second);
+    } catch(...) {
+        field_error = std::current_exception();
+    }
+    // Wait for every queued operation, even if one of them failed, since they
+    // refer to field_op
+    for(auto& result : field_results) {
+        try {
+            result.get();
+        } catch(...) {
+            if(!field_error) {
+                field_error = std::current_exception();
+            }
+        }
+    }
+    if(field_error) {
+        std::rethrow_exception(field_error);
+    }
+}
+
 void PersistentRegistry::makeVersion(version_t ver, const HLC& mhlc) {
     dbg_trace(m_logger, "PersistentRegistry: makeVersion({}, hlc({},{}))", ver, mhlc.m_rtc_us, mhlc.m_logic);
     for(auto& entry : m_registry) {
@@ -183,13 +261,17 @@ bool PersistentRegistry::verify(version_t version, openssl::Verifier& verifier,
 
 version_t PersistentRegistry::persist(std::optional<version_t> latest_version) {
     version_t min = INVALID_VERSION;
-    for(auto& entry : m_registry) {
-        version_t ver = entry.second->persist(latest_version);
-        if (min == INVALID_VERSION ||
-            min > ver) {
+    std::mutex min_mutex;
+    // Each field flushes its own log files under its own locks, so the msync and
+    // meta-file rename of every field can be issued concurrently. All the flushes
+    // must finish before the minimum persisted version can be computed.
+    forEachFieldConcurrently([&](PersistentObject* field) {
+        version_t ver = field->persist(latest_version);
+        std::lock_guard<std::mutex> lock(min_mutex);
+        if(min == INVALID_VERSION || min > ver) {
             min = ver;
         }
-    }
+    });
     return min;
 };
 
@@ -214,22 +296,45 @@ int64_t PersistentRegistry::getMinimumLatestPersistedVersion() {
     return min;
 }
 
+std::map<std::size_t, version_t> PersistentRegistry::getLatestPersistedVersions() {
+    std::map<std::size_t, version_t> versions;
+    for(const auto& registry_entry : m_registry) {
+        versions.emplace(registry_entry.first, registry_entry.second->getLastPersistedVersion());
+    }
+    return versions;
+}
+
 void PersistentRegistry::setEarliestVersionToSerialize(version_t ver) noexcept(true) {
     PersistentRegistry::earliest_version_to_serialize = ver;
 }
 
+void PersistentRegistry::setEarliestVersionsToSerialize(const std::map<std::size_t, version_t>& versions) {
+    PersistentRegistry::earliest_versions_to_serialize = versions;
+}
+
 void PersistentRegistry::resetEarliestVersionToSerialize() noexcept(true) {
     PersistentRegistry::earliest_version_to_serialize = INVALID_VERSION;
+    PersistentRegistry::earliest_versions_to_serialize.clear();
 }
 
 int64_t PersistentRegistry::getEarliestVersionToSerialize() noexcept(true) {
     return PersistentRegistry::earliest_version_to_serialize;
 }
 
-void PersistentRegistry::truncate(version_t last_version) {
-    for(auto& entry : m_registry) {
-        entry.second->truncate(last_version);
+int64_t PersistentRegistry::getEarliestVersionToSerialize(const std::string& obj_name) noexcept(true) {
+    auto field_version = earliest_versions_to_serialize.find(std::hash<std::string>{}(obj_name));
+    if(field_version != earliest_versions_to_serialize.end()) {
+        return field_version->second;
     }
+    return PersistentRegistry::earliest_version_to_serialize;
+}
+
+void PersistentRegistry::truncate(version_t last_version) {
+    // Like persist(), each field truncates and rewrites its own log files, so
+    // the fields are truncated concurrently.
+    forEachFieldConcurrently([last_version](PersistentObject* field) {
+        field->truncate(last_version);
+    });
 }
 
 void PersistentRegistry::registerPersistent(const std::string& obj_name,
@@ -0,0 +1,66 @@
+#include <derecho/persistent/detail/crc32c.hpp>
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+namespace persistent {
+
+// reflected CRC32C polynomial
+static constexpr uint32_t CRC32C_POLY = 0x82f63b78;
+
+static std::array<uint32_t, 256> make_crc32c_table() {
+    std::array<uint32_t, 256> table;
+    for(uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for(int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : (crc >> 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+static uint32_t crc32c_sw(uint32_t crc, const uint8_t* p, std::size_t len) {
+    static const std::array<uint32_t, 256> table = make_crc32c_table();
+    while(len--) {
+        crc = table[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(__x86_64__)
+// Compiled for SSE4.2 regardless of the build flags; only called after the
+// CPU has been checked for support.
+__attribute__((target("sse4.2"))) static uint32_t crc32c_hw(uint32_t crc, const uint8_t* p, std::size_t len) {
+    uint64_t crc64 = crc;
+    while(len >= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        p += sizeof(uint64_t);
+        len -= sizeof(uint64_t);
+    }
+    crc = static_cast<uint32_t>(crc64);
+    while(len--) {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return crc;
+}
+#endif
+
+uint32_t crc32c(uint32_t crc, const void* buf, std::size_t len) {
+    const uint8_t* p = static_cast<const uint8_t*>(buf);
+#if defined(__x86_64__)
+    static const bool has_sse42 = __builtin_cpu_supports("sse4.2");
+    if(has_sse42) {
+        return ~crc32c_hw(~crc, p, len);
+    }
+#endif
+    return ~crc32c_sw(~crc, p, len);
+}
+
+}  // namespace persistent
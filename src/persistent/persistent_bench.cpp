@@ -0,0 +1,346 @@
+/**
+ * @file persistent_bench.cpp
+ *
+ * A microbenchmark for the persistence layer that runs without a Derecho group.
+ * It drives Persistent<T>, PersistentRegistry and FilePersistLog directly, so
+ * the cost of each operation can be measured in isolation:
+ *
+ *   append    Persistent<T>::set() of a new version
+ *   version   PersistentRegistry::makeVersion() after updating the object
+ *   persist   PersistentRegistry::persist() of one new version
+ *   sign      PersistentRegistry::sign() of one new version (needs PERS/private_key_file)
+ *   getbyidx  Persistent<T>::getByIndex() of a random index
+ *   hlc       Persistent<T>::getIndexAtTime() of a random HLC timestamp
+ *   trim      Persistent<T>::trim() of one more version
+ *   truncate  Persistent<T>::truncate() of one more version
+ *
+ * Each operation is timed individually. A summary line per run, with the
+ * throughput and latency percentiles, is written to stdout as CSV; a latency
+ * histogram with power-of-two buckets can be written to a second CSV file.
+ */
+#include <derecho/conf/conf.hpp>
+#include <derecho/openssl/signature.hpp>
+#include <derecho/persistent/Persistent.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if __GNUC__ > 7
+#include <filesystem>
+namespace fs = std::filesystem;
+#else
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#endif
+
+using namespace persistent;
+using std::cout;
+using std::endl;
+
+// the subgroup type used to name the benchmark's PersistentRegistry
+struct BenchSubgroup {};
+
+/**
+ * A byte array that is logged in full on every version.
+ */
+class Blob : public mutils::ByteRepresentable {
+public:
+    std::vector<uint8_t> bytes;
+
+    Blob() = default;
+    Blob(const std::vector<uint8_t>& bytes) : bytes(bytes) {}
+
+    void update(const std::vector<uint8_t>& payload) {
+        bytes = payload;
+    }
+
+    DEFAULT_SERIALIZATION_SUPPORT(Blob, bytes);
+};
+
+/**
+ * A byte array that logs only the bytes written since the last version.
+ * Every update overwrites the whole array, so each delta is as large as an
+ * entry of Blob, but reading a version has to replay the log.
+ */
+class DeltaBlob : public mutils::ByteRepresentable, public IDeltaSupport<DeltaBlob> {
+public:
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> delta;
+
+    DeltaBlob() = default;
+    DeltaBlob(const std::vector<uint8_t>& bytes) : bytes(bytes) {}
+
+    void update(const std::vector<uint8_t>& payload) {
+        bytes = payload;
+        delta = payload;
+    }
+
+    // delta format: [length(uint64_t)][bytes]
+    virtual size_t currentDeltaToBytes(uint8_t* const buf, size_t buf_size) override {
+        if(buf_size < currentDeltaSize()) {
+            return 0;
+        }
+        uint64_t len = delta.size();
+        memcpy(buf, &len, sizeof(len));
+        memcpy(buf + sizeof(len), delta.data(), delta.size());
+        delta.clear();
+        return sizeof(len) + len;
+    }
+
+    virtual size_t currentDeltaSize() override {
+        return delta.empty() ? 0 : sizeof(uint64_t) + delta.size();
+    }
+
+    virtual void applyDelta(uint8_t const* const buf) override {
+        uint64_t len;
+        memcpy(&len, buf, sizeof(len));
+        bytes.assign(buf + sizeof(len), buf + sizeof(len) + len);
+    }
+
+    static std::unique_ptr<DeltaBlob> create(mutils::DeserializationManager*) {
+        return std::make_unique<DeltaBlob>();
+    }
+
+    DEFAULT_SERIALIZATION_SUPPORT(DeltaBlob, bytes);
+};
+
+struct BenchResult {
+    std::string op;
+    std::string storage;
+    std::string type;
+    uint64_t entry_size;
+    std::vector<uint64_t> latencies_ns;
+    uint64_t total_ns = 0;
+};
+
+static void print_csv_header() {
+    cout << "op,storage,type,entry_size,num_ops,total_us,ops_per_sec,MB_per_sec,"
+         << "mean_us,p50_us,p90_us,p99_us,max_us" << endl;
+}
+
+static void print_csv_summary(BenchResult& result) {
+    std::vector<uint64_t>& lat = result.latencies_ns;
+    if(lat.empty()) {
+        return;
+    }
+    std::sort(lat.begin(), lat.end());
+    auto percentile = [&lat](double p) {
+        return lat[std::min(lat.size() - 1, static_cast<size_t>(p * lat.size()))] / 1e3;
+    };
+    double total_s = result.total_ns / 1e9;
+    cout << result.op << "," << result.storage << "," << result.type << ","
+         << result.entry_size << "," << lat.size() << ","
+         << result.total_ns / 1e3 << ","
+         << lat.size() / total_s << ","
+         << (double)lat.size() * result.entry_size / total_s / 1e6 << ","
+         << (double)result.total_ns / lat.size() / 1e3 << ","
+         << percentile(0.5) << "," << percentile(0.9) << "," << percentile(0.99) << ","
+         << lat.back() / 1e3 << endl;
+}
+
+static void write_csv_histogram(std::ofstream& out, const BenchResult& result) {
+    // bucket k counts latencies in [2^k, 2^(k+1)) nanoseconds
+    std::vector<uint64_t> buckets(64, 0);
+    for(uint64_t ns : result.latencies_ns) {
+        buckets[ns == 0 ? 0 : 63 - __builtin_clzll(ns)]++;
+    }
+    for(uint32_t k = 0; k < buckets.size(); k++) {
+        if(buckets[k] > 0) {
+            out << result.op << "," << result.storage << "," << result.type << ","
+                << result.entry_size << "," << (1ull << k) << "," << (2ull << k) << ","
+                << buckets[k] << endl;
+        }
+    }
+}
+
+template <typename Func>
+static void time_op(BenchResult& result, const Func& op) {
+    auto start = std::chrono::steady_clock::now();
+    op();
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    result.latencies_ns.push_back(ns);
+    result.total_ns += ns;
+}
+
+// remove the files left by an earlier run, so every run starts from an empty log
+template <StorageType st>
+static void remove_log_files(const std::string& name) {
+    const std::string dir = (st == ST_MEM) ? getPersRamdiskPath() : getPersFilePath();
+    for(const char* suffix : {META_FILE_SUFFIX, LOG_FILE_SUFFIX, DATA_FILE_SUFFIX}) {
+        fs::remove(dir + "/" + name + "." + suffix);
+    }
+}
+
+template <typename ObjectType, StorageType st>
+static BenchResult run_bench(const std::string& op, const std::string& type,
+                             uint64_t entry_size, int nops, openssl::Signer* signer) {
+    BenchResult result{op, (st == ST_FILE) ? "file" : "mem", type, entry_size};
+    result.latencies_ns.reserve(nops);
+    const std::string name = "bench_" + op + "_" + type;
+    remove_log_files<st>(name);
+
+    PersistentRegistry pr(nullptr, typeid(BenchSubgroup), 0, 0);
+    Persistent<ObjectType, st> pvar([]() { return std::make_unique<ObjectType>(); },
+                                    name.c_str(), &pr, signer != nullptr);
+    std::size_t sig_size = (signer != nullptr) ? signer->get_max_signature_size() : 0;
+    pr.initializeLastSignature(INVALID_VERSION, nullptr, sig_size);
+    std::vector<uint8_t> sig_buf(sig_size);
+
+    std::vector<uint8_t> payload(entry_size);
+    std::mt19937_64 rng(entry_size);
+    auto next_payload = [&payload, &rng]() {
+        // change the first word so consecutive versions differ
+        uint64_t word = rng();
+        memcpy(payload.data(), &word, std::min(sizeof(word), payload.size()));
+        return payload;
+    };
+    // version i gets HLC (i+1,0), so HLC lookups have a known answer
+    auto new_version = [&](version_t ver) {
+        pvar->update(next_payload());
+        pr.makeVersion(ver, HLC(ver + 1, 0));
+    };
+    auto populate = [&]() {
+        for(version_t ver = 0; ver < nops; ver++) {
+            new_version(ver);
+        }
+        pr.persist(nops - 1);
+    };
+
+    if(op == "append") {
+        ObjectType obj;
+        for(version_t ver = 0; ver < nops; ver++) {
+            obj.update(next_payload());
+            time_op(result, [&]() { pvar.set(obj, ver, HLC(ver + 1, 0)); });
+        }
+    } else if(op == "version") {
+        for(version_t ver = 0; ver < nops; ver++) {
+            pvar->update(next_payload());
+            time_op(result, [&]() { pr.makeVersion(ver, HLC(ver + 1, 0)); });
+        }
+    } else if(op == "persist") {
+        for(version_t ver = 0; ver < nops; ver++) {
+            new_version(ver);
+            time_op(result, [&]() { pr.persist(ver); });
+        }
+    } else if(op == "sign") {
+        for(version_t ver = 0; ver < nops; ver++) {
+            new_version(ver);
+            time_op(result, [&]() { pr.sign(*signer, sig_buf.data()); });
+        }
+    } else if(op == "getbyidx") {
+        populate();
+        std::uniform_int_distribution<int64_t> pick(pvar.getEarliestIndex(), pvar.getLatestIndex());
+        for(int i = 0; i < nops; i++) {
+            int64_t idx = pick(rng);
+            time_op(result, [&]() { pvar.getByIndex(idx); });
+        }
+    } else if(op == "hlc") {
+        populate();
+        std::uniform_int_distribution<uint64_t> pick(1, nops);
+        for(int i = 0; i < nops; i++) {
+            HLC hlc(pick(rng), 0);
+            time_op(result, [&]() { pvar.getIndexAtTime(hlc); });
+        }
+    } else if(op == "trim") {
+        populate();
+        for(version_t ver = 0; ver < nops - 1; ver++) {
+            time_op(result, [&]() { pvar.trim(ver); });
+        }
+    } else if(op == "truncate") {
+        populate();
+        for(version_t ver = nops - 2; ver >= 0; ver--) {
+            time_op(result, [&]() { pvar.truncate(ver); });
+        }
+    } else {
+        std::cerr << "unknown operation: " << op << endl;
+    }
+    return result;
+}
+
+template <StorageType st>
+static BenchResult run_bench_for_type(const std::string& op, const std::string& type,
+                                      uint64_t entry_size, int nops, openssl::Signer* signer) {
+    if(type == "delta") {
+        return run_bench<DeltaBlob, st>(op, type, entry_size, nops, signer);
+    }
+    return run_bench<Blob, st>(op, type, entry_size, nops, signer);
+}
+
+static void printhelp(const char* prog) {
+    cout << "usage: " << prog << " [derecho-config-list --] <op> <file|mem> <delta|nodelta> <entry_size> <num_ops> [histogram_csv]" << endl;
+    cout << "\top: all|append|version|persist|sign|getbyidx|hlc|trim|truncate" << endl;
+    cout << "\tsign runs only if PERS/private_key_file exists; \"all\" skips it otherwise." << endl;
+    cout << "\tThe summary CSV goes to stdout; debug builds also log there unless LOGGER/log_to_terminal is false." << endl;
+}
+
+int main(int argc, char** argv) {
+    int dashdash_pos = argc - 1;
+    while(dashdash_pos > 0) {
+        if(strcmp(argv[dashdash_pos], "--") == 0) {
+            break;
+        }
+        dashdash_pos--;
+    }
+    if((argc - dashdash_pos) < 6) {
+        printhelp(argv[0]);
+        return -1;
+    }
+    derecho::Conf::initialize(argc, argv);
+
+    const std::string op = argv[dashdash_pos + 1];
+    const std::string storage = argv[dashdash_pos + 2];
+    const std::string type = argv[dashdash_pos + 3];
+    const uint64_t entry_size = std::stoull(argv[dashdash_pos + 4]);
+    const int nops = std::stoi(argv[dashdash_pos + 5]);
+    std::ofstream histogram;
+    if(dashdash_pos + 6 < argc) {
+        histogram.open(argv[dashdash_pos + 6]);
+        histogram << "op,storage,type,entry_size,bucket_lower_ns,bucket_upper_ns,count" << endl;
+    }
+    if((storage != "file" && storage != "mem") || (type != "delta" && type != "nodelta") || nops < 2) {
+        printhelp(argv[0]);
+        return -1;
+    }
+
+    std::unique_ptr<openssl::EnvelopeKey> prikey;
+    std::unique_ptr<openssl::Signer> signer;
+    if(checkRegularFile(derecho::getConfString(derecho::Conf::PERS_PRIVATE_KEY_FILE))) {
+        prikey = std::make_unique<openssl::EnvelopeKey>(
+                openssl::EnvelopeKey::from_pem_private(derecho::getConfString(derecho::Conf::PERS_PRIVATE_KEY_FILE)));
+        signer = std::make_unique<openssl::Signer>(*prikey, openssl::DigestAlgorithm::SHA256);
+    }
+
+    std::vector<std::string> ops;
+    if(op == "all") {
+        ops = {"append", "version", "persist", "getbyidx", "hlc", "trim", "truncate"};
+        if(signer) {
+            ops.push_back("sign");
+        }
+    } else if(op == "sign" && !signer) {
+        std::cerr << "sign requires the private key file " << derecho::getConfString(derecho::Conf::PERS_PRIVATE_KEY_FILE) << endl;
+        return -1;
+    } else {
+        ops = {op};
+    }
+
+    print_csv_header();
+    for(const auto& this_op : ops) {
+        // only the sign benchmark writes signatures, so the others measure unsigned logs
+        openssl::Signer* op_signer = (this_op == "sign") ? signer.get() : nullptr;
+        BenchResult result = (storage == "file")
+                                     ? run_bench_for_type<ST_FILE>(this_op, type, entry_size, nops, op_signer)
+                                     : run_bench_for_type<ST_MEM>(this_op, type, entry_size, nops, op_signer);
+        print_csv_summary(result);
+        if(histogram.is_open()) {
+            write_csv_histogram(histogram, result);
+        }
+    }
+    return 0;
+}
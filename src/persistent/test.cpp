@@ -12,6 +12,7 @@
 #include <sys/mman.h>
 #include <time.h>
 #include <iomanip>
+#include <vector>
 /**
  * @cond DoxygenSuppressed
  */
@@ -164,6 +165,7 @@ printhelp() {
     cout << "\tdelta-getbyidx <index>" << endl;
     cout << "\tdelta-getbyver <version>" << endl;
     cout << "\tdelta-verify <version> <desired-value>" << endl;
+    cout << "\ttransfer-trimmed" << endl;
     cout << "NOTICE: test can crash if <datasize> is too large(>8MB).\n"
          << "This is probably due to the stack size is limited. Try \n"
          << "  \"ulimit -s unlimited\"\n"
@@ -216,6 +218,49 @@ static void nologload() {
 }
 
 static void test_hlc();
+
+/**
+ * Simulates state transfer of a delta object to a node whose copy of the log
+ * was trimmed. The sender's log lives in the file store and the receiver's in
+ * the memory store, so both can use the same log name in one process.
+ * @return true if the receiver ends up with the sender's object
+ */
+static bool transfer_trimmed() {
+    const char* log_name = "TrimmedTransferDelta";
+    auto factory = []() { return std::make_unique<IntegerWithDelta>(); };
+    Persistent<IntegerWithDelta> sender(factory, log_name, nullptr, false);
+    // Start from empty logs, in case the test ran before
+    sender.truncate(INVALID_VERSION);
+    (*sender).value = 0;
+    for(int ver = 1; ver <= 10; ver++) {
+        (*sender).add(ver);
+        sender.version(ver);
+    }
+    sender.persist();
+    sender.trim(5);
+    version_t receiver_version;
+    {
+        Persistent<IntegerWithDelta, ST_MEM> receiver(factory, log_name, nullptr, false);
+        receiver.truncate(INVALID_VERSION);
+        (*receiver).value = 0;
+        for(int ver = 1; ver <= 7; ver++) {
+            (*receiver).add(ver);
+            receiver.version(ver);
+        }
+        receiver.persist();
+        // Entries 1-3 are gone, so replaying this log alone can't rebuild the object
+        receiver.trim(3);
+        receiver_version = receiver.getLatestVersion();
+    }
+    PersistentRegistry::setEarliestVersionToSerialize(receiver_version);
+    std::vector<uint8_t> buffer(sender.bytes_size());
+    sender.to_bytes(buffer.data());
+    PersistentRegistry::resetEarliestVersionToSerialize();
+    auto received = mutils::from_bytes<Persistent<IntegerWithDelta, ST_MEM>>(nullptr, buffer.data());
+    cout << "sender value = " << (*sender).value << ", received value = " << (**received).value
+         << ", received log ends at version " << received->getLatestVersion() << endl;
+    return (**received).value == (*sender).value && received->getLatestVersion() == sender.getLatestVersion();
+}
 template <StorageType st = ST_FILE>
 static void eval_write(std::size_t osize, int nops, bool batch) {
     VariableBytes writeMe;
@@ -321,6 +366,11 @@ int main(int argc, char** argv) {
                 });
             // by copy
             cout << "[" << ver << "]\t" << npx.get(ver)->to_string() << "\t//by copy" << endl;
+            // by view
+            {
+                auto view = npx.getView(ver);
+                cout << "[" << ver << "]\t" << view->to_string() << "\t//by view" << endl;
+            }
         } else if(strcmp(argv[1], "getbytime") == 0) {
             HLC hlc;
             hlc.m_rtc_us = atol(argv[2]);
@@ -416,13 +466,20 @@ int main(int argc, char** argv) {
             }
             PersistentRegistry::setEarliestVersionToSerialize(ver);
             ssize_t ds1 = npx_logtail.bytes_size();
-            ssize_t prefix = mutils::bytes_size(npx_logtail.getObjectName()) + mutils::bytes_size(*npx_logtail);
             uint8_t* buf = (uint8_t*)malloc(ds1);
             if(buf == NULL) {
-                cerr << "faile to allocate " << ds1 << " bytes for serialized data. prefix=" << prefix << " bytes" << endl;
+                cerr << "faile to allocate " << ds1 << " bytes for serialized data." << endl;
                 return -1;
             }
             ssize_t ds2 = npx_logtail.to_bytes(buf);
+            // skip the name, the wrapped object (if it was included), and the signature flag
+            ssize_t prefix = mutils::bytes_size(npx_logtail.getObjectName());
+            bool has_wrapped_object = *reinterpret_cast<bool*>(buf + prefix);
+            prefix += sizeof(bool);
+            if(has_wrapped_object) {
+                prefix += mutils::bytes_size(*npx_logtail);
+            }
+            prefix += sizeof(bool);
             cout << "serialization requested " << (ds1 - prefix) << " bytes, used " << (ds2 - prefix) << " bytes" << endl;
             int fd = open(LOGTAIL_FILE, O_CREAT | O_WRONLY, S_IWUSR | S_IRUSR);
             if(fd == -1) {
@@ -566,6 +623,10 @@ int main(int argc, char** argv) {
             cout << "dx[ver:" << version << "] = " << dx[version]->value << endl;
             cout << "dx.delta[ver:" << version << "] = " << *dx.template getDelta<int>(version,true) << "\t- by copy" << endl;
             dx.template getDelta<int>(version, true, [version](const int& x){ cout << "dx.delta[ver:" << version << "] = " << x << "\t- by lambda" << std::endl;});
+            cout << "dx.delta[ver:" << version << "] = " << *dx.template getDeltaView<int>(version, true) << "\t- by view" << endl;
+            int folded_value = 0;
+            dx.template visitDeltas<int>(version, [&folded_value](const int& x) { folded_value += x; });
+            cout << "dx[ver:" << version << "] = " << folded_value << "\t- by visitor" << endl;
         } else if(strcmp(argv[1], "delta-verify") == 0) {
             if (!use_signature) {
                 std::cout << "unable to verify without signature...exit." << std::endl;
@@ -597,6 +658,13 @@ int main(int argc, char** argv) {
                 }
             }
 
+        } else if(strcmp(argv[1], "transfer-trimmed") == 0) {
+            if(transfer_trimmed()) {
+                cout << "transfer-trimmed: receiver rebuilt the sender's object" << endl;
+            } else {
+                cout << "transfer-trimmed: receiver's object differs from the sender's" << endl;
+                return -1;
+            }
         } else {
             cout << "unknown command: " << argv[1] << endl;
             printhelp();
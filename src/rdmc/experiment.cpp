@@ -82,7 +82,7 @@ send_stats measure_partially_concurrent_multicast(
         }
         CHECK(rdmc::create_group(
                 base_group_number + i, members, block_size, type,
-                [&mr, i, buffer_size](size_t length) -> rdmc::receive_destination {
+                [&mr, i, buffer_size](size_t length, const uint8_t *prefix) -> rdmc::receive_destination {
                     return {mr, buffer_size * i};
                 },
                 [&](uint8_t *data, size_t) {
@@ -222,6 +222,35 @@ void blocksize_v_bandwidth(uint16_t gsize) {
     puts("");
     fflush(stdout);
 }
+void message_size_v_bandwidth(uint16_t gsize) {
+    // The largest block size a message may use. With
+    // DERECHO/rdmc_adaptive_block_size enabled, each message picks its own
+    // block size no larger than this, so running this experiment with the
+    // option on and off shows what adapting the block size gains.
+    const size_t block_size = 1ull << 20;
+
+    puts("=========================================================");
+    puts("=            Message Size vs. Bandwdith (Gb/s)          =");
+    puts("=========================================================");
+    printf("Group Size = %d, Max Block Size = %d KB\n", (int)gsize, (int)(block_size >> 10));
+    puts("Send Size, Binomial Send, Chain Send, Binomial Send stddev, Chain Send stddev");
+    fflush(stdout);
+    for(size_t size = 64ull << 10; size <= 512ull << 20; size *= 4) {
+        if(size >= 1 << 20)
+            printf("%d MB, ", (int)(size >> 20));
+        else
+            printf("%d KB, ", (int)(size >> 10));
+
+        size_t iterations = max<size_t>((1ull << 30) / size, 8);
+        auto bs = measure_multicast(size, block_size, gsize, iterations, rdmc::BINOMIAL_SEND);
+        auto cs = measure_multicast(size, block_size, gsize, iterations, rdmc::CHAIN_SEND);
+        printf("%f, %f, %f, %f\n", bs.bandwidth.mean, cs.bandwidth.mean,
+               bs.bandwidth.stddev, cs.bandwidth.stddev);
+        fflush(stdout);
+    }
+    puts("");
+    fflush(stdout);
+}
 void compare_send_types() {
     puts("=========================================================");
     puts("=         Compare Send Types - Bandwidth (Gb/s)         =");
@@ -552,7 +581,7 @@ void test_create_group_failure() {
     uint64_t t = get_time();
     bool ret = rdmc::create_group(
             0, members, 1 << 20, rdmc::BINOMIAL_SEND,
-            [&](size_t length) -> rdmc::receive_destination {
+            [&](size_t length, const uint8_t *prefix) -> rdmc::receive_destination {
                 puts("FAILURE: incoming message called");
                 return {nullptr, 0};
             },
@@ -726,6 +755,8 @@ int main(int argc, char *argv[]) {
         blocksize_v_bandwidth(4);
     } else if(strcmp(argv[1], "blocksize16") == 0) {
         blocksize_v_bandwidth(16);
+    } else if(strcmp(argv[1], "messagesize") == 0) {
+        message_size_v_bandwidth(num_nodes);
     } else if(strcmp(argv[1], "sendtypes") == 0) {
         compare_send_types();
     } else if(strcmp(argv[1], "bandwidth") == 0) {
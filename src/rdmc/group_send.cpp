@@ -1,6 +1,7 @@
 #include <derecho/rdmc/group_send.hpp>
 #include <derecho/rdmc/detail/message.hpp>
 #include <derecho/rdmc/detail/util.hpp>
+#include <derecho/conf/conf.hpp>
 
 #ifdef USE_VERBS_API
 #include <derecho/rdmc/detail/verbs_helper.hpp>
@@ -8,8 +9,10 @@
 #include <derecho/rdmc/detail/lf_helper.hpp>
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <limits>
 
 using namespace std;
 using namespace rdma;
@@ -20,29 +23,49 @@ extern map<uint16_t, shared_ptr<group>> groups;
 extern mutex groups_lock;
 };  // namespace rdmc
 
-decltype(polling_group::message_types) polling_group::message_types;
+decltype(group::message_types) group::message_types;
+
+// Builds the header of a message that this node sends from message_mr
+static message_header make_message_header(const memory_region& message_mr, size_t offset, size_t length,
+                                          uint8_t block_size_shift, uint32_t message_number) {
+    message_header header{length, block_size_shift, message_number, {}};
+    memcpy(header.prefix, message_mr.buffer + offset, min(length, MESSAGE_PREFIX_SIZE));
+    return header;
+}
 
 group::group(uint16_t _group_number, size_t _block_size,
-             vector<uint32_t> _members, uint32_t _member_index,
-             incoming_message_callback_t upcall,
-             completion_callback_t callback,
-             unique_ptr<schedule> _schedule)
+             vector<uint32_t> _members, uint32_t _member_index)
         : members(_members),
           group_number(_group_number),
           block_size(_block_size),
           num_members(members.size()),
           member_index(_member_index),
-          transfer_schedule(std::move(_schedule)),
-          completion_callback(callback),
-          incoming_message_upcall(upcall) {}
+          max_in_flight(std::max<uint32_t>(1, derecho::getConfUInt32(derecho::Conf::DERECHO_RDMC_MAX_IN_FLIGHT_MESSAGES))),
+          adaptive_block_size(derecho::getConfBoolean(derecho::Conf::DERECHO_RDMC_ADAPTIVE_BLOCK_SIZE)),
+          min_block_size(derecho::getConfUInt64(derecho::Conf::DERECHO_RDMC_MIN_BLOCK_SIZE)),
+          block_overhead_us(derecho::getConfDouble(derecho::Conf::DERECHO_RDMC_BLOCK_OVERHEAD_US)),
+          // 1 Gb/s is 125 bytes per microsecond
+          link_bytes_per_us(derecho::getConfDouble(derecho::Conf::DERECHO_RDMC_LINK_BANDWIDTH_GBPS) * 125) {}
 group::~group() { unique_lock<mutex> lock(monitor); }
 
-void polling_group::initialize_message_types() {
+void group::initialize_message_types() {
     auto find_group = [](uint16_t group_number) {
         unique_lock<mutex> lock(groups_lock);
         auto it = groups.find(group_number);
         return it != groups.end() ? it->second : nullptr;
     };
+    auto send_header = [find_group](uint64_t tag, uint32_t immediate,
+                                    size_t length) {
+        ParsedTag parsed_tag = parse_tag(tag);
+        shared_ptr<group> g = find_group(parsed_tag.group_number);
+        if(g) g->complete_header_send(parsed_tag.target);
+    };
+    auto receive_header = [find_group](uint64_t tag, uint32_t immediate,
+                                       size_t length) {
+        ParsedTag parsed_tag = parse_tag(tag);
+        shared_ptr<group> g = find_group(parsed_tag.group_number);
+        if(g) g->receive_header(parsed_tag.target);
+    };
     auto send_data_block = [find_group](uint64_t tag, uint32_t immediate,
                                         size_t length) {
         ParsedTag parsed_tag = parse_tag(tag);
@@ -53,7 +76,7 @@ void polling_group::initialize_message_types() {
                                            size_t length) {
         ParsedTag parsed_tag = parse_tag(tag);
         shared_ptr<group> g = find_group(parsed_tag.group_number);
-        if(g) g->receive_block(immediate, length);
+        if(g) g->receive_block(parsed_tag.target, immediate, length);
     };
     auto send_ready_for_block = [](uint64_t, uint32_t, size_t) {};
     auto receive_ready_for_block = [find_group](
@@ -63,23 +86,52 @@ void polling_group::initialize_message_types() {
         if(g) g->receive_ready_for_block(immediate, parsed_tag.target);
     };
 
+    message_types.header = message_type("rdmc.header", send_header, receive_header);
     message_types.data_block = message_type("rdmc.data_block", send_data_block, receive_data_block);
     message_types.ready_for_block = message_type(
             "rdmc.ready_for_block", send_ready_for_block, receive_ready_for_block);
 }
+uint8_t group::choose_block_size_shift(const schedule& transfer_schedule, size_t length) const {
+    if(!adaptive_block_size) {
+        return 0;
+    }
+    // Estimate the time to send the message with each candidate block size as
+    // the number of steps the schedule takes times the time to send one block,
+    // and keep the fastest. Candidates must divide the group's block size so
+    // that receive buffers sized for the group's block size stay large enough.
+    uint8_t best_shift = 0;
+    double best_time = std::numeric_limits<double>::max();
+    for(uint8_t shift = 0; shift <= MAX_BLOCK_SIZE_SHIFT; ++shift) {
+        size_t candidate_size = block_size >> shift;
+        if(candidate_size < min_block_size || (candidate_size << shift) != block_size) {
+            break;
+        }
+        size_t candidate_blocks = (length - 1) / candidate_size + 1;
+        if(candidate_blocks > std::numeric_limits<uint16_t>::max()) {
+            break;
+        }
+        double time = transfer_schedule.get_total_steps(candidate_blocks)
+                      * (block_overhead_us + min(candidate_size, length) / link_bytes_per_us);
+        if(time < best_time) {
+            best_time = time;
+            best_shift = shift;
+        }
+    }
+    return best_shift;
+}
 polling_group::polling_group(uint16_t _group_number, size_t _block_size,
                              vector<uint32_t> _members, uint32_t _member_index,
                              incoming_message_callback_t upcall,
                              completion_callback_t callback,
                              unique_ptr<schedule> _schedule)
-        : group(_group_number, _block_size, _members, _member_index, upcall,
-                callback, std::move(_schedule)),
-          first_block_buffer(nullptr) {
-    if(member_index != 0) {
-        first_block_buffer = unique_ptr<uint8_t[]>(new uint8_t[block_size]);
-        memset(first_block_buffer.get(), 0, block_size);
-        first_block_mr = make_unique<memory_region>(first_block_buffer.get(), block_size);
-    }
+        : group(_group_number, _block_size, _members, _member_index),
+          transfer_schedule(std::move(_schedule)),
+          completion_callback(callback),
+          incoming_message_upcall(upcall),
+          outgoing_headers(max_in_flight) {
+    incoming_header_mr = make_unique<memory_region>((uint8_t*)&incoming_header, sizeof(incoming_header));
+    outgoing_headers_mr = make_unique<memory_region>((uint8_t*)outgoing_headers.data(),
+                                                     outgoing_headers.size() * sizeof(message_header));
 
     auto connections = transfer_schedule->get_connections();
     for(auto c : connections) {
@@ -87,155 +139,115 @@ polling_group::polling_group(uint16_t _group_number, size_t _block_size,
     }
 
     if(member_index > 0) {
-        auto transfer = transfer_schedule->get_first_block(num_blocks);
-        first_block_number = transfer->block_number;
-        post_recv(*transfer);
-        incoming_block = transfer->block_number;
-        send_ready_for_block(transfer->target);
-        // puts("Issued Ready For Block CCCCCCCCC");
+        request_header();
     }
 }
-void polling_group::receive_block(uint32_t send_imm, size_t received_block_size) {
+polling_group::message_state& polling_group::get_message(size_t message_number) {
+    assert(!messages.empty() && message_number >= messages.front().message_number);
+    return messages[message_number - messages.front().message_number];
+}
+void polling_group::receive_header(uint32_t sender) {
     unique_lock<mutex> lock(monitor);
 
     assert(member_index > 0);
+    assert(header_requested);
+    header_requested = false;
+
+    message_state& message = messages.emplace_back();
+    message.message_number = next_message_number++;
+    assert(incoming_header.message_number == (uint32_t)message.message_number);
+    message.message_size = incoming_header.message_size;
+    message.block_size_shift = incoming_header.block_size_shift;
+    message.message_block_size = block_size >> message.block_size_shift;
+    message.num_blocks = (message.message_size - 1) / message.message_block_size + 1;
+    auto first_transfer = transfer_schedule->get_first_block(message.num_blocks);
+    message.first_block_number = min(first_transfer->block_number, message.num_blocks - 1);
+
+    auto destination = incoming_message_upcall(message.message_size, incoming_header.prefix);
+    message.mr_offset = destination.offset;
+    message.mr = destination.mr;
+
+    assert(message.mr->size >= message.mr_offset + message.message_size);
+
+    message.received_blocks = vector<bool>(message.num_blocks);
+
+    LOG_EVENT(group_number, message.message_number, message.first_block_number,
+              "received_header");
+
+    // The first block can now be received directly into the destination
+    post_recv(message, schedule::block_transfer{first_transfer->target, message.first_block_number});
+    message.incoming_block = message.first_block_number;
+    send_ready_for_block(first_transfer->target);
+
+    // Pass the header on to any receivers that get their first block from us
+    outgoing_headers[message.message_number % max_in_flight] = incoming_header;
+    send_headers();
+}
+void polling_group::receive_block(uint32_t sender, uint32_t send_imm, size_t received_block_size) {
+    unique_lock<mutex> lock(monitor);
 
-    if(receive_step == 0) {
-        num_blocks = parse_immediate(send_imm).total_blocks;
-        first_block_number = min(transfer_schedule->get_first_block(num_blocks)->block_number,
-                                 num_blocks - 1);
-        message_size = num_blocks * block_size;
-        if(num_blocks == 1) {
-            message_size = received_block_size;
-        }
-
-        assert(*first_block_number == parse_immediate(send_imm).block_number);
-
-        //////////////////////////////////////////////////////
-        auto destination = incoming_message_upcall(message_size);
-        mr_offset = destination.offset;
-        mr = destination.mr;
-
-        assert(mr->size >= mr_offset + message_size);
-        //////////////////////////////////////////////////////
-
-        num_received_blocks = 1;
-        received_blocks = vector<bool>(num_blocks);
-        received_blocks[*first_block_number] = true;
-
-        LOG_EVENT(group_number, message_number, *first_block_number,
-                  "initialized_internal_datastructures");
+    assert(member_index > 0);
 
-        assert(receive_step == 0);
-        auto transfer = transfer_schedule->get_incoming_transfer(num_blocks,
-                                                                 receive_step);
-        while((!transfer || transfer->block_number == *first_block_number) && receive_step < transfer_schedule->get_total_steps(num_blocks)) {
-            transfer = transfer_schedule->get_incoming_transfer(num_blocks, ++receive_step);
+    // Blocks can only arrive for the newest message, since we do not ask
+    // for the next header until all of its blocks have been received.
+    message_state& message = messages.back();
+    const size_t total_steps = transfer_schedule->get_total_steps(message.num_blocks);
+    size_t block_number = message.incoming_block;
+    if(block_number != parse_immediate(send_imm).block_number) {
+        printf("Expected block #%d but got #%d on step %d\n",
+               (int)block_number,
+               (int)parse_immediate(send_imm).block_number,
+               (int)message.receive_step);
+        fflush(stdout);
+    }
+    assert(message.num_blocks == parse_immediate(send_imm).total_blocks);
+    assert(block_number == parse_immediate(send_imm).block_number);
+    assert(received_block_size == min(message.message_block_size,
+                                      message.message_size - block_number * message.message_block_size));
+
+    message.received_blocks[block_number] = true;
+    LOG_EVENT(group_number, message.message_number, block_number, "received_block");
+
+    // Figure out the next block to receive. The first block may have been
+    // moved out of its place in the schedule, so skip it.
+    std::optional<schedule::block_transfer> transfer;
+    if(message.num_received_blocks++ == 0) {
+        transfer = transfer_schedule->get_incoming_transfer(message.num_blocks, message.receive_step);
+        while((!transfer || transfer->block_number == message.first_block_number) && message.receive_step < total_steps) {
+            transfer = transfer_schedule->get_incoming_transfer(message.num_blocks, ++message.receive_step);
         }
-
-        // cout << "receive_step = " << receive_step
-        //      << " transfer->block_number = "
-        //      << transfer->block_number
-        //      << " first_block_number = " << *first_block_number
-        //      << " total_steps = " << get_total_steps() << endl;
-
-        LOG_EVENT(group_number, message_number, *first_block_number,
-                  "found_next_transfer");
-
+        // The receive for the next block was not posted ahead of time
         if(transfer) {
-            LOG_EVENT(group_number, message_number, transfer->block_number,
-                      "posting_recv");
-            // printf("Posting recv #%d (receive_step = %d,
-            // *first_block_number =
-            // %d, total_steps = %d)\n",
-            //        (int)transfer->block_number, (int)receive_step,
-            // (int)*first_block_number, (int)get_total_steps());
-            post_recv(*transfer);
-            incoming_block = transfer->block_number;
-            send_ready_for_block(transfer->target);
-            // cout << "Issued Ready For Block AAAAAAAA (receive_step = "
-            //      << receive_step << ", target = " << transfer->target << ")"
-            //      << endl;
-
-            for(auto r = receive_step + 1; r < transfer_schedule->get_total_steps(num_blocks); r++) {
-                auto t = transfer_schedule->get_incoming_transfer(num_blocks, r);
-                if(t) {
-                    // cout << "posting block for step " << (int)r
-                    //      << " (block #" << (*t).block_number << ")" << endl;
-                    post_recv(*t);
-                    break;
-                }
-            }
-        }
-
-        LOG_EVENT(group_number, message_number, *first_block_number,
-                  "calling_send_next_block");
-
-        send_next_block();
-
-        LOG_EVENT(group_number, message_number, *first_block_number,
-                  "returned_from_send_next_block");
-
-        if(!sending && num_received_blocks == num_blocks && send_step == transfer_schedule->get_total_steps(num_blocks)) {
-            complete_message();
+            post_recv(message, *transfer);
         }
     } else {
-        //        assert(tag.index() <= tag.message_size());
-        size_t block_number = incoming_block;
-        if(block_number != parse_immediate(send_imm).block_number) {
-            printf("Expected block #%d but got #%d on step %d\n",
-                   (int)block_number,
-                   (int)parse_immediate(send_imm).block_number,
-                   (int)receive_step);
-            fflush(stdout);
-        }
-        assert(block_number == parse_immediate(send_imm).block_number);
-
-        if(block_number == num_blocks - 1) {
-            message_size = (num_blocks - 1) * block_size + received_block_size;
-        } else {
-            assert(received_block_size == block_size);
-        }
-
-        received_blocks[block_number] = true;
-
-        LOG_EVENT(group_number, message_number, block_number, "received_block");
-
-        // Figure out the next block to receive.
-        std::optional<schedule::block_transfer> transfer;
-        while(!transfer && receive_step + 1 < transfer_schedule->get_total_steps(num_blocks)) {
-            transfer = transfer_schedule->get_incoming_transfer(num_blocks, ++receive_step);
+        while(!transfer && message.receive_step + 1 < total_steps) {
+            transfer = transfer_schedule->get_incoming_transfer(message.num_blocks, ++message.receive_step);
         }
+    }
 
-        // Post a receive for it.
-        if(transfer) {
-            incoming_block = transfer->block_number;
-            send_ready_for_block(transfer->target);
-            // cout << "Issued Ready For Block BBBBBBBB (receive_step = "
-            //      << receive_step << ", target = " << transfer->target
-            //      << ", total_steps = " << get_total_steps() << ")" << endl;
-            for(auto r = receive_step + 1; r < transfer_schedule->get_total_steps(num_blocks); r++) {
-                auto t = transfer_schedule->get_incoming_transfer(num_blocks, r);
-                if(t) {
-                    post_recv(*t);
-                    break;
-                }
+    if(transfer) {
+        message.incoming_block = transfer->block_number;
+        send_ready_for_block(transfer->target);
+        // Post a receive for the block after it ahead of time
+        for(auto r = message.receive_step + 1; r < total_steps; r++) {
+            auto t = transfer_schedule->get_incoming_transfer(message.num_blocks, r);
+            if(t) {
+                post_recv(message, *t);
+                break;
             }
         }
+    }
 
-        // If we just finished receiving a block and we weren't
-        // previously sending, then try to send now.
-        if(!sending) {
-            send_next_block();
-        }
-        // If we just received the last block and aren't still sending then
-        // issue a completion callback
-        if(++num_received_blocks == num_blocks && !sending && send_step == transfer_schedule->get_total_steps(num_blocks)) {
-            complete_message();
-        }
+    // If we just finished receiving a block and we weren't
+    // previously sending, then try to send now.
+    if(!sending) {
+        send_next_block();
     }
+    complete_messages();
+    call_completion_callbacks(lock);
 }
-void polling_group::receive_ready_for_block(uint32_t step, uint32_t sender) {
+void polling_group::receive_ready_for_block(uint32_t immediate, uint32_t sender) {
     unique_lock<mutex> lock(monitor);
 
 #ifdef USE_VERBS_API
@@ -248,26 +260,33 @@ void polling_group::receive_ready_for_block(uint32_t step, uint32_t sender) {
     it->second.post_empty_recv(form_tag(group_number, sender),
                                message_types.ready_for_block);
 
+    if(immediate == READY_FOR_HEADER) {
+        receivers_awaiting_header.insert(sender);
+        send_headers();
+        return;
+    }
+
     receivers_ready.insert(sender);
 
-    if(!sending && mr) {
+    if(!sending) {
         send_next_block();
     }
+    complete_messages();
+    call_completion_callbacks(lock);
+}
+void polling_group::complete_header_send(uint32_t target) {
+    // Header slots are only reused once the message has completed, so there
+    // is nothing to do
 }
 void polling_group::complete_block_send() {
     unique_lock<mutex> lock(monitor);
 
-    LOG_EVENT(group_number, message_number, outgoing_block,
+    LOG_EVENT(group_number, sending_message_number, outgoing_block,
               "finished_sending_block");
 
     send_next_block();
-
-    // If we just send the last block, and were already done
-    // receiving, then signal completion and prepare for the next
-    // message.
-    if(!sending && send_step == transfer_schedule->get_total_steps(num_blocks) && (member_index == 0 || num_received_blocks == num_blocks)) {
-        complete_message();
-    }
+    complete_messages();
+    call_completion_callbacks(lock);
 }
 void polling_group::send_message(shared_ptr<memory_region> message_mr, size_t offset,
                                  size_t length) {
@@ -279,134 +298,153 @@ void polling_group::send_message(shared_ptr<memory_region> message_mr, size_t of
     if(offset + length > message_mr->size) throw rdmc::invalid_args();
     if(member_index > 0) throw rdmc::nonroot_sender();
 
-    // Queueing sends is not supported
-    if(receive_step > 0) throw rdmc::group_busy();
-    if(send_step > 0) throw rdmc::group_busy();
+    // At most max_in_flight sends can be queued
+    if(messages.size() >= max_in_flight) throw rdmc::group_busy();
 
-    mr = message_mr;
-    mr_offset = offset;
-    message_size = length;
-    num_blocks = (message_size - 1) / block_size + 1;
+    uint8_t block_size_shift = choose_block_size_shift(*transfer_schedule, length);
+    size_t num_blocks = (length - 1) / (block_size >> block_size_shift) + 1;
     if(num_blocks > std::numeric_limits<uint16_t>::max())
         throw rdmc::invalid_args();
-    // printf("message_size = %lu, block_size = %lu, num_blocks = %lu\n",
-    //        message_size, block_size, num_blocks);
-    LOG_EVENT(group_number, message_number, -1, "send_message");
 
-    send_next_block();
+    message_state& message = messages.emplace_back();
+    message.message_number = next_message_number++;
+    message.mr = message_mr;
+    message.mr_offset = offset;
+    message.message_size = length;
+    message.block_size_shift = block_size_shift;
+    message.message_block_size = block_size >> block_size_shift;
+    message.num_blocks = num_blocks;
+    LOG_EVENT(group_number, message.message_number, -1, "send_message");
+
+    outgoing_headers[message.message_number % max_in_flight]
+            = make_message_header(*message_mr, offset, length, block_size_shift, (uint32_t)message.message_number);
+    send_headers();
+    if(!sending) {
+        send_next_block();
+    }
     // No need to worry about completion here. We must send at least
     // one block, so we can't be done already.
 }
 void polling_group::send_next_block() {
     sending = false;
-    if(send_step == transfer_schedule->get_total_steps(num_blocks)) {
-        return;
-    }
-    auto transfer = transfer_schedule->get_outgoing_transfer(num_blocks, send_step);
-    while(!transfer) {
-        if(++send_step == transfer_schedule->get_total_steps(num_blocks)) return;
+    // Send the blocks of each message in order. A message is finished as
+    // soon as its last step has passed, so move on to the next one.
+    while(sending_message_number < next_message_number) {
+        message_state& message = get_message(sending_message_number);
+        const size_t total_steps = transfer_schedule->get_total_steps(message.num_blocks);
+        std::optional<schedule::block_transfer> transfer;
+        while(message.send_step < total_steps
+              && !(transfer = transfer_schedule->get_outgoing_transfer(message.num_blocks, message.send_step))) {
+            ++message.send_step;
+        }
+        if(message.send_step == total_steps) {
+            ++sending_message_number;
+            continue;
+        }
 
-        transfer = transfer_schedule->get_outgoing_transfer(num_blocks, send_step);
-    }
+        size_t target = transfer->target;
+        size_t block_number = transfer->block_number;
 
-    size_t target = transfer->target;
-    size_t block_number = transfer->block_number;
-    //    size_t forged_block_number = transfer->forged_block_number;
+        if(member_index > 0 && !message.received_blocks[block_number]) return;
+
+        if(receivers_ready.count(target) == 0) {
+            LOG_EVENT(group_number, message.message_number, block_number,
+                      "receiver_not_ready");
+            return;
+        }
 
-    if(member_index > 0 && !received_blocks[block_number]) return;
+        receivers_ready.erase(target);
+        sending = true;
+        ++message.send_step;
 
-    if(receivers_ready.count(transfer->target) == 0) {
-        LOG_EVENT(group_number, message_number, block_number,
-                  "receiver_not_ready");
+#ifdef USE_VERBS_API
+        auto it = queue_pairs.find(target);
+        assert(it != queue_pairs.end());
+#else
+        auto it = endpoints.find(target);
+        assert(it != endpoints.end());
+#endif
+        size_t offset = block_number * message.message_block_size;
+        size_t nbytes = min(message.message_block_size, message.message_size - offset);
+        CHECK(it->second.post_send(*message.mr, message.mr_offset + offset, nbytes,
+                                   form_tag(group_number, target),
+                                   form_immediate(message.num_blocks, block_number),
+                                   message_types.data_block));
+        outgoing_block = block_number;
+        LOG_EVENT(group_number, message.message_number, block_number,
+                  "started_sending_block");
         return;
     }
+}
+void polling_group::complete_messages() {
+    // A message is complete once all of its blocks have been sent and
+    // received, and messages complete in order.
+    while(!messages.empty() && messages.front().message_number < sending_message_number
+          && (member_index == 0 || messages.front().num_received_blocks == messages.front().num_blocks)) {
+        message_state& message = messages.front();
+        completed_messages.push_back({message.mr, message.mr_offset, message.message_size});
+        messages.pop_front();
+    }
 
-    receivers_ready.erase(transfer->target);
-    sending = true;
-    ++send_step;
-
-    // printf("sending block #%d to node #%d on step %d\n", (int)block_number,
-    // 	   (int)target, (int)send_step-1);
-    // fflush(stdout);
+    // Ask for the next message once the newest one has been received, if
+    // there is room for it
+    if(member_index > 0 && !header_requested && messages.size() < max_in_flight
+       && (messages.empty() || messages.back().num_received_blocks == messages.back().num_blocks)) {
+        request_header();
+    }
+}
+void polling_group::call_completion_callbacks(std::unique_lock<std::mutex>& lock) {
+    // The callbacks run without the monitor held, so that they can block on
+    // locks held by a thread that is calling send_message(). All callbacks
+    // are issued from the completion polling thread, so they stay in order.
+    vector<completed_message> completed;
+    completed.swap(completed_messages);
+    lock.unlock();
+    for(const completed_message& message : completed) {
+        completion_callback(message.mr->buffer + message.offset, message.size);
+    }
+}
+void polling_group::request_header() {
+    // The sender of a receiver's first block does not depend on the number of blocks
+    auto transfer = transfer_schedule->get_first_block(1);
+    assert(transfer);
 #ifdef USE_VERBS_API
-    auto it = queue_pairs.find(target);
+    auto it = queue_pairs.find(transfer->target);
     assert(it != queue_pairs.end());
 #else
-    auto it = endpoints.find(target);
+    auto it = endpoints.find(transfer->target);
     assert(it != endpoints.end());
 #endif
-    if(first_block_number && block_number == *first_block_number) {
-        CHECK(it->second.post_send(*first_block_mr, 0, block_size,
-                                   form_tag(group_number, target),
-                                   form_immediate(num_blocks, block_number),
-                                   message_types.data_block));
-    } else {
-        size_t offset = block_number * block_size;
-        size_t nbytes = min(block_size, message_size - offset);
-        CHECK(it->second.post_send(*mr, mr_offset + offset, nbytes,
-                                   form_tag(group_number, target),
-                                   form_immediate(num_blocks, block_number),
-                                   message_types.data_block));
-    }
-    outgoing_block = block_number;
-    LOG_EVENT(group_number, message_number, block_number,
-              "started_sending_block");
-}
-void polling_group::complete_message() {
-    // remap first_block into buffer
-    if(member_index > 0 && first_block_number) {
-        LOG_EVENT(group_number, message_number, *first_block_number,
-                  "starting_remap_first_block");
-        // if(block_size > (128 << 10) && (block_size % 4096 == 0)) {
-        //     uint8_t *tmp_buffer =
-        //         (uint8_t *)mmap(NULL, block_size, PROT_READ | PROT_WRITE,
-        //                      MAP_ANON | MAP_PRIVATE, -1, 0);
-
-        //     mremap(buffer + block_size * (*first_block_number), block_size,
-        //            block_size, MREMAP_FIXED | MREMAP_MAYMOVE, tmp_buffer);
-
-        //     mremap(first_block_buffer, block_size, block_size,
-        //            MREMAP_FIXED | MREMAP_MAYMOVE,
-        //            buffer + block_size * (*first_block_number));
-        //     first_block_buffer = tmp_buffer;
-        // } else {
-        memcpy(mr->buffer + mr_offset + block_size * (*first_block_number),
-               first_block_buffer.get(), block_size);
-        // }
-        LOG_EVENT(group_number, message_number, *first_block_number,
-                  "finished_remap_first_block");
-    }
-    completion_callback(mr->buffer + mr_offset, message_size);
-
-    ++message_number;
-    sending = false;
-    send_step = 0;
-    receive_step = 0;
-    mr.reset();
-    // if(first_block_buffer == nullptr && member_index > 0){
-    //     first_block_buffer = (uint8_t*)mmap(NULL, block_size,
-    // PROT_READ|PROT_WRITE,
-    //                                      MAP_ANON|MAP_PRIVATE, -1, 0);
-    //     memset(first_block_buffer, 1, block_size);
-    //     memset(first_block_buffer, 0, block_size);
-    // }
-    first_block_number = std::nullopt;
-
-    if(member_index != 0) {
-        num_received_blocks = 0;
-        received_blocks.clear();
-        auto transfer = transfer_schedule->get_first_block(num_blocks);
-        assert(transfer);
-        first_block_number = transfer->block_number;
-        post_recv(*transfer);
-        incoming_block = transfer->block_number;
-        send_ready_for_block(transfer->target);
-        // cout << "Issued Ready For Block DDDDDDD (target = " <<
-        // transfer->target
-        //      << ")" << endl;
+    CHECK(it->second.post_recv(*incoming_header_mr, 0, sizeof(incoming_header),
+                               form_tag(group_number, transfer->target),
+                               message_types.header));
+    header_requested = true;
+    send_ready_for_block(transfer->target, READY_FOR_HEADER);
+}
+void polling_group::send_headers() {
+    for(auto target_it = receivers_awaiting_header.begin(); target_it != receivers_awaiting_header.end();) {
+        // Until we know about the message a receiver needs next, there is no
+        // header to send it
+        size_t header_number = next_header_numbers[*target_it];
+        if(header_number >= next_message_number) {
+            ++target_it;
+            continue;
+        }
+#ifdef USE_VERBS_API
+        auto it = queue_pairs.find(*target_it);
+        assert(it != queue_pairs.end());
+#else
+        auto it = endpoints.find(*target_it);
+        assert(it != endpoints.end());
+#endif
+        CHECK(it->second.post_send(*outgoing_headers_mr, (header_number % max_in_flight) * sizeof(message_header),
+                                   sizeof(message_header), form_tag(group_number, *target_it), 0,
+                                   message_types.header));
+        next_header_numbers[*target_it] = header_number + 1;
+        target_it = receivers_awaiting_header.erase(target_it);
     }
 }
-void polling_group::post_recv(schedule::block_transfer transfer) {
+void polling_group::post_recv(const message_state& message, schedule::block_transfer transfer) {
 #ifdef USE_VERBS_API
     auto it = queue_pairs.find(transfer.target);
     assert(it != queue_pairs.end());
@@ -414,25 +452,15 @@ void polling_group::post_recv(schedule::block_transfer transfer) {
     auto it = endpoints.find(transfer.target);
     assert(it != endpoints.end());
 #endif
-    // printf("Posting receive buffer for block #%d from node #%d\n",
-    //        (int)transfer.block_number, (int)transfer.target);
-    // fflush(stdout);
+    size_t offset = message.message_block_size * transfer.block_number;
+    size_t length = min(message.message_block_size, (size_t)(message.message_size - offset));
 
-    if(first_block_number && transfer.block_number == *first_block_number) {
-        CHECK(it->second.post_recv(*first_block_mr, 0, block_size,
+    if(length > 0) {
+        CHECK(it->second.post_recv(*message.mr, message.mr_offset + offset, length,
                                    form_tag(group_number, transfer.target),
                                    message_types.data_block));
-    } else {
-        size_t offset = block_size * transfer.block_number;
-        size_t length = min(block_size, (size_t)(message_size - offset));
-
-        if(length > 0) {
-            CHECK(it->second.post_recv(*mr, mr_offset + offset, length,
-                                       form_tag(group_number, transfer.target),
-                                       message_types.data_block));
-        }
     }
-    LOG_EVENT(group_number, message_number, transfer.block_number,
+    LOG_EVENT(group_number, message.message_number, transfer.block_number,
               "posted_receive_buffer");
 }
 void polling_group::connect(uint32_t neighbor) {
@@ -459,7 +487,18 @@ void polling_group::connect(uint32_t neighbor) {
 #endif
 }
 
-void polling_group::send_ready_for_block(uint32_t neighbor) {
+rdmc::group_resources polling_group::get_resources() {
+    unique_lock<mutex> lock(monitor);
+    rdmc::group_resources resources;
+#ifdef USE_VERBS_API
+    resources.num_connections = queue_pairs.size() + rfb_queue_pairs.size();
+#else
+    resources.num_connections = endpoints.size() + rfb_endpoints.size();
+#endif
+    resources.registered_bytes = incoming_header_mr->size + outgoing_headers_mr->size;
+    return resources;
+}
+void polling_group::send_ready_for_block(uint32_t neighbor, uint32_t immediate) {
 #ifdef USE_VERBS_API
     auto it = rfb_queue_pairs.find(neighbor);
     assert(it != rfb_queue_pairs.end());
@@ -468,6 +507,488 @@ void polling_group::send_ready_for_block(uint32_t neighbor) {
     assert(it != rfb_endpoints.end());
 #endif
 
-    it->second.post_empty_send(form_tag(group_number, neighbor), 0,
+    it->second.post_empty_send(form_tag(group_number, neighbor), immediate,
+                               message_types.ready_for_block);
+}
+
+multi_root_group::multi_root_group(uint16_t _group_number, size_t _block_size,
+                                   vector<uint32_t> _members, uint32_t _member_index,
+                                   multi_root_incoming_message_callback_t upcall,
+                                   multi_root_completion_callback_t callback,
+                                   const schedule_factory_t& make_schedule)
+        : group(_group_number, _block_size, _members, _member_index),
+          completion_callback(callback),
+          incoming_message_upcall(upcall),
+          roots(num_members),
+          incoming_headers(num_members),
+          outgoing_headers(num_members * max_in_flight) {
+    if(num_members - 1 > MAX_CONTROL_ROOT) throw rdmc::invalid_args();
+
+    incoming_headers_mr = make_unique<memory_region>((uint8_t*)incoming_headers.data(),
+                                                     incoming_headers.size() * sizeof(message_header));
+    outgoing_headers_mr = make_unique<memory_region>((uint8_t*)outgoing_headers.data(),
+                                                     outgoing_headers.size() * sizeof(message_header));
+
+    // Set up the schedule of each root, and find the members we exchange
+    // its headers with. Headers travel along the same tree as the first
+    // block of a message.
+    map<uint32_t, uint32_t> roots_per_neighbor;
+    for(uint32_t root = 0; root < num_members; root++) {
+        root_state& r = roots[root];
+        r.transfer_schedule = make_schedule(root, to_rotated(root, member_index));
+        for(uint32_t neighbor : r.transfer_schedule->get_connections()) {
+            roots_per_neighbor[to_member(root, neighbor)]++;
+        }
+        for(uint32_t member = 0; member < num_members; member++) {
+            if(member == root) continue;
+            uint32_t header_source;
+            if(member == member_index) {
+                header_source = to_member(root, r.transfer_schedule->get_first_block(1)->target);
+                r.header_source = header_source;
+            } else {
+                auto member_schedule = make_schedule(root, to_rotated(root, member));
+                header_source = to_member(root, member_schedule->get_first_block(1)->target);
+                if(header_source == member_index) {
+                    r.header_children.push_back(member);
+                }
+            }
+        }
+    }
+
+    // Each neighbor can have announcements and readies outstanding for every
+    // root whose transfers use the connection to it, and each one takes up a
+    // receive on that connection
+    for(const auto& neighbor_roots : roots_per_neighbor) {
+        uint32_t control_messages = 2 * neighbor_roots.second * (MAX_ANNOUNCED_BLOCKS + 1);
+        if(control_messages > derecho::getConfUInt32(derecho::Conf::RDMA_RX_DEPTH)
+           || control_messages > derecho::getConfUInt32(derecho::Conf::RDMA_TX_DEPTH)) {
+            throw rdmc::invalid_args();
+        }
+    }
+    // Connect to the neighbors in order of member index, so that every pair
+    // of members creates its connections in the same order
+    for(const auto& neighbor_roots : roots_per_neighbor) {
+        connect(neighbor_roots.first, neighbor_roots.second);
+    }
+}
+uint32_t multi_root_group::to_member(uint32_t root, uint32_t rotated_index) const {
+    return (rotated_index + root) % num_members;
+}
+uint32_t multi_root_group::to_rotated(uint32_t root, uint32_t member) const {
+    return (member + num_members - root) % num_members;
+}
+multi_root_group::message_state& multi_root_group::get_message(root_state& root, size_t message_number) {
+    assert(!root.messages.empty() && message_number >= root.messages.front().message_number);
+    return root.messages[message_number - root.messages.front().message_number];
+}
+multi_root_group::message_state& multi_root_group::add_message(uint32_t root, const message_header& header) {
+    root_state& r = roots[root];
+    assert(r.messages.size() < max_in_flight);
+
+    message_state& message = r.messages.emplace_back();
+    message.message_number = r.next_message_number++;
+    assert(header.message_number == (uint32_t)message.message_number);
+    message.message_size = header.message_size;
+    message.message_block_size = block_size >> header.block_size_shift;
+    message.num_blocks = (message.message_size - 1) / message.message_block_size + 1;
+
+    // We are done with the message once we have sent its header to each
+    // header child and made every send in our schedule
+    message.sends_remaining = r.header_children.size();
+    const size_t total_steps = r.transfer_schedule->get_total_steps(message.num_blocks);
+    for(size_t step = 0; step < total_steps; step++) {
+        if(r.transfer_schedule->get_outgoing_transfer(message.num_blocks, step)) {
+            message.sends_remaining++;
+        }
+    }
+
+    outgoing_headers[root * max_in_flight + message.message_number % max_in_flight] = header;
+    return message;
+}
+void multi_root_group::send_message(shared_ptr<memory_region> message_mr, size_t offset,
+                                    size_t length) {
+    LOG_EVENT(group_number, -1, -1, "send()");
+
+    unique_lock<mutex> lock(monitor);
+
+    if(length == 0) throw rdmc::invalid_args();
+    if(offset + length > message_mr->size) throw rdmc::invalid_args();
+
+    root_state& r = roots[member_index];
+    if(r.messages.size() >= max_in_flight) throw rdmc::group_busy();
+
+    uint8_t block_size_shift = choose_block_size_shift(*r.transfer_schedule, length);
+    if((length - 1) / (block_size >> block_size_shift) + 1 > std::numeric_limits<uint16_t>::max())
+        throw rdmc::invalid_args();
+
+    message_state& message = add_message(member_index,
+                                         make_message_header(*message_mr, offset, length, block_size_shift,
+                                                             (uint32_t)r.next_message_number));
+    message.mr = message_mr;
+    message.mr_offset = offset;
+    message.received_blocks = vector<bool>(message.num_blocks, true);
+    message.num_received_blocks = message.num_blocks;
+    LOG_EVENT(group_number, message.message_number, -1, "send_message");
+
+    announce_headers(member_index);
+    announce_blocks(member_index);
+    // No need to worry about completion here. We must send at least
+    // one block, so we can't be done already.
+}
+void multi_root_group::receive_header(uint32_t sender) {
+    unique_lock<mutex> lock(monitor);
+
+    auto& posted = posted_receives.at(sender);
+    assert(!posted.empty() && !posted.front().block_number);
+    const uint32_t root = posted.front().root;
+
+    // The upcall takes the caller's locks, and a thread holding them may be
+    // waiting for the monitor in send_message(), so ask for the destination
+    // without holding it. Only this thread handles completions, and no
+    // header receive is posted for this root, so none of the state used
+    // below can change meanwhile.
+    lock.unlock();
+    auto destination = incoming_message_upcall(root, incoming_headers[root].message_size,
+                                               incoming_headers[root].prefix);
+    lock.lock();
+    posted.pop_front();
+
+    root_state& r = roots[root];
+    r.header_receive_posted = false;
+    message_state& message = add_message(root, incoming_headers[root]);
+    message.mr_offset = destination.offset;
+    message.mr = destination.mr;
+
+    assert(message.mr->size >= message.mr_offset + message.message_size);
+
+    // Find out who sends us each block
+    message.block_sources = vector<uint32_t>(message.num_blocks, member_index);
+    message.announced_blocks = vector<bool>(message.num_blocks);
+    message.received_blocks = vector<bool>(message.num_blocks);
+    const size_t total_steps = r.transfer_schedule->get_total_steps(message.num_blocks);
+    for(size_t step = 0; step < total_steps; step++) {
+        auto transfer = r.transfer_schedule->get_incoming_transfer(message.num_blocks, step);
+        if(transfer) {
+            message.block_sources[transfer->block_number] = to_member(root, transfer->target);
+        }
+    }
+    assert(std::find(message.block_sources.begin(), message.block_sources.end(), member_index)
+           == message.block_sources.end());
+
+    LOG_EVENT(group_number, message.message_number, -1, "received_header");
+
+    // Pass the header on, and take the blocks that were announced before it
+    // arrived
+    announce_headers(root);
+    for(const auto& unmatched : r.unmatched_announcements) {
+        match_announcements(root, unmatched.first);
+    }
+    accept_header(root);
+}
+void multi_root_group::receive_block(uint32_t sender, uint32_t send_imm, size_t received_block_size) {
+    unique_lock<mutex> lock(monitor);
+
+    // Receives complete in the order they were posted
+    auto& posted = posted_receives.at(sender);
+    assert(!posted.empty() && posted.front().block_number);
+    pending_transfer transfer = posted.front();
+    posted.pop_front();
+
+    message_state& message = get_message(roots[transfer.root], transfer.message_number);
+    size_t block_number = *transfer.block_number;
+    assert(message.num_blocks == parse_immediate(send_imm).total_blocks);
+    assert(block_number == parse_immediate(send_imm).block_number);
+    assert(received_block_size == min(message.message_block_size,
+                                      message.message_size - block_number * message.message_block_size));
+
+    message.received_blocks[block_number] = true;
+    message.num_received_blocks++;
+    LOG_EVENT(group_number, message.message_number, block_number, "received_block");
+
+    announce_blocks(transfer.root);
+    complete_messages(transfer.root);
+    call_completion_callbacks(lock);
+}
+void multi_root_group::receive_ready_for_block(uint32_t immediate, uint32_t sender) {
+    unique_lock<mutex> lock(monitor);
+
+#ifdef USE_VERBS_API
+    auto it = rfb_queue_pairs.find(sender);
+    assert(it != rfb_queue_pairs.end());
+#else
+    auto it = rfb_endpoints.find(sender);
+    assert(it != rfb_endpoints.end());
+#endif
+    it->second.post_empty_recv(form_tag(group_number, sender),
+                               message_types.ready_for_block);
+
+    ParsedControl control = parse_control(immediate);
+    root_state& r = roots[control.root];
+    switch(control.type) {
+        case control_type::announce_header:
+            assert(sender == r.header_source);
+            r.header_announced = true;
+            accept_header(control.root);
+            break;
+        case control_type::announce_block:
+            r.unmatched_announcements[sender].push_back(control.block_number);
+            match_announcements(control.root, sender);
+            break;
+        case control_type::ready_for_header: {
+            assert(r.header_announcements_outstanding.count(sender));
+            r.header_announcements_outstanding.erase(sender);
+            size_t header_number = r.next_header_numbers[sender]++;
+            ready_sends.push_back(pending_transfer{control.root, header_number, sender, std::nullopt});
+            announce_headers(control.root);
+            send_next();
+            break;
+        }
+        case control_type::ready_for_block: {
+            // Readies for a root's blocks come in the order we announced them
+            auto& announced = announced_sends[sender];
+            auto transfer = std::find_if(announced.begin(), announced.end(),
+                                         [&control](const pending_transfer& t) {
+                                             return t.root == control.root && *t.block_number == control.block_number;
+                                         });
+            assert(transfer != announced.end());
+            ready_sends.push_back(*transfer);
+            announced.erase(transfer);
+            send_next();
+            break;
+        }
+    }
+}
+void multi_root_group::complete_header_send(uint32_t target) {
+    unique_lock<mutex> lock(monitor);
+    complete_send();
+    call_completion_callbacks(lock);
+}
+void multi_root_group::complete_block_send() {
+    unique_lock<mutex> lock(monitor);
+    complete_send();
+    call_completion_callbacks(lock);
+}
+void multi_root_group::accept_header(uint32_t root) {
+    root_state& r = roots[root];
+    // Headers of a root share one receive slot, so only one can be
+    // outstanding, and a header starts a message so it must wait for room
+    if(!r.header_announced || r.header_receive_posted || r.messages.size() >= max_in_flight) {
+        return;
+    }
+    r.header_announced = false;
+    r.header_receive_posted = true;
+
+#ifdef USE_VERBS_API
+    auto it = queue_pairs.find(r.header_source);
+    assert(it != queue_pairs.end());
+#else
+    auto it = endpoints.find(r.header_source);
+    assert(it != endpoints.end());
+#endif
+    CHECK(it->second.post_recv(*incoming_headers_mr, root * sizeof(message_header), sizeof(message_header),
+                               form_tag(group_number, r.header_source), message_types.header));
+    posted_receives[r.header_source].push_back(
+            pending_transfer{root, r.next_message_number, r.header_source, std::nullopt});
+    send_control(r.header_source, control_type::ready_for_header, root);
+}
+void multi_root_group::announce_headers(uint32_t root) {
+    root_state& r = roots[root];
+    for(uint32_t child : r.header_children) {
+        if(r.next_header_numbers[child] < r.next_message_number
+           && !r.header_announcements_outstanding.count(child)) {
+            r.header_announcements_outstanding.insert(child);
+            send_control(child, control_type::announce_header, root);
+        }
+    }
+}
+void multi_root_group::announce_blocks(uint32_t root) {
+    root_state& r = roots[root];
+    // Announce the sends of each message in the order of the schedule, and
+    // those of one message before those of the next
+    while(r.announcing_message_number < r.next_message_number) {
+        message_state& message = get_message(r, r.announcing_message_number);
+        const size_t total_steps = r.transfer_schedule->get_total_steps(message.num_blocks);
+        for(; message.send_step < total_steps; message.send_step++) {
+            auto transfer = r.transfer_schedule->get_outgoing_transfer(message.num_blocks, message.send_step);
+            if(!transfer) continue;
+
+            uint32_t target = to_member(root, transfer->target);
+            if(!message.received_blocks[transfer->block_number]
+               || r.announced_blocks[target] >= MAX_ANNOUNCED_BLOCKS) {
+                return;
+            }
+            r.announced_blocks[target]++;
+            announced_sends[target].push_back(
+                    pending_transfer{root, message.message_number, target, (uint16_t)transfer->block_number});
+            send_control(target, control_type::announce_block, root, transfer->block_number);
+            LOG_EVENT(group_number, message.message_number, transfer->block_number,
+                      "announced_block");
+        }
+        r.announcing_message_number++;
+    }
+}
+void multi_root_group::match_announcements(uint32_t root, uint32_t sender) {
+    root_state& r = roots[root];
+    auto& unmatched = r.unmatched_announcements[sender];
+    while(!unmatched.empty()) {
+        // The sender announces the blocks of older messages first, so the
+        // block belongs to the oldest message that expects it from the sender
+        uint16_t block_number = unmatched.front();
+        auto message = std::find_if(r.messages.begin(), r.messages.end(),
+                                    [&](const message_state& m) {
+                                        return block_number < m.block_sources.size()
+                                               && m.block_sources[block_number] == sender
+                                               && !m.announced_blocks[block_number];
+                                    });
+        if(message == r.messages.end()) {
+            return;
+        }
+        message->announced_blocks[block_number] = true;
+        post_recv(*message, sender, root, block_number);
+        send_control(sender, control_type::ready_for_block, root, block_number);
+        unmatched.pop_front();
+    }
+}
+void multi_root_group::send_next() {
+    if(current_send || ready_sends.empty()) {
+        return;
+    }
+    current_send = ready_sends.front();
+    ready_sends.pop_front();
+
+    const pending_transfer& transfer = *current_send;
+    message_state& message = get_message(roots[transfer.root], transfer.message_number);
+#ifdef USE_VERBS_API
+    auto it = queue_pairs.find(transfer.neighbor);
+    assert(it != queue_pairs.end());
+#else
+    auto it = endpoints.find(transfer.neighbor);
+    assert(it != endpoints.end());
+#endif
+    if(transfer.block_number) {
+        size_t offset = *transfer.block_number * message.message_block_size;
+        size_t nbytes = min(message.message_block_size, message.message_size - offset);
+        CHECK(it->second.post_send(*message.mr, message.mr_offset + offset, nbytes,
+                                   form_tag(group_number, transfer.neighbor),
+                                   form_immediate(message.num_blocks, *transfer.block_number),
+                                   message_types.data_block));
+        LOG_EVENT(group_number, message.message_number, *transfer.block_number,
+                  "started_sending_block");
+    } else {
+        size_t header_slot = transfer.root * max_in_flight + transfer.message_number % max_in_flight;
+        CHECK(it->second.post_send(*outgoing_headers_mr, header_slot * sizeof(message_header),
+                                   sizeof(message_header), form_tag(group_number, transfer.neighbor), 0,
+                                   message_types.header));
+    }
+}
+void multi_root_group::complete_send() {
+    assert(current_send);
+    pending_transfer transfer = *current_send;
+    current_send.reset();
+
+    root_state& r = roots[transfer.root];
+    get_message(r, transfer.message_number).sends_remaining--;
+    if(transfer.block_number) {
+        LOG_EVENT(group_number, transfer.message_number, *transfer.block_number,
+                  "finished_sending_block");
+        r.announced_blocks[transfer.neighbor]--;
+        announce_blocks(transfer.root);
+    }
+    send_next();
+    complete_messages(transfer.root);
+}
+void multi_root_group::complete_messages(uint32_t root) {
+    root_state& r = roots[root];
+    bool completed = false;
+    while(!r.messages.empty() && r.messages.front().message_number < r.announcing_message_number
+          && r.messages.front().sends_remaining == 0
+          && r.messages.front().num_received_blocks == r.messages.front().num_blocks) {
+        message_state& message = r.messages.front();
+        completed_messages.push_back({root, message.mr, message.mr_offset, message.message_size});
+        r.messages.pop_front();
+        completed = true;
+    }
+    // There may be room for the next message now
+    if(completed) {
+        accept_header(root);
+    }
+}
+void multi_root_group::call_completion_callbacks(std::unique_lock<std::mutex>& lock) {
+    // As in polling_group, the callbacks run without the monitor held
+    vector<completed_message> completed;
+    completed.swap(completed_messages);
+    lock.unlock();
+    for(const completed_message& message : completed) {
+        completion_callback(message.root, message.mr->buffer + message.offset, message.size);
+    }
+}
+void multi_root_group::post_recv(const message_state& message, uint32_t sender, uint32_t root,
+                                 uint16_t block_number) {
+#ifdef USE_VERBS_API
+    auto it = queue_pairs.find(sender);
+    assert(it != queue_pairs.end());
+#else
+    auto it = endpoints.find(sender);
+    assert(it != endpoints.end());
+#endif
+    size_t offset = message.message_block_size * block_number;
+    size_t length = min(message.message_block_size, (size_t)(message.message_size - offset));
+    CHECK(it->second.post_recv(*message.mr, message.mr_offset + offset, length,
+                               form_tag(group_number, sender),
+                               message_types.data_block));
+    posted_receives[sender].push_back(pending_transfer{root, message.message_number, sender, block_number});
+    LOG_EVENT(group_number, message.message_number, block_number,
+              "posted_receive_buffer");
+}
+void multi_root_group::send_control(uint32_t neighbor, control_type type, uint32_t root,
+                                    uint16_t block_number) {
+#ifdef USE_VERBS_API
+    auto it = rfb_queue_pairs.find(neighbor);
+    assert(it != rfb_queue_pairs.end());
+#else
+    auto it = rfb_endpoints.find(neighbor);
+    assert(it != rfb_endpoints.end());
+#endif
+    it->second.post_empty_send(form_tag(group_number, neighbor),
+                               form_control(type, root, block_number),
                                message_types.ready_for_block);
 }
+rdmc::group_resources multi_root_group::get_resources() {
+    unique_lock<mutex> lock(monitor);
+    rdmc::group_resources resources;
+#ifdef USE_VERBS_API
+    resources.num_connections = queue_pairs.size() + rfb_queue_pairs.size();
+#else
+    resources.num_connections = endpoints.size() + rfb_endpoints.size();
+#endif
+    resources.registered_bytes = incoming_headers_mr->size + outgoing_headers_mr->size;
+    return resources;
+}
+void multi_root_group::connect(uint32_t neighbor, uint32_t num_roots) {
+    const uint32_t control_receives = 2 * num_roots * (MAX_ANNOUNCED_BLOCKS + 1);
+#ifdef USE_VERBS_API
+    queue_pairs.emplace(neighbor, queue_pair(members[neighbor]));
+
+    auto post_recvs = [this, neighbor, control_receives](rdma::queue_pair* qp) {
+        for(uint32_t i = 0; i < control_receives; i++) {
+            qp->post_empty_recv(form_tag(group_number, neighbor),
+                                message_types.ready_for_block);
+        }
+    };
+
+    rfb_queue_pairs.emplace(neighbor, queue_pair(members[neighbor], post_recvs));
+#else
+    // Decide whether the endpoint will act as a server in the connection
+    bool is_lf_server = members[member_index] < members[neighbor];
+    endpoints.emplace(neighbor, endpoint(members[neighbor], is_lf_server));
+
+    auto post_recvs = [this, neighbor, control_receives](rdma::endpoint* ep) {
+        for(uint32_t i = 0; i < control_receives; i++) {
+            ep->post_empty_recv(form_tag(group_number, neighbor),
+                                message_types.ready_for_block);
+        }
+    };
+
+    rfb_endpoints.emplace(neighbor, endpoint(members[neighbor], is_lf_server, post_recvs));
+#endif
+}
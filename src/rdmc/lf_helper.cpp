@@ -5,10 +5,12 @@
 #include <derecho/rdmc/detail/util.hpp>
 #include <derecho/tcp/tcp.hpp>
 #include <derecho/utils/logger.hpp>
+#include <derecho/utils/registered_memory.hpp>
 
 #include <arpa/inet.h>
 #include <atomic>
 #include <byteswap.h>
+#include <chrono>
 #include <cstring>
 #include <fcntl.h>
 #include <iostream>
@@ -184,12 +186,14 @@ memory_region::memory_region(uint8_t* buf, size_t s) : buffer(buf), size(s) {
 
     /** Register the memory, use it to construct a smart pointer */
     fid_mr* raw_mr;
+    const auto start_time = std::chrono::steady_clock::now();
     fail_if_nonzero_retry_on_eagain(
             "Failed to register memory", CRASH_ON_FAILURE,
             fi_mr_reg, g_ctxt.domain, (void*)buffer, size, mr_access, 0, 0, 0, &raw_mr, nullptr);
     if(!raw_mr) {
         crash_with_message("Pointer to memory region is null");
     }
+    derecho::record_memory_registration(std::chrono::steady_clock::now() - start_time);
 
     mr = std::unique_ptr<fid_mr, std::function<void(fid_mr*)>>(
             raw_mr, [](fid_mr* mr) { fi_close(&mr->fid); });
@@ -9,6 +9,7 @@
 #include <derecho/rdmc/detail/lf_helper.hpp>
 #endif
 
+#include <derecho/conf/conf.hpp>
 #include <derecho/core/derecho_type_definitions.hpp>
 
 #include <atomic>
@@ -19,6 +20,7 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -34,10 +36,48 @@ atomic<bool> shutdown_flag;
 map<uint16_t, shared_ptr<group>> groups;
 mutex groups_lock;
 
+// map from node ID to the location used by topology_send
+map<uint32_t, string> node_locations;
+
+// Parses DERECHO/rdmc_node_locations, a comma-separated list of
+// <node_id>:<location> entries
+static bool parse_node_locations(const string& value) {
+    node_locations.clear();
+    size_t start = 0;
+    while(start < value.size()) {
+        size_t end = value.find(',', start);
+        if(end == string::npos) end = value.size();
+        string entry = value.substr(start, end - start);
+        start = end + 1;
+        if(entry.find_first_not_of(" \t") == string::npos) continue;
+
+        size_t colon = entry.find(':');
+        if(colon == string::npos) {
+            printf("Malformed entry in rdmc_node_locations: %s\n", entry.c_str());
+            fflush(stdout);
+            return false;
+        }
+        string location = entry.substr(colon + 1);
+        location.erase(0, location.find_first_not_of(" \t"));
+        location.erase(location.find_last_not_of(" \t") + 1);
+        try {
+            node_locations[std::stoul(entry.substr(0, colon))] = location;
+        } catch(std::logic_error&) {
+            printf("Malformed node ID in rdmc_node_locations: %s\n", entry.c_str());
+            fflush(stdout);
+            return false;
+        }
+    }
+    return true;
+}
+
   bool initialize(const map<uint32_t, std::pair<ip_addr_t, uint16_t>>& ip_addrs_and_ports, uint32_t _node_rank) {
     if(shutdown_flag) return false;
 
     node_rank = _node_rank;
+    if(!parse_node_locations(derecho::getConfString(derecho::Conf::DERECHO_RDMC_NODE_LOCATIONS))) {
+        return false;
+    }
 #ifdef USE_VERBS_API
     if(!::rdma::impl::verbs_initialize(ip_addrs_and_ports, node_rank)) {
 #else
@@ -46,7 +86,7 @@ mutex groups_lock;
         return false;
     }
 
-    polling_group::initialize_message_types();
+    group::initialize_message_types();
     return true;
 }
 void add_address(uint32_t index, const std::pair<ip_addr_t, uint16_t>& address) {
@@ -57,6 +97,27 @@ void add_address(uint32_t index, const std::pair<ip_addr_t, uint16_t>& address)
 #endif
 }
 
+static unique_ptr<schedule> make_schedule(send_algorithm algorithm, const vector<uint32_t>& members,
+                                          uint32_t member_index) {
+    if(algorithm == BINOMIAL_SEND) {
+        return make_unique<binomial_schedule>(members.size(), member_index);
+    } else if(algorithm == SEQUENTIAL_SEND) {
+        return make_unique<sequential_schedule>(members.size(), member_index);
+    } else if(algorithm == CHAIN_SEND) {
+        return make_unique<chain_schedule>(members.size(), member_index);
+    } else if(algorithm == TREE_SEND) {
+        return make_unique<tree_schedule>(members.size(), member_index);
+    } else if(algorithm == TOPOLOGY_SEND) {
+        vector<string> member_locations;
+        for(uint32_t member : members) {
+            auto it = node_locations.find(member);
+            member_locations.push_back(it != node_locations.end() ? it->second : string());
+        }
+        return make_unique<topology_schedule>(members.size(), member_index, member_locations);
+    }
+    return nullptr;
+}
+
 bool create_group(uint16_t group_number, std::vector<uint32_t> members,
                   size_t block_size, send_algorithm algorithm,
                   incoming_message_callback_t incoming_upcall,
@@ -64,17 +125,9 @@ bool create_group(uint16_t group_number, std::vector<uint32_t> members,
                   failure_callback_t failure_callback) {
     if(shutdown_flag) return false;
 
-    schedule* send_schedule;
     uint32_t member_index = index_of(members, node_rank);
-    if(algorithm == BINOMIAL_SEND) {
-        send_schedule = new binomial_schedule(members.size(), member_index);
-    } else if(algorithm == SEQUENTIAL_SEND) {
-        send_schedule = new sequential_schedule(members.size(), member_index);
-    } else if(algorithm == CHAIN_SEND) {
-        send_schedule = new chain_schedule(members.size(), member_index);
-    } else if(algorithm == TREE_SEND) {
-        send_schedule = new tree_schedule(members.size(), member_index);
-    } else {
+    unique_ptr<schedule> send_schedule = make_schedule(algorithm, members, member_index);
+    if(!send_schedule) {
         puts("Unsupported group type?!");
         fflush(stdout);
         return false;
@@ -83,11 +136,50 @@ bool create_group(uint16_t group_number, std::vector<uint32_t> members,
     unique_lock<mutex> lock(groups_lock);
     auto g = make_shared<polling_group>(group_number, block_size, members,
                                         member_index, incoming_upcall, callback,
-                                        unique_ptr<schedule>(send_schedule));
+                                        std::move(send_schedule));
     auto p = groups.emplace(group_number, std::move(g));
     return p.second;
 }
 
+bool create_multi_root_group(uint16_t group_number, std::vector<uint32_t> members,
+                             size_t block_size, send_algorithm algorithm,
+                             multi_root_incoming_message_callback_t incoming_upcall,
+                             multi_root_completion_callback_t callback,
+                             failure_callback_t failure_callback) {
+    if(shutdown_flag) return false;
+
+    if(!make_schedule(algorithm, members, 0)) {
+        puts("Unsupported group type?!");
+        fflush(stdout);
+        return false;
+    }
+
+    uint32_t member_index = index_of(members, node_rank);
+    unique_lock<mutex> lock(groups_lock);
+    auto g = make_shared<multi_root_group>(
+            group_number, block_size, members, member_index, incoming_upcall, callback,
+            [algorithm, &members](uint32_t root, uint32_t rotated_index) {
+                vector<uint32_t> rotated_members(members.size());
+                for(uint32_t k = 0; k < members.size(); k++) {
+                    rotated_members[k] = members[(root + k) % members.size()];
+                }
+                return make_schedule(algorithm, rotated_members, rotated_index);
+            });
+    auto p = groups.emplace(group_number, std::move(g));
+    return p.second;
+}
+
+group_resources get_group_resources(uint16_t group_number) {
+    shared_ptr<group> g;
+    {
+        unique_lock<mutex> lock(groups_lock);
+        auto it = groups.find(group_number);
+        if(it == groups.end()) return group_resources();
+        g = it->second;
+    }
+    return g->get_resources();
+}
+
 void destroy_group(uint16_t group_number) {
     if(shutdown_flag) return;
 
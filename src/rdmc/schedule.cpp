@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <climits>
+#include <utility>
 
 using std::min;
 using std::optional;
@@ -491,3 +492,98 @@ optional<schedule::block_transfer> binomial_schedule::get_first_block(size_t num
 
     return transfer;
 }
+
+// Appends the members of group to order, keeping those whose paths agree
+// beyond the given level together
+static void order_by_path(const vector<vector<std::string>>& paths,
+                          const vector<uint32_t>& group, size_t level,
+                          vector<uint32_t>& order) {
+    // Split the group by the path component at this level, keeping the
+    // subgroups in the order in which their first members appear
+    vector<std::pair<std::string, vector<uint32_t>>> subgroups;
+    bool paths_exhausted = true;
+    for(uint32_t member : group) {
+        std::string component;
+        if(level < paths[member].size()) {
+            component = paths[member][level];
+            paths_exhausted = false;
+        }
+        size_t i = 0;
+        while(i < subgroups.size() && subgroups[i].first != component) i++;
+        if(i == subgroups.size()) subgroups.emplace_back(component, vector<uint32_t>());
+        subgroups[i].second.push_back(member);
+    }
+    if(paths_exhausted) {
+        order.insert(order.end(), group.begin(), group.end());
+        return;
+    }
+    for(const auto& subgroup : subgroups) {
+        order_by_path(paths, subgroup.second, level + 1, order);
+    }
+}
+vector<uint32_t> topology_schedule::order_by_location(const vector<std::string>& member_locations) {
+    vector<vector<std::string>> paths(member_locations.size());
+    for(uint32_t member = 0; member < member_locations.size(); member++) {
+        const std::string& location = member_locations[member];
+        if(location.empty()) {
+            // A component no other member can have
+            paths[member].push_back(std::string(1, '\0') + std::to_string(member));
+            continue;
+        }
+        size_t start = 0;
+        while(start <= location.size()) {
+            size_t end = location.find('/', start);
+            if(end == std::string::npos) end = location.size();
+            paths[member].push_back(location.substr(start, end - start));
+            start = end + 1;
+        }
+    }
+
+    vector<uint32_t> members(member_locations.size());
+    for(uint32_t member = 0; member < members.size(); member++) {
+        members[member] = member;
+    }
+    vector<uint32_t> order;
+    order_by_path(paths, members, 0, order);
+    assert(order.empty() || order[0] == 0);
+    return order;
+}
+
+static vector<uint32_t> invert_order(const vector<uint32_t>& order) {
+    vector<uint32_t> positions(order.size());
+    for(uint32_t position = 0; position < order.size(); position++) {
+        positions[order[position]] = position;
+    }
+    return positions;
+}
+topology_schedule::topology_schedule(uint32_t members, uint32_t index,
+                                     const vector<std::string>& member_locations)
+        : schedule(members, index),
+          chain_order(order_by_location(member_locations)),
+          chain_positions(invert_order(chain_order)),
+          chain(members, chain_positions.at(index)) {
+    assert(member_locations.size() == members);
+}
+optional<schedule::block_transfer> topology_schedule::from_chain(optional<block_transfer> transfer) const {
+    if(!transfer) return std::nullopt;
+    return block_transfer{chain_order[transfer->target], transfer->block_number};
+}
+vector<uint32_t> topology_schedule::get_connections() const {
+    vector<uint32_t> connections = chain.get_connections();
+    for(uint32_t& neighbor : connections) {
+        neighbor = chain_order[neighbor];
+    }
+    return connections;
+}
+size_t topology_schedule::get_total_steps(size_t num_blocks) const {
+    return chain.get_total_steps(num_blocks);
+}
+optional<schedule::block_transfer> topology_schedule::get_outgoing_transfer(size_t num_blocks, size_t step) const {
+    return from_chain(chain.get_outgoing_transfer(num_blocks, step));
+}
+optional<schedule::block_transfer> topology_schedule::get_incoming_transfer(size_t num_blocks, size_t step) const {
+    return from_chain(chain.get_incoming_transfer(num_blocks, step));
+}
+optional<schedule::block_transfer> topology_schedule::get_first_block(size_t num_blocks) const {
+    return from_chain(chain.get_first_block(num_blocks));
+}
@@ -5,8 +5,10 @@
 #include <derecho/rdmc/detail/util.hpp>
 #include <derecho/tcp/tcp.hpp>
 #include <derecho/utils/logger.hpp>
+#include <derecho/utils/registered_memory.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <cstring>
 #include <fcntl.h>
 #include <iostream>
@@ -434,6 +436,7 @@ static ibv_mr_unique_ptr create_mr(uint8_t* buffer, size_t size) {
 
     int mr_flags = IBV_ACCESS_LOCAL_WRITE | IBV_ACCESS_REMOTE_READ | IBV_ACCESS_REMOTE_WRITE;
 
+    const auto start_time = std::chrono::steady_clock::now();
     ibv_mr_unique_ptr mr = ibv_mr_unique_ptr(
             ibv_reg_mr(verbs_resources.pd, (void*)buffer, size, mr_flags),
             [](ibv_mr* m) { ibv_dereg_mr(m); });
@@ -441,6 +444,7 @@ static ibv_mr_unique_ptr create_mr(uint8_t* buffer, size_t size) {
     if(!mr) {
         throw rdma::mr_creation_failure();
     }
+    derecho::record_memory_registration(std::chrono::steady_clock::now() - start_time);
     return mr;
 }
 #ifdef MELLANOX_EXPERIMENTAL_VERBS
@@ -12,11 +12,13 @@
 #include <derecho/sst/detail/sst_impl.hpp>
 #include <derecho/tcp/tcp.hpp>
 #include <derecho/utils/logger.hpp>
+#include <derecho/utils/registered_memory.hpp>
 #include <derecho/utils/time.h>
 #include <derecho/core/derecho_exception.hpp>
 
 #include <arpa/inet.h>
 #include <byteswap.h>
+#include <chrono>
 #include <errno.h>
 #include <iostream>
 #include <rdma/fabric.h>
@@ -221,11 +223,8 @@ int _resources::init_endpoint(struct fi_info* fi) {
     return ret;
 }
 
-void _resources::connect_endpoint(bool is_lf_server) {
-    dbg_trace(sst_logger, "preparing connection to remote node(id={})...\n", this->remote_id);
-    struct cm_con_data_t local_cm_data, remote_cm_data;
-
-    // STEP 1 exchange CM info
+void _resources::exchange_connection_info(struct cm_con_data_t& remote_cm_data) {
+    struct cm_con_data_t local_cm_data;
     dbg_trace(sst_logger, "Exchanging connection management info.");
     local_cm_data.pep_addr_len = (uint32_t)htonl((uint32_t)g_ctxt.pep_addr_len);
     memcpy((void*)&local_cm_data.pep_addr, &g_ctxt.pep_addr, g_ctxt.pep_addr_len);
@@ -250,6 +249,14 @@ void _resources::connect_endpoint(bool is_lf_server) {
     this->mr_rwkey = (uint64_t)ntohll(remote_cm_data.mr_key);
     this->remote_fi_addr = (fi_addr_t)ntohll(remote_cm_data.vaddr);
     dbg_trace(sst_logger, "Exchanging connection management info succeeds.");
+}
+
+void _resources::connect_endpoint(bool is_lf_server) {
+    dbg_trace(sst_logger, "preparing connection to remote node(id={})...\n", this->remote_id);
+    struct cm_con_data_t remote_cm_data;
+
+    // STEP 1 exchange CM info
+    exchange_connection_info(remote_cm_data);
 
     // STEP 2 connect to remote
     dbg_trace(sst_logger, "connect to remote node.");
@@ -376,20 +383,81 @@ _resources::_resources(
         dbg_warn(sst_logger, "{}:{} called with NULL read_addr!", __FILE__, __func__);
     }
 
-#define LF_RMR_KEY(rid) (((uint64_t)0xf0000000) << 32 | (uint64_t)(rid))
-#define LF_WMR_KEY(rid) (((uint64_t)0xf8000000) << 32 | (uint64_t)(rid))
-    // register the write buffer
-    fail_if_nonzero_retry_on_eagain("register memory buffer for write", CRASH_ON_FAILURE,
-                                    fi_mr_reg, g_ctxt.domain, write_buf, size_w,
+    register_buffers(size_w, size_r);
+    // set up the endpoint
+    connect_endpoint(is_lf_server);
+    this->connection = std::make_shared<lf_connection>(this->ep, this->eq);
+}
+
+_resources::_resources(
+        int r_id,
+        uint8_t* write_addr,
+        uint8_t* read_addr,
+        int size_w,
+        int size_r,
+        const _resources& connected_resources)
+        : sst_logger(spdlog::get(LoggerFactory::SST_LOGGER_NAME)),
+          remote_failed(false),
+          remote_id(r_id),
+          ep(connected_resources.ep),
+          write_buf(write_addr),
+          read_buf(read_addr),
+          eq(connected_resources.eq),
+          connection(connected_resources.connection) {
+    dbg_trace(sst_logger, "resources constructor reusing the endpoint of {}: this={}",
+              (void*)&connected_resources, (void*)this);
+    assert(connected_resources.remote_id == r_id);
+
+    register_buffers(size_w, size_r);
+    // the endpoint is already connected, so the remote node only needs the new buffer's key and address
+    struct cm_con_data_t remote_cm_data;
+    exchange_connection_info(remote_cm_data);
+    sync(remote_id);
+}
+
+std::mutex _resources::mr_cache_mutex;
+std::map<std::pair<uint8_t*, size_t>, struct _resources::cached_mr_t> _resources::mr_cache;
+
+struct fid_mr* _resources::acquire_cached_mr(uint8_t* buf, size_t size) {
+    std::lock_guard<std::mutex> lock(mr_cache_mutex);
+    auto cached_mr = mr_cache.find({buf, size});
+    if(cached_mr != mr_cache.end()) {
+        cached_mr->second.ref_count++;
+        derecho::record_registration_cache_hit();
+        return cached_mr->second.mr;
+    }
+    struct fid_mr* mr = nullptr;
+    const auto start_time = std::chrono::steady_clock::now();
+    fail_if_nonzero_retry_on_eagain("register memory buffer", CRASH_ON_FAILURE,
+                                    fi_mr_reg, g_ctxt.domain, buf, size,
                                     FI_SEND | FI_RECV | FI_READ | FI_WRITE | FI_REMOTE_READ | FI_REMOTE_WRITE,
-                                    0, 0, 0, &this->write_mr, nullptr);
-    dbg_trace(sst_logger, "{}:{} registered memory for remote write: {}:{}", __FILE__, __func__, (void*)write_addr, size_w);
+                                    0, 0, 0, &mr, nullptr);
+    derecho::record_memory_registration(std::chrono::steady_clock::now() - start_time);
+    mr_cache.emplace(std::make_pair(buf, size), cached_mr_t{mr, 1});
+    return mr;
+}
+
+void _resources::release_cached_mr(struct fid_mr* mr) {
+    std::lock_guard<std::mutex> lock(mr_cache_mutex);
+    for(auto cached_mr = mr_cache.begin(); cached_mr != mr_cache.end(); ++cached_mr) {
+        if(cached_mr->second.mr == mr) {
+            if(--cached_mr->second.ref_count == 0) {
+                fail_if_nonzero_retry_on_eagain("unregister mr", REPORT_ON_FAILURE,
+                                                fi_close, &mr->fid);
+                mr_cache.erase(cached_mr);
+            }
+            return;
+        }
+    }
+}
+
+void _resources::register_buffers(int size_w, int size_r) {
+    // register the write buffer
+    this->write_mr = acquire_cached_mr(write_buf, size_w);
+    dbg_trace(sst_logger, "{}:{} registered memory for remote write: {}:{}", __FILE__, __func__, (void*)write_buf, size_w);
     // register the read buffer
-    fail_if_nonzero_retry_on_eagain("register memory buffer for read", CRASH_ON_FAILURE,
-                                    fi_mr_reg, g_ctxt.domain, read_buf, size_r,
-                                    FI_SEND | FI_RECV | FI_READ | FI_WRITE | FI_REMOTE_READ | FI_REMOTE_WRITE,
-                                    0, 0, 0, &this->read_mr, nullptr);
-    dbg_trace(sst_logger, "{}:{} registered memory for remote read: {}:{}", __FILE__, __func__, (void*)read_addr, size_r);
+    this->read_mr = acquire_cached_mr(read_buf, size_r);
+    dbg_trace(sst_logger, "{}:{} registered memory for remote read: {}:{}", __FILE__, __func__, (void*)read_buf, size_r);
 
     this->mr_lrkey = fi_mr_key(this->read_mr);
     if(this->mr_lrkey == FI_KEY_NOTAVAIL) {
@@ -400,26 +468,26 @@ _resources::_resources(
     if(this->mr_lwkey == FI_KEY_NOTAVAIL) {
         crash_with_message("fail to get write memory key.");
     }
-    // set up the endpoint
-    connect_endpoint(is_lf_server);
 }
 
-_resources::~_resources() {
-    dbg_trace(sst_logger, "resources destructor:this={}", (void*)this);
-    if(this->ep) {
+lf_connection::~lf_connection() {
+    if(ep) {
         fail_if_nonzero_retry_on_eagain("close endpoint", REPORT_ON_FAILURE,
-                                        fi_close, &this->ep->fid);
+                                        fi_close, &ep->fid);
     }
-    if(this->eq) {
+    if(eq) {
         fail_if_nonzero_retry_on_eagain("close event", REPORT_ON_FAILURE,
-                                        fi_close, &this->eq->fid);
+                                        fi_close, &eq->fid);
     }
+}
+
+_resources::~_resources() {
+    dbg_trace(sst_logger, "resources destructor:this={}", (void*)this);
+    // The endpoint and event queue are closed when the last resources sharing connection are destroyed
     if(this->write_mr)
-        fail_if_nonzero_retry_on_eagain("unregister write mr", REPORT_ON_FAILURE,
-                                        fi_close, &this->write_mr->fid);
+        release_cached_mr(this->write_mr);
     if(this->read_mr)
-        fail_if_nonzero_retry_on_eagain("unregister read mr", REPORT_ON_FAILURE,
-                                        fi_close, &this->read_mr->fid);
+        release_cached_mr(this->read_mr);
 }
 
 int _resources::post_remote_send(
@@ -960,12 +1028,13 @@ void polling_loop() {
     uint64_t last_time_ms = get_walltime() / INT64_1E6;
 
     while(!shutdown) {
-        auto ce = lf_poll_completion();
+        uint64_t seq;
+        auto ce = lf_poll_completion(&seq);
         if(shutdown) {
             break;
         }
         if(ce.first != 0xFFFFFFFF) {
-            util::polling_data.insert_completion_entry(ce.first, ce.second);
+            util::polling_data.insert_completion_entry(ce.first, ce.second, seq);
 
             // update last time
             last_time_ms = get_walltime() / INT64_1E6;
@@ -989,9 +1058,12 @@ void polling_loop() {
  * @return pair(remote_id,result) The queue pair number associated with the
  * completed request and the result (1 for successful, -1 for unsuccessful)
  */
-std::pair<uint32_t, std::pair<int32_t, int32_t>> lf_poll_completion() {
+std::pair<uint32_t, std::pair<int32_t, int32_t>> lf_poll_completion(uint64_t* seq) {
     struct fi_cq_entry entry;
     int poll_result = 0;
+    if(seq) {
+        *seq = 0;
+    }
 
     uint64_t last_time_ms = get_walltime() / INT64_1E6;
 
@@ -1086,6 +1158,9 @@ std::pair<uint32_t, std::pair<int32_t, int32_t>> lf_poll_completion() {
 
             // dbg_trace(g_ctxt.sst_logger, "Normal: we get an entry with op_context = {:p}.", static_cast<void*>(ce_ctxt));
             std::pair<uint32_t,std::pair<int32_t,int32_t>> ret = {ce_ctxt->ce_idx(), {ce_ctxt->remote_id(), 1}};
+            if(seq) {
+                *seq = ce_ctxt->seq();
+            }
             if (!ce_ctxt->is_managed()) {
                 delete ce_ctxt;
             }
@@ -20,34 +20,35 @@ bool PollingData::check_waiting() {
     return std::accumulate(if_waiting.begin(), if_waiting.end(), false, [](bool a, bool b) { return a || b; });
 }
 
-void PollingData::insert_completion_entry(uint32_t index, std::pair<int32_t, int32_t> ce) {
+void PollingData::insert_completion_entry(uint32_t index, std::pair<int32_t, int32_t> ce, uint64_t seq) {
     std::lock_guard<std::mutex> lk(poll_mutex);
     int32_t nid     = ce.first;
     int32_t result  = ce.second;
-    if (completion_entries[index].find(nid) == completion_entries[index].end()) {
-        completion_entries[index].emplace(std::pair<int32_t,std::list<int32_t>>{nid,{}});
-    }
-    completion_entries[index][nid].push_back(result);
+    completion_entries[index][nid].emplace_back(result, seq);
 }
 
-std::optional<int32_t> PollingData::get_completion_entry(const std::thread::id tid, const int nid) {
+std::optional<int32_t> PollingData::get_completion_entry(const std::thread::id tid, const int nid, uint64_t seq) {
     std::lock_guard<std::mutex> lk(poll_mutex);
     auto index = tid_to_index[tid];
-    if(completion_entries[index].find(nid)==completion_entries[index].end()) {
+    auto entries = completion_entries[index].find(nid);
+    if(entries == completion_entries[index].end()) {
         return {};
     }
-    if(completion_entries[index][nid].empty()) {
+    while(!entries->second.empty() && entries->second.front().second < seq) {
+        entries->second.pop_front();
+    }
+    if(entries->second.empty()) {
         return {};
     }
-    int32_t result = completion_entries[index][nid].front();
-    completion_entries[index][nid].pop_front();
+    int32_t result = entries->second.front().first;
+    entries->second.pop_front();
     return result;
 }
 
 uint32_t PollingData::get_index(const std::thread::id id) {
     std::lock_guard<std::mutex> lk(poll_mutex);
     if(tid_to_index.find(id) == tid_to_index.end()) {
-        completion_entries.push_back(std::map<int32_t,std::list<int32_t>>());
+        completion_entries.push_back(std::map<int32_t, std::list<std::pair<int32_t, uint64_t>>>());
         tid_to_index[id] = completion_entries.size() - 1;
         if_waiting.push_back(false);
     }
@@ -577,8 +577,9 @@ void polling_loop() {
     pthread_setname_np(pthread_self(), "sst_poll");
     cout << "Polling thread starting" << endl;
     while(!shutdown) {
-        auto ce = verbs_poll_completion();
-        util::polling_data.insert_completion_entry(ce.first, ce.second);
+        uint64_t seq;
+        auto ce = verbs_poll_completion(&seq);
+        util::polling_data.insert_completion_entry(ce.first, ce.second, seq);
     }
     cout << "Polling thread ending" << endl;
 }
@@ -592,7 +593,7 @@ void polling_loop() {
  * @return pair(qp_num,result) The queue pair number associated with the
  * completed request and the result (1 for successful, -1 for unsuccessful)
  */
-std::pair<uint32_t, std::pair<int, int>> verbs_poll_completion() {
+std::pair<uint32_t, std::pair<int, int>> verbs_poll_completion(uint64_t* seq) {
     struct ibv_wc wc;
     int poll_result;
     verbs_sender_ctxt* sctxt;
@@ -652,7 +653,14 @@ std::pair<uint32_t, std::pair<int, int>> verbs_poll_completion() {
         }
         // util::polling_data.wait_for_requests();
     }
-    return {sctxt->ce_idx(), {sctxt->remote_id(), 1}};
+    std::pair<uint32_t, std::pair<int, int>> ret = {sctxt->ce_idx(), {sctxt->remote_id(), 1}};
+    if(seq) {
+        *seq = sctxt->seq();
+    }
+    if(!sctxt->is_managed()) {
+        delete sctxt;
+    }
+    return ret;
 }
 
 /** Allocates memory for global RDMA resources. */
@@ -0,0 +1,185 @@
+#include <derecho/utils/registered_memory.hpp>
+
+#include <derecho/conf/conf.hpp>
+#include <derecho/core/derecho_exception.hpp>
+#include <derecho/utils/logger.hpp>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <initializer_list>
+#include <linux/mempolicy.h>
+#include <mutex>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+namespace derecho {
+
+static constexpr std::size_t HUGEPAGE_SIZE_2MB = std::size_t{1} << 21;
+static constexpr std::size_t HUGEPAGE_SIZE_1GB = std::size_t{1} << 30;
+
+static std::mutex stats_mutex;
+static RegisteredMemoryStats stats;
+
+static std::size_t normal_page_size() {
+    static const std::size_t page_size = sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+
+RegisteredMemoryOptions get_registered_memory_options() {
+    RegisteredMemoryOptions options;
+    const std::string& hugepages = getConfString(Conf::DERECHO_REGISTERED_MEMORY_HUGEPAGES);
+    if(hugepages == "1gb") {
+        options.max_hugepage_size = HUGEPAGE_SIZE_1GB;
+    } else if(hugepages == "2mb") {
+        options.max_hugepage_size = HUGEPAGE_SIZE_2MB;
+    } else if(hugepages != "none") {
+        throw derecho_exception("Invalid value for " + std::string(Conf::DERECHO_REGISTERED_MEMORY_HUGEPAGES)
+                                + ": " + hugepages + " (expected none, 2mb or 1gb)");
+    }
+    options.numa_node = getConfInt32(Conf::DERECHO_REGISTERED_MEMORY_NUMA_NODE);
+    return options;
+}
+
+/**
+ * Maps size bytes of anonymous memory backed by pages of page_size bytes,
+ * which must be a multiple of page_size.
+ * @return The mapping, or nullptr if it could not be made
+ */
+static uint8_t* map_pages(std::size_t size, std::size_t page_size) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    if(page_size != normal_page_size()) {
+        int page_shift = 0;
+        while((std::size_t{1} << page_shift) < page_size) {
+            page_shift++;
+        }
+        flags |= MAP_HUGETLB | (page_shift << MAP_HUGE_SHIFT);
+    }
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if(memory == MAP_FAILED) {
+        return nullptr;
+    }
+    return static_cast<uint8_t*>(memory);
+}
+
+/**
+ * Binds a mapping that has not been touched yet to a NUMA node. libnuma is
+ * not a dependency, so this makes the mbind system call directly.
+ */
+static void bind_to_numa_node(uint8_t* base, std::size_t size, int numa_node) {
+    constexpr std::size_t bits_per_word = sizeof(unsigned long) * CHAR_BIT;
+    std::vector<unsigned long> node_mask(numa_node / bits_per_word + 1, 0);
+    node_mask[numa_node / bits_per_word] = 1UL << (numa_node % bits_per_word);
+    //The kernel reads one bit fewer than maxnode
+    if(syscall(SYS_mbind, base, size, MPOL_BIND, node_mask.data(), node_mask.size() * bits_per_word + 1, 0) != 0) {
+        dbg_default_warn("Failed to bind {} bytes of registered memory to NUMA node {}: {}",
+                         size, numa_node, std::strerror(errno));
+    }
+}
+
+static void unmap_pages(uint8_t* base, std::size_t size) {
+    munmap(base, size);
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats.mapped_bytes -= size;
+}
+
+RegisteredMemory::RegisteredMemory(std::size_t requested_size, const RegisteredMemoryOptions& options)
+        : base(nullptr), size(0), page_size(0) {
+    const auto start_time = std::chrono::steady_clock::now();
+    for(std::size_t hugepage_size : {HUGEPAGE_SIZE_1GB, HUGEPAGE_SIZE_2MB}) {
+        if(hugepage_size > options.max_hugepage_size || requested_size < hugepage_size / 2) {
+            continue;
+        }
+        const std::size_t rounded_size = (requested_size + hugepage_size - 1) / hugepage_size * hugepage_size;
+        base = map_pages(rounded_size, hugepage_size);
+        if(base) {
+            size = rounded_size;
+            page_size = hugepage_size;
+            break;
+        }
+        dbg_default_debug("No {}-byte huge pages available for {} bytes of registered memory: {}",
+                          hugepage_size, rounded_size, std::strerror(errno));
+    }
+    if(!base) {
+        page_size = normal_page_size();
+        size = (requested_size + page_size - 1) / page_size * page_size;
+        base = map_pages(size, page_size);
+        if(!base) {
+            throw derecho_exception("Failed to map " + std::to_string(size)
+                                    + " bytes of registered memory: " + std::strerror(errno));
+        }
+    }
+    if(options.numa_node >= 0) {
+        bind_to_numa_node(base, size, options.numa_node);
+    }
+    //Fault in every page now, on the bound node, instead of during registration
+    std::memset(base, 0, size);
+    const auto allocation_time = std::chrono::steady_clock::now() - start_time;
+    dbg_default_debug("Mapped {} bytes of registered memory with {}-byte pages in {} ns",
+                      size, page_size, std::chrono::duration_cast<std::chrono::nanoseconds>(allocation_time).count());
+
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats.num_allocations++;
+    if(is_hugepage_backed()) {
+        stats.num_hugepage_allocations++;
+    }
+    stats.mapped_bytes += size;
+    stats.allocation_time += std::chrono::duration_cast<std::chrono::nanoseconds>(allocation_time);
+}
+
+RegisteredMemory::RegisteredMemory(RegisteredMemory&& other)
+        : base(other.base), size(other.size), page_size(other.page_size) {
+    other.base = nullptr;
+    other.size = 0;
+    other.page_size = 0;
+}
+
+RegisteredMemory& RegisteredMemory::operator=(RegisteredMemory&& other) {
+    if(this != &other) {
+        if(base) {
+            unmap_pages(base, size);
+        }
+        base = other.base;
+        size = other.size;
+        page_size = other.page_size;
+        other.base = nullptr;
+        other.size = 0;
+        other.page_size = 0;
+    }
+    return *this;
+}
+
+RegisteredMemory::~RegisteredMemory() {
+    if(base) {
+        unmap_pages(base, size);
+    }
+}
+
+bool RegisteredMemory::is_hugepage_backed() const {
+    return base && page_size != normal_page_size();
+}
+
+RegisteredMemoryStats get_registered_memory_stats() {
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    return stats;
+}
+
+void record_memory_registration(std::chrono::nanoseconds registration_time) {
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats.num_registrations++;
+    stats.registration_time += registration_time;
+}
+
+void record_registration_cache_hit() {
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats.num_registration_cache_hits++;
+}
+
+}  // namespace derecho